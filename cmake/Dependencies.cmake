@@ -23,6 +23,15 @@ find_package(Libevent REQUIRED)
 include_directories(SYSTEM ${LIBEVENT_INCLUDE_DIRS})
 list(APPEND Peloton_LINKER_LIBS ${LIBEVENT_LIBRARIES})
 
+# ---[ Libnuma
+# NOTE: without it, the tables are not placed on the NUMA nodes.
+find_package(Numa)
+if(Numa_FOUND)
+  include_directories(SYSTEM ${NUMA_INCLUDE_DIRS})
+  list(APPEND Peloton_LINKER_LIBS ${NUMA_LIBRARIES})
+  add_definitions(-DPELOTON_HAVE_NUMA)
+endif()
+
 # ---[ Doxygen
 if(BUILD_docs)
   find_package(Doxygen)
@@ -0,0 +1,40 @@
+# - Try to find libnuma
+#
+# the NUMA policy library (https://github.com/numactl/numactl)
+#
+# Usage:
+# NUMA_INCLUDE_DIRS, where to find libnuma headers
+# NUMA_LIBRARIES, libnuma libraries
+# Numa_FOUND, If false, do not try to use libnuma
+
+set(NUMA_ROOT CACHE PATH "Root directory of libnuma installation")
+set(Numa_EXTRA_PREFIXES /usr/local /opt/local "$ENV{HOME}" ${NUMA_ROOT})
+foreach(prefix ${Numa_EXTRA_PREFIXES})
+  list(APPEND Numa_INCLUDE_PATHS "${prefix}/include")
+  list(APPEND Numa_LIBRARIES_PATHS "${prefix}/lib")
+endforeach()
+
+find_path(NUMA_INCLUDE_DIRS numa.h PATHS ${Numa_INCLUDE_PATHS})
+find_library(NUMA_LIBRARIES NAMES numa PATHS ${Numa_LIBRARIES_PATHS})
+
+if (NUMA_LIBRARIES AND NUMA_INCLUDE_DIRS)
+  set(Numa_FOUND TRUE)
+else ()
+  set(Numa_FOUND FALSE)
+endif ()
+
+if (Numa_FOUND)
+  if (NOT Numa_FIND_QUIETLY)
+    message(STATUS "Found libnuma (include: ${NUMA_INCLUDE_DIRS}, library: ${NUMA_LIBRARIES})")
+  endif ()
+else ()
+  if (Numa_FIND_REQUIRED)
+    message(FATAL_ERROR "Could NOT find libnuma.")
+  endif ()
+  message(STATUS "libnuma NOT found.")
+endif ()
+
+mark_as_advanced(
+    NUMA_LIBRARIES
+    NUMA_INCLUDE_DIRS
+  )
@@ -73,6 +73,7 @@ if [ "$DISTRO" = "UBUNTU" ]; then
         bison \
         flex \
         libevent-dev \
+        libnuma-dev \
         libboost-dev \
         libboost-thread-dev \
         libboost-filesystem-dev \
@@ -92,6 +93,7 @@ elif [[ "$DISTRO" == *"FEDORA"* ]]; then
         bison \
         flex \
         libevent-devel \
+        numactl-devel \
         boost-devel \
         jemalloc-devel \
         valgrind \
@@ -125,6 +127,7 @@ elif [[ "$DISTRO" == *"REDHAT"* ]] && [[ "${DISTRO_VER%.*}" == "7" ]]; then
         flex \
         protobuf-devel \
         jemalloc-devel \
+        numactl-devel \
         valgrind \
         lcov \
         m4 \
@@ -18,13 +18,11 @@
 #include "brain/clusterer.h"
 #include "catalog/catalog.h"
 #include "catalog/schema.h"
-#include "common/container_tuple.h"
 #include "common/logger.h"
 #include "common/macros.h"
 #include "common/timer.h"
 #include "index/index_factory.h"
 #include "storage/data_table.h"
-#include "storage/tile_group.h"
 #include "wire/packet_manager.h"
 
 namespace peloton {
@@ -94,45 +92,25 @@ static void AddIndex(storage::DataTable* table,
 
 void IndexTuner::BuildIndex(storage::DataTable* table,
                             std::shared_ptr<index::Index> index) {
-  auto table_schema = table->GetSchema();
   auto index_tile_group_offset = index->GetIndexedTileGroupOff();
   auto table_tile_group_count = table->GetTileGroupCount();
-  oid_t tile_groups_indexed = 0;
 
-  auto index_schema = index->GetKeySchema();
-  auto indexed_columns = index_schema->GetIndexedColumns();
-  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-
-  while (index_tile_group_offset < table_tile_group_count &&
-         (tile_groups_indexed < tile_groups_indexed_per_iteration)) {
-    std::unique_ptr<storage::Tuple> tuple_ptr(
-        new storage::Tuple(table_schema, true));
-
-    auto tile_group = table->GetTileGroup(index_tile_group_offset);
-    auto tile_group_id = tile_group->GetTileGroupId();
-    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
-
-    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-      // Setup container tuple
-      expression::ContainerTuple<storage::TileGroup> container_tuple(
-          tile_group.get(), tuple_id);
-
-      // Set the location
-      ItemPointer location(tile_group_id, tuple_id);
-
-      // Set the key
-      key->SetFromTuple(&container_tuple, indexed_columns, index->GetPool());
+  oid_t end_tile_group_offset = std::min<oid_t>(
+      index_tile_group_offset + tile_groups_indexed_per_iteration,
+      table_tile_group_count);
+  if (index_tile_group_offset >= end_tile_group_offset) {
+    return;
+  }
 
-      // Insert in specific index
-      // TODO: Allocate itempointer ?
-      index->InsertEntry(key.get(), &location);
-    }
+  // The index is already in the table, so the entries are inserted along
+  // with those of the queries
+  table->PopulateIndex(index.get(), index_tile_group_offset,
+                       end_tile_group_offset, false);
 
-    // Update indexed tile group offset (set of tgs indexed)
+  // Update indexed tile group offset (set of tgs indexed)
+  oid_t tile_groups_indexed = end_tile_group_offset - index_tile_group_offset;
+  for (oid_t i = 0; i < tile_groups_indexed; i++) {
     index->IncrementIndexedTileGroupOffset();
-
-    index_tile_group_offset++;
-    tile_groups_indexed++;
   }
 
   tile_groups_indexed_ += tile_groups_indexed;
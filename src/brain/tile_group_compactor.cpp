@@ -0,0 +1,216 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.cpp
+//
+// Identification: src/brain/tile_group_compactor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "brain/tile_group_compactor.h"
+
+#include <algorithm>
+
+#include "common/logger.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "gc/gc_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace brain {
+
+TileGroupCompactor& TileGroupCompactor::GetInstance() {
+  static TileGroupCompactor tile_group_compactor;
+  return tile_group_compactor;
+}
+
+TileGroupCompactor::TileGroupCompactor() {
+  // Nothing to do here !
+}
+
+TileGroupCompactor::~TileGroupCompactor() {}
+
+void TileGroupCompactor::Start() {
+  // Set signal
+  compaction_stop = false;
+
+  // Launch thread
+  tile_group_compactor_thread =
+      std::thread(&brain::TileGroupCompactor::Run, this);
+
+  LOG_INFO("Started tile group compactor");
+}
+
+void TileGroupCompactor::Run() {
+  // Continue till signal is not false
+  while (compaction_stop == false) {
+    Compact();
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
+  }
+}
+
+void TileGroupCompactor::Compact() {
+  // the old versions are only collected by the GC
+  if (gc::GCManagerFactory::GetGCType() != GarbageCollectionType::ON) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(tile_group_compactor_mutex);
+  auto& epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // Move on the tile groups retired before
+  auto retired_itr = retired_tile_groups.begin();
+  while (retired_itr != retired_tile_groups.end()) {
+    auto& retired_tile_group = *retired_itr;
+
+    // transactions that entered before the retirement may still fill it
+    if (retired_tile_group.relocated == false &&
+        epoch_manager.IsEpochExited(retired_tile_group.epoch) == true) {
+      retired_tile_group.relocated = RelocateTileGroup(retired_tile_group);
+    }
+
+    if (retired_tile_group.relocated == true &&
+        retired_tile_group.table->DropRetiredTileGroup(
+            retired_tile_group.tile_group_offset) == true) {
+      LOG_TRACE("Dropped tile group at offset: %u",
+                retired_tile_group.tile_group_offset);
+      retired_itr = retired_tile_groups.erase(retired_itr);
+    } else {
+      retired_itr++;
+    }
+  }
+
+  // Retire new sparse tile groups
+  for (auto table : tables) {
+    RetireTileGroups(table);
+  }
+}
+
+void TileGroupCompactor::RetireTileGroups(storage::DataTable* table) {
+  auto& epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto tile_group_count = table->GetTileGroupCount();
+
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    auto tile_group_header = tile_group->GetHeader();
+    if (tile_group_header->IsRetired() == true) {
+      continue;
+    }
+
+    // the latest versions, committed or not
+    oid_t allocated_count = tile_group->GetAllocatedTupleCount();
+    oid_t tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+    oid_t live_count = 0;
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (tile_group_header->GetTransactionId(tuple_id) != INVALID_TXN_ID &&
+          tile_group_header->GetEndCommitId(tuple_id) == MAX_CID) {
+        live_count++;
+      }
+    }
+
+    if (live_count > occupancy_threshold * allocated_count) {
+      continue;
+    }
+
+    if (table->RetireTileGroup(tile_group_offset) == true) {
+      // read after the retirement, the transactions of later epochs see it
+      auto epoch = epoch_manager.GetCurrentEpoch();
+      LOG_TRACE("Retired tile group at offset: %u, live tuples: %u",
+                tile_group_offset, live_count);
+      retired_tile_groups.push_back({table, tile_group_offset, epoch, false});
+    }
+  }
+}
+
+bool TileGroupCompactor::RelocateTileGroup(
+    const RetiredTileGroup& retired_tile_group) {
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto table = retired_tile_group.table;
+  auto tile_group = table->GetTileGroup(retired_tile_group.tile_group_offset);
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto tile_group_header = tile_group->GetHeader();
+
+  bool relocated = true;
+  auto txn = txn_manager.BeginTransaction();
+
+  oid_t tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    // the free slots and the old versions are left to the GC
+    if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID ||
+        tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+      continue;
+    }
+
+    // a version being written by another transaction is tried again later
+    if (table->RelocateVersion(txn, ItemPointer(tile_group_id, tuple_id)) ==
+        false) {
+      relocated = false;
+    }
+  }
+
+  if (txn_manager.CommitTransaction(txn) != ResultType::SUCCESS) {
+    relocated = false;
+  }
+
+  return relocated;
+}
+
+void TileGroupCompactor::Stop() {
+  // Stop compacting
+  compaction_stop = true;
+
+  // Stop thread
+  tile_group_compactor_thread.join();
+
+  LOG_INFO("Stopped tile group compactor");
+}
+
+void TileGroupCompactor::AddTable(storage::DataTable* table) {
+  {
+    std::lock_guard<std::mutex> lock(tile_group_compactor_mutex);
+    LOG_TRACE("Tile group compactor adding table : %p", table);
+
+    tables.push_back(table);
+  }
+}
+
+void TileGroupCompactor::RemoveTable(storage::DataTable* table) {
+  {
+    std::lock_guard<std::mutex> lock(tile_group_compactor_mutex);
+    LOG_TRACE("Tile group compactor removing table : %p", table);
+
+    tables.erase(std::remove(tables.begin(), tables.end(), table),
+                 tables.end());
+    retired_tile_groups.erase(
+        std::remove_if(retired_tile_groups.begin(), retired_tile_groups.end(),
+                       [table](const RetiredTileGroup& retired_tile_group) {
+                         return retired_tile_group.table == table;
+                       }),
+        retired_tile_groups.end());
+  }
+}
+
+void TileGroupCompactor::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(tile_group_compactor_mutex);
+    tables.clear();
+    retired_tile_groups.clear();
+  }
+}
+
+size_t TileGroupCompactor::GetRetiredTileGroupCount() {
+  std::lock_guard<std::mutex> lock(tile_group_compactor_mutex);
+  return retired_tile_groups.size();
+}
+
+}  // End brain namespace
+}  // End peloton namespace
@@ -11,9 +11,13 @@
 //===----------------------------------------------------------------------===//
 #include "catalog/catalog.h"
 
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
 #include "catalog/manager.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "common/exception.h"
 #include "common/macros.h"
 #include "expression/string_functions.h"
@@ -235,7 +239,8 @@ ResultType Catalog::CreatePrimaryIndex(const std::string &database_name,
 // Function to add non-primary Key index
 ResultType Catalog::CreateIndex(const std::string &database_name,
     const std::string &table_name, std::vector<std::string> index_attr,
-    std::string index_name, bool unique, IndexType index_type) {
+    std::string index_name, bool unique, IndexType index_type,
+    std::vector<std::string> include_attr, concurrency::Transaction *txn) {
   auto database = GetDatabaseWithName(database_name);
   if (database != nullptr) {
     auto table = database->GetTableWithName(table_name);
@@ -267,24 +272,98 @@ ResultType Catalog::CreateIndex(const std::string &database_name,
       return ResultType::FAILURE;
     }
 
-    key_schema = catalog::Schema::CopySchema(schema, key_attrs);
-    key_schema->SetIndexedColumns(key_attrs);
+    // The included columns are stored in the entries after the key columns
+    std::vector<oid_t> included_attrs;
+    for (auto attr : include_attr) {
+      for (uint i = 0; i < columns.size(); ++i) {
+        if (attr == columns[i].column_name &&
+            std::find(key_attrs.begin(), key_attrs.end(), i) ==
+                key_attrs.end()) {
+          included_attrs.push_back(i);
+        }
+      }
+    }
+
+    if (included_attrs.size() != include_attr.size()) {
+      LOG_TRACE("Some included columns are missing or are key columns");
+      return ResultType::FAILURE;
+    }
+
+    if (included_attrs.empty() == true) {
+      key_schema = catalog::Schema::CopySchema(schema, key_attrs);
+      key_schema->SetIndexedColumns(key_attrs);
+    } else {
+      // The covering entries are per version, they can neither be unique nor
+      // be looked up without their version hint
+      if (unique == true || index_type != IndexType::BWTREE) {
+        LOG_TRACE("Only non-unique BWTREE indexes can include columns");
+        return ResultType::FAILURE;
+      }
+
+      key_schema = index::IndexMetadata::GetCoveringKeySchema(
+          schema, key_attrs, included_attrs);
+      key_attrs.insert(key_attrs.end(), included_attrs.begin(),
+                       included_attrs.end());
+    }
 
     // Check if unique index or not
     if (unique == false) {
       index_metadata = new index::IndexMetadata(index_name.c_str(),
           GetNextOid(), table->GetOid(), database->GetOid(), index_type,
-          IndexConstraintType::DEFAULT, schema, key_schema, key_attrs, true);
+          IndexConstraintType::DEFAULT, schema, key_schema, key_attrs, true,
+          included_attrs.size());
     } else {
       index_metadata = new index::IndexMetadata(index_name.c_str(),
           GetNextOid(), table->GetOid(), database->GetOid(), index_type,
           IndexConstraintType::UNIQUE, schema, key_schema, key_attrs, true);
     }
 
-    // Add index to table
+    // Build the index bottom up from a snapshot of the table before anyone
+    // sees it. A read-only transaction keeps the versions of the snapshot
+    // from being reclaimed, and so their slots from being reused, until the
+    // index is complete.
     std::shared_ptr<index::Index> key_index(
         index::IndexFactory::GetIndex(index_metadata));
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto pin_txn = txn_manager.BeginReadonlyTransaction();
+    auto snapshot_txn = txn_manager.BeginTransaction();
+    std::vector<ItemPointer> indexed_versions;
+    bool built =
+        table->BuildIndex(key_index.get(), snapshot_txn, indexed_versions);
+    txn_manager.CommitTransaction(snapshot_txn);
+    if (built == false) {
+      txn_manager.EndReadonlyTransaction(pin_txn);
+      LOG_TRACE("Some tuples violate the constraint of index %s",
+                index_name.c_str());
+      return ResultType::FAILURE;
+    }
+
+    // Then add it to the table, so that the tuples written from now on are
+    // inserted into it by their writers. The writers that looked at the
+    // indexes of the table before may still be running, wait for them.
     table->AddIndex(key_index);
+    auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+    auto epoch = epoch_manager.GetCurrentEpoch();
+    auto own_epoch =
+        txn != nullptr ? txn->GetEpochId() : std::numeric_limits<size_t>::max();
+    while (epoch_manager.IsEpochExitedByWriters(epoch, own_epoch) == false) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Finally insert the tuples written since the snapshot, as a transaction
+    // that begins now sees them all
+    auto build_txn = txn_manager.BeginTransaction();
+    bool populated =
+        table->BackfillIndex(key_index.get(), build_txn, indexed_versions);
+    txn_manager.CommitTransaction(build_txn);
+    txn_manager.EndReadonlyTransaction(pin_txn);
+
+    if (populated == false) {
+      LOG_TRACE("Some tuples violate the constraint of index %s",
+                index_name.c_str());
+      table->DropIndexWithOid(key_index->GetOid());
+      return ResultType::FAILURE;
+    }
 
     LOG_TRACE("Successfully add index for table %s", table->GetName().c_str());
     return ResultType::SUCCESS;
@@ -17,6 +17,7 @@
 #include "storage/database.h"
 #include "storage/data_table.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "concurrency/epoch_manager_factory.h"
 
 namespace peloton {
 namespace catalog {
@@ -36,15 +37,58 @@ Manager &Manager::GetInstance() {
 
 void Manager::AddTileGroup(const oid_t oid,
                            std::shared_ptr<storage::TileGroup> location) {
+  auto old_location = tile_group_locator_.Find(oid);
 
   // add/update the catalog reference to the tile group
+  tile_group_raw_locator_.Update(oid, location.get());
   tile_group_locator_.Update(oid, location);
+
+  // a replaced tile group may still be looked up
+  if (old_location != nullptr && old_location != location) {
+    RetireTileGroup(std::move(old_location));
+  }
 }
 
 void Manager::DropTileGroup(const oid_t oid) {
-  
+  auto location = tile_group_locator_.Find(oid);
+
   // drop the catalog reference to the tile group
+  tile_group_raw_locator_.Erase(oid, nullptr);
   tile_group_locator_.Erase(oid, empty_tile_group_);
+
+  if (location != nullptr) {
+    RetireTileGroup(std::move(location));
+  }
+}
+
+void Manager::RetireTileGroup(
+    std::shared_ptr<storage::TileGroup> &&tile_group) {
+  auto epoch = concurrency::EpochManagerFactory::GetInstance().GetCurrentEpoch();
+  {
+    std::lock_guard<std::mutex> lock(retired_tile_groups_lock_);
+    retired_tile_groups_.emplace_back(epoch, std::move(tile_group));
+  }
+
+  ReclaimTileGroups();
+}
+
+void Manager::ReclaimTileGroups() {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // Free them outside of the lock
+  std::vector<std::shared_ptr<storage::TileGroup>> reclaimed_tile_groups;
+  {
+    std::lock_guard<std::mutex> lock(retired_tile_groups_lock_);
+    size_t retained_count = 0;
+    for (auto &retired_tile_group : retired_tile_groups_) {
+      if (epoch_manager.IsEpochExited(retired_tile_group.first)) {
+        reclaimed_tile_groups.push_back(std::move(retired_tile_group.second));
+      } else {
+        retired_tile_groups_[retained_count++] = std::move(retired_tile_group);
+      }
+    }
+    retired_tile_groups_.resize(retained_count);
+  }
 }
 
 std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
@@ -58,7 +102,11 @@ std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
 // used for logging test
 void Manager::ClearTileGroup() {
 
+  tile_group_raw_locator_.Clear(nullptr);
   tile_group_locator_.Clear(empty_tile_group_);
+
+  std::lock_guard<std::mutex> lock(retired_tile_groups_lock_);
+  retired_tile_groups_.clear();
 }
 
 
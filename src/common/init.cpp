@@ -18,6 +18,7 @@
 
 #include "brain/index_tuner.h"
 #include "brain/layout_tuner.h"
+#include "brain/tile_group_compactor.h"
 #include "concurrency/epoch_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 #include "storage/data_table.h"
@@ -37,7 +38,11 @@ void PelotonInit::Initialize() {
   EPOCH_THREAD_COUNT = 1;
 
   // set max thread number.
-  thread_pool.Initialize(0, std::thread::hardware_concurrency() + 3);
+  // the pool threads run the parallel scans, the query thread being one of
+  // the threads of a scan.
+  size_t pool_size =
+      FLAGS_parallel_scan_threads > 1 ? FLAGS_parallel_scan_threads - 1 : 0;
+  thread_pool.Initialize(pool_size, std::thread::hardware_concurrency() + 3);
 
   int parallelism = (std::thread::hardware_concurrency() + 1) / 2;
   storage::DataTable::SetActiveTileGroupCount(parallelism);
@@ -63,6 +68,12 @@ void PelotonInit::Initialize() {
     layout_tuner.Start();
   }
 
+  // start tile group compactor
+  if (FLAGS_tile_group_compactor == true) {
+    auto& tile_group_compactor = brain::TileGroupCompactor::GetInstance();
+    tile_group_compactor.Start();
+  }
+
   // initialize the catalog and add the default database, so we don't do this on
   // the first query
   catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
@@ -81,6 +92,12 @@ void PelotonInit::Shutdown() {
     layout_tuner.Stop();
   }
 
+  // shut down tile group compactor
+  if (FLAGS_tile_group_compactor == true) {
+    auto& tile_group_compactor = brain::TileGroupCompactor::GetInstance();
+    tile_group_compactor.Stop();
+  }
+
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
 
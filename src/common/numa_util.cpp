@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa_util.cpp
+//
+// Identification: src/common/numa_util.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/numa_util.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <vector>
+
+#ifdef PELOTON_HAVE_NUMA
+#include <numa.h>
+#include <numaif.h>
+#endif
+
+#include "common/logger.h"
+#include "configuration/configuration.h"
+
+namespace peloton {
+
+namespace {
+
+/** Topology of the machine, read once. */
+struct NumaTopology {
+  NumaTopology() {
+#ifdef PELOTON_HAVE_NUMA
+    if (numa_available() < 0) {
+      return;
+    }
+
+    node_count = numa_max_node() + 1;
+    int cpu_count = numa_num_configured_cpus();
+    for (int cpu = 0; cpu < cpu_count; cpu++) {
+      int node = numa_node_of_cpu(cpu);
+      cpu_nodes.push_back(node < 0 ? 0 : node);
+    }
+#endif
+  }
+
+  size_t node_count = 1;
+
+  // Node of each cpu
+  std::vector<size_t> cpu_nodes;
+};
+
+const NumaTopology &GetTopology() {
+  static NumaTopology topology;
+  return topology;
+}
+
+}  // namespace
+
+const int NumaUtil::ANY_NODE;
+
+bool NumaUtil::IsEnabled() {
+  return FLAGS_numa_aware == true && GetNodeCount() > 1;
+}
+
+size_t NumaUtil::GetNodeCount() { return GetTopology().node_count; }
+
+size_t NumaUtil::GetCurrentNode() {
+  auto &cpu_nodes = GetTopology().cpu_nodes;
+  int cpu = sched_getcpu();
+  if (cpu < 0 || (size_t)cpu >= cpu_nodes.size()) {
+    return 0;
+  }
+  return cpu_nodes[cpu];
+}
+
+void NumaUtil::BindMemory(void *address, size_t size, int node) {
+#ifdef PELOTON_HAVE_NUMA
+  if (node == ANY_NODE || (size_t)node >= GetNodeCount()) {
+    return;
+  }
+
+  static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t begin = ((uintptr_t)address + page_size - 1) & ~(page_size - 1);
+  uintptr_t end = ((uintptr_t)address + size) & ~(page_size - 1);
+  if (begin >= end) {
+    return;
+  }
+
+  struct bitmask *node_mask = numa_allocate_nodemask();
+  numa_bitmask_setbit(node_mask, node);
+  if (mbind((void *)begin, end - begin, MPOL_PREFERRED, node_mask->maskp,
+            node_mask->size + 1, MPOL_MF_MOVE) != 0) {
+    LOG_TRACE("Could not bind memory to node %d", node);
+  }
+  numa_free_nodemask(node_mask);
+#else
+  (void)address;
+  (void)size;
+  (void)node;
+#endif
+}
+
+}  // End peloton namespace
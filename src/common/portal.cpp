@@ -13,6 +13,7 @@
 #include "common/portal.h"
 #include "common/logger.h"
 #include "common/statement.h"
+#include "executor/plan_executor.h"
 
 namespace peloton {
 
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// thread_pool.cpp
+//
+// Identification: src/common/thread_pool.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/thread_pool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace peloton {
+
+void ThreadPool::RunTasks(size_t worker_count, size_t task_count,
+                          const std::function<void(size_t, size_t)> &body) {
+  struct TaskState {
+    std::function<void(size_t, size_t)> body;
+    size_t task_count;
+    std::atomic<size_t> next_task;
+    std::mutex lock;
+    std::condition_variable cond;
+    size_t done_tasks = 0;
+    std::exception_ptr error;
+
+    void Work(size_t worker) {
+      while (true) {
+        size_t task = next_task.fetch_add(1);
+        if (task >= task_count) {
+          return;
+        }
+
+        std::exception_ptr task_error;
+        try {
+          body(worker, task);
+        } catch (...) {
+          task_error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+        if (task_error != nullptr && error == nullptr) {
+          error = task_error;
+        }
+        if (++done_tasks == task_count) {
+          cond.notify_all();
+        }
+      }
+    }
+  };
+
+  std::shared_ptr<TaskState> state(new TaskState());
+  state->body = body;
+  state->task_count = task_count;
+  state->next_task = 0;
+
+  // Workers starting after the last task is done return right away
+  for (size_t worker = 1; worker < worker_count && worker < task_count;
+       worker++) {
+    SubmitTask([state, worker] { state->Work(worker); });
+  }
+  state->Work(0);
+
+  std::unique_lock<std::mutex> lock(state->lock);
+  state->cond.wait(lock,
+                   [&state] { return state->done_tasks == state->task_count; });
+  if (state->error != nullptr) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+}  // End peloton namespace
@@ -0,0 +1,144 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.cpp
+//
+// Identification: src/concurrency/optimistic_transaction_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/platform.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace concurrency {
+
+OptimisticTransactionManager &OptimisticTransactionManager::GetInstance() {
+  static OptimisticTransactionManager txn_manager;
+  return txn_manager;
+}
+
+// a snapshot may be older than the latest committed version, so unlike
+// timestamp ordering, being visible is not enough to own a version.
+bool OptimisticTransactionManager::IsOwnable(
+    UNUSED_ATTRIBUTE Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  return tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid == MAX_CID;
+}
+
+// readers are not tracked in the tuple header, so the ownership is granted to
+// the first writer. the readers find out at validation.
+bool OptimisticTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  return tile_group_header->SetAtomicTransactionId(
+      tuple_id, current_txn->GetTransactionId());
+}
+
+bool OptimisticTransactionManager::PerformRead(Transaction *const current_txn,
+                                               const ItemPointer &location,
+                                               bool acquire_ownership) {
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    // Ignore read validation for all readonly transactions
+    return true;
+  }
+
+  oid_t tile_group_id = location.block;
+  oid_t tuple_id = location.offset;
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
+
+  if (acquire_ownership == true &&
+      IsOwner(current_txn, tile_group_header, tuple_id) == false) {
+    if (IsOwnable(current_txn, tile_group_header, tuple_id) == false) {
+      return false;
+    }
+    if (AcquireOwnership(current_txn, tile_group_header, tuple_id) == false) {
+      return false;
+    }
+    // Promote to RW_TYPE_READ_OWN
+    current_txn->RecordReadOwn(location);
+  }
+
+  // versions that are not owned by the current transaction are validated at
+  // commit.
+  if (IsOwner(current_txn, tile_group_header, tuple_id) == false) {
+    current_txn->RecordRead(location);
+  }
+
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+  return true;
+}
+
+bool OptimisticTransactionManager::ValidateReadSet(
+    Transaction *const current_txn) {
+  auto &manager = catalog::Manager::GetInstance();
+  cid_t end_commit_id = current_txn->GetEndCommitId();
+
+  for (auto &tuple_entry : current_txn->GetReadWriteSet()) {
+    if (tuple_entry.type != RW_TYPE_READ) {
+      // the transaction owns the other versions of its set.
+      continue;
+    }
+    auto tile_group_header =
+        manager.GetTileGroupRaw(tuple_entry.tile_group_id)->GetHeader();
+    auto tuple_slot = tuple_entry.tuple_id;
+
+    // a committing transaction sets the end commit id of the version it
+    // replaces before releasing it, so read the owner first.
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_slot);
+    COMPILER_MEMORY_FENCE;
+    cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_slot);
+
+    if (tuple_txn_id == current_txn->GetTransactionId()) {
+      continue;
+    }
+    // any transaction that replaced the version with a smaller commit id
+    // owned it before the current commit id was taken.
+    if (tuple_txn_id != INITIAL_TXN_ID || tuple_end_cid <= end_commit_id) {
+      LOG_TRACE("Validation failed on (%u, %u)", tuple_entry.tile_group_id,
+                tuple_slot);
+      return false;
+    }
+  }
+  return true;
+}
+
+ResultType OptimisticTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    EndReadonlyTransaction(current_txn);
+    return ResultType::SUCCESS;
+  }
+
+  // the write set is already owned, the commit id is the serialization point.
+  current_txn->SetEndCommitId(GetNextGlobalCommitId());
+
+  if (ValidateReadSet(current_txn) == false) {
+    return AbortTransaction(current_txn);
+  }
+
+  return CommitWriteSet(current_txn);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -90,7 +90,7 @@ Transaction *TimestampOrderingTransactionManager::BeginTransaction() {
 
   txn_id_t txn_id = GetNextTransactionId();
   cid_t begin_cid = GetNextCommitId();
-  Transaction *txn = new Transaction(txn_id, begin_cid);
+  Transaction *txn = Transaction::Allocate(txn_id, begin_cid);
 
   auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
   txn->SetEpochId(eid);
@@ -109,7 +109,7 @@ Transaction *TimestampOrderingTransactionManager::BeginReadonlyTransaction() {
   auto &epoch_manager = EpochManagerFactory::GetInstance();
 
   cid_t begin_cid = epoch_manager.GetReadOnlyTxnCid();
-  Transaction *txn = new Transaction(txn_id, begin_cid, true);
+  Transaction *txn = Transaction::Allocate(txn_id, begin_cid, true);
 
   auto eid = epoch_manager.EnterReadOnlyEpoch(begin_cid);
   txn->SetEpochId(eid);
@@ -125,27 +125,30 @@ Transaction *TimestampOrderingTransactionManager::BeginReadonlyTransaction() {
 
 void TimestampOrderingTransactionManager::EndTransaction(
     Transaction *current_txn) {
-  EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
   auto &log_manager = logging::LogManager::GetInstance();
 
+  // the garbage is handed to the GC before the transaction leaves its epoch,
+  // so that a tile group compacted after the epoch is dropped behind it
   if (current_txn->GetResult() == ResultType::SUCCESS) {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().RecycleTransaction(
-          current_txn->GetGCSetPtr(), current_txn->GetBeginCommitId(),
+          current_txn->GetGCSetPtr(), current_txn->GetEndCommitId(),
           GC_SET_TYPE_COMMITTED);
     }
+    EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
     // Log the transaction's commit
-    // For time stamp ordering, every transaction only has one timestamp
-    log_manager.LogCommitTransaction(current_txn->GetBeginCommitId());
+    log_manager.LogCommitTransaction(current_txn->GetEndCommitId());
   } else {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().RecycleTransaction(
-          current_txn->GetGCSetPtr(), GetNextCommitId(), GC_SET_TYPE_ABORTED);
+          current_txn->GetGCSetPtr(), GetNextGlobalCommitId(),
+          GC_SET_TYPE_ABORTED);
     }
+    EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
     log_manager.DoneLogging();
   }
 
-  delete current_txn;
+  Transaction::Free(current_txn);
   current_txn = nullptr;
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
@@ -161,7 +164,7 @@ void TimestampOrderingTransactionManager::EndReadonlyTransaction(
   EpochManagerFactory::GetInstance().ExitReadOnlyEpoch(
       current_txn->GetEpochId());
 
-  delete current_txn;
+  Transaction::Free(current_txn);
   current_txn = nullptr;
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
@@ -185,7 +188,7 @@ bool TimestampOrderingTransactionManager::IsOccupied(
   ItemPointer &position = *((ItemPointer *)position_ptr);
 
   auto tile_group_header =
-      catalog::Manager::GetInstance().GetTileGroup(position.block)->GetHeader();
+      catalog::Manager::GetInstance().GetTileGroupRaw(position.block)->GetHeader();
   auto tuple_id = position.offset;
 
   txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
@@ -321,6 +324,80 @@ VisibilityType TimestampOrderingTransactionManager::IsVisible(
   }
 }
 
+// same visibility rules as IsVisible, applied to a range of slots.
+// the common case of committed versions that nobody owns is decided inline,
+// the rest fall back to the per-tuple check.
+void TimestampOrderingTransactionManager::IsVisibleBatch(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &start, const oid_t &end,
+    std::vector<oid_t> &visible_tuples) {
+  cid_t read_cid = current_txn->GetBeginCommitId();
+
+  // every version in the tile group is old enough.
+  if (tile_group_header->IsAllVisible(read_cid)) {
+    for (oid_t tuple_id = start; tuple_id < end; tuple_id++) {
+      visible_tuples.push_back(tuple_id);
+    }
+    return;
+  }
+
+  // whether the scan covers the whole tile group and finds every version
+  // committed, unowned and live, so that the summary can be published.
+  bool all_visible =
+      (start == START_OID &&
+       end == tile_group_header->GetAllocatedTupleCount());
+  cid_t max_begin_cid = 0;
+
+  for (oid_t tuple_id = start; tuple_id < end; tuple_id++) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+    cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+
+    if (tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid == MAX_CID &&
+        tuple_begin_cid != MAX_CID && !CidIsInDirtyRange(tuple_begin_cid)) {
+      // committed version that is not owned by any transaction.
+      if (read_cid >= tuple_begin_cid) {
+        visible_tuples.push_back(tuple_id);
+      }
+      if (tuple_begin_cid > max_begin_cid) {
+        max_begin_cid = tuple_begin_cid;
+      }
+      continue;
+    }
+
+    all_visible = false;
+
+    if (tuple_txn_id == current_txn->GetTransactionId()) {
+      // versions owned by the current transaction depend on its rw set.
+      if (TimestampOrderingTransactionManager::IsVisible(
+              current_txn, tile_group_header, tuple_id) ==
+          VisibilityType::OK) {
+        visible_tuples.push_back(tuple_id);
+      }
+      continue;
+    }
+
+    if (tuple_txn_id == INVALID_TXN_ID || CidIsInDirtyRange(tuple_begin_cid)) {
+      // the tuple is not available.
+      continue;
+    }
+
+    if (tuple_txn_id != INITIAL_TXN_ID && tuple_begin_cid == MAX_CID) {
+      // never read an uncommitted version.
+      continue;
+    }
+
+    if (read_cid >= tuple_begin_cid && read_cid < tuple_end_cid) {
+      visible_tuples.push_back(tuple_id);
+    }
+  }
+
+  if (all_visible == true) {
+    tile_group_header->SetAllVisible(max_begin_cid);
+  }
+}
+
 // check whether the current transaction owns the tuple.
 // this function is called by update/delete executors.
 bool TimestampOrderingTransactionManager::IsOwner(
@@ -395,7 +472,7 @@ void TimestampOrderingTransactionManager::YieldOwnership(
     UNUSED_ATTRIBUTE Transaction *const current_txn, const oid_t &tile_group_id,
     const oid_t &tuple_id) {
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
   PL_ASSERT(IsOwner(current_txn, tile_group_header, tuple_id));
   tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
 }
@@ -413,7 +490,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
   LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(tile_group_id);
+  auto tile_group = manager.GetTileGroupRaw(tile_group_id);
   auto tile_group_header = tile_group->GetHeader();
 
   // Check if it's select for update before we check the ownership and modify
@@ -474,7 +551,7 @@ void TimestampOrderingTransactionManager::PerformInsert(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
   auto transaction_id = current_txn->GetTransactionId();
 
   // check MVCC info
@@ -513,10 +590,10 @@ void TimestampOrderingTransactionManager::PerformUpdate(
             new_location.offset);
 
   auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
+                               .GetTileGroupRaw(old_location.block)
                                ->GetHeader();
   auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
+                                   .GetTileGroupRaw(new_location.block)
                                    ->GetHeader();
 
   auto transaction_id = current_txn->GetTransactionId();
@@ -552,7 +629,7 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   if (old_prev.IsNull() == false) {
     auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                          .GetTileGroup(old_prev.block)
+                                          .GetTileGroupRaw(old_prev.block)
                                           ->GetHeader();
 
     // once everything is set, we can allow traversing the new version.
@@ -604,7 +681,7 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -633,10 +710,10 @@ void TimestampOrderingTransactionManager::PerformDelete(
   LOG_TRACE("Performing Delete");
 
   auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
+                               .GetTileGroupRaw(old_location.block)
                                ->GetHeader();
   auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
+                                   .GetTileGroupRaw(new_location.block)
                                    ->GetHeader();
 
   auto transaction_id = current_txn->GetTransactionId();
@@ -673,7 +750,7 @@ void TimestampOrderingTransactionManager::PerformDelete(
 
   if (old_prev.IsNull() == false) {
     auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                          .GetTileGroup(old_prev.block)
+                                          .GetTileGroupRaw(old_prev.block)
                                           ->GetHeader();
 
     old_prev_tile_group_header->SetNextItemPointer(old_prev.offset,
@@ -725,7 +802,7 @@ void TimestampOrderingTransactionManager::PerformDelete(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupRaw(tile_group_id)->GetHeader();
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -759,11 +836,20 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
     return ResultType::SUCCESS;
   }
 
+  // in timestamp ordering, every transaction only has one timestamp.
+  current_txn->SetEndCommitId(current_txn->GetBeginCommitId());
+
+  return CommitWriteSet(current_txn);
+}
+
+// install the versions of the write set with the end commit id of the
+// transaction and release the ownerships.
+ResultType TimestampOrderingTransactionManager::CommitWriteSet(
+    Transaction *const current_txn) {
   auto &manager = catalog::Manager::GetInstance();
   auto &log_manager = logging::LogManager::GetInstance();
 
-  // generate transaction id.
-  cid_t end_commit_id = current_txn->GetBeginCommitId();
+  cid_t end_commit_id = current_txn->GetEndCommitId();
   log_manager.LogBeginTransaction(end_commit_id);
 
   auto &rw_set = current_txn->GetReadWriteSet();
@@ -772,9 +858,9 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
   oid_t database_id = 0;
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
-    if (!rw_set.empty()) {
-      database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+    if (!rw_set.IsEmpty()) {
+      database_id = manager.GetTileGroupRaw(rw_set.begin()->tile_group_id)
+                        ->GetDatabaseId();
     }
   }
 
@@ -782,117 +868,115 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   // 1. install a new version for update operations;
   // 2. install an empty version for delete operations;
   // 3. install a new tuple for insert operations.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further
-        // update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // we must guarantee that, at any time point, only one version is
-        // visible.
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+  for (auto &tuple_entry : rw_set) {
+    oid_t tile_group_id = tuple_entry.tile_group_id;
+    auto tile_group_header =
+        manager.GetTileGroupRaw(tile_group_id)->GetHeader();
+    auto tuple_slot = tuple_entry.tuple_id;
+    if (tuple_entry.type == RW_TYPE_READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further
+      // update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_id, tuple_slot);
+    } else if (tuple_entry.type == RW_TYPE_UPDATE) {
+      // we must guarantee that, at any time point, only one version is
+      // visible.
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        PL_ASSERT(new_version.IsNull() == false);
+      PL_ASSERT(new_version.IsNull() == false);
 
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroupRaw(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_UPDATE;
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_UPDATE);
 
-        // add to log manager
-        log_manager.LogUpdate(
-            end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
+      // add to log manager
+      log_manager.LogUpdate(
+          end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+    } else if (tuple_entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroupRaw(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_DELETE;
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_DELETE);
 
-        // add to log manager
-        log_manager.LogDelete(end_commit_id,
-                              ItemPointer(tile_group_id, tuple_slot));
+      // add to log manager
+      log_manager.LogDelete(end_commit_id,
+                            ItemPointer(tile_group_id, tuple_slot));
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (tuple_entry.type == RW_TYPE_INSERT) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // nothing to be added to gc set.
+      // nothing to be added to gc set.
 
-        // add to log manager
-        log_manager.LogInsert(end_commit_id,
-                              ItemPointer(tile_group_id, tuple_slot));
+      // add to log manager
+      log_manager.LogInsert(end_commit_id,
+                            ItemPointer(tile_group_id, tuple_slot));
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
+    } else if (tuple_entry.type == RW_TYPE_INS_DEL) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
 
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        // set the begin commit id to persist insert
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      // set the begin commit id to persist insert
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INS_DEL;
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_INS_DEL);
 
-        // no log is needed for this case
-      }
+      // no log is needed for this case
     }
   }
 
@@ -923,162 +1007,157 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
 
   oid_t database_id = 0;
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
-    if (!rw_set.empty()) {
-      database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+    if (!rw_set.IsEmpty()) {
+      database_id = manager.GetTileGroupRaw(rw_set.begin()->tile_group_id)
+                        ->GetDatabaseId();
     }
   }
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further
-        // update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RW_TYPE_UPDATE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-
-        // these two fields can be set at any time.
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
-
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+  for (auto &tuple_entry : rw_set) {
+    oid_t tile_group_id = tuple_entry.tile_group_id;
+    auto tile_group_header =
+        manager.GetTileGroupRaw(tile_group_id)->GetHeader();
+    auto tuple_slot = tuple_entry.tuple_id;
+    if (tuple_entry.type == RW_TYPE_READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further
+      // update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_id, tuple_slot);
+    } else if (tuple_entry.type == RW_TYPE_UPDATE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+
+      auto new_tile_group_header =
+          manager.GetTileGroupRaw(new_version.block)->GetHeader();
+
+      // these two fields can be set at any time.
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
+
+      // check whether the previous version exists.
+      if (old_prev.IsNull() == true) {
+        PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-          tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
-        } else {
-          tile_group_header->SetPrevItemPointer(tuple_slot,
-                                                INVALID_ITEMPOINTER);
-        }
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header = catalog::Manager::GetInstance()
+                                              .GetTileGroupRaw(old_prev.block)
+                                              ->GetHeader();
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      } else {
+        tile_group_header->SetPrevItemPointer(tuple_slot,
+                                              INVALID_ITEMPOINTER);
+      }
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] =
-            RW_TYPE_UPDATE;
+      // add to gc set.
+      gc_set->Set(new_version.block, new_version.offset, RW_TYPE_UPDATE);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+    } else if (tuple_entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroupRaw(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
 
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+      // check whether the previous version exists.
+      if (old_prev.IsNull() == true) {
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-        }
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header = catalog::Manager::GetInstance()
+                                              .GetTileGroupRaw(old_prev.block)
+                                              ->GetHeader();
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+      }
 
-        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] =
-            RW_TYPE_DELETE;
+      // add to gc set.
+      gc_set->Set(new_version.block, new_version.offset, RW_TYPE_DELETE);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (tuple_entry.type == RW_TYPE_INSERT) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INSERT;
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_INSERT);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (tuple_entry.type == RW_TYPE_INS_DEL) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INS_DEL;
-      }
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_INS_DEL);
     }
   }
 
@@ -46,34 +46,65 @@ namespace concurrency {
  *    i: insert
  */
 
-RWType Transaction::GetRWType(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-  auto itr = rw_set_.find(tile_group_id);
-  if (itr == rw_set_.end()) {
-    return RW_TYPE_INVALID;
+namespace {
+
+/** Transactions a thread ended, kept for its next ones. */
+struct TransactionFreeList {
+  std::vector<Transaction *> transactions;
+
+  ~TransactionFreeList() {
+    for (auto txn : transactions) {
+      delete txn;
+    }
   }
+};
 
-  auto inner_itr = itr->second.find(tuple_id);
-  if (inner_itr == itr->second.end()) {
-    return RW_TYPE_INVALID;
+thread_local TransactionFreeList free_list;
+
+}  // namespace
+
+const size_t Transaction::free_list_size;
+
+Transaction *Transaction::Allocate(const txn_id_t &txn_id,
+                                   const cid_t &begin_cid, bool ro) {
+  auto &transactions = free_list.transactions;
+  if (transactions.empty() == true) {
+    return new Transaction(txn_id, begin_cid, ro);
   }
 
-  return inner_itr->second;
+  Transaction *txn = transactions.back();
+  transactions.pop_back();
+  txn->Init(txn_id, begin_cid, ro);
+  return txn;
+}
+
+void Transaction::Free(Transaction *txn) {
+  auto &transactions = free_list.transactions;
+  if (transactions.size() >= free_list_size) {
+    delete txn;
+    return;
+  }
+  transactions.push_back(txn);
+}
+
+RWType Transaction::GetRWType(const ItemPointer &location) {
+  auto type = rw_set_.Find(location.block, location.offset);
+  if (type == nullptr) {
+    return RW_TYPE_INVALID;
+  }
+  return *type;
 }
 
 void Transaction::RecordRead(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    PL_ASSERT(rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_DELETE &&
-              rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_INS_DEL);
+  auto type = rw_set_.Find(tile_group_id, tuple_id);
+  if (type != nullptr) {
+    PL_ASSERT(*type != RW_TYPE_DELETE && *type != RW_TYPE_INS_DEL);
     return;
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_READ;
+    rw_set_.Insert(tile_group_id, tuple_id, RW_TYPE_READ);
   }
 }
 
@@ -81,43 +112,36 @@ void Transaction::RecordReadOwn(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-      rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ) {
-      type = RW_TYPE_READ_OWN;
+  auto type = rw_set_.Find(tile_group_id, tuple_id);
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ) {
+      *type = RW_TYPE_READ_OWN;
       // record write.
       return;
     }
-    PL_ASSERT(type != RW_TYPE_DELETE && type != RW_TYPE_INS_DEL);
+    PL_ASSERT(*type != RW_TYPE_DELETE && *type != RW_TYPE_INS_DEL);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_READ_OWN;
+    rw_set_.Insert(tile_group_id, tuple_id, RW_TYPE_READ_OWN);
   }
 }
 
 void Transaction::RecordUpdate(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ || type == RW_TYPE_READ_OWN) {
-      type = RW_TYPE_UPDATE;
+  auto type = rw_set_.Find(location.block, location.offset);
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ || *type == RW_TYPE_READ_OWN) {
+      *type = RW_TYPE_UPDATE;
       // record write.
       is_written_ = true;
 
       return;
     }
-    if (type == RW_TYPE_UPDATE) {
+    if (*type == RW_TYPE_UPDATE) {
       return;
     }
-    if (type == RW_TYPE_INSERT) {
+    if (*type == RW_TYPE_INSERT) {
       return;
     }
-    if (type == RW_TYPE_DELETE) {
+    if (*type == RW_TYPE_DELETE) {
       PL_ASSERT(false);
       return;
     }
@@ -129,44 +153,36 @@ void Transaction::RecordInsert(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
+  if (rw_set_.Find(tile_group_id, tuple_id) != nullptr) {
     PL_ASSERT(false);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_INSERT;
+    rw_set_.Insert(tile_group_id, tuple_id, RW_TYPE_INSERT);
     ++insert_count_;
-
   }
 }
 
 bool Transaction::RecordDelete(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ || type == RW_TYPE_READ_OWN) {
-      type = RW_TYPE_DELETE;
+  auto type = rw_set_.Find(location.block, location.offset);
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ || *type == RW_TYPE_READ_OWN) {
+      *type = RW_TYPE_DELETE;
       // record write.
       is_written_ = true;
 
       return false;
     }
-    if (type == RW_TYPE_UPDATE) {
-      type = RW_TYPE_DELETE;
+    if (*type == RW_TYPE_UPDATE) {
+      *type = RW_TYPE_DELETE;
 
       return false;
     }
-    if (type == RW_TYPE_INSERT) {
-      type = RW_TYPE_INS_DEL;
+    if (*type == RW_TYPE_INSERT) {
+      *type = RW_TYPE_INS_DEL;
       --insert_count_;
 
       return true;
     }
-    if (type == RW_TYPE_DELETE) {
+    if (*type == RW_TYPE_DELETE) {
       PL_ASSERT(false);
       return false;
     }
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_manager.cpp
+//
+// Identification: src/concurrency/transaction_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace concurrency {
+
+const cid_t TransactionManager::commit_id_batch_size;
+
+namespace {
+
+/** Range of ids a worker took from the counters of a manager. */
+struct IdBatch {
+  const TransactionManager *manager = nullptr;
+  size_t generation = 0;
+  size_t epoch = 0;
+  uint64_t next = 0;
+  uint64_t end = 0;
+};
+
+thread_local IdBatch commit_id_batch;
+
+thread_local IdBatch txn_id_batch;
+
+}  // namespace
+
+cid_t TransactionManager::GetNextBatchedCommitId() {
+  auto epoch = EpochManagerFactory::GetInstance().GetCurrentEpoch();
+  auto generation = batch_generation_.load();
+
+  auto &batch = commit_id_batch;
+  if (batch.manager != this || batch.generation != generation ||
+      batch.epoch != epoch || batch.next == batch.end) {
+    batch.manager = this;
+    batch.generation = generation;
+    batch.epoch = epoch;
+    batch.next = next_cid_.fetch_add(commit_id_batch_size);
+    batch.end = batch.next + commit_id_batch_size;
+  }
+
+  cid_t temp_cid = batch.next++;
+  // wait if we do not yet have a grant for this commit id
+  while (temp_cid > maximum_grant_cid_.load())
+    ;
+  return temp_cid;
+}
+
+txn_id_t TransactionManager::GetNextBatchedTransactionId() {
+  auto generation = batch_generation_.load();
+
+  // transaction ids only have to be unique, the range lives across epochs
+  auto &batch = txn_id_batch;
+  if (batch.manager != this || batch.generation != generation ||
+      batch.next == batch.end) {
+    batch.manager = this;
+    batch.generation = generation;
+    batch.next = next_txn_id_.fetch_add(commit_id_batch_size);
+    batch.end = batch.next + commit_id_batch_size;
+  }
+
+  return batch.next++;
+}
+
+// The version read is visible to the current transaction, so it is not
+// reclaimed before the transaction ends, and its link to the older version
+// only changes when it is cut. The GC threads still reclaim the older version
+// and recycle its slot.
+bool TransactionManager::PruneVersionChain(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id, const cid_t &dead_cid) {
+  ItemPointer older_location = tile_group_header->GetNextItemPointer(tuple_id);
+  if (older_location.IsNull() == true) {
+    return false;
+  }
+
+  auto older_tile_group = catalog::Manager::GetInstance().GetTileGroupRaw(
+      older_location.block);
+  if (older_tile_group == nullptr) {
+    return false;
+  }
+
+  // the older version must be committed and ended before any transaction
+  // still running began
+  auto older_tile_group_header = older_tile_group->GetHeader();
+  if (older_tile_group_header->GetTransactionId(older_location.offset) !=
+          INITIAL_TXN_ID ||
+      older_tile_group_header->GetEndCommitId(older_location.offset) >=
+          dead_cid) {
+    return false;
+  }
+
+  return tile_group_header->SetAtomicNextItemPointer(tuple_id, older_location,
+                                                     INVALID_ITEMPOINTER);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -19,5 +19,7 @@ ConcurrencyType TransactionManagerFactory::protocol_ =
     ConcurrencyType::TIMESTAMP_ORDERING;
 IsolationLevelType TransactionManagerFactory::isolation_level_ =
     IsolationLevelType::FULL;
+TimestampType TransactionManagerFactory::timestamp_type_ =
+    TimestampType::CENTRALIZED;
 }
 }
@@ -70,6 +70,15 @@ DEFINE_string(socket_family,
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+DEFINE_uint64(parallel_scan_threads,
+              0,
+              "Number of threads scanning a table in parallel (default: 0)");
+
+DEFINE_bool(numa_aware,
+            true,
+            "Place tile groups on the NUMA node of the threads inserting "
+            "into them (default: true)");
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -106,9 +115,16 @@ DEFINE_bool(layout_tuner,
             false,
             "Enable layout tuner (default: false)");
 
+DEFINE_bool(tile_group_compactor,
+            false,
+            "Enable tile group compactor (default: false)");
+
 // Layout mode
 int peloton_layout_mode = peloton::LAYOUT_TYPE_ROW;
 
+// Tile group header layout mode
+peloton::LayoutType peloton_header_layout_mode = peloton::LAYOUT_TYPE_ROW;
+
 // Logging mode
 peloton::LoggingType peloton_logging_mode = peloton::LOGGING_TYPE_INVALID;
 
@@ -147,6 +147,8 @@ template class LockFreeArray<std::shared_ptr<index::Index>>;
 
 template class LockFreeArray<std::shared_ptr<storage::TileGroup>>;
 
+template class LockFreeArray<storage::TileGroup *>;
+
 template class LockFreeArray<std::shared_ptr<storage::Database>>;
 
 template class LockFreeArray<std::shared_ptr<storage::IndirectionArray>>;
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.cpp
+//
+// Identification: src/container/read_write_set.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "container/read_write_set.h"
+
+#include <algorithm>
+
+#include "common/macros.h"
+
+namespace peloton {
+
+const size_t ReadWriteSet::inline_entry_count;
+const size_t ReadWriteSet::initial_capacity;
+
+// Larger indexes are released by Clear rather than kept for the next user
+static const size_t max_retained_slot_count = 16 * 1024;
+
+RWType *ReadWriteSet::Find(const oid_t tile_group_id, const oid_t tuple_id) {
+  if (entries_.size() <= inline_entry_count) {
+    for (auto &entry : entries_) {
+      if (entry.tuple_id == tuple_id && entry.tile_group_id == tile_group_id) {
+        return &entry.type;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t slot = Hash(tile_group_id, tuple_id) & slot_mask_;
+  while (slots_[slot] != 0) {
+    auto &entry = entries_[slots_[slot] - 1];
+    if (entry.tuple_id == tuple_id && entry.tile_group_id == tile_group_id) {
+      return &entry.type;
+    }
+    slot = (slot + 1) & slot_mask_;
+  }
+  return nullptr;
+}
+
+void ReadWriteSet::Insert(const oid_t tile_group_id, const oid_t tuple_id,
+                          const RWType type) {
+  PL_ASSERT(Find(tile_group_id, tuple_id) == nullptr);
+  entries_.push_back({tile_group_id, tuple_id, type});
+
+  auto entry_count = entries_.size();
+  if (entry_count <= inline_entry_count) {
+    return;
+  }
+
+  // keep the index at most half full
+  if (entry_count == inline_entry_count + 1 ||
+      entry_count * 2 > slots_.size()) {
+    size_t slot_count = std::max<size_t>(slots_.size(), initial_capacity * 2);
+    while (entry_count * 2 > slot_count) {
+      slot_count *= 2;
+    }
+    BuildIndex(slot_count);
+  } else {
+    IndexEntry(entry_count - 1);
+  }
+}
+
+void ReadWriteSet::Set(const oid_t tile_group_id, const oid_t tuple_id,
+                       const RWType type) {
+  auto existing_type = Find(tile_group_id, tuple_id);
+  if (existing_type != nullptr) {
+    *existing_type = type;
+  } else {
+    Insert(tile_group_id, tuple_id, type);
+  }
+}
+
+// the index is rebuilt from scratch when the set outgrows the inline entries
+// again, so it does not have to be emptied.
+void ReadWriteSet::Clear() {
+  if (slots_.size() > max_retained_slot_count) {
+    std::vector<uint32_t>().swap(slots_);
+    std::vector<Entry>().swap(entries_);
+    entries_.reserve(initial_capacity);
+  }
+  entries_.clear();
+}
+
+void ReadWriteSet::BuildIndex(size_t slot_count) {
+  slots_.assign(slot_count, 0);
+  slot_mask_ = slot_count - 1;
+  for (uint32_t entry_offset = 0; entry_offset < entries_.size();
+       entry_offset++) {
+    IndexEntry(entry_offset);
+  }
+}
+
+void ReadWriteSet::IndexEntry(uint32_t entry_offset) {
+  auto &entry = entries_[entry_offset];
+  size_t slot = Hash(entry.tile_group_id, entry.tuple_id) & slot_mask_;
+  while (slots_[slot] != 0) {
+    slot = (slot + 1) & slot_mask_;
+  }
+  slots_[slot] = entry_offset + 1;
+}
+
+}  // End peloton namespace
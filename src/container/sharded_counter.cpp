@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// sharded_counter.cpp
+//
+// Identification: src/container/sharded_counter.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "container/sharded_counter.h"
+
+namespace peloton {
+
+const size_t ShardedCounter::shard_count;
+
+size_t ShardedCounter::GetShardOffset() {
+  // threads are given shards round-robin as they first update a counter
+  static std::atomic<size_t> thread_count(0);
+  static thread_local size_t shard_offset = thread_count++ % shard_count;
+  return shard_offset;
+}
+
+void ShardedCounter::Set(int64_t value) {
+  shards_[0].value.store(value, std::memory_order_relaxed);
+  for (size_t shard_itr = 1; shard_itr < shard_count; shard_itr++) {
+    shards_[shard_itr].value.store(0, std::memory_order_relaxed);
+  }
+}
+
+int64_t ShardedCounter::Get() const {
+  int64_t value = 0;
+  for (size_t shard_itr = 0; shard_itr < shard_count; shard_itr++) {
+    value += shards_[shard_itr].value.load(std::memory_order_relaxed);
+  }
+  return value;
+}
+
+}  // End peloton namespace
@@ -22,6 +22,10 @@
 #include "executor/logical_tile_factory.h"
 #include "expression/abstract_expression.h"
 #include "common/container_tuple.h"
+#include "configuration/configuration.h"
+#include "executor/join_bloom_filter.h"
+#include "executor/join_hash_table.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 
@@ -54,8 +58,56 @@ bool AbstractScanExecutor::DInit() {
 
   column_ids_ = std::move(node.GetColumnIds());
 
+  join_filter_ = nullptr;
+  join_filter_column_ids_.clear();
+
   return true;
 }
 
+void AbstractScanExecutor::SetJoinFilter(
+    const JoinBloomFilter *join_filter,
+    const std::vector<oid_t> &key_column_offsets) {
+  join_filter_ = join_filter;
+
+  // No column ids means all the columns of the table
+  join_filter_column_ids_.clear();
+  for (oid_t column_offset : key_column_offsets) {
+    join_filter_column_ids_.push_back(
+        column_ids_.empty() ? column_offset : column_ids_[column_offset]);
+  }
+}
+
+bool AbstractScanExecutor::PassesJoinFilter(storage::TileGroup *tile_group,
+                                            oid_t tuple_id) const {
+  PL_ASSERT(join_filter_ != nullptr);
+  return join_filter_->MayContain(
+      JoinHashTable::HashKey(tile_group, tuple_id, join_filter_column_ids_));
+}
+
+void AbstractScanExecutor::ApplyJoinFilter(
+    storage::TileGroup *tile_group, std::vector<oid_t> &position_list) const {
+  size_t probe_count = position_list.size();
+  size_t pass_count = 0;
+  for (oid_t tuple_id : position_list) {
+    if (PassesJoinFilter(tile_group, tuple_id)) {
+      position_list[pass_count++] = tuple_id;
+    }
+  }
+  position_list.resize(pass_count);
+
+  RecordJoinFilterProbes(tile_group->GetDatabaseId(), tile_group->GetTableId(),
+                         probe_count, pass_count);
+}
+
+void AbstractScanExecutor::RecordJoinFilterProbes(oid_t database_id,
+                                                  oid_t table_id,
+                                                  size_t probe_count,
+                                                  size_t pass_count) const {
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID && probe_count > 0) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableBloomFilterProbes(
+        database_id, table_id, probe_count, pass_count);
+  }
+}
+
 }  // namespace executor
 }  // namespace peloton
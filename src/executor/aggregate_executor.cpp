@@ -20,6 +20,7 @@
 #include "executor/aggregator.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile_factory.h"
+#include "executor/partitioned_aggregator.h"
 #include "planner/aggregate_plan.h"
 #include "storage/table_factory.h"
 
@@ -96,6 +97,11 @@ bool AggregateExecutor::DExecute() {
   // Get an aggregator
   std::unique_ptr<AbstractAggregator> aggregator(nullptr);
 
+  // Input tiles of the partitioned hash aggregator, aggregated in parallel
+  // once they are all there
+  PartitionedHashAggregator *partitioned_aggregator = nullptr;
+  std::vector<std::unique_ptr<LogicalTile>> input_tiles;
+
   // Get input tiles and aggregate them
   while (children_[0]->Execute() == true) {
     std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
@@ -104,6 +110,14 @@ bool AggregateExecutor::DExecute() {
       // Initialize the aggregator
       switch (node.GetAggregateStrategy()) {
         case AggregateType::HASH:
+          if (PartitionedHashAggregator::IsSupported(&node, tile.get())) {
+            LOG_TRACE("Use PartitionedHashAggregator");
+            partitioned_aggregator = new PartitionedHashAggregator(
+                &node, output_table, executor_context_,
+                tile->GetColumnCount());
+            aggregator.reset(partitioned_aggregator);
+            break;
+          }
           LOG_TRACE("Use HashAggregator");
           aggregator.reset(new HashAggregator(
               &node, output_table, executor_context_, tile->GetColumnCount()));
@@ -124,6 +138,11 @@ bool AggregateExecutor::DExecute() {
       }
     }
 
+    if (partitioned_aggregator != nullptr) {
+      input_tiles.push_back(std::move(tile));
+      continue;
+    }
+
     LOG_TRACE("Looping over tile..");
 
     for (oid_t tuple_id : *tile) {
@@ -137,6 +156,12 @@ bool AggregateExecutor::DExecute() {
     LOG_TRACE("Finished processing logical tile");
   }
 
+  if (partitioned_aggregator != nullptr &&
+      partitioned_aggregator->AdvanceTiles(input_tiles) == false) {
+    return false;
+  }
+  input_tiles.clear();
+
   LOG_TRACE("Finalizing..");
   if (!aggregator.get() || !aggregator->Finalize()) {
     // If there's no tuples and no group-by, count() aggregations should return
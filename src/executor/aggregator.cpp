@@ -95,9 +95,6 @@ bool Helper(const planner::AggregatePlan *node, AbstractAttributeAggregator **ag
             storage::AbstractTable *output_table,
             const AbstractTuple *delegate_tuple,
             executor::ExecutorContext *econtext) {
-  auto schema = output_table->GetSchema();
-  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
-
   /*
    * 1) Construct a vector of aggregated values
    */
@@ -111,6 +108,22 @@ bool Helper(const planner::AggregatePlan *node, AbstractAttributeAggregator **ag
     }
   }
 
+  return InsertAggregateTuple(node, aggregate_values, output_table,
+                              delegate_tuple, econtext);
+}
+
+/*
+ * Inserts the output tuple of a group into the output table, given the
+ * aggregated values of the group and its delegate tuple.
+ */
+bool InsertAggregateTuple(const planner::AggregatePlan *node,
+                          std::vector<type::Value> &aggregate_values,
+                          storage::AbstractTable *output_table,
+                          const AbstractTuple *delegate_tuple,
+                          executor::ExecutorContext *econtext) {
+  auto schema = output_table->GetSchema();
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+
   /*
    * 2) Evaluate filter predicate;
    * if fail, just return
@@ -68,10 +68,11 @@ bool CreateExecutor::DExecute() {
     IndexType index_type = node.GetIndexType();
 
     auto index_attrs = node.GetIndexAttributes();
+    auto index_include_attrs = node.GetIndexIncludeAttributes();
 
     ResultType result = catalog::Catalog::GetInstance()->CreateIndex(
         DEFAULT_DB_NAME, table_name, index_attrs, index_name, unique_flag,
-        index_type);
+        index_type, index_include_attrs, current_txn);
     current_txn->SetResult(result);
 
     if (current_txn->GetResult() == ResultType::SUCCESS) {
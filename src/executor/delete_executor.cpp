@@ -111,6 +111,15 @@ bool DeleteExecutor::DExecute() {
     if (is_owner == true && is_written == true) {
       // if the thread is the owner of the tuple, then directly update in place.
       LOG_TRACE("Thread is owner of the tuple");
+
+      // The version becomes the empty version of the delete, which is not
+      // collected with its values
+      expression::ContainerTuple<storage::TileGroup> old_tuple(
+          tile_group, physical_tuple_id);
+      target_table_->DeleteFromCoveringIndexes(
+          &old_tuple, old_location,
+          tile_group_header->GetIndirection(physical_tuple_id));
+
       transaction_manager.PerformDelete(current_txn, old_location);
 
     } else {
@@ -0,0 +1,336 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_executor.cpp
+//
+// Identification: src/executor/exchange_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/exchange_executor.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "common/init.h"
+#include "common/logger.h"
+#include "common/thread_pool.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "planner/exchange_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace executor {
+
+//===--------------------------------------------------------------------===//
+// Scan State
+//===--------------------------------------------------------------------===//
+
+struct ExchangeExecutor::ScanState {
+  // Morsels left in the range of a worker. The owner takes them from the
+  // front, thieves from the back.
+  struct MorselRange {
+    std::mutex lock;
+    oid_t begin = 0;
+    oid_t end = 0;
+  };
+
+  // Qualifying tuples of a tile group, valid as long as the transaction of
+  // the scan runs
+  struct ScanResult {
+    storage::TileGroup *tile_group = nullptr;
+    std::vector<oid_t> position_list;
+  };
+
+  ScanState(SeqScanExecutor *scan, size_t worker_count)
+      : scan(scan), ranges(worker_count) {
+    oid_t morsel_count = scan->GetTileGroupCount();
+    for (size_t worker = 0; worker < worker_count; worker++) {
+      ranges[worker].begin = morsel_count * worker / worker_count;
+      ranges[worker].end = morsel_count * (worker + 1) / worker_count;
+    }
+    pending_morsels = morsel_count;
+  }
+
+  bool NextMorsel(size_t worker, oid_t &tile_group_offset);
+
+  void ScanMorsel(oid_t tile_group_offset);
+
+  void Work(size_t worker);
+
+  SeqScanExecutor *scan;
+
+  std::vector<MorselRange> ranges;
+
+  // Protects the members below
+  std::mutex lock;
+
+  std::condition_variable cond;
+
+  std::deque<ScanResult> results;
+
+  // Morsels whose result is not in the queue yet
+  size_t pending_morsels = 0;
+
+  // Workers running on the thread pool
+  size_t active_workers = 0;
+
+  bool cancelled = false;
+
+  // First exception thrown by a worker, rethrown by the consumer
+  std::exception_ptr error;
+};
+
+/**
+ * @brief Takes the next morsel of a worker, stealing one from the largest
+ * remaining range when the worker's own range is empty.
+ * @return false if there is no morsel left.
+ */
+bool ExchangeExecutor::ScanState::NextMorsel(size_t worker,
+                                             oid_t &tile_group_offset) {
+  {
+    std::lock_guard<std::mutex> guard(ranges[worker].lock);
+    if (ranges[worker].begin < ranges[worker].end) {
+      tile_group_offset = ranges[worker].begin++;
+      return true;
+    }
+  }
+
+  while (true) {
+    size_t victim = ranges.size();
+    oid_t victim_size = 0;
+    for (size_t other = 0; other < ranges.size(); other++) {
+      std::lock_guard<std::mutex> guard(ranges[other].lock);
+      oid_t size = ranges[other].end - ranges[other].begin;
+      if (size > victim_size) {
+        victim = other;
+        victim_size = size;
+      }
+    }
+
+    if (victim == ranges.size()) {
+      return false;
+    }
+
+    // The range may have been drained since we looked at it
+    std::lock_guard<std::mutex> guard(ranges[victim].lock);
+    if (ranges[victim].begin < ranges[victim].end) {
+      tile_group_offset = --ranges[victim].end;
+      return true;
+    }
+  }
+}
+
+/**
+ * @brief Scans a morsel and queues its result for the consumer.
+ */
+void ExchangeExecutor::ScanState::ScanMorsel(oid_t tile_group_offset) {
+  ScanResult result;
+  result.tile_group =
+      scan->ScanTileGroup(tile_group_offset, result.position_list);
+
+  std::lock_guard<std::mutex> guard(lock);
+  results.push_back(std::move(result));
+  pending_morsels--;
+  cond.notify_all();
+}
+
+/**
+ * @brief Body of a worker running on the thread pool.
+ */
+void ExchangeExecutor::ScanState::Work(size_t worker) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    // The exchange may be gone already, together with the scan
+    if (cancelled == true) {
+      return;
+    }
+    active_workers++;
+  }
+
+  oid_t tile_group_offset;
+  while (NextMorsel(worker, tile_group_offset)) {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (cancelled == true) {
+        break;
+      }
+    }
+
+    try {
+      ScanMorsel(tile_group_offset);
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(lock);
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+      pending_morsels--;
+      cond.notify_all();
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  active_workers--;
+  cond.notify_all();
+}
+
+//===--------------------------------------------------------------------===//
+// Exchange Executor
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Constructor
+ * @param node  ExchangePlan plan node corresponding to this executor
+ */
+ExchangeExecutor::ExchangeExecutor(const planner::AbstractPlan *node,
+                                   ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context) {}
+
+ExchangeExecutor::~ExchangeExecutor() { StopWorkers(); }
+
+/**
+ * @brief Waits until no worker runs the scan anymore.
+ */
+void ExchangeExecutor::StopWorkers() {
+  if (state_ == nullptr) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(state_->lock);
+  state_->cancelled = true;
+  state_->cond.wait(lock, [this] { return state_->active_workers == 0; });
+  lock.unlock();
+
+  state_.reset();
+}
+
+/**
+ * @brief Takes over the sequential scan below and starts the workers.
+ * Any other child is run serially.
+ * @return true on success, false otherwise.
+ */
+bool ExchangeExecutor::DInit() {
+  StopWorkers();
+
+  // Initialized again, the exchange already owns the scan
+  if (scan_ != nullptr) {
+    if (scan_->Init() == false) {
+      return false;
+    }
+  } else {
+    PL_ASSERT(children_.size() == 1);
+
+    auto scan = dynamic_cast<SeqScanExecutor *>(children_[0]);
+    if (scan == nullptr) {
+      return true;
+    }
+    auto scan_node =
+        static_cast<const planner::SeqScanPlan *>(scan->GetRawNode());
+    if (scan_node->GetTable() == nullptr || scan_node->IsForUpdate()) {
+      return true;
+    }
+
+    scan_.reset(scan);
+    children_.clear();
+  }
+
+  const planner::ExchangePlan &node = GetPlanNode<planner::ExchangePlan>();
+
+  // One morsel per tile group, at least one per worker
+  size_t morsel_count = scan_->GetTileGroupCount();
+  size_t worker_count =
+      std::min({node.GetParallelism(), thread_pool.GetPoolSize() + 1,
+                morsel_count});
+  worker_count = std::max(worker_count, (size_t)1);
+
+  state_.reset(new ScanState(scan_.get(), worker_count));
+
+  // The thread executing the plan is worker 0
+  for (size_t worker = 1; worker < worker_count; worker++) {
+    std::shared_ptr<ScanState> state = state_;
+    thread_pool.SubmitTask([state, worker] { state->Work(worker); });
+  }
+
+  LOG_TRACE("Scanning %lu tile groups with %lu workers", morsel_count,
+            worker_count);
+  return true;
+}
+
+/**
+ * @brief Hands the tiles of the scan to the parent in the order the workers
+ * produce them.
+ * @return true on success, false otherwise.
+ */
+bool ExchangeExecutor::DExecute() {
+  // Not a parallel scan
+  if (scan_ == nullptr) {
+    if (children_[0]->Execute() == false) {
+      return false;
+    }
+    SetOutput(children_[0]->GetOutput());
+    return true;
+  }
+
+  while (true) {
+    ScanState::ScanResult result;
+    bool has_result = false;
+
+    {
+      std::lock_guard<std::mutex> guard(state_->lock);
+      if (state_->error != nullptr) {
+        std::rethrow_exception(state_->error);
+      }
+      if (state_->results.empty() == false) {
+        result = std::move(state_->results.front());
+        state_->results.pop_front();
+        has_result = true;
+      } else if (state_->pending_morsels == 0) {
+        return false;
+      }
+    }
+
+    if (has_result == false) {
+      // Scan a morsel rather than wait for the workers
+      oid_t tile_group_offset;
+      if (state_->NextMorsel(0, tile_group_offset) == true) {
+        result.tile_group = scan_->ScanTileGroup(tile_group_offset,
+                                                 result.position_list);
+        std::lock_guard<std::mutex> guard(state_->lock);
+        state_->pending_morsels--;
+      } else {
+        // The last morsels are being scanned by the workers
+        std::unique_lock<std::mutex> lock(state_->lock);
+        state_->cond.wait(lock, [this] {
+          return state_->results.empty() == false ||
+                 state_->pending_morsels == 0 || state_->error != nullptr;
+        });
+        continue;
+      }
+    }
+
+    if (scan_->PerformReads(result.tile_group, result.position_list) == false) {
+      return false;
+    }
+
+    // Don't return empty tiles
+    if (result.position_list.empty()) {
+      continue;
+    }
+
+    SetOutput(scan_->BuildLogicalTile(result.tile_group,
+                                      std::move(result.position_list)));
+    return true;
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -70,6 +70,7 @@ bool HashExecutor::DExecute() {
     auto &hashkeys = node.GetHashKeys();
 
     // Construct a logical tile
+    column_ids_.clear();
     for (auto &hashkey : hashkeys) {
       PL_ASSERT(hashkey->GetExpressionType() == ExpressionType::VALUE_TUPLE);
       auto tuple_value =
@@ -78,40 +79,45 @@ bool HashExecutor::DExecute() {
       column_ids_.push_back(tuple_value->GetColumnId());
     }
 
-    // Construct the hash table by going over each child logical tile and
-    // hashing
+    // Materialize the hash of the key and the location of each tuple,
+    // i.e. < child_tile offset, tuple offset >
+    hash_table_.Clear();
     for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
          child_tile_itr++) {
       auto tile = child_tiles_[child_tile_itr].get();
 
       // Go over all tuples in the logical tile
       for (oid_t tuple_id : *tile) {
-        // Key : container tuple with a subset of tuple attributes
-        // Value : < child_tile offset, tuple offset >
-        auto key = HashMapType::key_type(tile, tuple_id, &column_ids_);
-        if (hash_table_.find(key) != hash_table_.end()){
-           //If data is already present, remove from output
-           //but leave data for hash joins.
-           tile->RemoveVisibility(tuple_id);
-        }
-        hash_table_[key].insert(
-                    std::make_pair(child_tile_itr, tuple_id));
+        hash_table_.Insert(JoinHashTable::HashKey(tile, tuple_id, column_ids_),
+                           child_tile_itr, tuple_id);
       }
     }
 
+    // Construct the hash table
+    hash_table_.Build(
+        [this](const JoinHashTable::Entry &lhs,
+               const JoinHashTable::Entry &rhs) {
+          return JoinHashTable::KeysEqual(
+              child_tiles_[lhs.tile_itr].get(), lhs.tuple_id, column_ids_,
+              child_tiles_[rhs.tile_itr].get(), rhs.tuple_id, column_ids_);
+        },
+        [this](const JoinHashTable::Entry &entry) {
+          // If data is already present, remove from output
+          // but leave data for hash joins.
+          child_tiles_[entry.tile_itr]->RemoveVisibility(entry.tuple_id);
+        });
+
     done_ = true;
   }
 
-  // Return logical tiles one at a time
-  while (result_itr < child_tiles_.size()) {
-    if (child_tiles_[result_itr]->GetTupleCount() == 0) {
-      result_itr++;
-      continue;
-    } else {
-      SetOutput(child_tiles_[result_itr++].release());
-      LOG_TRACE("Hash Executor : true -- return tile one at a time ");
-      return true;
-    }
+  // Return logical tiles one at a time.
+  // IMPORTANT: tiles left empty by the removal of duplicates are returned
+  // too, the hash join looks up the tuples of the hash table by the offset of
+  // their tile.
+  if (result_itr < child_tiles_.size()) {
+    SetOutput(child_tiles_[result_itr++].release());
+    LOG_TRACE("Hash Executor : true -- return tile one at a time ");
+    return true;
   }
 
   LOG_TRACE("Hash Executor : false -- done ");
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
 #include <vector>
 
 #include "type/types.h"
@@ -18,6 +19,8 @@
 #include "executor/logical_tile_factory.h"
 #include "executor/hash_join_executor.h"
 #include "expression/abstract_expression.h"
+#include "executor/join_hash_table.h"
+#include "executor/abstract_scan_executor.h"
 #include "common/container_tuple.h"
 
 namespace peloton {
@@ -78,6 +81,10 @@ bool HashJoinExecutor::DExecute() {
         BufferRightTile(children_[1]->GetOutput());
       }
       right_child_done_ = true;
+
+      if (GetPlanNode<planner::HashJoinPlan>().IsBloomFilterPushdown()) {
+        PushDownBloomFilter();
+      }
     }
 
     // Get next tile from LEFT child
@@ -104,21 +111,44 @@ bool HashJoinExecutor::DExecute() {
     // Get the hash table from the hash executor
     auto &hash_table = hash_executor_->GetHashTable();
     auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
+    auto &left_col_ids = GetLeftKeyIds();
+
+    // Hash the left tile
+    left_tuple_ids_.clear();
+    left_hashes_.clear();
+    for (auto left_tile_itr : *left_tile) {
+      left_tuple_ids_.push_back(left_tile_itr);
+      left_hashes_.push_back(
+          JoinHashTable::HashKey(left_tile, left_tile_itr, left_col_ids));
+    }
+
+    // Find matching tuples in the hash table built on top of the right table
+    matches_.clear();
+    hash_table.ProbeBatch(
+        left_hashes_.data(), left_hashes_.size(),
+        [&](size_t left_itr, const JoinHashTable::Entry &entry) {
+          return JoinHashTable::KeysEqual(
+              left_tile, left_tuple_ids_[left_itr], left_col_ids,
+              right_result_tiles_[entry.tile_itr].get(), entry.tuple_id,
+              hashed_col_ids);
+        },
+        [&](size_t left_itr, const JoinHashTable::Entry &entry) {
+          matches_.push_back(
+              {entry.tile_itr, entry.tuple_id, left_tuple_ids_[left_itr]});
+        });
+
+    // Group the matches by right tile, one output tile per right tile
+    std::stable_sort(matches_.begin(), matches_.end(),
+                     [](const JoinMatch &lhs, const JoinMatch &rhs) {
+                       return lhs.right_tile_itr < rhs.right_tile_itr;
+                     });
 
     oid_t prev_tile = INVALID_OID;
     std::unique_ptr<LogicalTile> output_tile;
     LogicalTile::PositionListsBuilder pos_lists_builder;
 
-    // Go over the left tile
-    for (auto left_tile_itr : *left_tile) {
-      const expression::ContainerTuple<executor::LogicalTile> left_tuple(
-          left_tile, left_tile_itr, &hashed_col_ids);
-
-      // Find matching tuples in the hash table built on top of the right table
-      auto right_tuples = hash_table.find(left_tuple);
-
-      if (right_tuples != hash_table.end()) {
-    	// Not yet supported due to assertion in gettomg right_tuples->first
+    for (auto &match : matches_) {
+      // Not yet supported due to assertion in gettomg right_tuples->first
 //    	if (predicate_ != nullptr) {
 //    		auto eval = predicate_->Evaluate(&left_tuple, &right_tuples->first,
 //					executor_context_);
@@ -126,43 +156,40 @@ bool HashJoinExecutor::DExecute() {
 //				continue;
 //    	}
 
-        RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
+      RecordMatchedLeftRow(left_result_tiles_.size() - 1, match.left_tuple_id);
 
-        // Go over the matching right tuples
-        for (auto &location : right_tuples->second) {
-          // Check if we got a new right tile itr
-          if (prev_tile != location.first) {
-            // Check if we have any join tuples
-            if (pos_lists_builder.Size() > 0) {
-              LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
-              output_tile->SetPositionListsAndVisibility(
-                  pos_lists_builder.Release());
-              buffered_output_tiles.push_back(output_tile.release());
-            }
+      // Check if we got a new right tile itr
+      if (prev_tile != match.right_tile_itr) {
+        // Check if we have any join tuples
+        if (pos_lists_builder.Size() > 0) {
+          LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
+          output_tile->SetPositionListsAndVisibility(
+              pos_lists_builder.Release());
+          buffered_output_tiles.push_back(output_tile.release());
+        }
 
-            // Get the logical tile from right child
-            LogicalTile *right_tile = right_result_tiles_[location.first].get();
+        // Get the logical tile from right child
+        LogicalTile *right_tile =
+            right_result_tiles_[match.right_tile_itr].get();
 
-            // Build output logical tile
-            output_tile = BuildOutputLogicalTile(left_tile, right_tile);
+        // Build output logical tile
+        output_tile = BuildOutputLogicalTile(left_tile, right_tile);
 
-            // Build position lists
-            pos_lists_builder =
-                LogicalTile::PositionListsBuilder(left_tile, right_tile);
+        // Build position lists
+        pos_lists_builder =
+            LogicalTile::PositionListsBuilder(left_tile, right_tile);
 
-            pos_lists_builder.SetRightSource(
-                &right_result_tiles_[location.first]->GetPositionLists());
-          }
+        pos_lists_builder.SetRightSource(
+            &right_result_tiles_[match.right_tile_itr]->GetPositionLists());
+      }
 
-          // Add join tuple
-          pos_lists_builder.AddRow(left_tile_itr, location.second);
+      // Add join tuple
+      pos_lists_builder.AddRow(match.left_tuple_id, match.right_tuple_id);
 
-          RecordMatchedRightRow(location.first, location.second);
+      RecordMatchedRightRow(match.right_tile_itr, match.right_tuple_id);
 
-          // Cache prev logical tile itr
-          prev_tile = location.first;
-        }
-      }
+      // Cache prev logical tile itr
+      prev_tile = match.right_tile_itr;
     }
 
     // Check if we have any join tuples
@@ -186,5 +213,43 @@ bool HashJoinExecutor::DExecute() {
   }
 }
 
+/**
+ * @brief The left tuples are hashed on the outer hash keys if there are some,
+ * otherwise on the same columns as the right ones.
+ */
+const std::vector<oid_t> &HashJoinExecutor::GetLeftKeyIds() {
+  auto &outer_col_ids = GetPlanNode<planner::HashJoinPlan>().GetOuterHashIds();
+  return outer_col_ids.empty() ? hash_executor_->GetHashKeyIds()
+                               : outer_col_ids;
+}
+
+/**
+ * @brief Builds a bloom filter over the keys of the hash table and pushes it
+ * down into the scan of the left child, which then skips the tuples that have
+ * no match. Only done when unmatched left tuples are not part of the output.
+ */
+void HashJoinExecutor::PushDownBloomFilter() {
+  auto join_type = GetPlanNode<planner::HashJoinPlan>().GetJoinType();
+  if (join_type != JoinType::INNER && join_type != JoinType::RIGHT &&
+      join_type != JoinType::SEMI) {
+    return;
+  }
+
+  auto left_node_type = children_[0]->GetRawNode()->GetPlanNodeType();
+  if (left_node_type != PlanNodeType::SEQSCAN &&
+      left_node_type != PlanNodeType::INDEXSCAN) {
+    return;
+  }
+
+  auto &hash_table = hash_executor_->GetHashTable();
+  bloom_filter_.reset(new JoinBloomFilter(hash_table.GetEntryCount()));
+  for (auto &entry : hash_table.GetEntries()) {
+    bloom_filter_->Insert(entry.hash);
+  }
+
+  auto left_scan = static_cast<AbstractScanExecutor *>(children_[0]);
+  left_scan->SetJoinFilter(bloom_filter_.get(), GetLeftKeyIds());
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -362,6 +362,7 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
       concurrency::TransactionManagerFactory::GetInstance();
 
   auto current_txn = executor_context_->GetTransaction();
+  auto dead_cid = transaction_manager.GetLastMaxCommittedCid();
 
   if (tuple_location_ptrs.size() == 0) {
     index_done_ = true;
@@ -392,6 +393,10 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
           current_txn, tile_group_header, tuple_location.offset);
 
       if (visibility == VisibilityType::OK) {
+        // unlink the older versions no transaction observes anymore
+        transaction_manager.PruneVersionChain(
+            tile_group_header, tuple_location.offset, dead_cid);
+
         visible_tuples[tuple_location.block].push_back(tuple_location.offset);
         auto res = transaction_manager.PerformRead(current_txn, tuple_location,
                                                    acquire_owner);
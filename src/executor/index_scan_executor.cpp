@@ -12,6 +12,7 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -30,6 +31,7 @@
 #include "planner/index_scan_plan.h"
 #include "storage/data_table.h"
 #include "storage/masked_tuple.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "type/types.h"
@@ -71,6 +73,7 @@ bool IndexScanExecutor::DInit() {
 
   result_itr_ = START_OID;
   result_.clear();
+  scan_cursor_.reset();
   done_ = false;
   key_ready_ = false;
 
@@ -89,6 +92,9 @@ bool IndexScanExecutor::DInit() {
   limit_offset_ = node.GetLimitOffset();
   descend_ = node.GetDescend();
 
+  index_only_ = node.GetIndexOnly();
+  PL_ASSERT(index_only_ == false || index_->IsCovering() == true);
+
   if (runtime_keys_.size() != 0) {
     PL_ASSERT(runtime_keys_.size() == values_.size());
 
@@ -111,6 +117,11 @@ bool IndexScanExecutor::DInit() {
   if (table_ != nullptr) {
     full_column_ids_.resize(table_->GetSchema()->GetColumnCount());
     std::iota(full_column_ids_.begin(), full_column_ids_.end(), 0);
+
+    if (index_only_ == true) {
+      index_only_schema_.reset(
+          catalog::Schema::CopySchema(table_->GetSchema(), column_ids_));
+    }
   }
 
   return true;
@@ -123,100 +134,115 @@ bool IndexScanExecutor::DInit() {
 bool IndexScanExecutor::DExecute() {
   LOG_TRACE("Index Scan executor :: 0 child");
 
-  if (!done_) {
-    if (index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
-      auto status = ExecPrimaryIndexLookup();
+  while (true) {
+    while (result_itr_ < result_.size()) {  // Avoid returning empty tiles
+      if (result_[result_itr_]->GetTupleCount() == 0) {
+        delete result_[result_itr_];
+        result_itr_++;
+        continue;
+      } else {
+        LOG_TRACE("Information %s", result_[result_itr_]->GetInfo().c_str());
+        SetOutput(result_[result_itr_]);
+        result_itr_++;
+        return true;
+      }
+
+    }  // end while
+
+    if (done_) {
+      return false;
+    }
+
+    // The tiles of the previous batch have all been returned
+    result_.clear();
+    result_itr_ = START_OID;
+
+    std::vector<ItemPointer *> tuple_location_ptrs;
+    std::vector<type::Value> key_values;
+    if (ScanNextBatch(tuple_location_ptrs, key_values) == false) {
+      LOG_TRACE("no tuple is retrieved from index.");
+      done_ = true;
+      return false;
+    }
+
+    if (index_->IsCovering() == true) {
+      auto status = ExecCoveringIndexLookup(tuple_location_ptrs, key_values);
+      if (status == false) return false;
+    } else if (index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
+      auto status = ExecPrimaryIndexLookup(tuple_location_ptrs);
       if (status == false) return false;
     } else {
-      auto status = ExecSecondaryIndexLookup();
+      auto status = ExecSecondaryIndexLookup(tuple_location_ptrs);
       if (status == false) return false;
     }
   }
-  // Already performed the index lookup
-  PL_ASSERT(done_);
+}
 
-  while (result_itr_ < result_.size()) {  // Avoid returning empty tiles
-    if (result_[result_itr_]->GetTupleCount() == 0) {
-      result_itr_++;
-      continue;
+bool IndexScanExecutor::ScanNextBatch(
+    std::vector<ItemPointer *> &tuple_location_ptrs,
+    std::vector<type::Value> &key_values) {
+  // Open the cursor on the first batch
+  if (scan_cursor_ == nullptr) {
+    if (0 == key_column_ids_.size()) {
+      scan_cursor_ = index_->ScanAllKeysCursor();
     } else {
-      LOG_TRACE("Information %s", result_[result_itr_]->GetInfo().c_str());
-      SetOutput(result_[result_itr_]);
-      result_itr_++;
-      return true;
+      // Limit clause accelerate
+      auto scan_direction = (limit_ && descend_) ? ScanDirectionType::BACKWARD
+                                                 : ScanDirectionType::FORWARD;
+      scan_cursor_ = index_->ScanCursor(
+          values_, key_column_ids_, expr_types_, scan_direction,
+          &index_predicate_.GetConjunctionList()[0]);
     }
+  }
 
-  }  // end while
+  // With a limit, the first batch is enough unless some of its tuples are
+  // not visible
+  size_t batch_size = scan_batch_size;
+  if (limit_ && limit_number_ + limit_offset_ > 0) {
+    batch_size = std::min(batch_size,
+                          static_cast<size_t>(limit_number_ + limit_offset_));
+  }
+
+  bool status =
+      index_->IsCovering()
+          ? scan_cursor_->NextEntries(tuple_location_ptrs, key_values,
+                                      batch_size)
+          : scan_cursor_->Next(tuple_location_ptrs, batch_size);
+  LOG_TRACE("tuple_location_ptrs:%lu", tuple_location_ptrs.size());
 
-  return false;
+  return status;
 }
 
-bool IndexScanExecutor::ExecPrimaryIndexLookup() {
+bool IndexScanExecutor::ExecPrimaryIndexLookup(
+    const std::vector<ItemPointer *> &tuple_location_ptrs) {
   LOG_TRACE("Exec primary index lookup");
   PL_ASSERT(!done_);
 
-  std::vector<ItemPointer *> tuple_location_ptrs;
-
   // Grab info from plan node
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
   PL_ASSERT(index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY);
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    // Limit clause accelerate
-    if (limit_) {
-      // invoke index scan limit
-      if (!descend_) {
-        LOG_TRACE("ASCENDING SCAN LIMIT in Primary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::FORWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-      } else {
-        LOG_TRACE("DESCENDING SCAN LIMIT in Primary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::BACKWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-
-        LOG_TRACE("1-Result size is %lu", result_.size());
-      }
-    }
-    // Normal SQL (without limit)
-    else {
-      LOG_TRACE("Index Scan in Primary Index");
-      index_->Scan(values_, key_column_ids_, expr_types_,
-                   ScanDirectionType::FORWARD, tuple_location_ptrs,
-                   &index_predicate_.GetConjunctionList()[0]);
-    }
-
-    LOG_TRACE("tuple_location_ptrs:%lu", tuple_location_ptrs.size());
-  }
-
-  if (tuple_location_ptrs.size() == 0) {
-    LOG_TRACE("no tuple is retrieved from index.");
-    return false;
-  }
-
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
   auto current_txn = executor_context_->GetTransaction();
+  auto dead_cid = transaction_manager.GetLastMaxCommittedCid();
   auto &manager = catalog::Manager::GetInstance();
   std::vector<ItemPointer> visible_tuple_locations;
-  std::map<oid_t, std::vector<oid_t>> visible_tuples;
 
 #ifdef LOG_TRACE_ENABLED
   int num_tuples_examined = 0;
 #endif
 
+  size_t join_filter_probe_count = 0;
+  size_t join_filter_pass_count = 0;
+
   // for every tuple that is found in the index.
   for (auto tuple_location_ptr : tuple_location_ptrs) {
     ItemPointer tuple_location = *tuple_location_ptr;
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupRaw(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
     size_t chain_length = 0;
 
 #ifdef LOG_TRACE_ENABLED
@@ -229,8 +255,13 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
     while (true) {
       ++chain_length;
 
-      auto visibility = transaction_manager.IsVisible(
-          current_txn, tile_group_header, tuple_location.offset);
+      // skip the per-tuple check if every version in the tile group is
+      // visible to the current transaction.
+      auto visibility =
+          tile_group_header->IsAllVisible(current_txn->GetBeginCommitId())
+              ? VisibilityType::OK
+              : transaction_manager.IsVisible(current_txn, tile_group_header,
+                                              tuple_location.offset);
 
       // if the tuple is deleted
       if (visibility == VisibilityType::DELETED) {
@@ -243,15 +274,27 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
+        // unlink the older versions no transaction observes anymore, while
+        // the header of the version is in the cache
+        transaction_manager.PruneVersionChain(
+            tile_group_header, tuple_location.offset, dead_cid);
+
         bool eval = true;
         // if having predicate, then perform evaluation.
         if (predicate_ != nullptr) {
           LOG_TRACE("perform prediate evaluate");
           expression::ContainerTuple<storage::TileGroup> tuple(
-              tile_group.get(), tuple_location.offset);
+              tile_group, tuple_location.offset);
           eval =
               predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
         }
+        // skip the tuple if it can not join with the build side of a hash
+        // join.
+        if (eval == true && join_filter_ != nullptr) {
+          join_filter_probe_count++;
+          eval = PassesJoinFilter(tile_group, tuple_location.offset);
+          join_filter_pass_count += eval;
+        }
         // if passed evaluation, then perform write.
         if (eval == true) {
           LOG_TRACE("perform read operation");
@@ -290,8 +333,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupRaw(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
@@ -315,8 +358,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupRaw(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
         continue;
       }
     }
@@ -327,6 +370,10 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
             index_->GetName().c_str());
 #endif
 
+  RecordJoinFilterProbes(index_->GetMetadata()->GetDatabaseOid(),
+                         index_->GetMetadata()->GetTableOid(),
+                         join_filter_probe_count, join_filter_pass_count);
+
   LOG_TRACE("%ld tuples before pruning boundaries",
             visible_tuple_locations.size());
 
@@ -336,89 +383,27 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   LOG_TRACE("%ld tuples after pruning boundaries",
             visible_tuple_locations.size());
 
-  for (auto &visible_tuple_location : visible_tuple_locations) {
-    visible_tuples[visible_tuple_location.block]
-        .push_back(visible_tuple_location.offset);
-  }
-
-  // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
-
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
-    if (column_ids_.size() != 0) {
-      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
-    }
-
-    result_.push_back(logical_tile.release());
-  }
-
-  done_ = true;
-
-  LOG_TRACE("Result tiles : %lu", result_.size());
+  BuildResultTiles(visible_tuple_locations);
 
   return true;
 }
 
-bool IndexScanExecutor::ExecSecondaryIndexLookup() {
+bool IndexScanExecutor::ExecSecondaryIndexLookup(
+    const std::vector<ItemPointer *> &tuple_location_ptrs) {
   LOG_TRACE("ExecSecondaryIndexLookup");
   PL_ASSERT(!done_);
   PL_ASSERT(index_->GetIndexType() != IndexConstraintType::PRIMARY_KEY);
 
-  std::vector<ItemPointer *> tuple_location_ptrs;
-
   // Grab info from plan node
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    // Limit clause accelerate
-    if (limit_) {
-      // invoke index scan limit
-      if (!descend_) {
-        LOG_TRACE("ASCENDING SCAN LIMIT in Secondary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::FORWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-      } else {
-        LOG_TRACE("DESCENDING SCAN LIMIT in Secondary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::BACKWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-
-        if (tuple_location_ptrs.size() == 0) {
-          LOG_TRACE("2-Result size is %lu", tuple_location_ptrs.size());
-        }
-      }
-    }
-    // Normal SQL (without limit)
-    else {
-      LOG_TRACE("Index Scan in Primary Index");
-      index_->Scan(values_, key_column_ids_, expr_types_,
-                   ScanDirectionType::FORWARD, tuple_location_ptrs,
-                   &index_predicate_.GetConjunctionList()[0]);
-    }
-  }
-
-  if (tuple_location_ptrs.size() == 0) {
-    LOG_TRACE("no tuple is retrieved from index.");
-    return false;
-  }
-
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
   auto current_txn = executor_context_->GetTransaction();
+  auto dead_cid = transaction_manager.GetLastMaxCommittedCid();
 
   std::vector<ItemPointer> visible_tuple_locations;
-  std::map<oid_t, std::vector<oid_t>> visible_tuples;
   auto &manager = catalog::Manager::GetInstance();
 
   // Quickie Hack
@@ -427,7 +412,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // we got for each tuple and check whether its the same to avoid having
   // to go back to the catalog each time.
   oid_t last_block = INVALID_OID;
-  std::shared_ptr<storage::TileGroup> tile_group;
+  storage::TileGroup *tile_group = nullptr;
   storage::TileGroupHeader *tile_group_header = nullptr;
 
 #ifdef LOG_TRACE_ENABLED
@@ -435,11 +420,14 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   int num_blocks_reused = 0;
 #endif
 
+  size_t join_filter_probe_count = 0;
+  size_t join_filter_pass_count = 0;
+
   for (auto tuple_location_ptr : tuple_location_ptrs) {
     ItemPointer tuple_location = *tuple_location_ptr;
     if (tuple_location.block != last_block) {
-      tile_group = manager.GetTileGroup(tuple_location.block);
-      tile_group_header = tile_group.get()->GetHeader();
+      tile_group = manager.GetTileGroupRaw(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
     }
 #ifdef LOG_TRACE_ENABLED
     else
@@ -457,8 +445,13 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
     while (true) {
       ++chain_length;
 
-      auto visibility = transaction_manager.IsVisible(
-          current_txn, tile_group_header, tuple_location.offset);
+      // skip the per-tuple check if every version in the tile group is
+      // visible to the current transaction.
+      auto visibility =
+          tile_group_header->IsAllVisible(current_txn->GetBeginCommitId())
+              ? VisibilityType::OK
+              : transaction_manager.IsVisible(current_txn, tile_group_header,
+                                              tuple_location.offset);
 
       // if the tuple is deleted
       if (visibility == VisibilityType::DELETED) {
@@ -471,9 +464,14 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
+        // unlink the older versions no transaction observes anymore, while
+        // the header of the version is in the cache
+        transaction_manager.PruneVersionChain(
+            tile_group_header, tuple_location.offset, dead_cid);
+
         // Further check if the version has the secondary key
         expression::ContainerTuple<storage::TileGroup> candidate_tuple(
-            tile_group.get(), tuple_location.offset);
+            tile_group, tuple_location.offset);
 
         LOG_TRACE("candidate_tuple size: %s",
                   candidate_tuple.GetInfo().c_str());
@@ -495,6 +493,13 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           eval = predicate_->Evaluate(&candidate_tuple, nullptr,
                                       executor_context_).IsTrue();
         }
+        // skip the tuple if it can not join with the build side of a hash
+        // join.
+        if (eval == true && join_filter_ != nullptr) {
+          join_filter_probe_count++;
+          eval = PassesJoinFilter(tile_group, tuple_location.offset);
+          join_filter_pass_count += eval;
+        }
         // if passed evaluation, then perform write.
         if (eval == true) {
           auto res = transaction_manager.PerformRead(
@@ -536,8 +541,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupRaw(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
@@ -565,8 +570,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupRaw(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
       }
     }
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
@@ -576,9 +581,166 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
             num_tuples_examined, index_->GetName().c_str(), num_blocks_reused);
 #endif
 
+  RecordJoinFilterProbes(index_->GetMetadata()->GetDatabaseOid(),
+                         index_->GetMetadata()->GetTableOid(),
+                         join_filter_probe_count, join_filter_pass_count);
+
   // Check whether the boundaries satisfy the required condition
   CheckOpenRangeWithReturnedTuples(visible_tuple_locations);
 
+  BuildResultTiles(visible_tuple_locations);
+
+  return true;
+}
+
+bool IndexScanExecutor::ExecCoveringIndexLookup(
+    const std::vector<ItemPointer *> &tuple_location_ptrs,
+    const std::vector<type::Value> &key_values) {
+  LOG_TRACE("ExecCoveringIndexLookup");
+  PL_ASSERT(!done_);
+  PL_ASSERT(index_->IsCovering() == true);
+
+  // Grab info from plan node
+  bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  // The key of an entry holds the key columns, the included columns and the
+  // version hint, in that order
+  auto &indexed_columns = index_->GetKeySchema()->GetIndexedColumns();
+  oid_t key_column_count = index_->GetColumnCount();
+  PL_ASSERT(key_values.size() == tuple_location_ptrs.size() * key_column_count);
+
+  // The covered values of an entry are laid out as in the table, so that the
+  // key conditions and the predicate are checked as they are on the versions
+  storage::Tuple covered_tuple(table_->GetSchema(), true);
+  storage::MaskedTuple key_tuple(&covered_tuple, indexed_columns);
+
+  std::vector<ItemPointer> visible_tuple_locations;
+  std::vector<size_t> visible_entries;
+
+  size_t join_filter_probe_count = 0;
+  size_t join_filter_pass_count = 0;
+
+  for (size_t entry_itr = 0; entry_itr < tuple_location_ptrs.size();
+       entry_itr++) {
+    auto entry_values = key_values.begin() + entry_itr * key_column_count;
+
+    // There is an entry per version, so the visibility of the entry is the
+    // one of the version the hint locates and no chain is traversed
+    ItemPointer tuple_location =
+        index::Index::GetVersionHint(entry_values[key_column_count - 1]);
+    auto tile_group = manager.GetTileGroupRaw(tuple_location.block);
+    if (tile_group == nullptr) {
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+
+    auto visibility =
+        tile_group_header->IsAllVisible(current_txn->GetBeginCommitId())
+            ? VisibilityType::OK
+            : transaction_manager.IsVisible(current_txn, tile_group_header,
+                                            tuple_location.offset);
+    if (visibility != VisibilityType::OK) {
+      LOG_TRACE("Invisible entry: %u, %u", tuple_location.block,
+                tuple_location.offset);
+      continue;
+    }
+
+    for (oid_t column_itr = 0; column_itr < indexed_columns.size();
+         column_itr++) {
+      covered_tuple.SetValue(indexed_columns[column_itr],
+                             entry_values[column_itr],
+                             executor_context_->GetPool());
+    }
+
+    // The whole range is scanned, the conditions are checked on every key
+    if (index_->Compare(key_tuple, key_column_ids_, expr_types_, values_) ==
+        false) {
+      continue;
+    }
+
+    bool eval = true;
+    // if having predicate, then perform evaluation.
+    if (predicate_ != nullptr) {
+      if (index_only_ == true) {
+        eval = predicate_->Evaluate(&covered_tuple, nullptr, executor_context_)
+                   .IsTrue();
+      } else {
+        expression::ContainerTuple<storage::TileGroup> tuple(
+            tile_group, tuple_location.offset);
+        eval =
+            predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+      }
+    }
+    // skip the tuple if it can not join with the build side of a hash
+    // join.
+    if (eval == true && join_filter_ != nullptr) {
+      join_filter_probe_count++;
+      eval = PassesJoinFilter(tile_group, tuple_location.offset);
+      join_filter_pass_count += eval;
+    }
+    // if passed evaluation, then perform read.
+    if (eval == true) {
+      auto res = transaction_manager.PerformRead(current_txn, tuple_location,
+                                                 acquire_owner);
+      if (!res) {
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 ResultType::FAILURE);
+        LOG_TRACE("passed evaluation, but txn read fails");
+        return res;
+      }
+      visible_tuple_locations.push_back(tuple_location);
+      visible_entries.push_back(entry_itr);
+    }
+  }
+
+  RecordJoinFilterProbes(index_->GetMetadata()->GetDatabaseOid(),
+                         index_->GetMetadata()->GetTableOid(),
+                         join_filter_probe_count, join_filter_pass_count);
+
+  if (index_only_ == false) {
+    BuildResultTiles(visible_tuple_locations);
+    return true;
+  }
+
+  if (visible_entries.empty() == true) {
+    return true;
+  }
+
+  // The output columns are copied out of the keys into a temporary tile
+  std::vector<oid_t> output_key_columns;
+  for (auto column_id : column_ids_) {
+    output_key_columns.push_back(index_->TupleColumnToKeyColumn(column_id));
+  }
+
+  std::shared_ptr<storage::Tile> dest_tile(storage::TileFactory::GetTempTile(
+      *index_only_schema_, visible_entries.size()));
+  oid_t tuple_id = 0;
+  for (auto entry_itr : visible_entries) {
+    auto entry_values = key_values.begin() + entry_itr * key_column_count;
+    for (oid_t column_itr = 0; column_itr < output_key_columns.size();
+         column_itr++) {
+      dest_tile->SetValue(entry_values[output_key_columns[column_itr]],
+                          tuple_id, column_itr);
+    }
+    tuple_id++;
+  }
+
+  result_.push_back(LogicalTileFactory::WrapTiles({dest_tile}));
+
+  LOG_TRACE("Result tiles : %lu", result_.size());
+
+  return true;
+}
+
+void IndexScanExecutor::BuildResultTiles(
+    const std::vector<ItemPointer> &visible_tuple_locations) {
+  std::map<oid_t, std::vector<oid_t>> visible_tuples;
   for (auto &visible_tuple_location : visible_tuple_locations) {
     visible_tuples[visible_tuple_location.block]
         .push_back(visible_tuple_location.offset);
@@ -587,7 +749,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
+    auto tile_group = manager.GetTileGroupRaw(tuples.first);
 
     std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
     // Add relevant columns to logical tile
@@ -600,11 +762,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
     result_.push_back(logical_tile.release());
   }
 
-  done_ = true;
-
   LOG_TRACE("Result tiles : %lu", result_.size());
-
-  return true;
 }
 
 void IndexScanExecutor::CheckOpenRangeWithReturnedTuples(
@@ -620,13 +778,15 @@ void IndexScanExecutor::CheckOpenRangeWithReturnedTuples(
       tuple_locations.erase(tuple_location_itr);
   }
 
-  while (right_open_) {
+  // Any batch may be the last one, so the tail of each is pruned
+  bool right_open = right_open_;
+  while (right_open) {
     LOG_TRACE("Range right open!");
     auto tuple_location_itr = tuple_locations.rbegin();
 
     if (tuple_location_itr == tuple_locations.rend() ||
         CheckKeyConditions(*tuple_location_itr) == true)
-      right_open_ = false;
+      right_open = false;
     else
       tuple_locations.pop_back();
   }
@@ -641,8 +801,8 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
 
   auto &manager = catalog::Manager::GetInstance();
 
-  auto tile_group = manager.GetTileGroup(tuple_location.block);
-  expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+  auto tile_group = manager.GetTileGroupRaw(tuple_location.block);
+  expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
                                                        tuple_location.offset);
 
   // This is the end of loop
@@ -828,6 +988,8 @@ void IndexScanExecutor::UpdatePredicate(
 void IndexScanExecutor::ResetState() {
   result_.clear();
 
+  scan_cursor_.reset();
+
   result_itr_ = START_OID;
 
   done_ = false;
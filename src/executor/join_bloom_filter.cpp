@@ -0,0 +1,31 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_bloom_filter.cpp
+//
+// Identification: src/executor/join_bloom_filter.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/join_bloom_filter.h"
+
+namespace peloton {
+namespace executor {
+
+const size_t JoinBloomFilter::bits_per_key;
+
+JoinBloomFilter::JoinBloomFilter(size_t key_count) {
+  // A power of two number of words, for the offset to be a mask
+  size_t word_count = 1;
+  while (word_count * 64 < key_count * bits_per_key) {
+    word_count <<= 1;
+  }
+  word_mask_ = word_count - 1;
+  words_.assign(word_count, 0);
+}
+
+}  // namespace executor
+}  // namespace peloton
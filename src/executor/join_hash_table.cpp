@@ -0,0 +1,194 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_hash_table.cpp
+//
+// Identification: src/executor/join_hash_table.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/join_hash_table.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "executor/logical_tile.h"
+#include "storage/tile_group.h"
+#include "type/value.h"
+#include "type/value_peeker.h"
+
+namespace peloton {
+namespace executor {
+
+namespace {
+
+/** Upper bound of the number of radix bits. */
+const size_t max_partition_bits = 12;
+
+// finalizer of MurmurHash3
+inline uint64_t Mix(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/**
+ * Hash of a value. Numbers that compare equal hash the same whatever their
+ * type, so that an INTEGER key can be joined with a BIGINT or DECIMAL one.
+ */
+uint64_t HashValue(const type::Value &value) {
+  if (value.IsNull()) {
+    return 0;
+  }
+
+  switch (value.GetTypeId()) {
+    case type::Type::BOOLEAN:
+      return type::ValuePeeker::PeekBoolean(value);
+    case type::Type::TINYINT:
+      return (uint64_t)type::ValuePeeker::PeekTinyInt(value);
+    case type::Type::SMALLINT:
+      return (uint64_t)type::ValuePeeker::PeekSmallInt(value);
+    case type::Type::INTEGER:
+      return (uint64_t)type::ValuePeeker::PeekInteger(value);
+    case type::Type::BIGINT:
+      return (uint64_t)type::ValuePeeker::PeekBigInt(value);
+    case type::Type::DECIMAL: {
+      double decimal = type::ValuePeeker::PeekDouble(value);
+      if (decimal == std::floor(decimal) && std::fabs(decimal) < 9.2e18) {
+        return (uint64_t)(int64_t)decimal;
+      }
+      uint64_t bits;
+      memcpy(&bits, &decimal, sizeof(bits));
+      return bits;
+    }
+    case type::Type::TIMESTAMP:
+      return type::ValuePeeker::PeekTimestamp(value);
+    default:
+      return value.Hash();
+  }
+}
+
+template <class ContainerType>
+uint64_t HashKeyImpl(ContainerType *container, oid_t tuple_id,
+                     const std::vector<oid_t> &column_ids) {
+  uint64_t hash = 0;
+  for (oid_t column_id : column_ids) {
+    hash = Mix(hash ^ HashValue(container->GetValue(tuple_id, column_id)));
+  }
+  return hash;
+}
+
+size_t NextPowerOfTwo(size_t size) {
+  size_t power = 1;
+  while (power < size) {
+    power <<= 1;
+  }
+  return power;
+}
+
+}  // namespace
+
+const size_t JoinHashTable::l2_cache_size;
+
+const size_t JoinHashTable::prefetch_distance;
+
+const uint32_t JoinHashTable::INVALID_ENTRY;
+
+uint64_t JoinHashTable::HashKey(LogicalTile *tile, oid_t tuple_id,
+                                const std::vector<oid_t> &column_ids) {
+  return HashKeyImpl(tile, tuple_id, column_ids);
+}
+
+uint64_t JoinHashTable::HashKey(storage::TileGroup *tile_group,
+                                oid_t tuple_id,
+                                const std::vector<oid_t> &column_ids) {
+  return HashKeyImpl(tile_group, tuple_id, column_ids);
+}
+
+/**
+ * Same comparison as the one of ContainerTupleComparator.
+ */
+bool JoinHashTable::KeysEqual(LogicalTile *left_tile, oid_t left_tuple_id,
+                              const std::vector<oid_t> &left_column_ids,
+                              LogicalTile *right_tile, oid_t right_tuple_id,
+                              const std::vector<oid_t> &right_column_ids) {
+  PL_ASSERT(left_column_ids.size() == right_column_ids.size());
+  for (size_t column_itr = 0; column_itr < left_column_ids.size();
+       column_itr++) {
+    type::Value lhs =
+        left_tile->GetValue(left_tuple_id, left_column_ids[column_itr]);
+    type::Value rhs =
+        right_tile->GetValue(right_tuple_id, right_column_ids[column_itr]);
+    if (lhs.CompareNotEquals(rhs) == type::CMP_TRUE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void JoinHashTable::Clear() {
+  partition_bits_ = 0;
+  entries_.clear();
+  partitions_.clear();
+  slots_.clear();
+}
+
+/**
+ * @brief Chooses the number of partitions so that the table of a partition
+ * fits in the L2 cache, then radix partitions the entries.
+ */
+void JoinHashTable::PartitionEntries() {
+  // Tables are at most half full
+  size_t table_size =
+      NextPowerOfTwo(std::max(entries_.size() * 2, (size_t)2)) * sizeof(Slot);
+  partition_bits_ = 0;
+  while ((table_size >> partition_bits_) > l2_cache_size &&
+         partition_bits_ < max_partition_bits) {
+    partition_bits_++;
+  }
+
+  size_t partition_count = (size_t)1 << partition_bits_;
+  std::vector<size_t> histogram(partition_count, 0);
+  if (partition_bits_ > 0) {
+    for (auto &entry : entries_) {
+      histogram[entry.hash >> (64 - partition_bits_)]++;
+    }
+
+    // Scatter the entries, keeping their order within a partition
+    std::vector<size_t> offsets(partition_count, 0);
+    for (size_t partition_itr = 1; partition_itr < partition_count;
+         partition_itr++) {
+      offsets[partition_itr] =
+          offsets[partition_itr - 1] + histogram[partition_itr - 1];
+    }
+    std::vector<Entry> partitioned_entries(entries_.size());
+    for (auto &entry : entries_) {
+      partitioned_entries[offsets[entry.hash >> (64 - partition_bits_)]++] =
+          entry;
+    }
+    entries_.swap(partitioned_entries);
+  } else {
+    histogram[0] = entries_.size();
+  }
+
+  partitions_.resize(partition_count);
+  size_t slot_count = 0;
+  for (size_t partition_itr = 0; partition_itr < partition_count;
+       partition_itr++) {
+    size_t capacity =
+        NextPowerOfTwo(std::max(histogram[partition_itr] * 2, (size_t)2));
+    partitions_[partition_itr].slot_offset = slot_count;
+    partitions_[partition_itr].mask = capacity - 1;
+    slot_count += capacity;
+  }
+  slots_.assign(slot_count, Slot{0, 0});
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -171,7 +171,7 @@ type::Value LogicalTile::GetValue(oid_t tuple_id, oid_t column_id) {
 
   if (base_tuple_id == NULL_OID) {
     return type::ValueFactory::GetNullValueByType(
-        base_tile->GetSchema()->GetType(column_id));
+        base_tile->GetSchema()->GetType(cp.origin_column_id));
   } else {
     return base_tile->GetValue(base_tuple_id, cp.origin_column_id);
   }
@@ -396,6 +396,15 @@ void LogicalTile::AddColumn(const std::shared_ptr<storage::Tile> &base_tile,
 void LogicalTile::AddColumns(
     const std::shared_ptr<storage::TileGroup> &tile_group,
     const std::vector<oid_t> &column_ids) {
+  AddColumns(tile_group.get(), column_ids);
+}
+
+/**
+ * @brief Adds the columns of a tile group, the logical tile keeping references
+ * on its tiles only.
+ */
+void LogicalTile::AddColumns(storage::TileGroup *tile_group,
+                             const std::vector<oid_t> &column_ids) {
   const int position_list_idx = 0;
   for (oid_t origin_column_id : column_ids) {
     oid_t base_tile_offset, tile_column_id;
@@ -434,57 +443,51 @@ std::vector<std::vector<std::string>> LogicalTile::GetAllValuesAsStrings(
     const std::vector<int> &result_format, bool use_to_string_null) {
   std::vector<std::vector<std::string>> string_tile;
   for (oid_t tuple_itr = 0; tuple_itr < total_tuples_; tuple_itr++) {
-    std::vector<std::string> row;
-    std::string empty_string;
     if (visible_rows_[tuple_itr] == false) continue;
-    for (oid_t column_itr = 0; column_itr < schema_.size(); column_itr++) {
-      const LogicalTile::ColumnInfo &cp = schema_[column_itr];
-      oid_t base_tuple_id = position_lists_[cp.position_list_idx][tuple_itr];
-      // get the value from the base physical tile
-      type::Value val;
-      if (base_tuple_id == NULL_OID) {
-        val = type::ValueFactory::GetNullValueByType(
-            cp.base_tile->GetSchema()->GetType(cp.origin_column_id));
-      } else {
-        val = cp.base_tile->GetValue(base_tuple_id, cp.origin_column_id);
-      }
+    string_tile.push_back(
+        GetValuesAsStrings(tuple_itr, result_format, use_to_string_null));
+  }
+  return string_tile;
+}
 
-      // LM: I put varchar here because we don't need to do endian conversion
-      // for them, and assuming binary and text for a varchar are the same.
-      if (result_format[column_itr] == 0 ||
-          cp.base_tile->GetSchema()->GetType(cp.origin_column_id) ==
-              type::Type::VARCHAR) {
-        // don't let to_string function decide what NULL value is
-        if (use_to_string_null == false && val.IsNull() == true) {
-          // materialize Null values as 0B string
-          row.push_back(empty_string);
-        } else {
-          // otherwise, materialize using ToString
-          row.push_back(val.ToString());
-        }
+std::vector<std::string> LogicalTile::GetValuesAsStrings(
+    const oid_t tuple_id, const std::vector<int> &result_format,
+    bool use_to_string_null) {
+  std::vector<std::string> row;
+  for (oid_t column_itr = 0; column_itr < schema_.size(); column_itr++) {
+    type::Value val = GetValue(tuple_id, column_itr);
+    const LogicalTile::ColumnInfo &cp = schema_[column_itr];
+
+    // LM: I put varchar here because we don't need to do endian conversion
+    // for them, and assuming binary and text for a varchar are the same.
+    if (result_format[column_itr] == 0 ||
+        cp.base_tile->GetSchema()->GetType(cp.origin_column_id) ==
+            type::Type::VARCHAR) {
+      // don't let to_string function decide what NULL value is
+      if (use_to_string_null == false && val.IsNull() == true) {
+        // materialize Null values as 0B string
+        row.push_back(std::string());
       } else {
-        auto data_length =
-            cp.base_tile->GetSchema()->GetLength(cp.origin_column_id);
-        LOG_TRACE("data length: %ld", data_length);
-        char *val_binary = new char[data_length];
-        bool is_inlined = false;
-
-        val.SerializeTo(val_binary, is_inlined, nullptr);
-
-        // convert little endian to big endian...
-        // TODO: This is stupid.... But I think this hack is fine for now.
-        for (size_t i = 0; i < (data_length >> 1); ++i) {
-          auto tmp_char = val_binary[i];
-          val_binary[i] = val_binary[data_length - i - 1];
-          val_binary[data_length - i - 1] = tmp_char;
-        }
-
-        row.push_back(std::string(val_binary, data_length));
+        // otherwise, materialize using ToString
+        row.push_back(val.ToString());
       }
+    } else {
+      auto data_length =
+          cp.base_tile->GetSchema()->GetLength(cp.origin_column_id);
+      LOG_TRACE("data length: %ld", data_length);
+      std::string val_binary(data_length, 0);
+      bool is_inlined = false;
+
+      val.SerializeTo(&val_binary[0], is_inlined, nullptr);
+
+      // convert little endian to big endian...
+      // TODO: This is stupid.... But I think this hack is fine for now.
+      std::reverse(val_binary.begin(), val_binary.end());
+
+      row.push_back(std::move(val_binary));
     }
-    string_tile.push_back(row);
   }
-  return string_tile;
+  return row;
 }
 
 const std::string LogicalTile::GetInfo() const {
@@ -0,0 +1,536 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partitioned_aggregator.cpp
+//
+// Identification: src/executor/partitioned_aggregator.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/partitioned_aggregator.h"
+
+#include <cstring>
+
+#include "common/container_tuple.h"
+#include "common/init.h"
+#include "common/logger.h"
+#include "common/thread_pool.h"
+#include "executor/logical_tile.h"
+#include "storage/tile.h"
+#include "type/value_peeker.h"
+
+namespace peloton {
+namespace executor {
+
+namespace {
+
+/** Number of bits of the hash selecting the partition of a group. */
+const size_t partition_bits = 4;
+
+static_assert(PartitionedHashAggregator::partition_count ==
+                  (1 << partition_bits),
+              "partition count must match the partition bits");
+
+bool IsFixedWidthKeyType(type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+    case type::Type::DECIMAL:
+    case type::Type::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The raw bits of a non-NULL fixed-width value
+uint64_t EncodeKeyValue(const type::Value &value) {
+  switch (value.GetTypeId()) {
+    case type::Type::BOOLEAN:
+      return type::ValuePeeker::PeekBoolean(value);
+    case type::Type::TINYINT:
+      return (uint64_t)type::ValuePeeker::PeekTinyInt(value);
+    case type::Type::SMALLINT:
+      return (uint64_t)type::ValuePeeker::PeekSmallInt(value);
+    case type::Type::INTEGER:
+      return (uint64_t)type::ValuePeeker::PeekInteger(value);
+    case type::Type::BIGINT:
+      return (uint64_t)type::ValuePeeker::PeekBigInt(value);
+    case type::Type::DECIMAL: {
+      // -0.0 and 0.0 are the same group
+      double decimal = type::ValuePeeker::PeekDouble(value);
+      if (decimal == 0) {
+        decimal = 0;
+      }
+      uint64_t bits;
+      memcpy(&bits, &decimal, sizeof(bits));
+      return bits;
+    }
+    case type::Type::TIMESTAMP:
+      return type::ValuePeeker::PeekTimestamp(value);
+    default:
+      throw Exception("Unsupported group-by key type " +
+                      TypeIdToString(value.GetTypeId()));
+  }
+}
+
+uint64_t HashKey(const uint64_t *key, size_t key_width) {
+  uint64_t hash = 0x9E3779B97F4A7C15ULL * (key_width + 1);
+  for (size_t i = 0; i < key_width; i++) {
+    hash ^= key[i];
+    // finalizer of MurmurHash3
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+  }
+  return hash;
+}
+
+}  // namespace
+
+//===--------------------------------------------------------------------===//
+// Group Table
+//===--------------------------------------------------------------------===//
+
+/**
+ * Open-addressing hash table over the encoded keys of the groups of a
+ * partition. The keys, hashes, aggregate states and delegate values of the
+ * groups are stored in flat arrays indexed by the id of the group.
+ */
+class PartitionedHashAggregator::GroupTable {
+ public:
+  GroupTable(size_t key_width, size_t agg_count, size_t num_input_columns)
+      : key_width_(key_width),
+        agg_count_(agg_count),
+        num_input_columns_(num_input_columns) {}
+
+  size_t GetGroupCount() const { return hashes_.size(); }
+
+  /**
+   * @brief Finds the group of the key, adding it if it is not there.
+   * @return The id of the group.
+   */
+  size_t FindOrInsert(const uint64_t *key, uint64_t hash, bool &inserted) {
+    if ((hashes_.size() + 1) * 2 > slots_.size()) {
+      Grow();
+    }
+
+    size_t mask = slots_.size() - 1;
+    size_t slot = hash & mask;
+    while (slots_[slot] != 0) {
+      size_t group = slots_[slot] - 1;
+      if (hashes_[group] == hash &&
+          memcmp(&keys_[group * key_width_], key,
+                 key_width_ * sizeof(uint64_t)) == 0) {
+        inserted = false;
+        return group;
+      }
+      slot = (slot + 1) & mask;
+    }
+
+    size_t group = hashes_.size();
+    slots_[slot] = group + 1;
+    hashes_.push_back(hash);
+    keys_.insert(keys_.end(), key, key + key_width_);
+    states_.resize(states_.size() + agg_count_);
+    first_values_.resize(first_values_.size() + num_input_columns_);
+    inserted = true;
+    return group;
+  }
+
+  const uint64_t *GetKey(size_t group) const {
+    return &keys_[group * key_width_];
+  }
+
+  uint64_t GetHash(size_t group) const { return hashes_[group]; }
+
+  AggregateState *GetStates(size_t group) {
+    return &states_[group * agg_count_];
+  }
+
+  type::Value *GetFirstValues(size_t group) {
+    return &first_values_[group * num_input_columns_];
+  }
+
+ private:
+  void Grow() {
+    std::vector<uint32_t> slots(std::max(slots_.size() * 2, (size_t)16), 0);
+    size_t mask = slots.size() - 1;
+    for (size_t group = 0; group < hashes_.size(); group++) {
+      size_t slot = hashes_[group] & mask;
+      while (slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+      }
+      slots[slot] = group + 1;
+    }
+    slots_.swap(slots);
+  }
+
+  const size_t key_width_;
+
+  const size_t agg_count_;
+
+  const size_t num_input_columns_;
+
+  // Id of the group + 1 of the slots, 0 if the slot is empty
+  std::vector<uint32_t> slots_;
+
+  std::vector<uint64_t> hashes_;
+
+  std::vector<uint64_t> keys_;
+
+  std::vector<AggregateState> states_;
+
+  std::vector<type::Value> first_values_;
+};
+
+//===--------------------------------------------------------------------===//
+// Partitioned Hash Aggregator
+//===--------------------------------------------------------------------===//
+
+const size_t PartitionedHashAggregator::partition_count;
+
+PartitionedHashAggregator::PartitionedHashAggregator(
+    const planner::AggregatePlan *node, storage::AbstractTable *output_table,
+    executor::ExecutorContext *econtext, size_t num_input_columns)
+    : AbstractAggregator(node, output_table, econtext),
+      num_input_columns_(num_input_columns),
+      // one word per column and a NULL bitmap
+      key_width_(node->GetGroupbyColIds().size() + 1) {
+  PL_ASSERT(node->GetGroupbyColIds().size() < 64);
+}
+
+PartitionedHashAggregator::~PartitionedHashAggregator() {}
+
+/**
+ * @brief Checks that the aggregates have no DISTINCT and that the group-by
+ * columns of the tile have a fixed-width type.
+ */
+bool PartitionedHashAggregator::IsSupported(const planner::AggregatePlan *node,
+                                            const LogicalTile *tile) {
+  for (auto &agg_term : node->GetUniqueAggTerms()) {
+    if (agg_term.distinct) {
+      return false;
+    }
+  }
+
+  auto &group_by_columns = node->GetGroupbyColIds();
+  if (group_by_columns.size() == 0 || group_by_columns.size() >= 64) {
+    return false;
+  }
+
+  for (oid_t column_id : group_by_columns) {
+    auto &column_info = tile->GetColumnInfo(column_id);
+    auto type_id = column_info.base_tile->GetSchema()->GetType(
+        column_info.origin_column_id);
+    if (IsFixedWidthKeyType(type_id) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+PartitionedHashAggregator::PartitionedTable &
+PartitionedHashAggregator::GetWorkerTable(size_t worker) {
+  PL_ASSERT(worker < worker_tables_.size());
+  if (worker_tables_[worker] == nullptr) {
+    worker_tables_[worker].reset(new PartitionedTable(
+        partition_count,
+        GroupTable(key_width_, node->GetUniqueAggTerms().size(),
+                   num_input_columns_)));
+  }
+  return *worker_tables_[worker];
+}
+
+size_t PartitionedHashAggregator::GetGroupCount() const {
+  size_t group_count = 0;
+  for (auto &table : worker_tables_) {
+    if (table == nullptr) {
+      continue;
+    }
+    for (auto &partition : *table) {
+      group_count += partition.GetGroupCount();
+    }
+  }
+  return group_count;
+}
+
+/**
+ * @brief Aggregates a tuple into the table of a worker.
+ * @param key Buffer for the encoded key.
+ */
+void PartitionedHashAggregator::AdvanceTuple(PartitionedTable &table,
+                                             AbstractTuple *tuple,
+                                             std::vector<uint64_t> &key) {
+  auto &group_by_columns = node->GetGroupbyColIds();
+  auto &agg_terms = node->GetUniqueAggTerms();
+
+  // Encode the group-by key
+  uint64_t nulls = 0;
+  for (size_t column_itr = 0; column_itr < group_by_columns.size();
+       column_itr++) {
+    type::Value value = tuple->GetValue(group_by_columns[column_itr]);
+    if (value.IsNull()) {
+      nulls |= (1ULL << column_itr);
+      key[column_itr] = 0;
+    } else {
+      key[column_itr] = EncodeKeyValue(value);
+    }
+  }
+  key[group_by_columns.size()] = nulls;
+
+  uint64_t hash = HashKey(key.data(), key_width_);
+  auto &partition = table[hash >> (64 - partition_bits)];
+
+  bool inserted;
+  size_t group = partition.FindOrInsert(key.data(), hash, inserted);
+
+  // Keep a deep copy of the first tuple we met of this group
+  if (inserted) {
+    type::Value *first_values = partition.GetFirstValues(group);
+    for (size_t col_id = 0; col_id < num_input_columns_; col_id++) {
+      first_values[col_id] = tuple->GetValue(col_id);
+    }
+  }
+
+  AggregateState *states = partition.GetStates(group);
+  for (oid_t aggno = 0; aggno < agg_terms.size(); aggno++) {
+    auto expression = agg_terms[aggno].expression;
+    if (expression == nullptr) {
+      AdvanceState(states[aggno], aggno, type::ValueFactory::GetIntegerValue(1));
+    } else {
+      AdvanceState(states[aggno], aggno,
+                   expression->Evaluate(tuple, nullptr, executor_context));
+    }
+  }
+}
+
+/**
+ * @brief Same as the Advance of the matching attribute aggregator.
+ */
+void PartitionedHashAggregator::AdvanceState(AggregateState &state,
+                                             oid_t aggno,
+                                             const type::Value &value) const {
+  switch (node->GetUniqueAggTerms()[aggno].aggtype) {
+    case ExpressionType::AGGREGATE_COUNT_STAR:
+      state.count++;
+      return;
+    case ExpressionType::AGGREGATE_COUNT:
+      if (!value.IsNull()) {
+        state.count++;
+      }
+      return;
+    default:
+      break;
+  }
+
+  if (value.IsNull()) {
+    return;
+  }
+  if (state.count == 0) {
+    state.value = value.Copy();
+  } else {
+    switch (node->GetUniqueAggTerms()[aggno].aggtype) {
+      case ExpressionType::AGGREGATE_SUM:
+      case ExpressionType::AGGREGATE_AVG:
+        state.value = state.value.Add(value);
+        break;
+      case ExpressionType::AGGREGATE_MIN:
+        state.value = state.value.Min(value);
+        break;
+      case ExpressionType::AGGREGATE_MAX:
+        state.value = state.value.Max(value);
+        break;
+      default: {
+        auto agg_type = node->GetUniqueAggTerms()[aggno].aggtype;
+        throw UnknownTypeException(
+            static_cast<int>(agg_type),
+            "Unknown aggregate type " + ExpressionTypeToString(agg_type));
+      }
+    }
+  }
+  state.count++;
+}
+
+/**
+ * @brief Adds the partial aggregate of another worker to the state.
+ */
+void PartitionedHashAggregator::CombineState(AggregateState &state,
+                                             AggregateState &other,
+                                             oid_t aggno) const {
+  auto agg_type = node->GetUniqueAggTerms()[aggno].aggtype;
+  if (other.count == 0) {
+    return;
+  }
+  if (state.count == 0 || agg_type == ExpressionType::AGGREGATE_COUNT ||
+      agg_type == ExpressionType::AGGREGATE_COUNT_STAR) {
+    if (state.count == 0) {
+      state.value = std::move(other.value);
+    }
+    state.count += other.count;
+    return;
+  }
+
+  switch (agg_type) {
+    case ExpressionType::AGGREGATE_SUM:
+    case ExpressionType::AGGREGATE_AVG:
+      state.value = state.value.Add(other.value);
+      break;
+    case ExpressionType::AGGREGATE_MIN:
+      state.value = state.value.Min(other.value);
+      break;
+    case ExpressionType::AGGREGATE_MAX:
+      state.value = state.value.Max(other.value);
+      break;
+    default:
+      throw UnknownTypeException(
+          static_cast<int>(agg_type),
+          "Unknown aggregate type " + ExpressionTypeToString(agg_type));
+  }
+  state.count += other.count;
+}
+
+/**
+ * @brief Same as the Finalize of the matching attribute aggregator.
+ */
+type::Value PartitionedHashAggregator::FinalizeState(AggregateState &state,
+                                                     oid_t aggno) const {
+  switch (node->GetUniqueAggTerms()[aggno].aggtype) {
+    case ExpressionType::AGGREGATE_COUNT:
+    case ExpressionType::AGGREGATE_COUNT_STAR:
+      return type::ValueFactory::GetBigIntValue(state.count);
+    case ExpressionType::AGGREGATE_AVG:
+      if (state.count == 0) {
+        return type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+      }
+      return state.value.Divide(
+          type::ValueFactory::GetDecimalValue(static_cast<double>(state.count)));
+    default:
+      if (state.count == 0) {
+        return type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+      }
+      return state.value;
+  }
+}
+
+bool PartitionedHashAggregator::Advance(AbstractTuple *cur_tuple) {
+  if (worker_tables_.empty()) {
+    worker_tables_.resize(1);
+  }
+  std::vector<uint64_t> key(key_width_);
+  AdvanceTuple(GetWorkerTable(0), cur_tuple, key);
+  return true;
+}
+
+/**
+ * @brief Pre-aggregates the tiles, each worker into its own table.
+ * @return true on success, false otherwise.
+ */
+bool PartitionedHashAggregator::AdvanceTiles(
+    std::vector<std::unique_ptr<LogicalTile>> &tiles) {
+  size_t worker_count = std::min(thread_pool.GetPoolSize() + 1, tiles.size());
+  if (worker_tables_.size() < worker_count) {
+    worker_tables_.resize(worker_count);
+  }
+
+  LOG_TRACE("Pre-aggregating %lu tiles with %lu workers", tiles.size(),
+            worker_count);
+  thread_pool.RunTasks(
+      worker_count, tiles.size(), [this, &tiles](size_t worker, size_t task) {
+        auto &table = GetWorkerTable(worker);
+        std::vector<uint64_t> key(key_width_);
+        LogicalTile *tile = tiles[task].get();
+        for (oid_t tuple_id : *tile) {
+          expression::ContainerTuple<LogicalTile> cur_tuple(tile, tuple_id);
+          AdvanceTuple(table, &cur_tuple, key);
+        }
+      });
+  return true;
+}
+
+/**
+ * @brief Merges a partition of the other workers into the same partition of
+ * the first worker.
+ */
+void PartitionedHashAggregator::MergePartition(size_t partition) {
+  auto &target = (*worker_tables_[0])[partition];
+  size_t agg_count = node->GetUniqueAggTerms().size();
+
+  for (size_t worker = 1; worker < worker_tables_.size(); worker++) {
+    if (worker_tables_[worker] == nullptr) {
+      continue;
+    }
+    auto &source = (*worker_tables_[worker])[partition];
+    for (size_t group = 0; group < source.GetGroupCount(); group++) {
+      bool inserted;
+      size_t target_group = target.FindOrInsert(
+          source.GetKey(group), source.GetHash(group), inserted);
+
+      AggregateState *states = target.GetStates(target_group);
+      AggregateState *source_states = source.GetStates(group);
+      if (inserted) {
+        std::move(source_states, source_states + agg_count, states);
+        std::move(source.GetFirstValues(group),
+                  source.GetFirstValues(group) + num_input_columns_,
+                  target.GetFirstValues(target_group));
+      } else {
+        for (oid_t aggno = 0; aggno < agg_count; aggno++) {
+          CombineState(states[aggno], source_states[aggno], aggno);
+        }
+      }
+    }
+  }
+}
+
+bool PartitionedHashAggregator::Finalize() {
+  if (worker_tables_.empty()) {
+    return true;
+  }
+  GetWorkerTable(0);
+
+  // Merge the partitions in parallel
+  if (worker_tables_.size() > 1) {
+    thread_pool.RunTasks(
+        std::min(thread_pool.GetPoolSize() + 1, partition_count),
+        partition_count,
+        [this](size_t, size_t partition) { MergePartition(partition); });
+  }
+  for (size_t worker = 1; worker < worker_tables_.size(); worker++) {
+    worker_tables_[worker].reset();
+  }
+
+  // Output the groups
+  size_t agg_count = node->GetUniqueAggTerms().size();
+  std::vector<type::Value> aggregate_values(agg_count);
+  std::vector<type::Value> first_tuple_values(num_input_columns_);
+  for (auto &partition : *worker_tables_[0]) {
+    for (size_t group = 0; group < partition.GetGroupCount(); group++) {
+      AggregateState *states = partition.GetStates(group);
+      for (oid_t aggno = 0; aggno < agg_count; aggno++) {
+        aggregate_values[aggno] = FinalizeState(states[aggno], aggno);
+      }
+
+      type::Value *first_values = partition.GetFirstValues(group);
+      first_tuple_values.assign(first_values,
+                                first_values + num_input_columns_);
+      expression::ContainerTuple<std::vector<type::Value>> first_tuple(
+          &first_tuple_values);
+      if (InsertAggregateTuple(node, aggregate_values, output_table,
+                               &first_tuple, executor_context) == false) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace executor
+}  // namespace peloton
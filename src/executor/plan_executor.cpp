@@ -34,24 +34,15 @@ executor::AbstractExecutor *BuildExecutorTree(
 
 void CleanExecutorTree(executor::AbstractExecutor *root);
 
-/**
- * @brief Build a executor tree and execute it.
- * Use std::vector<type::Value> as params to make it more elegant for
- * networking
- * Before ExecutePlan, a node first receives value list, so we should pass
- * value list directly rather than passing Postgres's ParamListInfo
- * @return status of execution.
- */
-peloton_status PlanExecutor::ExecutePlan(
-    const planner::AbstractPlan *plan, concurrency::Transaction *txn,
-    const std::vector<type::Value> &params, std::vector<StatementResult> &result,
-    const std::vector<int> &result_format) {
-  peloton_status p_status;
-  if (plan == nullptr) return p_status;
-
-  LOG_TRACE("PlanExecutor Start ");
-
-  bool status;
+PlanCursor::PlanCursor(const planner::AbstractPlan *plan,
+                       concurrency::Transaction *txn,
+                       const std::vector<type::Value> &params,
+                       const std::vector<int> &result_format)
+    : txn_(txn), result_format_(result_format) {
+  if (plan == nullptr) {
+    done_ = true;
+    return;
+  }
 
   PL_ASSERT(txn);
 
@@ -60,53 +51,101 @@ peloton_status PlanExecutor::ExecutePlan(
 
   // Use const std::vector<type::Value> &params to make it more elegant for
   // network
-  std::unique_ptr<executor::ExecutorContext> executor_context(
-      BuildExecutorContext(params, txn));
+  executor_context_.reset(BuildExecutorContext(params, txn));
 
   // Build the executor tree
-  std::unique_ptr<executor::AbstractExecutor> executor_tree(
-      BuildExecutorTree(nullptr, plan, executor_context.get()));
+  executor_tree_.reset(
+      BuildExecutorTree(nullptr, plan, executor_context_.get()));
+}
+
+PlanCursor::~PlanCursor() {
+  // clean up executor tree
+  CleanExecutorTree(executor_tree_.get());
+}
+
+bool PlanCursor::Init() {
+  // Nothing to run
+  if (executor_tree_ == nullptr) {
+    initialized_ = true;
+    return true;
+  }
 
   LOG_TRACE("Initializing the executor tree");
 
-  // Initialize the executor tree
-  status = executor_tree->Init();
+  initialized_ = executor_tree_->Init();
+  if (initialized_ == false) {
+    done_ = true;
+  }
+  return initialized_;
+}
 
-  if (status == true) {
-    LOG_TRACE("Running the executor tree");
-    result.clear();
+executor::LogicalTile *PlanCursor::FetchRows(const size_t max_rows,
+                                             std::vector<oid_t> &rows) {
+  PL_ASSERT(initialized_ == true || done_ == true);
+  rows.clear();
 
-    // Execute the tree until we get result tiles from root node
-    while (status == true) {
-      status = executor_tree->Execute();
-
-      std::unique_ptr<executor::LogicalTile> logical_tile(
-          executor_tree->GetOutput());
-      // Some executors don't return logical tiles (e.g., Update).
-      if (logical_tile.get() != nullptr) {
-        LOG_TRACE("Final Answer: %s",
-                  logical_tile->GetInfo().c_str());  // Printing the answers
-        std::vector<std::vector<std::string>> answer_tuples;
-        answer_tuples = std::move(
-            logical_tile->GetAllValuesAsStrings(result_format, false));
-
-        // Construct the returned results
-        for (auto &tuple : answer_tuples) {
-          unsigned int col_index = 0;
-          for (unsigned int i = 0; i < logical_tile->GetColumnCount(); i++) {
-            auto res = StatementResult();
-            PlanExecutor::copyFromTo(tuple[col_index++], res.second);
-            if (tuple[col_index - 1].c_str() != nullptr) {
-              LOG_TRACE("column content: %s", tuple[col_index - 1].c_str());
-            }
-            result.push_back(std::move(res));
-          }
-        }
+  // Run the tree until we get a logical tile with some rows in it
+  while (next_row_ == tile_rows_.size()) {
+    tile_.reset();
+    tile_rows_.clear();
+    next_row_ = 0;
+    if (done_ == true) return nullptr;
+
+    if (executor_tree_->Execute() == false) {
+      done_ = true;
+    }
+
+    tile_.reset(executor_tree_->GetOutput());
+    // Some executors don't return logical tiles (e.g., Update).
+    if (tile_.get() != nullptr) {
+      LOG_TRACE("Final Answer: %s",
+                tile_->GetInfo().c_str());  // Printing the answers
+      for (auto tuple_id : *tile_) {
+        tile_rows_.push_back(tuple_id);
       }
+      column_count_ = tile_->GetColumnCount();
     }
+  }
 
+  size_t row_count = tile_rows_.size() - next_row_;
+  if (max_rows != 0 && max_rows < row_count) {
+    row_count = max_rows;
+  }
+
+  rows.insert(rows.end(), tile_rows_.begin() + next_row_,
+              tile_rows_.begin() + next_row_ + row_count);
+  next_row_ += row_count;
+
+  return tile_.get();
+}
+
+size_t PlanCursor::FetchRows(const size_t max_rows,
+                             std::vector<StatementResult> &result) {
+  std::vector<oid_t> rows;
+  auto tile = FetchRows(max_rows, rows);
+  if (tile == nullptr) return 0;
+
+  // Construct the returned results
+  for (auto tuple_id : rows) {
+    auto tuple = tile->GetValuesAsStrings(tuple_id, result_format_, false);
+    for (auto &column : tuple) {
+      auto res = StatementResult();
+      PlanExecutor::copyFromTo(column, res.second);
+      LOG_TRACE("column content: %s", column.c_str());
+      result.push_back(std::move(res));
+    }
+  }
+
+  return rows.size();
+}
+
+peloton_status PlanCursor::GetStatus() const {
+  peloton_status p_status;
+  if (executor_context_ == nullptr) return p_status;
+
+  if (initialized_ == true) {
     // Set the result
-    p_status.m_processed = executor_context->num_processed;
+    p_status.m_processed = executor_context_->num_processed;
     // success so far
     p_status.m_result = ResultType::SUCCESS;
   } else {
@@ -114,11 +153,38 @@ peloton_status PlanExecutor::ExecutePlan(
   }
 
   p_status.m_result_slots = nullptr;
+  return p_status;
+}
 
-  // clean up executor tree
-  CleanExecutorTree(executor_tree.get());
+/**
+ * @brief Build a executor tree and execute it.
+ * Use std::vector<type::Value> as params to make it more elegant for
+ * networking
+ * Before ExecutePlan, a node first receives value list, so we should pass
+ * value list directly rather than passing Postgres's ParamListInfo
+ * @return status of execution.
+ */
+peloton_status PlanExecutor::ExecutePlan(
+    const planner::AbstractPlan *plan, concurrency::Transaction *txn,
+    const std::vector<type::Value> &params, std::vector<StatementResult> &result,
+    const std::vector<int> &result_format) {
+  if (plan == nullptr) return peloton_status();
 
-  return p_status;
+  LOG_TRACE("PlanExecutor Start ");
+
+  PlanCursor cursor(plan, txn, params, result_format);
+
+  if (cursor.Init() == true) {
+    LOG_TRACE("Running the executor tree");
+    result.clear();
+
+    // Execute the tree until we get result tiles from root node
+    while (cursor.IsDone() == false) {
+      cursor.FetchRows(0, result);
+    }
+  }
+
+  return cursor.GetStatus();
 }
 
 /**
@@ -340,6 +406,11 @@ executor::AbstractExecutor *BuildExecutorTree(
       child_executor = new executor::CopyExecutor(plan, executor_context);
       break;
 
+    case PlanNodeType::EXCHANGE:
+      LOG_TRACE("Adding Exchange Executer");
+      child_executor = new executor::ExchangeExecutor(plan, executor_context);
+      break;
+
     default:
       LOG_ERROR("Unsupported plan node type : %s",
                 PlanNodeTypeToString(plan_node_type).c_str());
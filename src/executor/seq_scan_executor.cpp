@@ -64,6 +64,12 @@ bool SeqScanExecutor::DInit() {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
       std::iota(column_ids_.begin(), column_ids_.end(), 0);
     }
+
+    // Evaluate the predicate batch-at-a-time if every node supports it
+    vectorized_predicate_ =
+        predicate_ != nullptr &&
+        predicate_->IsVectorizable(target_table_->GetSchema(),
+                                   executor_context_);
   }
 
   return true;
@@ -115,58 +121,14 @@ bool SeqScanExecutor::DExecute() {
     PL_ASSERT(target_table_ != nullptr);
     PL_ASSERT(column_ids_.size() > 0);
 
-    // Force to use occ txn manager if dirty read is forbidden
-    concurrency::TransactionManager &transaction_manager =
-        concurrency::TransactionManagerFactory::GetInstance();
-
-    bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
-    auto current_txn = executor_context_->GetTransaction();
-
     // Retrieve next tile group.
     while (current_tile_group_offset_ < table_tile_group_count_) {
+      std::vector<oid_t> position_list;
       auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
-      auto tile_group_header = tile_group->GetHeader();
-
-      oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+          ScanTileGroup(current_tile_group_offset_++, position_list);
 
-      // Construct position list by looping through tile group
-      // and applying the predicate.
-      std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-
-
-        auto visibility = transaction_manager.IsVisible(current_txn, tile_group_header, tuple_id);
-
-        // check transaction visibility
-        if (visibility == VisibilityType::OK) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
-            if (!res) {
-              transaction_manager.SetTransactionResult(current_txn, ResultType::FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
-              if (!res) {
-                transaction_manager.SetTransactionResult(current_txn, ResultType::FAILURE);
-                return res;
-              } else {
-                LOG_TRACE("Sequential Scan Predicate Satisfied");
-              }
-            }
-          }
-        }
+      if (PerformReads(tile_group, position_list) == false) {
+        return false;
       }
 
       // Don't return empty tiles
@@ -174,13 +136,7 @@ bool SeqScanExecutor::DExecute() {
         continue;
       }
 
-      // Construct logical tile.
-      std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-      logical_tile->AddColumns(tile_group, column_ids_);
-      logical_tile->AddPositionList(std::move(position_list));
-
-      LOG_TRACE("Information %s", logical_tile->GetInfo().c_str());
-      SetOutput(logical_tile.release());
+      SetOutput(BuildLogicalTile(tile_group, std::move(position_list)));
       return true;
     }
   }
@@ -188,5 +144,123 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+/**
+ * @brief Collects the visible tuples of a tile group that satisfy the scan
+ * predicate and pass the join filter.
+ * @param tile_group_offset Offset of the tile group in the table.
+ * @param position_list Filled with the ids of the qualifying tuples.
+ * @return The tile group, which is valid as long as the transaction runs.
+ */
+storage::TileGroup *SeqScanExecutor::ScanTileGroup(
+    const oid_t tile_group_offset, std::vector<oid_t> &position_list) const {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  auto tile_group = target_table_->GetTileGroupRaw(tile_group_offset);
+  auto tile_group_header = tile_group->GetHeader();
+
+  oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+  // Construct position list by looping through tile group
+  // and applying the predicate.
+  position_list.clear();
+
+  // Collect the visible tuples first.
+  std::vector<oid_t> visible_tuples;
+  transaction_manager.IsVisibleBatch(current_txn, tile_group_header, START_OID,
+                                     active_tuple_count, visible_tuples);
+
+  // Unlink the older versions of the tuples read that no transaction
+  // observes anymore. The tile groups whose versions are all visible are not
+  // updated, the GC threads take care of them.
+  if (tile_group_header->IsAllVisible(current_txn->GetBeginCommitId()) ==
+      false) {
+    auto dead_cid = transaction_manager.GetLastMaxCommittedCid();
+    for (oid_t tuple_id : visible_tuples) {
+      transaction_manager.PruneVersionChain(tile_group_header, tuple_id,
+                                            dead_cid);
+    }
+  }
+
+  if (vectorized_predicate_ == true) {
+    // Filter them all at once.
+    position_list = std::move(visible_tuples);
+    if (position_list.empty() == false) {
+      expression::TileGroupBatch batch(tile_group, executor_context_);
+      predicate_->FilterBatch(batch, position_list);
+    }
+  } else if (predicate_ == nullptr) {
+    position_list = std::move(visible_tuples);
+  } else {
+    for (oid_t tuple_id : visible_tuples) {
+      // if the tuple is visible, then perform predicate evaluation.
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
+                                                           tuple_id);
+      LOG_TRACE("Evaluate predicate for a tuple");
+      auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
+      LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
+      if (eval.IsTrue()) {
+        LOG_TRACE("Sequential Scan Predicate Satisfied");
+        position_list.push_back(tuple_id);
+      }
+    }
+  }
+
+  // Skip the tuples that can not join with the build side of a hash join
+  if (join_filter_ != nullptr) {
+    ApplyJoinFilter(tile_group, position_list);
+  }
+
+  return tile_group;
+}
+
+/**
+ * @brief Performs the reads of the qualifying tuples of a tile group for the
+ * transaction, acquiring their ownership if the scan is for update.
+ * @return false if a read failed, in which case the transaction fails.
+ */
+bool SeqScanExecutor::PerformReads(const storage::TileGroup *tile_group,
+                                   const std::vector<oid_t> &position_list) {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
+  auto current_txn = executor_context_->GetTransaction();
+
+  // a snapshot has no reads to record.
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return true;
+  }
+
+  for (oid_t tuple_id : position_list) {
+    ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+    auto res =
+        transaction_manager.PerformRead(current_txn, location, acquire_owner);
+    if (!res) {
+      transaction_manager.SetTransactionResult(current_txn,
+                                               ResultType::FAILURE);
+      return res;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Constructs the logical tile of the qualifying tuples of a tile
+ * group.
+ * @return The logical tile.
+ */
+LogicalTile *SeqScanExecutor::BuildLogicalTile(
+    storage::TileGroup *tile_group,
+    std::vector<oid_t> &&position_list) const {
+  std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+  logical_tile->AddColumns(tile_group, column_ids_);
+  logical_tile->AddPositionList(std::move(position_list));
+
+  LOG_TRACE("Information %s", logical_tile->GetInfo().c_str());
+  return logical_tile.release();
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -195,10 +195,20 @@ bool UpdateExecutor::DExecute() {
         // Make a copy of the original tuple and allocate a new tuple
         expression::ContainerTuple<storage::TileGroup> old_tuple(
             tile_group, physical_tuple_id);
+
+        // The version is updated in place, so are its covering index entries
+        ItemPointer *indirection =
+            tile_group_header->GetIndirection(physical_tuple_id);
+        target_table_->DeleteFromCoveringIndexes(&old_tuple, old_location,
+                                                 indirection);
+
         // Execute the projections
         project_info_->Evaluate(&old_tuple, &old_tuple, nullptr,
                                 executor_context_);
 
+        target_table_->InsertInCoveringIndexes(&old_tuple, old_location,
+                                               indirection);
+
         transaction_manager.PerformUpdate(current_txn, old_location);
       }
     }
@@ -269,9 +279,9 @@ bool UpdateExecutor::DExecute() {
           ItemPointer *indirection =
               tile_group_header->GetIndirection(old_location.offset);
           // finally install new version into the table
-          ret = target_table_->InstallVersion(&new_tuple,
-                                              &(project_info_->GetTargetList()),
-                                              current_txn, indirection);
+          ret = target_table_->InstallVersion(
+              &new_tuple, &(project_info_->GetTargetList()), current_txn,
+              indirection, new_location);
 
           // PerformUpdate() will not be executed if the insertion failed.
           // There is a write lock acquired, but since it is not in the write
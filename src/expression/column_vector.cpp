@@ -0,0 +1,403 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_vector.cpp
+//
+// Identification: src/expression/column_vector.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/column_vector.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// Value Vector
+//===----------------------------------------------------------------------===//
+
+void ValueVector::Reset(type::Type::TypeId type, size_t count) {
+  type_id = type;
+  is_constant = false;
+  if (type == type::Type::DECIMAL) {
+    decimals.resize(count);
+    integers.clear();
+  } else {
+    integers.resize(count);
+    decimals.clear();
+  }
+  nulls.assign(count, 0);
+}
+
+void ValueVector::SetConstant(const type::Value &value) {
+  Reset(value.GetTypeId(), 1);
+  is_constant = true;
+  nulls[0] = value.IsNull();
+  if (value.IsNull()) {
+    return;
+  }
+
+  switch (value.GetTypeId()) {
+    case type::Type::TINYINT:
+      integers[0] = value.GetAs<int8_t>();
+      break;
+    case type::Type::SMALLINT:
+      integers[0] = value.GetAs<int16_t>();
+      break;
+    case type::Type::INTEGER:
+      integers[0] = value.GetAs<int32_t>();
+      break;
+    case type::Type::BIGINT:
+      integers[0] = value.GetAs<int64_t>();
+      break;
+    case type::Type::TIMESTAMP:
+      integers[0] = static_cast<int64_t>(value.GetAs<uint64_t>());
+      break;
+    case type::Type::DECIMAL:
+      decimals[0] = value.GetAs<double>();
+      break;
+    default:
+      throw Exception(EXCEPTION_TYPE_MISMATCH_TYPE,
+                      "Type " + TypeIdToString(value.GetTypeId()) +
+                          " is not supported by vectorized evaluation.");
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Tile Group Batch
+//===----------------------------------------------------------------------===//
+
+ColumnVector TileGroupBatch::GetColumn(const oid_t column_id) const {
+  oid_t tile_offset, tile_column_offset;
+  tile_group_->LocateTileAndColumn(column_id, tile_offset, tile_column_offset);
+
+  auto tile = tile_group_->GetTile(tile_offset);
+  auto tile_schema = tile->GetSchema();
+
+  ColumnVector column;
+  column.base =
+      tile->GetTupleLocation(0) + tile_schema->GetOffset(tile_column_offset);
+  column.stride = tile_schema->GetLength();
+  column.type_id = tile_schema->GetType(tile_column_offset);
+  return column;
+}
+
+//===----------------------------------------------------------------------===//
+// Vectorized Kernels
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+template <typename T>
+void GatherIntegers(const ColumnVector &column,
+                    const SelectionVector &selection, const T null_value,
+                    ValueVector &result) {
+  for (size_t itr = 0; itr < selection.size(); itr++) {
+    T value = *reinterpret_cast<const T *>(column.GetLocation(selection[itr]));
+    result.integers[itr] = static_cast<int64_t>(value);
+    result.nulls[itr] = (value == null_value);
+  }
+}
+
+void GatherDecimals(const ColumnVector &column,
+                    const SelectionVector &selection, ValueVector &result) {
+  for (size_t itr = 0; itr < selection.size(); itr++) {
+    double value =
+        *reinterpret_cast<const double *>(column.GetLocation(selection[itr]));
+    result.decimals[itr] = value;
+    result.nulls[itr] = (value == type::PELOTON_DECIMAL_NULL);
+  }
+}
+
+template <typename T, typename Accessor, typename Predicate>
+void FilterPositions(const ValueVector &left, const ValueVector &right,
+                     Accessor get, Predicate predicate,
+                     SelectionVector &selection) {
+  size_t match_count = 0;
+  for (size_t itr = 0; itr < selection.size(); itr++) {
+    // comparisons with NULL are never true
+    if (left.IsNull(itr) || right.IsNull(itr)) continue;
+    if (predicate(get(left, itr), get(right, itr))) {
+      selection[match_count++] = selection[itr];
+    }
+  }
+  selection.resize(match_count);
+}
+
+template <typename T, typename Accessor>
+void CompareAs(const ExpressionType op, const ValueVector &left,
+               const ValueVector &right, Accessor get,
+               SelectionVector &selection) {
+  switch (op) {
+    case ExpressionType::COMPARE_EQUAL:
+      FilterPositions<T>(left, right, get, std::equal_to<T>(), selection);
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      FilterPositions<T>(left, right, get, std::not_equal_to<T>(), selection);
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      FilterPositions<T>(left, right, get, std::less<T>(), selection);
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      FilterPositions<T>(left, right, get, std::greater<T>(), selection);
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      FilterPositions<T>(left, right, get, std::less_equal<T>(), selection);
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      FilterPositions<T>(left, right, get, std::greater_equal<T>(), selection);
+      break;
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+}
+
+// Range of the values a column or expression of this integer type can hold.
+// The lowest value of every integer type is reserved for NULL.
+void GetIntegerRange(const type::Type::TypeId type_id, int64_t &min,
+                     int64_t &max) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+      min = type::PELOTON_INT8_MIN;
+      max = type::PELOTON_INT8_MAX;
+      break;
+    case type::Type::SMALLINT:
+      min = type::PELOTON_INT16_MIN;
+      max = type::PELOTON_INT16_MAX;
+      break;
+    case type::Type::INTEGER:
+      min = type::PELOTON_INT32_MIN;
+      max = type::PELOTON_INT32_MAX;
+      break;
+    default:
+      min = type::PELOTON_INT64_MIN;
+      max = type::PELOTON_INT64_MAX;
+      break;
+  }
+}
+
+void IntegerArithmetic(const ExpressionType op,
+                       const type::Type::TypeId result_type,
+                       const ValueVector &left, const ValueVector &right,
+                       const size_t count, ValueVector &result) {
+  int64_t min, max;
+  GetIntegerRange(result_type, min, max);
+
+  for (size_t itr = 0; itr < count; itr++) {
+    if (left.IsNull(itr) || right.IsNull(itr)) {
+      result.nulls[itr] = 1;
+      continue;
+    }
+
+    int64_t x = left.GetInteger(itr);
+    int64_t y = right.GetInteger(itr);
+    int64_t value = 0;
+    bool overflow = false;
+    switch (op) {
+      case ExpressionType::OPERATOR_PLUS:
+        overflow = __builtin_add_overflow(x, y, &value);
+        break;
+      case ExpressionType::OPERATOR_MINUS:
+        overflow = __builtin_sub_overflow(x, y, &value);
+        break;
+      case ExpressionType::OPERATOR_MULTIPLY:
+        overflow = __builtin_mul_overflow(x, y, &value);
+        break;
+      case ExpressionType::OPERATOR_DIVIDE:
+        if (y == 0) {
+          throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+        }
+        value = x / y;
+        break;
+      default:
+        throw Exception("Invalid operator expression type.");
+    }
+
+    if (overflow || value < min || value > max) {
+      throw Exception(EXCEPTION_TYPE_OUT_OF_RANGE,
+                      "Numeric value out of range.");
+    }
+    result.integers[itr] = value;
+  }
+}
+
+void DecimalArithmetic(const ExpressionType op, const ValueVector &left,
+                       const ValueVector &right, const size_t count,
+                       ValueVector &result) {
+  for (size_t itr = 0; itr < count; itr++) {
+    if (left.IsNull(itr) || right.IsNull(itr)) {
+      result.nulls[itr] = 1;
+      continue;
+    }
+
+    double x = left.GetDecimal(itr);
+    double y = right.GetDecimal(itr);
+    switch (op) {
+      case ExpressionType::OPERATOR_PLUS:
+        result.decimals[itr] = x + y;
+        break;
+      case ExpressionType::OPERATOR_MINUS:
+        result.decimals[itr] = x - y;
+        break;
+      case ExpressionType::OPERATOR_MULTIPLY:
+        result.decimals[itr] = x * y;
+        break;
+      case ExpressionType::OPERATOR_DIVIDE:
+        if (y == 0) {
+          throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+        }
+        result.decimals[itr] = x / y;
+        break;
+      default:
+        throw Exception("Invalid operator expression type.");
+    }
+  }
+}
+
+inline bool IsIntegerType(const type::Type::TypeId type_id) {
+  return type_id >= type::Type::TINYINT && type_id <= type::Type::BIGINT;
+}
+
+inline bool IsNumericType(const type::Type::TypeId type_id) {
+  return IsIntegerType(type_id) || type_id == type::Type::DECIMAL;
+}
+
+}  // anonymous namespace
+
+bool VectorizedUtil::IsVectorizableType(const type::Type::TypeId type_id) {
+  return IsNumericType(type_id) || type_id == type::Type::TIMESTAMP;
+}
+
+bool VectorizedUtil::IsComparable(const type::Type::TypeId left,
+                                  const type::Type::TypeId right) {
+  if (IsNumericType(left) && IsNumericType(right)) return true;
+  return left == type::Type::TIMESTAMP && right == type::Type::TIMESTAMP;
+}
+
+type::Type::TypeId VectorizedUtil::GetArithmeticType(
+    const ExpressionType op, const type::Type::TypeId left,
+    const type::Type::TypeId right) {
+  switch (op) {
+    case ExpressionType::OPERATOR_PLUS:
+    case ExpressionType::OPERATOR_MINUS:
+    case ExpressionType::OPERATOR_MULTIPLY:
+    case ExpressionType::OPERATOR_DIVIDE:
+      break;
+    default:
+      return type::Type::INVALID;
+  }
+
+  if (IsNumericType(left) == false || IsNumericType(right) == false) {
+    return type::Type::INVALID;
+  }
+
+  // Same promotion rule as OperatorExpression::DeduceExpressionType()
+  return std::max(left, right);
+}
+
+void VectorizedUtil::Gather(const ColumnVector &column,
+                            const SelectionVector &selection,
+                            ValueVector &result) {
+  result.Reset(column.type_id, selection.size());
+
+  switch (column.type_id) {
+    case type::Type::TINYINT:
+      GatherIntegers<int8_t>(column, selection, type::PELOTON_INT8_NULL,
+                             result);
+      break;
+    case type::Type::SMALLINT:
+      GatherIntegers<int16_t>(column, selection, type::PELOTON_INT16_NULL,
+                              result);
+      break;
+    case type::Type::INTEGER:
+      GatherIntegers<int32_t>(column, selection, type::PELOTON_INT32_NULL,
+                              result);
+      break;
+    case type::Type::BIGINT:
+      GatherIntegers<int64_t>(column, selection, type::PELOTON_INT64_NULL,
+                              result);
+      break;
+    case type::Type::TIMESTAMP:
+      GatherIntegers<uint64_t>(column, selection,
+                               type::PELOTON_TIMESTAMP_NULL, result);
+      break;
+    case type::Type::DECIMAL:
+      GatherDecimals(column, selection, result);
+      break;
+    default:
+      throw Exception(EXCEPTION_TYPE_MISMATCH_TYPE,
+                      "Type " + TypeIdToString(column.type_id) +
+                          " is not supported by vectorized evaluation.");
+  }
+}
+
+void VectorizedUtil::Compare(const ExpressionType op, const ValueVector &left,
+                             const ValueVector &right,
+                             SelectionVector &selection) {
+  PL_ASSERT(IsComparable(left.type_id, right.type_id));
+
+  if (left.type_id == type::Type::TIMESTAMP) {
+    // timestamps are unsigned and may exceed the range of int64_t
+    CompareAs<uint64_t>(op, left, right,
+                        [](const ValueVector &vector, size_t itr) {
+                          return static_cast<uint64_t>(
+                              vector.GetInteger(itr));
+                        },
+                        selection);
+  } else if (left.IsDecimal() || right.IsDecimal()) {
+    CompareAs<double>(op, left, right,
+                      [](const ValueVector &vector, size_t itr) {
+                        return vector.GetDecimal(itr);
+                      },
+                      selection);
+  } else {
+    CompareAs<int64_t>(op, left, right,
+                       [](const ValueVector &vector, size_t itr) {
+                         return vector.GetInteger(itr);
+                       },
+                       selection);
+  }
+}
+
+void VectorizedUtil::Arithmetic(const ExpressionType op,
+                                const type::Type::TypeId result_type,
+                                const ValueVector &left,
+                                const ValueVector &right, const size_t count,
+                                ValueVector &result) {
+  // Fold operations over two constants into a single constant
+  bool is_constant = left.is_constant && right.is_constant;
+  size_t result_count = is_constant ? 1 : count;
+
+  result.Reset(result_type, result_count);
+  result.is_constant = is_constant;
+
+  if (result_type == type::Type::DECIMAL) {
+    DecimalArithmetic(op, left, right, result_count, result);
+  } else {
+    IntegerArithmetic(op, result_type, left, right, result_count, result);
+  }
+}
+
+void VectorizedUtil::Union(const SelectionVector &left,
+                           const SelectionVector &right,
+                           SelectionVector &result) {
+  result.clear();
+  result.reserve(left.size() + right.size());
+  std::set_union(left.begin(), left.end(), right.begin(), right.end(),
+                 std::back_inserter(result));
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -0,0 +1,1009 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_kernels.cpp
+//
+// Identification: src/expression/filter_kernels.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/filter_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <immintrin.h>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "expression/abstract_expression.h"
+#include "expression/tuple_value_expression.h"
+
+// The kernels for each instruction set are compiled for that instruction set
+// only, so that the rest of the binary still runs on any x86-64 CPU.
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Column Predicates
+//===----------------------------------------------------------------------===//
+
+/**
+ * A filter over the values of a column, expressed in the storage type T of
+ * the column. A value qualifies if
+ *   lower <= value <= upper,
+ *   value != null_value (if exclude_null),
+ *   value != excluded (if has_excluded),
+ * or, for IN lists, if it is equal to one of the values.
+ */
+template <typename T>
+struct ColumnPredicate {
+  bool empty = false;
+  T lower = T();
+  T upper = T();
+  bool exclude_null = false;
+  T null_value = T();
+  bool has_excluded = false;
+  T excluded = T();
+  bool is_in = false;
+  std::vector<T> values;
+};
+
+template <typename T>
+inline T Lowest() {
+  return std::numeric_limits<T>::lowest();
+}
+
+template <>
+inline double Lowest<double>() {
+  return -std::numeric_limits<double>::infinity();
+}
+
+template <typename T>
+inline T Highest() {
+  return std::numeric_limits<T>::max();
+}
+
+template <>
+inline double Highest<double>() {
+  return std::numeric_limits<double>::infinity();
+}
+
+// Next and previous representable values (callers check the bounds)
+template <typename T>
+inline T Next(const T value) {
+  return value + 1;
+}
+
+template <>
+inline double Next<double>(const double value) {
+  return std::nextafter(value, Highest<double>());
+}
+
+template <typename T>
+inline T Prev(const T value) {
+  return value - 1;
+}
+
+template <>
+inline double Prev<double>(const double value) {
+  return std::nextafter(value, Lowest<double>());
+}
+
+template <typename T>
+T NullValue();
+
+template <>
+int8_t NullValue<int8_t>() {
+  return type::PELOTON_INT8_NULL;
+}
+
+template <>
+int16_t NullValue<int16_t>() {
+  return type::PELOTON_INT16_NULL;
+}
+
+template <>
+int32_t NullValue<int32_t>() {
+  return type::PELOTON_INT32_NULL;
+}
+
+template <>
+int64_t NullValue<int64_t>() {
+  return type::PELOTON_INT64_NULL;
+}
+
+template <>
+uint64_t NullValue<uint64_t>() {
+  return type::PELOTON_TIMESTAMP_NULL;
+}
+
+template <>
+double NullValue<double>() {
+  return type::PELOTON_DECIMAL_NULL;
+}
+
+// Constants are first converted to the domain D of the column: int64_t for
+// integer columns, uint64_t for timestamps and double for decimals.
+template <typename D>
+D GetConstant(const type::Value &value);
+
+template <>
+int64_t GetConstant<int64_t>(const type::Value &value) {
+  ValueVector vector;
+  vector.SetConstant(value);
+  return vector.GetInteger(0);
+}
+
+template <>
+uint64_t GetConstant<uint64_t>(const type::Value &value) {
+  ValueVector vector;
+  vector.SetConstant(value);
+  return static_cast<uint64_t>(vector.GetInteger(0));
+}
+
+template <>
+double GetConstant<double>(const type::Value &value) {
+  ValueVector vector;
+  vector.SetConstant(value);
+  return vector.GetDecimal(0);
+}
+
+// Narrow the inclusive range [lower, upper] of the domain D to the values a
+// column of type T can hold, and keep the NULL value out of it
+template <typename T, typename D>
+void SetRange(D lower, D upper, ColumnPredicate<T> &predicate) {
+  lower = std::max(lower, static_cast<D>(Lowest<T>()));
+  upper = std::min(upper, static_cast<D>(Highest<T>()));
+  if (!(lower <= upper)) {
+    predicate.empty = true;
+    return;
+  }
+
+  T low = static_cast<T>(lower);
+  T high = static_cast<T>(upper);
+  T null_value = NullValue<T>();
+  if (low == null_value || high == null_value) {
+    if (low == high) {
+      predicate.empty = true;
+      return;
+    }
+    if (low == null_value) {
+      low = Next(low);
+    } else {
+      high = Prev(high);
+    }
+  } else if (low < null_value && null_value < high) {
+    predicate.exclude_null = true;
+    predicate.null_value = null_value;
+  }
+
+  predicate.lower = low;
+  predicate.upper = high;
+}
+
+// Is the value of the domain D representable in the column type T?
+template <typename T, typename D>
+inline bool IsRepresentable(const D value) {
+  return value >= static_cast<D>(Lowest<T>()) &&
+         value <= static_cast<D>(Highest<T>()) &&
+         static_cast<T>(value) != NullValue<T>();
+}
+
+template <typename T, typename D>
+void SetComparison(const ExpressionType op, const D constant,
+                   ColumnPredicate<T> &predicate) {
+  switch (op) {
+    case ExpressionType::COMPARE_EQUAL:
+      SetRange<T>(constant, constant, predicate);
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      SetRange<T>(Lowest<D>(), Highest<D>(), predicate);
+      if (IsRepresentable<T>(constant)) {
+        predicate.has_excluded = true;
+        predicate.excluded = static_cast<T>(constant);
+      }
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      if (constant == Lowest<D>()) {
+        predicate.empty = true;
+      } else {
+        SetRange<T>(Lowest<D>(), Prev(constant), predicate);
+      }
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      SetRange<T>(Lowest<D>(), constant, predicate);
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      if (constant == Highest<D>()) {
+        predicate.empty = true;
+      } else {
+        SetRange<T>(Next(constant), Highest<D>(), predicate);
+      }
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      SetRange<T>(constant, Highest<D>(), predicate);
+      break;
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+}
+
+/**
+ * What the caller asked for, before it is specialized for the column type
+ */
+struct FilterSpec {
+  enum Kind { COMPARE, BETWEEN, IN };
+
+  Kind kind;
+  ExpressionType op;
+  std::vector<type::Value> constants;
+};
+
+template <typename T, typename D>
+ColumnPredicate<T> MakePredicate(const FilterSpec &spec) {
+  ColumnPredicate<T> predicate;
+
+  switch (spec.kind) {
+    case FilterSpec::COMPARE:
+      if (spec.constants[0].IsNull()) {
+        predicate.empty = true;
+      } else {
+        SetComparison<T>(spec.op, GetConstant<D>(spec.constants[0]),
+                         predicate);
+      }
+      break;
+    case FilterSpec::BETWEEN:
+      if (spec.constants[0].IsNull() || spec.constants[1].IsNull()) {
+        predicate.empty = true;
+      } else {
+        SetRange<T>(GetConstant<D>(spec.constants[0]),
+                    GetConstant<D>(spec.constants[1]), predicate);
+      }
+      break;
+    case FilterSpec::IN:
+      predicate.is_in = true;
+      for (auto &constant : spec.constants) {
+        if (constant.IsNull()) continue;
+        D value = GetConstant<D>(constant);
+        if (IsRepresentable<T>(value)) {
+          predicate.values.push_back(static_cast<T>(value));
+        }
+      }
+      predicate.empty = predicate.values.empty();
+      break;
+  }
+
+  return predicate;
+}
+
+template <typename T>
+inline T Read(const char *location) {
+  T value;
+  std::memcpy(&value, location, sizeof(T));
+  return value;
+}
+
+template <typename T>
+inline bool Matches(const T value, const ColumnPredicate<T> &predicate) {
+  if (predicate.is_in) {
+    return std::find(predicate.values.begin(), predicate.values.end(),
+                     value) != predicate.values.end();
+  }
+  if (value < predicate.lower || value > predicate.upper) return false;
+  if (predicate.exclude_null && value == predicate.null_value) return false;
+  if (predicate.has_excluded && value == predicate.excluded) return false;
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// SSE4.2 Vectors
+//
+// Columns with a stride other than the value width are loaded one value at
+// a time, SSE has no gather instructions.
+//===----------------------------------------------------------------------===//
+
+struct SSE42Int32 {
+  typedef int32_t value_type;
+  typedef __m128i vector_type;
+  typedef size_t offsets_type;
+  static const size_t lanes = 4;
+
+  TARGET_SSE42 static inline offsets_type Offsets(const size_t stride) {
+    return stride;
+  }
+
+  TARGET_SSE42 static inline vector_type Load(const char *location) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(location));
+  }
+
+  TARGET_SSE42 static inline vector_type Gather(const char *location,
+                                                const offsets_type stride) {
+    return _mm_setr_epi32(Read<int32_t>(location),
+                          Read<int32_t>(location + stride),
+                          Read<int32_t>(location + 2 * stride),
+                          Read<int32_t>(location + 3 * stride));
+  }
+
+  TARGET_SSE42 static inline vector_type Set(const value_type value) {
+    return _mm_set1_epi32(value);
+  }
+
+  TARGET_SSE42 static inline vector_type InRange(const vector_type values,
+                                                 const vector_type lower,
+                                                 const vector_type upper) {
+    vector_type outside = _mm_or_si128(_mm_cmpgt_epi32(lower, values),
+                                       _mm_cmpgt_epi32(values, upper));
+    return _mm_andnot_si128(outside, _mm_set1_epi32(-1));
+  }
+
+  TARGET_SSE42 static inline vector_type Equal(const vector_type left,
+                                               const vector_type right) {
+    return _mm_cmpeq_epi32(left, right);
+  }
+
+  TARGET_SSE42 static inline vector_type Or(const vector_type left,
+                                            const vector_type right) {
+    return _mm_or_si128(left, right);
+  }
+
+  // (~left & right)
+  TARGET_SSE42 static inline vector_type AndNot(const vector_type left,
+                                                const vector_type right) {
+    return _mm_andnot_si128(left, right);
+  }
+
+  TARGET_SSE42 static inline vector_type Zero() { return _mm_setzero_si128(); }
+
+  TARGET_SSE42 static inline int MoveMask(const vector_type mask) {
+    return _mm_movemask_ps(_mm_castsi128_ps(mask));
+  }
+};
+
+struct SSE42Int64 {
+  typedef int64_t value_type;
+  typedef __m128i vector_type;
+  typedef size_t offsets_type;
+  static const size_t lanes = 2;
+
+  TARGET_SSE42 static inline offsets_type Offsets(const size_t stride) {
+    return stride;
+  }
+
+  TARGET_SSE42 static inline vector_type Load(const char *location) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(location));
+  }
+
+  TARGET_SSE42 static inline vector_type Gather(const char *location,
+                                                const offsets_type stride) {
+    return _mm_set_epi64x(Read<int64_t>(location + stride),
+                          Read<int64_t>(location));
+  }
+
+  TARGET_SSE42 static inline vector_type Set(const value_type value) {
+    return _mm_set1_epi64x(value);
+  }
+
+  TARGET_SSE42 static inline vector_type InRange(const vector_type values,
+                                                 const vector_type lower,
+                                                 const vector_type upper) {
+    vector_type outside = _mm_or_si128(_mm_cmpgt_epi64(lower, values),
+                                       _mm_cmpgt_epi64(values, upper));
+    return _mm_andnot_si128(outside, _mm_set1_epi32(-1));
+  }
+
+  TARGET_SSE42 static inline vector_type Equal(const vector_type left,
+                                               const vector_type right) {
+    return _mm_cmpeq_epi64(left, right);
+  }
+
+  TARGET_SSE42 static inline vector_type Or(const vector_type left,
+                                            const vector_type right) {
+    return _mm_or_si128(left, right);
+  }
+
+  TARGET_SSE42 static inline vector_type AndNot(const vector_type left,
+                                                const vector_type right) {
+    return _mm_andnot_si128(left, right);
+  }
+
+  TARGET_SSE42 static inline vector_type Zero() { return _mm_setzero_si128(); }
+
+  TARGET_SSE42 static inline int MoveMask(const vector_type mask) {
+    return _mm_movemask_pd(_mm_castsi128_pd(mask));
+  }
+};
+
+// Timestamps are unsigned. Flipping the sign bit of every value maps them to
+// signed integers in the same order.
+struct SSE42UInt64 : public SSE42Int64 {
+  typedef uint64_t value_type;
+
+  TARGET_SSE42 static inline vector_type Flip(const vector_type values) {
+    return _mm_xor_si128(values, _mm_set1_epi64x(INT64_MIN));
+  }
+
+  TARGET_SSE42 static inline vector_type Load(const char *location) {
+    return Flip(SSE42Int64::Load(location));
+  }
+
+  TARGET_SSE42 static inline vector_type Gather(const char *location,
+                                                const offsets_type stride) {
+    return Flip(SSE42Int64::Gather(location, stride));
+  }
+
+  TARGET_SSE42 static inline vector_type Set(const value_type value) {
+    return Flip(SSE42Int64::Set(static_cast<int64_t>(value)));
+  }
+};
+
+struct SSE42Double {
+  typedef double value_type;
+  typedef __m128d vector_type;
+  typedef size_t offsets_type;
+  static const size_t lanes = 2;
+
+  TARGET_SSE42 static inline offsets_type Offsets(const size_t stride) {
+    return stride;
+  }
+
+  TARGET_SSE42 static inline vector_type Load(const char *location) {
+    return _mm_loadu_pd(reinterpret_cast<const double *>(location));
+  }
+
+  TARGET_SSE42 static inline vector_type Gather(const char *location,
+                                                const offsets_type stride) {
+    return _mm_setr_pd(Read<double>(location),
+                       Read<double>(location + stride));
+  }
+
+  TARGET_SSE42 static inline vector_type Set(const value_type value) {
+    return _mm_set1_pd(value);
+  }
+
+  TARGET_SSE42 static inline vector_type InRange(const vector_type values,
+                                                 const vector_type lower,
+                                                 const vector_type upper) {
+    return _mm_and_pd(_mm_cmpge_pd(values, lower),
+                      _mm_cmple_pd(values, upper));
+  }
+
+  TARGET_SSE42 static inline vector_type Equal(const vector_type left,
+                                               const vector_type right) {
+    return _mm_cmpeq_pd(left, right);
+  }
+
+  TARGET_SSE42 static inline vector_type Or(const vector_type left,
+                                            const vector_type right) {
+    return _mm_or_pd(left, right);
+  }
+
+  TARGET_SSE42 static inline vector_type AndNot(const vector_type left,
+                                                const vector_type right) {
+    return _mm_andnot_pd(left, right);
+  }
+
+  TARGET_SSE42 static inline vector_type Zero() { return _mm_setzero_pd(); }
+
+  TARGET_SSE42 static inline int MoveMask(const vector_type mask) {
+    return _mm_movemask_pd(mask);
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// AVX2 Vectors
+//
+// Strided columns are loaded with gather instructions. The offsets of the
+// lanes are relative to the first value, so they only depend on the stride.
+//===----------------------------------------------------------------------===//
+
+struct AVX2Int32 {
+  typedef int32_t value_type;
+  typedef __m256i vector_type;
+  typedef __m256i offsets_type;
+  static const size_t lanes = 8;
+
+  TARGET_AVX2 static inline offsets_type Offsets(const size_t stride) {
+    int s = static_cast<int>(stride);
+    return _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+  }
+
+  TARGET_AVX2 static inline vector_type Load(const char *location) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(location));
+  }
+
+  TARGET_AVX2 static inline vector_type Gather(const char *location,
+                                               const offsets_type offsets) {
+    return _mm256_i32gather_epi32(reinterpret_cast<const int *>(location),
+                                  offsets, 1);
+  }
+
+  TARGET_AVX2 static inline vector_type Set(const value_type value) {
+    return _mm256_set1_epi32(value);
+  }
+
+  TARGET_AVX2 static inline vector_type InRange(const vector_type values,
+                                                const vector_type lower,
+                                                const vector_type upper) {
+    vector_type outside = _mm256_or_si256(_mm256_cmpgt_epi32(lower, values),
+                                          _mm256_cmpgt_epi32(values, upper));
+    return _mm256_andnot_si256(outside, _mm256_set1_epi32(-1));
+  }
+
+  TARGET_AVX2 static inline vector_type Equal(const vector_type left,
+                                              const vector_type right) {
+    return _mm256_cmpeq_epi32(left, right);
+  }
+
+  TARGET_AVX2 static inline vector_type Or(const vector_type left,
+                                           const vector_type right) {
+    return _mm256_or_si256(left, right);
+  }
+
+  TARGET_AVX2 static inline vector_type AndNot(const vector_type left,
+                                               const vector_type right) {
+    return _mm256_andnot_si256(left, right);
+  }
+
+  TARGET_AVX2 static inline vector_type Zero() {
+    return _mm256_setzero_si256();
+  }
+
+  TARGET_AVX2 static inline int MoveMask(const vector_type mask) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(mask));
+  }
+};
+
+struct AVX2Int64 {
+  typedef int64_t value_type;
+  typedef __m256i vector_type;
+  typedef __m128i offsets_type;
+  static const size_t lanes = 4;
+
+  TARGET_AVX2 static inline offsets_type Offsets(const size_t stride) {
+    int s = static_cast<int>(stride);
+    return _mm_setr_epi32(0, s, 2 * s, 3 * s);
+  }
+
+  TARGET_AVX2 static inline vector_type Load(const char *location) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(location));
+  }
+
+  TARGET_AVX2 static inline vector_type Gather(const char *location,
+                                               const offsets_type offsets) {
+    return _mm256_i32gather_epi64(
+        reinterpret_cast<const long long *>(location), offsets, 1);
+  }
+
+  TARGET_AVX2 static inline vector_type Set(const value_type value) {
+    return _mm256_set1_epi64x(value);
+  }
+
+  TARGET_AVX2 static inline vector_type InRange(const vector_type values,
+                                                const vector_type lower,
+                                                const vector_type upper) {
+    vector_type outside = _mm256_or_si256(_mm256_cmpgt_epi64(lower, values),
+                                          _mm256_cmpgt_epi64(values, upper));
+    return _mm256_andnot_si256(outside, _mm256_set1_epi32(-1));
+  }
+
+  TARGET_AVX2 static inline vector_type Equal(const vector_type left,
+                                              const vector_type right) {
+    return _mm256_cmpeq_epi64(left, right);
+  }
+
+  TARGET_AVX2 static inline vector_type Or(const vector_type left,
+                                           const vector_type right) {
+    return _mm256_or_si256(left, right);
+  }
+
+  TARGET_AVX2 static inline vector_type AndNot(const vector_type left,
+                                               const vector_type right) {
+    return _mm256_andnot_si256(left, right);
+  }
+
+  TARGET_AVX2 static inline vector_type Zero() {
+    return _mm256_setzero_si256();
+  }
+
+  TARGET_AVX2 static inline int MoveMask(const vector_type mask) {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(mask));
+  }
+};
+
+struct AVX2UInt64 : public AVX2Int64 {
+  typedef uint64_t value_type;
+
+  TARGET_AVX2 static inline vector_type Flip(const vector_type values) {
+    return _mm256_xor_si256(values, _mm256_set1_epi64x(INT64_MIN));
+  }
+
+  TARGET_AVX2 static inline vector_type Load(const char *location) {
+    return Flip(AVX2Int64::Load(location));
+  }
+
+  TARGET_AVX2 static inline vector_type Gather(const char *location,
+                                               const offsets_type offsets) {
+    return Flip(AVX2Int64::Gather(location, offsets));
+  }
+
+  TARGET_AVX2 static inline vector_type Set(const value_type value) {
+    return Flip(AVX2Int64::Set(static_cast<int64_t>(value)));
+  }
+};
+
+struct AVX2Double {
+  typedef double value_type;
+  typedef __m256d vector_type;
+  typedef __m128i offsets_type;
+  static const size_t lanes = 4;
+
+  TARGET_AVX2 static inline offsets_type Offsets(const size_t stride) {
+    int s = static_cast<int>(stride);
+    return _mm_setr_epi32(0, s, 2 * s, 3 * s);
+  }
+
+  TARGET_AVX2 static inline vector_type Load(const char *location) {
+    return _mm256_loadu_pd(reinterpret_cast<const double *>(location));
+  }
+
+  TARGET_AVX2 static inline vector_type Gather(const char *location,
+                                               const offsets_type offsets) {
+    return _mm256_i32gather_pd(reinterpret_cast<const double *>(location),
+                               offsets, 1);
+  }
+
+  TARGET_AVX2 static inline vector_type Set(const value_type value) {
+    return _mm256_set1_pd(value);
+  }
+
+  TARGET_AVX2 static inline vector_type InRange(const vector_type values,
+                                                const vector_type lower,
+                                                const vector_type upper) {
+    return _mm256_and_pd(_mm256_cmp_pd(values, lower, _CMP_GE_OQ),
+                         _mm256_cmp_pd(values, upper, _CMP_LE_OQ));
+  }
+
+  TARGET_AVX2 static inline vector_type Equal(const vector_type left,
+                                              const vector_type right) {
+    return _mm256_cmp_pd(left, right, _CMP_EQ_OQ);
+  }
+
+  TARGET_AVX2 static inline vector_type Or(const vector_type left,
+                                           const vector_type right) {
+    return _mm256_or_pd(left, right);
+  }
+
+  TARGET_AVX2 static inline vector_type AndNot(const vector_type left,
+                                               const vector_type right) {
+    return _mm256_andnot_pd(left, right);
+  }
+
+  TARGET_AVX2 static inline vector_type Zero() { return _mm256_setzero_pd(); }
+
+  TARGET_AVX2 static inline int MoveMask(const vector_type mask) {
+    return _mm256_movemask_pd(mask);
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// Kernels
+//
+// Evaluate the predicate over the tuple offsets [0, count) of the column and
+// set the bits of the matching offsets in the (zeroed) bitmap.
+//===----------------------------------------------------------------------===//
+
+template <typename T>
+void EvaluateScalar(const ColumnVector &column, const size_t begin,
+                    const size_t count, const ColumnPredicate<T> &predicate,
+                    uint64_t *bitmap) {
+  for (size_t itr = begin; itr < count; itr++) {
+    if (Matches(Read<T>(column.GetLocation(itr)), predicate)) {
+      bitmap[itr / 64] |= (1ULL << (itr % 64));
+    }
+  }
+}
+
+template <typename Traits>
+TARGET_SSE42 void EvaluateSSE42(
+    const ColumnVector &column, const size_t count,
+    const ColumnPredicate<typename Traits::value_type> &predicate,
+    uint64_t *bitmap) {
+  typedef typename Traits::vector_type vector_type;
+
+  const bool contiguous =
+      (column.stride == sizeof(typename Traits::value_type));
+  const auto offsets = Traits::Offsets(column.stride);
+  const vector_type lower = Traits::Set(predicate.lower);
+  const vector_type upper = Traits::Set(predicate.upper);
+  const vector_type null_value = Traits::Set(predicate.null_value);
+  const vector_type excluded = Traits::Set(predicate.excluded);
+
+  size_t itr = 0;
+  for (; itr + Traits::lanes <= count; itr += Traits::lanes) {
+    const char *location = column.GetLocation(itr);
+    vector_type values =
+        contiguous ? Traits::Load(location) : Traits::Gather(location, offsets);
+
+    vector_type matches;
+    if (predicate.is_in) {
+      matches = Traits::Zero();
+      for (auto value : predicate.values) {
+        matches = Traits::Or(matches, Traits::Equal(values, Traits::Set(value)));
+      }
+    } else {
+      matches = Traits::InRange(values, lower, upper);
+      if (predicate.exclude_null) {
+        matches = Traits::AndNot(Traits::Equal(values, null_value), matches);
+      }
+      if (predicate.has_excluded) {
+        matches = Traits::AndNot(Traits::Equal(values, excluded), matches);
+      }
+    }
+
+    // lanes divide 64, so the bits never straddle two words
+    bitmap[itr / 64] |= static_cast<uint64_t>(Traits::MoveMask(matches))
+                        << (itr % 64);
+  }
+
+  EvaluateScalar(column, itr, count, predicate, bitmap);
+}
+
+template <typename Traits>
+TARGET_AVX2 void EvaluateAVX2(
+    const ColumnVector &column, const size_t count,
+    const ColumnPredicate<typename Traits::value_type> &predicate,
+    uint64_t *bitmap) {
+  typedef typename Traits::vector_type vector_type;
+
+  const bool contiguous =
+      (column.stride == sizeof(typename Traits::value_type));
+  const auto offsets = Traits::Offsets(column.stride);
+  const vector_type lower = Traits::Set(predicate.lower);
+  const vector_type upper = Traits::Set(predicate.upper);
+  const vector_type null_value = Traits::Set(predicate.null_value);
+  const vector_type excluded = Traits::Set(predicate.excluded);
+
+  size_t itr = 0;
+  for (; itr + Traits::lanes <= count; itr += Traits::lanes) {
+    const char *location = column.GetLocation(itr);
+    vector_type values =
+        contiguous ? Traits::Load(location) : Traits::Gather(location, offsets);
+
+    vector_type matches;
+    if (predicate.is_in) {
+      matches = Traits::Zero();
+      for (auto value : predicate.values) {
+        matches = Traits::Or(matches, Traits::Equal(values, Traits::Set(value)));
+      }
+    } else {
+      matches = Traits::InRange(values, lower, upper);
+      if (predicate.exclude_null) {
+        matches = Traits::AndNot(Traits::Equal(values, null_value), matches);
+      }
+      if (predicate.has_excluded) {
+        matches = Traits::AndNot(Traits::Equal(values, excluded), matches);
+      }
+    }
+
+    bitmap[itr / 64] |= static_cast<uint64_t>(Traits::MoveMask(matches))
+                        << (itr % 64);
+  }
+
+  EvaluateScalar(column, itr, count, predicate, bitmap);
+}
+
+// Selections sparser than one in this many offsets are checked tuple by
+// tuple instead of scanning the whole column
+const size_t kSparseSelectionFactor = 8;
+
+std::atomic<SIMDLevel> simd_level(FilterKernels::GetSupportedLevel());
+
+// Check the selected offsets one at a time
+template <typename T>
+void FilterPositions(const ColumnVector &column,
+                     const ColumnPredicate<T> &predicate,
+                     SelectionVector &selection) {
+  if (predicate.empty) {
+    selection.clear();
+    return;
+  }
+
+  size_t match_count = 0;
+  for (auto tuple_offset : selection) {
+    if (Matches(Read<T>(column.GetLocation(tuple_offset)), predicate)) {
+      selection[match_count++] = tuple_offset;
+    }
+  }
+  selection.resize(match_count);
+}
+
+template <typename T, typename SSE42Traits, typename AVX2Traits>
+void FilterColumn(const ColumnVector &column,
+                  const ColumnPredicate<T> &predicate,
+                  SelectionVector &selection) {
+  if (selection.empty()) return;
+
+  const size_t count = selection.back() + 1;
+  const SIMDLevel level = simd_level.load();
+  if (predicate.empty || level == SIMDLevel::SCALAR ||
+      selection.size() * kSparseSelectionFactor < count) {
+    FilterPositions(column, predicate, selection);
+    return;
+  }
+
+  std::vector<uint64_t> bitmap((count + 63) / 64, 0);
+  if (level == SIMDLevel::AVX2) {
+    EvaluateAVX2<AVX2Traits>(column, count, predicate, bitmap.data());
+  } else {
+    EvaluateSSE42<SSE42Traits>(column, count, predicate, bitmap.data());
+  }
+
+  // Branch-free compaction, the outcome of each test is hard to predict
+  size_t match_count = 0;
+  for (auto tuple_offset : selection) {
+    selection[match_count] = tuple_offset;
+    match_count += (bitmap[tuple_offset / 64] >> (tuple_offset % 64)) & 1;
+  }
+  selection.resize(match_count);
+}
+
+void Filter(const ColumnVector &column, const FilterSpec &spec,
+            SelectionVector &selection) {
+  switch (column.type_id) {
+    case type::Type::TINYINT:
+      FilterPositions(column, MakePredicate<int8_t, int64_t>(spec),
+                      selection);
+      break;
+    case type::Type::SMALLINT:
+      FilterPositions(column, MakePredicate<int16_t, int64_t>(spec),
+                      selection);
+      break;
+    case type::Type::INTEGER:
+      FilterColumn<int32_t, SSE42Int32, AVX2Int32>(
+          column, MakePredicate<int32_t, int64_t>(spec), selection);
+      break;
+    case type::Type::BIGINT:
+      FilterColumn<int64_t, SSE42Int64, AVX2Int64>(
+          column, MakePredicate<int64_t, int64_t>(spec), selection);
+      break;
+    case type::Type::TIMESTAMP:
+      FilterColumn<uint64_t, SSE42UInt64, AVX2UInt64>(
+          column, MakePredicate<uint64_t, uint64_t>(spec), selection);
+      break;
+    case type::Type::DECIMAL:
+      FilterColumn<double, SSE42Double, AVX2Double>(
+          column, MakePredicate<double, double>(spec), selection);
+      break;
+    default:
+      throw Exception(EXCEPTION_TYPE_MISMATCH_TYPE,
+                      "Type " + TypeIdToString(column.type_id) +
+                          " is not supported by the filter kernels.");
+  }
+}
+
+void CheckSupported(const ColumnVector &column, const type::Value &constant) {
+  if (FilterKernels::IsSupported(column.type_id, constant.GetTypeId()) ==
+      false) {
+    throw Exception(EXCEPTION_TYPE_MISMATCH_TYPE,
+                    "Type " + TypeIdToString(constant.GetTypeId()) +
+                        " cannot be compared with a column of type " +
+                        TypeIdToString(column.type_id) +
+                        " by the filter kernels.");
+  }
+}
+
+inline bool IsIntegerType(const type::Type::TypeId type_id) {
+  return type_id >= type::Type::TINYINT && type_id <= type::Type::BIGINT;
+}
+
+// (constant op column) is the same as (column Commute(op) constant)
+ExpressionType Commute(const ExpressionType op) {
+  switch (op) {
+    case ExpressionType::COMPARE_LESSTHAN:
+      return ExpressionType::COMPARE_GREATERTHAN;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return ExpressionType::COMPARE_LESSTHAN;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return ExpressionType::COMPARE_LESSTHANOREQUALTO;
+    default:
+      return op;
+  }
+}
+
+}  // anonymous namespace
+
+SIMDLevel FilterKernels::GetSupportedLevel() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return SIMDLevel::AVX2;
+  if (__builtin_cpu_supports("sse4.2")) return SIMDLevel::SSE42;
+  return SIMDLevel::SCALAR;
+}
+
+SIMDLevel FilterKernels::GetLevel() { return simd_level.load(); }
+
+void FilterKernels::SetLevel(SIMDLevel level) {
+  simd_level.store(std::min(level, GetSupportedLevel()));
+}
+
+bool FilterKernels::IsSupported(const type::Type::TypeId column_type,
+                                const type::Type::TypeId constant_type) {
+  if (IsIntegerType(column_type)) return IsIntegerType(constant_type);
+  if (column_type == type::Type::DECIMAL) {
+    return IsIntegerType(constant_type) || constant_type == type::Type::DECIMAL;
+  }
+  if (column_type == type::Type::TIMESTAMP) {
+    return constant_type == type::Type::TIMESTAMP;
+  }
+  return false;
+}
+
+void FilterKernels::Compare(const ExpressionType op, const ColumnVector &column,
+                            const type::Value &constant,
+                            SelectionVector &selection) {
+  CheckSupported(column, constant);
+  Filter(column, FilterSpec{FilterSpec::COMPARE, op, {constant}}, selection);
+}
+
+void FilterKernels::Between(const ColumnVector &column, const type::Value &low,
+                            const type::Value &high,
+                            SelectionVector &selection) {
+  CheckSupported(column, low);
+  CheckSupported(column, high);
+  Filter(column,
+         FilterSpec{FilterSpec::BETWEEN, ExpressionType::INVALID, {low, high}},
+         selection);
+}
+
+void FilterKernels::In(const ColumnVector &column,
+                       const std::vector<type::Value> &values,
+                       SelectionVector &selection) {
+  for (auto &value : values) {
+    CheckSupported(column, value);
+  }
+  Filter(column, FilterSpec{FilterSpec::IN, ExpressionType::INVALID, values},
+         selection);
+}
+
+bool FilterKernels::FilterComparison(const ExpressionType op,
+                                     const AbstractExpression *left,
+                                     const AbstractExpression *right,
+                                     const TileGroupBatch &batch,
+                                     SelectionVector &selection) {
+  ExpressionType column_op = op;
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    std::swap(left, right);
+    column_op = Commute(op);
+  }
+
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE) return false;
+  if (right->GetExpressionType() != ExpressionType::VALUE_CONSTANT &&
+      right->GetExpressionType() != ExpressionType::VALUE_PARAMETER)
+    return false;
+
+  auto tuple_value = static_cast<const TupleValueExpression *>(left);
+  if (tuple_value->GetTupleId() != 0) return false;
+
+  ColumnVector column = batch.GetColumn(tuple_value->GetColumnId());
+  type::Value constant = right->Evaluate(nullptr, nullptr, batch.GetContext());
+  if (IsSupported(column.type_id, constant.GetTypeId()) == false) return false;
+
+  Compare(column_op, column, constant, selection);
+  return true;
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 #include "gc/gc_manager.h"
 
+#include "catalog/manager.h"
 #include "catalog/schema.h"
 #include "type/types.h"
 #include "type/value.h"
@@ -21,6 +22,10 @@
 namespace peloton {
 namespace gc {
 
+void GCManager::RetireTileGroup(const oid_t &tile_group_id) {
+  catalog::Manager::GetInstance().DropTileGroup(tile_group_id);
+}
+
 // Check a tuple and reclaim all varlen field
 void GCManager::CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple_id) {
     oid_t tile_count = tg->tile_count;
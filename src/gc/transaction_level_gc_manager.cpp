@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "gc/transaction_level_gc_manager.h"
 #include "storage/tuple.h"
 #include "storage/database.h"
@@ -21,6 +23,40 @@
 namespace peloton {
 namespace gc {
 
+namespace {
+
+/** Recycled slots of a table a thread took from its pool. */
+struct RecycledSlotCache {
+  oid_t table_id = INVALID_OID;
+  std::shared_ptr<RecyclePool> pool;
+  std::vector<ItemPointer> slots;
+
+  // hands the slots left back to the pool, for the other threads to reuse
+  void Release() {
+    if (pool != nullptr && pool->dropped == false && slots.empty() == false) {
+      pool->lock.Lock();
+      pool->slots.insert(pool->slots.end(), slots.begin(), slots.end());
+      pool->slot_count = pool->slots.size();
+      pool->lock.Unlock();
+    }
+    slots.clear();
+    pool.reset();
+    table_id = INVALID_OID;
+  }
+
+  ~RecycledSlotCache() { Release(); }
+};
+
+// The caches of a thread, the table of a cache replacing the previous one
+// when they map to the same entry.
+const size_t recycled_slot_cache_count = 8;
+
+thread_local RecycledSlotCache recycled_slot_caches[recycled_slot_cache_count];
+
+}  // namespace
+
+const size_t TransactionLevelGCManager::recycle_batch_size;
+
 void TransactionLevelGCManager::StartGC(int thread_id) {
   gc_threads_[thread_id].reset(new std::thread(&TransactionLevelGCManager::Running, this, thread_id));
 }
@@ -68,6 +104,11 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 
     int unlinked_count = Unlink(thread_id, max_cid);
 
+    // free the dropped tile groups no transaction can observe anymore
+    if (thread_id == 0) {
+      catalog::Manager::GetInstance().ReclaimTileGroups();
+    }
+
     if (is_running_ == false) {
       return;
     }
@@ -89,9 +130,46 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 
 void TransactionLevelGCManager::RecycleTransaction(std::shared_ptr<ReadWriteSet> gc_set, const cid_t &timestamp, const GCSetType gc_set_type) {
 
-  // Add the garbage context to the lock-free queue
-  std::shared_ptr<GarbageContext> gc_context(new GarbageContext(gc_set, timestamp, gc_set_type));
-  unlink_queues_[HashToThread(gc_context->timestamp_)]->Enqueue(gc_context);
+  if (gc_thread_count_ == 1) {
+    // Add the garbage context to the lock-free queue
+    std::shared_ptr<GarbageContext> gc_context(new GarbageContext(gc_set, timestamp, gc_set_type));
+    unlink_queues_[0]->Enqueue(gc_context);
+    return;
+  }
+
+  // split the garbage by tile group, so that the versions of a tile group are
+  // only reset by the thread that owns it
+  std::vector<std::shared_ptr<ReadWriteSet>> partitions(gc_thread_count_);
+  for (auto &entry : *gc_set) {
+    auto &partition = partitions[HashToThread(entry.tile_group_id)];
+    if (partition == nullptr) {
+      partition.reset(new ReadWriteSet());
+    }
+    partition->Insert(entry.tile_group_id, entry.tuple_id, entry.type);
+  }
+
+  for (int thread_id = 0; thread_id < gc_thread_count_; ++thread_id) {
+    if (partitions[thread_id] != nullptr) {
+      std::shared_ptr<GarbageContext> gc_context(
+          new GarbageContext(partitions[thread_id], timestamp, gc_set_type));
+      unlink_queues_[thread_id]->Enqueue(gc_context);
+    }
+  }
+}
+
+// the tile group may only be freed once no garbage left points into it, so
+// every thread gets the drop behind the garbage it was handed before
+void TransactionLevelGCManager::RetireTileGroup(const oid_t &tile_group_id) {
+  auto timestamp = concurrency::TransactionManagerFactory::GetInstance()
+                       .GetNextGlobalCommitId();
+  std::shared_ptr<std::atomic<int>> pending_thread_count(
+      new std::atomic<int>(gc_thread_count_));
+
+  for (int thread_id = 0; thread_id < gc_thread_count_; ++thread_id) {
+    std::shared_ptr<GarbageContext> gc_context(
+        new GarbageContext(tile_group_id, timestamp, pending_thread_count));
+    unlink_queues_[thread_id]->Enqueue(gc_context);
+  }
 }
 
 int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid) {
@@ -105,7 +183,8 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid
   // First iterate the local unlink queue
   local_unlink_queues_[thread_id].remove_if(
     [this, &garbages, &tuple_counter, max_cid](const std::shared_ptr<GarbageContext>& garbage_ctx) -> bool {
-      bool res = garbage_ctx->timestamp_ < max_cid;
+      bool res = garbage_ctx->IsTileGroupDrop() == false &&
+                 garbage_ctx->timestamp_ < max_cid;
       if (res == true) {
         DeleteFromIndexes(garbage_ctx);
         // Add to the garbage map
@@ -117,15 +196,20 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid
     }
   );
 
+  bool queue_drained = false;
   for (size_t i = 0; i < MAX_ATTEMPT_COUNT; ++i) {
 
     std::shared_ptr<GarbageContext> garbage_ctx;
     // if there's no more tuples in the queue, then break.
     if (unlink_queues_[thread_id]->Dequeue(garbage_ctx) == false) {
+      queue_drained = true;
       break;
     }
 
-    if (garbage_ctx->timestamp_ < max_cid) {
+    if (garbage_ctx->IsTileGroupDrop() == true) {
+      local_unlink_queues_[thread_id].push_back(garbage_ctx);
+
+    } else if (garbage_ctx->timestamp_ < max_cid) {
 
       // as the max timestamp of committed transactions is larger than the gc's timestamp,
       // it means that no active transactions can read it.
@@ -142,7 +226,24 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid
     }
   }  // end for
 
-  auto safe_max_cid = concurrency::TransactionManagerFactory::GetInstance().GetNextCommitId();
+  // once the queue is drained, the garbage queued before a drop has either
+  // been unlinked or is older than it, and is unlinked with it
+  if (queue_drained == true) {
+    local_unlink_queues_[thread_id].remove_if(
+      [&garbages, &tuple_counter, max_cid](const std::shared_ptr<GarbageContext>& garbage_ctx) -> bool {
+        bool res = garbage_ctx->IsTileGroupDrop() == true &&
+                   garbage_ctx->timestamp_ < max_cid;
+        if (res == true) {
+          garbages.push_back(garbage_ctx);
+          tuple_counter++;
+        }
+        return res;
+      }
+    );
+  }
+
+  auto safe_max_cid = concurrency::TransactionManagerFactory::GetInstance()
+                          .GetNextGlobalCommitId();
   for(auto& item : garbages){
       reclaim_maps_[thread_id].insert(std::make_pair(safe_max_cid, item));
   }
@@ -154,6 +255,9 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid
 int TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_cid) {
   int gc_counter = 0;
 
+  // the reset slots of each table, recycled at once
+  std::unordered_map<oid_t, std::vector<ItemPointer>> recycled_slots;
+
   // we delete garbage in the free list
   auto garbage_ctx_entry = reclaim_maps_[thread_id].begin();
   while (garbage_ctx_entry != reclaim_maps_[thread_id].end()) {
@@ -163,7 +267,15 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_ci
     // if the timestamp of the garbage is older than the current max_cid,
     // recycle it
     if (garbage_ts < max_cid) {
-      AddToRecycleMap(garbage_ctx);
+      if (garbage_ctx->IsTileGroupDrop() == true) {
+        // the last thread to get there drops the tile group
+        if (--(*garbage_ctx->pending_thread_count_) == 0) {
+          catalog::Manager::GetInstance().DropTileGroup(
+              garbage_ctx->dropped_tile_group_id_);
+        }
+      } else {
+        AddToRecycleMap(thread_id, garbage_ctx, recycled_slots);
+      }
 
       // Remove from the original map
       garbage_ctx_entry = reclaim_maps_[thread_id].erase(garbage_ctx_entry);
@@ -173,67 +285,200 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_ci
       break;
     }
   }
+
+  for (auto &table_slots : recycled_slots) {
+    RecycleSlots(table_slots.first, table_slots.second);
+  }
   LOG_TRACE("Marked %d txn contexts as recycled", gc_counter);
   return gc_counter;
 }
 
 // Multiple GC thread share the same recycle map
-void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext> garbage_ctx) {
+void TransactionLevelGCManager::AddToRecycleMap(
+    const int &thread_id, std::shared_ptr<GarbageContext> garbage_ctx,
+    std::unordered_map<oid_t, std::vector<ItemPointer>> &recycled_slots) {
   
+  auto &manager = catalog::Manager::GetInstance();
+  oid_t tile_group_id = INVALID_OID;
+  std::vector<ItemPointer> *table_slots = nullptr;
+  std::vector<ItemPointer> retired_slots;
+
   for (auto &entry : *(garbage_ctx->gc_set_.get())) {
 
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(entry.first);
+    // the entries of a tile group are mostly next to each other.
+    if (entry.tile_group_id != tile_group_id) {
+      tile_group_id = entry.tile_group_id;
+      auto tile_group = manager.GetTileGroup(tile_group_id);
 
-    // During the resetting, a table may deconstruct because of the DROP TABLE request
-    if (tile_group == nullptr) {
-      return;
-    }
+      // During the resetting, a table may deconstruct because of the DROP TABLE request
+      if (tile_group == nullptr) {
+        table_slots = nullptr;
+        continue;
+      }
 
-    PL_ASSERT(tile_group != nullptr);
+      storage::DataTable *table =
+        dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+      PL_ASSERT(table != nullptr);
 
-    storage::DataTable *table =
-      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
-    PL_ASSERT(table != nullptr);
+      // the slots of a tile group being compacted are not reused
+      if (tile_group->GetHeader()->IsRetired() == true) {
+        table_slots = &retired_slots;
+      } else {
+        table_slots = &recycled_slots[table->GetOid()];
+      }
+    }
 
-    oid_t table_id = table->GetOid();
+    if (table_slots == nullptr) {
+      continue;
+    }
 
-    for (auto &element : entry.second) {
+    // as this transaction has been committed, we should reclaim older versions.
+    ItemPointer location(entry.tile_group_id, entry.tuple_id);
 
-      // as this transaction has been committed, we should reclaim older versions.
-      ItemPointer location(entry.first, element.first); 
-      
-      // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
-        continue;
+    // unlink the version from the newer one, which may be reclaimed as well
+    if (garbage_ctx->gc_set_type_ == GC_SET_TYPE_COMMITTED) {
+      ItemPointer newer_location =
+          CompactVersionChain(thread_id, location, entry.type,
+                              garbage_ctx->timestamp_);
+      if (newer_location.IsNull() == false) {
+        table_slots->push_back(newer_location);
       }
-      // if the entry for table_id exists.
-      PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
-      recycle_queue_map_[table_id]->Enqueue(location);
+    }
+
+    // If the tuple being reset no longer exists, just skip it
+    if (ResetTuple(location) == false) {
+      continue;
+    }
+    table_slots->push_back(location);
+  }
+
+}
+
+// cut the link from the newer version of a reclaimed version to it. if the
+// newer version is the empty version of a delete, it is reset as well and
+// its location is returned, or it is handed to the thread that owns it.
+ItemPointer TransactionLevelGCManager::CompactVersionChain(const int &thread_id,
+                                                    const ItemPointer &location,
+                                                    const RWType &type,
+                                                    const cid_t &timestamp) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header =
+      manager.GetTileGroupRaw(location.block)->GetHeader();
+  ItemPointer newer_location =
+      tile_group_header->GetPrevItemPointer(location.offset);
+  if (newer_location.IsNull() == true) {
+    return INVALID_ITEMPOINTER;
+  }
+
+  auto newer_tile_group = manager.GetTileGroup(newer_location.block);
+  if (newer_tile_group == nullptr) {
+    return INVALID_ITEMPOINTER;
+  }
+  auto newer_tile_group_header = newer_tile_group->GetHeader();
+  ItemPointer next_location =
+      newer_tile_group_header->GetNextItemPointer(newer_location.offset);
+  if (next_location.block != location.block ||
+      next_location.offset != location.offset) {
+    return INVALID_ITEMPOINTER;
+  }
 
+  if (type == RW_TYPE_DELETE &&
+      newer_tile_group_header->GetTransactionId(newer_location.offset) ==
+          INVALID_TXN_ID) {
+    // the index entries were deleted when the garbage was unlinked, so no
+    // transaction can reach the empty version anymore
+    auto owner_id = HashToThread(newer_location.block);
+    if (owner_id != (unsigned int)thread_id) {
+      // committed inserts are never collected otherwise, so the owner just
+      // resets and recycles the version
+      std::shared_ptr<ReadWriteSet> empty_version(new ReadWriteSet());
+      empty_version->Insert(newer_location.block, newer_location.offset,
+                            RW_TYPE_INSERT);
+      std::shared_ptr<GarbageContext> gc_context(new GarbageContext(
+          empty_version, timestamp, GC_SET_TYPE_COMMITTED));
+      unlink_queues_[owner_id]->Enqueue(gc_context);
+      return INVALID_ITEMPOINTER;
     }
+    ResetTuple(newer_location);
+    return newer_location;
   }
 
+  // a newer version is only reset by the thread its tile group belongs to,
+  // the link is cut by that thread to not race with a reuse of the slot
+  if (type == RW_TYPE_UPDATE &&
+      HashToThread(newer_location.block) == (unsigned int)thread_id) {
+    newer_tile_group_header->SetNextItemPointer(newer_location.offset,
+                                                INVALID_ITEMPOINTER);
+  }
+  return INVALID_ITEMPOINTER;
+}
+
+void TransactionLevelGCManager::RecycleSlots(const oid_t &table_id,
+                                             std::vector<ItemPointer> &slots) {
+  if (slots.empty() == true) {
+    return;
+  }
+
+  // the table may have been dropped in the meantime
+  auto entry = recycle_pool_map_.find(table_id);
+  if (entry == recycle_pool_map_.end()) {
+    return;
+  }
+
+  auto &recycle_pool = *entry->second;
+  recycle_pool.lock.Lock();
+  recycle_pool.slots.insert(recycle_pool.slots.end(), slots.begin(),
+                            slots.end());
+  recycle_pool.slot_count = recycle_pool.slots.size();
+  recycle_pool.lock.Unlock();
 }
 
 // this function returns a free tuple slot, if one exists
 // called by data_table.
+// the slots are taken from the cache of the thread, which is refilled from
+// the pool of the table a batch at a time.
 ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
-  // for catalog tables, we directly return invalid item pointer.
-  if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
-    return INVALID_ITEMPOINTER;
+  auto &cache =
+      recycled_slot_caches[table_id % recycled_slot_cache_count];
+
+  if (cache.table_id != table_id || cache.pool == nullptr ||
+      cache.pool->dropped == true) {
+    cache.Release();
+
+    // for catalog tables, we directly return invalid item pointer.
+    auto entry = recycle_pool_map_.find(table_id);
+    if (entry == recycle_pool_map_.end()) {
+      return INVALID_ITEMPOINTER;
+    }
+    cache.table_id = table_id;
+    cache.pool = entry->second;
   }
 
-  ItemPointer location;
-  PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
-  auto recycle_queue = recycle_queue_map_[table_id];
+  if (cache.slots.empty() == true) {
+    auto &recycle_pool = *cache.pool;
+    if (recycle_pool.slot_count == 0) {
+      return INVALID_ITEMPOINTER;
+    }
 
-  if (recycle_queue->Dequeue(location) == true) {
-    LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
-              location.offset, table_id);
-    return location;
+    recycle_pool.lock.Lock();
+    size_t slot_count =
+        std::min(recycle_pool.slots.size(), recycle_batch_size);
+    cache.slots.assign(recycle_pool.slots.end() - slot_count,
+                       recycle_pool.slots.end());
+    recycle_pool.slots.resize(recycle_pool.slots.size() - slot_count);
+    recycle_pool.slot_count = recycle_pool.slots.size();
+    recycle_pool.lock.Unlock();
+
+    if (cache.slots.empty() == true) {
+      return INVALID_ITEMPOINTER;
+    }
   }
-  return INVALID_ITEMPOINTER;
+
+  ItemPointer location = cache.slots.back();
+  cache.slots.pop_back();
+  LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
+            location.offset, table_id);
+  return location;
 }
 
 void TransactionLevelGCManager::ClearGarbage(int thread_id) {
@@ -255,52 +500,59 @@ void TransactionLevelGCManager::DeleteFromIndexes(const std::shared_ptr<GarbageC
   if (gc_set_type == GC_SET_TYPE_COMMITTED) {
     // if the transaction is committed, 
     // then we need to remove tuples that are deleted by the transaction from indexes.
-    for (auto entry : *(garbage_ctx->gc_set_.get())) {
-      for (auto &element : entry.second) {
-        if (element.second == RW_TYPE_DELETE || element.second == RW_TYPE_INS_DEL) {
-          // only old versions are stored in the gc set.
-          // so we can safely get indirection from the indirection array.
-          auto tile_group = catalog::Manager::GetInstance().GetTileGroup(entry.first);
-          if (tile_group != nullptr){
-            auto tile_group_header = catalog::Manager::GetInstance()
-                                         .GetTileGroup(entry.first)
-                                         ->GetHeader();
-            ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
-
-            DeleteTupleFromIndexes(indirection);
-          }
+    for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+      if (entry.type == RW_TYPE_DELETE || entry.type == RW_TYPE_INS_DEL) {
+        // only old versions are stored in the gc set.
+        // so we can safely get indirection from the indirection array.
+        auto tile_group = catalog::Manager::GetInstance().GetTileGroup(entry.tile_group_id);
+        if (tile_group != nullptr){
+          auto tile_group_header = tile_group->GetHeader();
+          ItemPointer *indirection = tile_group_header->GetIndirection(entry.tuple_id);
+
+          // the key is the one of the deleted version, the empty version
+          // the indirection points to has no values
+          DeleteTupleFromIndexes(ItemPointer(entry.tile_group_id, entry.tuple_id),
+                                 indirection);
         }
+      } else if (entry.type == RW_TYPE_UPDATE) {
+        // the other indexes still reach the newer version through the
+        // indirection, but covering indexes have an entry per version.
+        DeleteVersionFromCoveringIndexes(
+            ItemPointer(entry.tile_group_id, entry.tuple_id));
       }
     }
 
   } else {
     PL_ASSERT(gc_set_type == GC_SET_TYPE_ABORTED);
 
-    for (auto entry : *(garbage_ctx->gc_set_.get())) {
-      for (auto &element : entry.second) {
-        if (element.second == RW_TYPE_INSERT || element.second == RW_TYPE_INS_DEL) {
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
-          DeleteTupleFromIndexes(indirection);
-
-        }
+    for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+      if (entry.type == RW_TYPE_INSERT || entry.type == RW_TYPE_INS_DEL) {
+        auto tile_group_header = catalog::Manager::GetInstance()
+                                     .GetTileGroup(entry.tile_group_id)
+                                     ->GetHeader();
+        ItemPointer *indirection = tile_group_header->GetIndirection(entry.tuple_id);
+        DeleteTupleFromIndexes(ItemPointer(entry.tile_group_id, entry.tuple_id),
+                               indirection);
+
+      } else if (entry.type == RW_TYPE_UPDATE) {
+        // the aborted new version is stored in the gc set.
+        DeleteVersionFromCoveringIndexes(
+            ItemPointer(entry.tile_group_id, entry.tuple_id));
       }
     }
   }
 
 }
 
-// delete a tuple from all its indexes it belongs to.
-void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection) {
+// delete a tuple from all its indexes it belongs to, the keys being built
+// from the version at the location.
+void TransactionLevelGCManager::DeleteTupleFromIndexes(const ItemPointer &location,
+                                                       ItemPointer *indirection) {
   // do nothing if indirection is null
   if (indirection == nullptr){
     return;
   }
   LOG_TRACE("Deleting indirection %p from index", indirection);
-  
-  ItemPointer location = *indirection;
 
   auto &manager = catalog::Manager::GetInstance();
   auto tile_group = manager.GetTileGroup(location.block);
@@ -317,6 +569,9 @@ void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection)
   // unlink the version from all the indexes.
   for (size_t idx = 0; idx < table->GetIndexCount(); ++idx) {
     auto index = table->GetIndex(idx);
+    if (index == nullptr) {
+      continue;
+    }
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
 
@@ -324,12 +579,37 @@ void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection)
     std::unique_ptr<storage::Tuple> key(
       new storage::Tuple(index_schema, true));
     key->SetFromTuple(&expired_tuple, indexed_columns, index->GetPool());
+    index->SetVersionHint(key.get(), location);
 
     index->DeleteEntry(key.get(), indirection);
 
   }
 }
 
+// delete the entries of a version from the covering indexes of its table.
+void TransactionLevelGCManager::DeleteVersionFromCoveringIndexes(
+    const ItemPointer &location) {
+  auto tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(location.block);
+  if (tile_group == nullptr) {
+    return;
+  }
+
+  storage::DataTable *table =
+    dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+  PL_ASSERT(table != nullptr);
+
+  ItemPointer *indirection =
+      tile_group->GetHeader()->GetIndirection(location.offset);
+  if (indirection == nullptr) {
+    return;
+  }
+
+  expression::ContainerTuple<storage::TileGroup> expired_tuple(
+      tile_group.get(), location.offset);
+  table->DeleteFromCoveringIndexes(&expired_tuple, location, indirection);
+}
+
 
 }  // namespace gc
 }  // namespace peloton
@@ -83,6 +83,9 @@ class configuration {
   // tile group layout
   LayoutType layout_mode;
 
+  // tile group header layout
+  LayoutType header_layout_mode;
+
   double selectivity;
 
   double projectivity;
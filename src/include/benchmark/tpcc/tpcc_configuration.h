@@ -189,7 +189,10 @@ class configuration {
   bool gc_mode;
 
   // number of gc threads
-  bool gc_backend_count;
+  int gc_backend_count;
+
+  // concurrency control protocol
+  ConcurrencyType protocol;
 
   // throughput
   double throughput = 0;
@@ -70,11 +70,20 @@ class configuration {
   // store strings
   bool string_mode;
 
+  // tile group header layout
+  LayoutType header_layout;
+
+  // commit id allocation
+  TimestampType timestamp_type;
+
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
   // garbage collection
   bool gc_mode;
 
   // number of gc threads
-  bool gc_backend_count;
+  int gc_backend_count;
 
   // throughput
   double throughput = 0;
@@ -116,6 +125,8 @@ void ValidateZipfTheta(const configuration &state);
 
 void ValidateGCBackendCount(const configuration &state);
 
+void ValidateTimestampType(const configuration &state);
+
 void WriteOutput();
 
 }  // namespace ycsb
@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.h
+//
+// Identification: src/include/brain/tile_group_compactor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace brain {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Moves the live versions out of the sparse tile groups of tables and
+ * drops them once they are empty.
+ *
+ * A full tile group whose live versions make up at most the occupancy
+ * threshold of its slots is first retired, so that its slots are not reused.
+ * Once the transactions that may have missed the retirement have exited their
+ * epoch, its live versions are relocated by a transaction as updates that
+ * keep them unchanged. The tile group is dropped when the GC has collected
+ * all its slots.
+ *
+ * Compaction relies on the GC to collect the old versions, it does nothing
+ * when the GC is off.
+ */
+class TileGroupCompactor {
+ public:
+  TileGroupCompactor(const TileGroupCompactor &) = delete;
+  TileGroupCompactor &operator=(const TileGroupCompactor &) = delete;
+  TileGroupCompactor(TileGroupCompactor &&) = delete;
+  TileGroupCompactor &operator=(TileGroupCompactor &&) = delete;
+
+  TileGroupCompactor();
+
+  ~TileGroupCompactor();
+
+  // Singleton
+  static TileGroupCompactor &GetInstance();
+
+  // Start compacting
+  void Start();
+
+  // Compact the tables until stopped
+  void Run();
+
+  // One compaction pass over the tables
+  void Compact();
+
+  // Stop compacting
+  void Stop();
+
+  // Add table to list of tables that must be compacted
+  void AddTable(storage::DataTable *table);
+
+  // Remove table from the list, before it is dropped
+  void RemoveTable(storage::DataTable *table);
+
+  // Clear list, the tile groups being compacted are left retired
+  void ClearTables();
+
+  void SetOccupancyThreshold(double threshold) {
+    occupancy_threshold = threshold;
+  }
+
+  // Number of tile groups retired and not dropped yet
+  size_t GetRetiredTileGroupCount();
+
+ private:
+  /** A tile group being compacted. */
+  struct RetiredTileGroup {
+    storage::DataTable *table;
+
+    oid_t tile_group_offset;
+
+    // epoch at the retirement
+    size_t epoch;
+
+    bool relocated;
+  };
+
+  // Retire the sparse tile groups of the table
+  void RetireTileGroups(storage::DataTable *table);
+
+  // Relocate the live versions of the tile group, returns false if some of
+  // them must be relocated again later
+  bool RelocateTileGroup(const RetiredTileGroup &retired_tile_group);
+
+  // Tables that must be compacted
+  std::vector<storage::DataTable *> tables;
+
+  std::vector<RetiredTileGroup> retired_tile_groups;
+
+  std::mutex tile_group_compactor_mutex;
+
+  // Stop signal
+  std::atomic<bool> compaction_stop;
+
+  // Compactor thread
+  std::thread tile_group_compactor_thread;
+
+  //===--------------------------------------------------------------------===//
+  // Compactor Parameters
+  //===--------------------------------------------------------------------===//
+
+  // Share of the slots of a tile group that are live below which it is
+  // compacted
+  double occupancy_threshold = 0.1;
+
+  // Sleeping period (in us)
+  oid_t sleep_duration = 100000;
+};
+
+}  // End brain namespace
+}  // End peloton namespace
@@ -98,10 +98,15 @@ class Catalog {
   ResultType CreatePrimaryIndex(const std::string &database_name,
                             const std::string &table_name);
 
+  // The entries of the index carry the values of the include_attr columns,
+  // which only non-unique BWTREE indexes support. The index is built while
+  // the table is written, txn being the transaction of the caller if any.
   ResultType CreateIndex(const std::string &database_name,
                      const std::string &table_name,
                      std::vector<std::string> index_attr,
-                     std::string index_name, bool unique, IndexType index_type);
+                     std::string index_name, bool unique, IndexType index_type,
+                     std::vector<std::string> include_attr = {},
+                     concurrency::Transaction *txn = nullptr);
 
   // Get a index with the oids of index, table, and database.
   index::Index *GetIndexWithOid(const oid_t database_oid, const oid_t table_oid,
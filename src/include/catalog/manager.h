@@ -62,6 +62,17 @@ class Manager {
 
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // Returns the tile group without taking a reference on it, nullptr if it
+  // was dropped. Only valid while the caller is in a transaction: a dropped
+  // or replaced tile group is freed once every transaction of the epoch it
+  // was dropped in has exited.
+  inline storage::TileGroup *GetTileGroupRaw(const oid_t oid) const {
+    return tile_group_raw_locator_.Find(oid);
+  }
+
+  // Frees the dropped tile groups that no transaction can observe anymore
+  void ReclaimTileGroups();
+
   void ClearTileGroup(void);
 
 
@@ -96,8 +107,20 @@ class Manager {
 
   LockFreeArray<std::shared_ptr<storage::TileGroup>> tile_group_locator_;
 
+  LockFreeArray<storage::TileGroup *> tile_group_raw_locator_;
+
   static std::shared_ptr<storage::TileGroup> empty_tile_group_;
 
+  // Keeps a tile group alive until the transactions that may have looked it
+  // up have exited
+  void RetireTileGroup(std::shared_ptr<storage::TileGroup> &&tile_group);
+
+  /** Dropped tile groups with the epoch they were dropped in. */
+  std::vector<std::pair<size_t, std::shared_ptr<storage::TileGroup>>>
+      retired_tile_groups_;
+
+  std::mutex retired_tile_groups_lock_;
+
   //===--------------------------------------------------------------------===//
   // Data members for indirection array allocation
   //===--------------------------------------------------------------------===//
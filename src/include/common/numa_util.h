@@ -0,0 +1,47 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa_util.h
+//
+// Identification: src/include/common/numa_util.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// NUMA Utilities
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Placement of memory on the NUMA nodes.
+ * Without libnuma the machine is seen as a single node.
+ */
+class NumaUtil {
+ public:
+  // Node of memory that may be placed on any node
+  static const int ANY_NODE = -1;
+
+  // Whether the tables place their tile groups on the nodes of the threads
+  // inserting into them
+  static bool IsEnabled();
+
+  static size_t GetNodeCount();
+
+  // Node of the cpu the calling thread runs on
+  static size_t GetCurrentNode();
+
+  // Asks the kernel to place the pages of the memory on the node, moving the
+  // pages already placed elsewhere. Only the pages lying entirely in the
+  // memory are bound, the others may be shared with other allocations.
+  static void BindMemory(void *address, size_t size, int node);
+};
+
+}  // End peloton namespace
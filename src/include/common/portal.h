@@ -22,6 +22,10 @@ namespace peloton {
 
 class Statement;
 
+namespace bridge {
+class PlanCursor;
+}
+
 class Portal {
  public:
   Portal() = delete;
@@ -55,6 +59,14 @@ class Portal {
 
   // The serialized params for stats collection
   std::shared_ptr<stats::QueryMetric::QueryParams> param_stat_;
+
+  // Executor state of a portal that was suspended after reaching the row
+  // limit of an Execute message. Set and cleared by the traffic cop, which
+  // must close the portal before it is destroyed.
+  std::unique_ptr<bridge::PlanCursor> cursor_;
+
+  // Was the transaction of the cursor started for this statement alone?
+  bool single_statement_txn_ = false;
 };
 
 }  // namespace peloton
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 #include <thread>
 
@@ -57,6 +58,9 @@ class ThreadPool {
     thread_pool_.join_all();
   }
 
+  // number of threads in the thread pool.
+  size_t GetPoolSize() const { return pool_size_; }
+
   // submit task to thread pool.
   // it accepts a function and a set of function parameters as parameters.
   template <typename FunctionType, typename... ParamTypes>
@@ -75,6 +79,13 @@ class ThreadPool {
     dedicated_threads_[thread_id].reset(new std::thread(std::thread(func, params...)));
   }
 
+  // run tasks on the caller and on up to worker_count - 1 threads of the
+  // pool. body is called with the id of the worker running the task and the
+  // task. it returns once all the tasks are done, rethrowing the first
+  // exception thrown by a task.
+  void RunTasks(size_t worker_count, size_t task_count,
+                const std::function<void(size_t, size_t)> &body);
+
  private:
   ThreadPool(const ThreadPool &);
   ThreadPool &operator=(const ThreadPool &);
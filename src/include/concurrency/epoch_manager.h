@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <limits>
 #include <thread>
 #include <vector>
 
@@ -143,11 +144,52 @@ public:
     return max_cid_gc_;
   }
 
+  // the cid GetMaxDeadTxnCid last returned, without moving the tails, for
+  // readers that check it often.
+  cid_t GetLastDeadTxnCid() const {
+    return max_cid_gc_;
+  }
+
   cid_t GetReadOnlyTxnCid() {
     IncreaseQueueTail();
     return max_cid_ro_;
   }
 
+  // objects unlinked now may still be observed by the transactions of the
+  // current epoch or an older one.
+  size_t GetCurrentEpoch() const {
+    return current_epoch_.load();
+  }
+
+  // whether every transaction that entered the epoch or an older one
+  // has exited it.
+  bool IsEpochExited(size_t epoch) {
+    for (auto itr = reclaim_tail_.load(); itr <= epoch; ++itr) {
+      auto &entry = epoch_queue_[itr % epoch_queue_size_];
+      if (entry.ro_txn_ref_count_ > 0 || entry.rw_txn_ref_count_ > 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // whether every read-write transaction that entered the epoch or an older
+  // one has exited it, but for the one of the caller that entered own_epoch,
+  // which would otherwise wait for itself. Read-only transactions do not
+  // write, they are not waited for.
+  bool IsEpochExitedByWriters(
+      size_t epoch,
+      size_t own_epoch = std::numeric_limits<size_t>::max()) {
+    for (auto itr = queue_tail_.load(); itr <= epoch; ++itr) {
+      auto &entry = epoch_queue_[itr % epoch_queue_size_];
+      int own_txn_count = (itr == own_epoch) ? 1 : 0;
+      if (entry.rw_txn_ref_count_ > own_txn_count) {
+        return false;
+      }
+    }
+    return true;
+  }
+
 private:
   void Start() {
     while (!finish_) {
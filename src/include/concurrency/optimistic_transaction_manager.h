@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.h
+//
+// Identification: src/include/concurrency/optimistic_transaction_manager.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// optimistic concurrency control
+//===--------------------------------------------------------------------===//
+
+/**
+ * Silo-style optimistic concurrency control over the version chains of
+ * timestamp ordering.
+ *
+ * Reads do not touch the tuple headers, they are only recorded in the read
+ * write set. Writes take the ownership of the latest version as in timestamp
+ * ordering. At commit, the transaction takes a commit id and validates that
+ * every version it read is still the latest committed one and not owned by a
+ * concurrent transaction; otherwise it aborts.
+ *
+ * Transactions begin with a commit id from GetNextCommitId, so their
+ * snapshots follow the timestamp type of the manager. Commit ids are always
+ * taken from the global counter, as validation relies on them being ordered
+ * by the time they are taken.
+ */
+class OptimisticTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  OptimisticTransactionManager() {}
+
+  virtual ~OptimisticTransactionManager() {}
+
+  static OptimisticTransactionManager &GetInstance();
+
+  // Only the latest version of a tuple can be owned.
+  virtual bool IsOwnable(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location,
+                           bool acquire_ownership = false);
+
+  virtual ResultType CommitTransaction(Transaction *const current_txn);
+
+ private:
+  // Whether the versions read by the transaction are still current at its
+  // end commit id.
+  bool ValidateReadSet(Transaction *const current_txn);
+};
+}
+}
@@ -42,6 +42,12 @@ class TimestampOrderingTransactionManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual void IsVisibleBatch(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &start, const oid_t &end,
+      std::vector<oid_t> &visible_tuples);
+
   // This method test whether the current transaction is the owner of a tuple.
   virtual bool IsOwner(Transaction *const current_txn,
                        const storage::TileGroupHeader *const tile_group_header,
@@ -108,7 +114,11 @@ class TimestampOrderingTransactionManager : public TransactionManager {
 
   virtual void EndReadonlyTransaction(Transaction *current_txn);
 
-private:
+protected:
+  // Installs the write set with the end commit id of the transaction and
+  // ends it.
+  ResultType CommitWriteSet(Transaction *const current_txn);
+
   static const int LOCK_OFFSET = 0;
   static const int LAST_READER_OFFSET = (LOCK_OFFSET + 8);
 
@@ -21,6 +21,7 @@
 #include "common/exception.h"
 #include "common/item_pointer.h"
 #include "common/printable.h"
+#include "container/read_write_set.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -43,22 +44,46 @@ class Transaction : public Printable {
   }
 
   Transaction(const txn_id_t &txn_id, const cid_t &begin_cid, bool ro) {
-    Init(txn_id, begin_cid);
-    declared_readonly_ = ro;
+    Init(txn_id, begin_cid, ro);
   }
 
   ~Transaction() {}
 
-  void Init(const txn_id_t &txn_id, const cid_t &begin_cid) {
+  // A declared read-only transaction reads a snapshot: it records no reads
+  // and has nothing to collect, so it gets no GC set.
+  void Init(const txn_id_t &txn_id, const cid_t &begin_cid,
+            bool ro = false) {
     txn_id_ = txn_id;
     begin_cid_ = begin_cid;
     end_cid_ = MAX_CID;
     is_written_ = false;
-    declared_readonly_ = false;
+    declared_readonly_ = ro;
     insert_count_ = 0;
-    gc_set_.reset(new ReadWriteSet());
+    result_ = ResultType::SUCCESS;
+    rw_set_.Clear();
+    if (ro == true) {
+      gc_set_.reset();
+    } else if (gc_set_ != nullptr && gc_set_.use_count() == 1) {
+      // the gc manager is done with the set of the previous transaction.
+      // use_count() is a relaxed load, the fence orders its reads of the set
+      // before our writes to it.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      gc_set_->Clear();
+    } else {
+      gc_set_.reset(new ReadWriteSet());
+    }
   }
 
+  // Transactions are recycled through a free list of the thread that ends
+  // them, together with the memory of their sets.
+  static Transaction *Allocate(const txn_id_t &txn_id, const cid_t &begin_cid,
+                               bool ro = false);
+
+  static void Free(Transaction *txn);
+
+  /** @brief Number of transactions a thread keeps for reuse. */
+  static const size_t free_list_size = 16;
+
   //===--------------------------------------------------------------------===//
   // Mutators and Accessors
   //===--------------------------------------------------------------------===//
@@ -92,7 +117,9 @@ class Transaction : public Printable {
 
   inline std::shared_ptr<ReadWriteSet> GetGCSetPtr() { return gc_set_; }
 
-  inline bool IsGCSetEmpty() { return gc_set_->size() == 0; }
+  inline bool IsGCSetEmpty() {
+    return gc_set_ == nullptr || gc_set_->IsEmpty();
+  }
 
   // Get a string representation for debugging
   const std::string GetInfo() const;
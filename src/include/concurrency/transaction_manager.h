@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "storage/tile_group_header.h"
 #include "concurrency/transaction.h"
@@ -46,13 +47,29 @@ class TransactionManager {
     next_txn_id_ = ATOMIC_VAR_INIT(START_TXN_ID);
     next_cid_ = ATOMIC_VAR_INIT(START_CID);
     maximum_grant_cid_ = ATOMIC_VAR_INIT(MAX_CID);
+    batch_generation_ = ATOMIC_VAR_INIT(0);
   }
 
   virtual ~TransactionManager() {}
 
-  txn_id_t GetNextTransactionId() { return next_txn_id_++; }
+  txn_id_t GetNextTransactionId() {
+    if (timestamp_type_ == TimestampType::EPOCH_BATCHED) {
+      return GetNextBatchedTransactionId();
+    }
+    return next_txn_id_++;
+  }
 
+  // Commit id of a new transaction
   cid_t GetNextCommitId() {
+    if (timestamp_type_ == TimestampType::EPOCH_BATCHED) {
+      return GetNextBatchedCommitId();
+    }
+    return GetNextGlobalCommitId();
+  }
+
+  // Commit id larger than any handed out so far, including the ones left in
+  // the ranges of the workers
+  cid_t GetNextGlobalCommitId() {
     cid_t temp_cid = next_cid_++;
     // wait if we do not yet have a grant for this commit id
     while (temp_cid > maximum_grant_cid_.load())
@@ -60,6 +77,29 @@ class TransactionManager {
     return temp_cid;
   }
 
+  /**
+   * With EPOCH_BATCHED timestamps, every worker takes a range of
+   * commit_id_batch_size commit ids (and transaction ids) from the global
+   * counters and hands them out locally. A range is dropped once the epoch
+   * advances, so a transaction entering an epoch gets a commit id larger
+   * than any transaction of the epochs before the previous one. These
+   * epochs are the ones the read-only and GC commit ids of the EpochManager
+   * are computed from, which keeps their semantics.
+   *
+   * Commit ids are unique and grow on every worker, but the transactions of
+   * different workers are not ordered as they begin, so a worker may begin
+   * a transaction older than one that already committed elsewhere.
+   */
+  void SetTimestampType(const TimestampType timestamp_type) {
+    timestamp_type_ = timestamp_type;
+    batch_generation_++;
+  }
+
+  TimestampType GetTimestampType() const { return timestamp_type_; }
+
+  /** @brief Number of ids a worker takes at a time. */
+  static const cid_t commit_id_batch_size = 64;
+
   cid_t GetCurrentCommitId() { return next_cid_.load(); }
 
   // This method is used for avoiding concurrent inserts.
@@ -72,6 +112,22 @@ class TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id) = 0;
 
+  // Collect the offsets in [start, end) of the tile group whose versions are
+  // visible to the current transaction. Scans call this once per tile group
+  // instead of calling IsVisible for every slot.
+  virtual void IsVisibleBatch(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &start, const oid_t &end,
+      std::vector<oid_t> &visible_tuples) {
+    for (oid_t tuple_id = start; tuple_id < end; tuple_id++) {
+      if (IsVisible(current_txn, tile_group_header, tuple_id) ==
+          VisibilityType::OK) {
+        visible_tuples.push_back(tuple_id);
+      }
+    }
+  }
+
   // This method test whether the current transaction is the owner of a tuple.
   virtual bool IsOwner(
       Transaction *const current_txn, 
@@ -132,7 +188,10 @@ class TransactionManager {
   }
 
   // for use by recovery
-  void SetNextCid(cid_t cid) { next_cid_ = cid; }
+  void SetNextCid(cid_t cid) {
+    next_cid_ = cid;
+    batch_generation_++;
+  }
 
   void SetMaxGrantCid(cid_t cid) { maximum_grant_cid_ = cid; }
 
@@ -151,6 +210,7 @@ class TransactionManager {
   void ResetStates() {
     next_txn_id_ = START_TXN_ID;
     next_cid_ = START_CID;
+    batch_generation_++;
   }
 
   // this function generates the maximum commit id of committed transactions.
@@ -160,6 +220,20 @@ class TransactionManager {
     return EpochManagerFactory::GetInstance().GetMaxDeadTxnCid();
   }
 
+  // the maximum commit id the GC last got, which lags behind the one above
+  // but is read without updating the epoch queue.
+  cid_t GetLastMaxCommittedCid() {
+    return EpochManagerFactory::GetInstance().GetLastDeadTxnCid();
+  }
+
+  // Cooperative garbage collection. Cuts the link from a version that the
+  // current transaction reads to its older version, if that version ended
+  // before dead_cid and so is not observed by any transaction anymore.
+  // Returns true if the link was cut.
+  bool PruneVersionChain(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id, const cid_t &dead_cid);
+
   void SetDirtyRange(std::pair<cid_t, cid_t> dirty_range) {
     this->dirty_range_ = dirty_range;
   }
@@ -174,9 +248,18 @@ class TransactionManager {
       std::make_pair(INVALID_CID, INVALID_CID);
 
  private:
+  cid_t GetNextBatchedCommitId();
+
+  txn_id_t GetNextBatchedTransactionId();
+
   std::atomic<txn_id_t> next_txn_id_;
   std::atomic<cid_t> next_cid_;
   std::atomic<cid_t> maximum_grant_cid_;
+
+  TimestampType timestamp_type_ = TimestampType::CENTRALIZED;
+
+  // bumped whenever the ranges taken so far become invalid
+  std::atomic<size_t> batch_generation_;
 };
 }  // End storage namespace
 }  // End peloton namespace
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "concurrency/optimistic_transaction_manager.h"
 #include "concurrency/timestamp_ordering_transaction_manager.h"
 
 namespace peloton {
@@ -25,24 +26,34 @@ class TransactionManagerFactory {
       case ConcurrencyType::TIMESTAMP_ORDERING:
         return TimestampOrderingTransactionManager::GetInstance();
 
+      case ConcurrencyType::OPTIMISTIC:
+        return OptimisticTransactionManager::GetInstance();
+
       default:
         return TimestampOrderingTransactionManager::GetInstance();
     }
   }
 
-  static void Configure(ConcurrencyType protocol,
-                        IsolationLevelType level = IsolationLevelType::FULL) {
+  static void Configure(
+      ConcurrencyType protocol,
+      IsolationLevelType level = IsolationLevelType::FULL,
+      TimestampType timestamp_type = TimestampType::CENTRALIZED) {
     protocol_ = protocol;
     isolation_level_ = level;
+    timestamp_type_ = timestamp_type;
+    GetInstance().SetTimestampType(timestamp_type);
   }
 
   static ConcurrencyType GetProtocol() { return protocol_; }
 
   static IsolationLevelType GetIsolationLevel() { return isolation_level_; }
 
+  static TimestampType GetTimestampType() { return timestamp_type_; }
+
  private:
   static ConcurrencyType protocol_;
   static IsolationLevelType isolation_level_;
+  static TimestampType timestamp_type_;
 };
 }
 }
\ No newline at end of file
@@ -35,6 +35,12 @@ DECLARE_string(socket_family);
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+// Number of threads scanning a table in parallel
+DECLARE_uint64(parallel_scan_threads);
+
+// Place tile groups on the NUMA node of the threads inserting into them
+DECLARE_bool(numa_aware);
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -67,6 +73,9 @@ DECLARE_bool(index_tuner);
 // Enable or disable layout tuner
 DECLARE_bool(layout_tuner);
 
+// Enable or disable tile group compactor
+DECLARE_bool(tile_group_compactor);
+
 //===----------------------------------------------------------------------===//
 // GENERAL
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.h
+//
+// Identification: src/include/container/read_write_set.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Set of the tuples a transaction accessed, with the type of the
+ * access.
+ *
+ * The entries are kept flat in the order they were added. Small sets are
+ * searched by scanning the entries; once a set outgrows inline_entry_count,
+ * an open-addressing index over the entries is built. Clear keeps the memory
+ * of both, so a recycled set does not allocate again.
+ */
+class ReadWriteSet {
+ public:
+  struct Entry {
+    oid_t tile_group_id;
+    oid_t tuple_id;
+    RWType type;
+  };
+
+  typedef std::vector<Entry>::iterator iterator;
+  typedef std::vector<Entry>::const_iterator const_iterator;
+
+  /** @brief Number of entries searched without the index. */
+  static const size_t inline_entry_count = 8;
+
+  /** @brief Number of entries reserved up front. */
+  static const size_t initial_capacity = 64;
+
+  ReadWriteSet() { entries_.reserve(initial_capacity); }
+
+  ReadWriteSet(const ReadWriteSet &) = delete;
+  ReadWriteSet &operator=(const ReadWriteSet &) = delete;
+
+  // Type of the access to the tuple, nullptr if the set does not have it
+  RWType *Find(const oid_t tile_group_id, const oid_t tuple_id);
+
+  // Adds a tuple the set does not have
+  void Insert(const oid_t tile_group_id, const oid_t tuple_id,
+              const RWType type);
+
+  // Adds the tuple or overwrites the type of its access
+  void Set(const oid_t tile_group_id, const oid_t tuple_id,
+           const RWType type);
+
+  void Clear();
+
+  size_t GetSize() const { return entries_.size(); }
+
+  bool IsEmpty() const { return entries_.empty(); }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+ private:
+  static inline uint64_t Hash(const oid_t tile_group_id,
+                              const oid_t tuple_id) {
+    uint64_t key = ((uint64_t)tile_group_id << 32) | tuple_id;
+    return (key * 0x9E3779B97F4A7C15ULL) >> 32;
+  }
+
+  // Rebuilds the index with slot_count slots, a power of two
+  void BuildIndex(size_t slot_count);
+
+  void IndexEntry(uint32_t entry_offset);
+
+  std::vector<Entry> entries_;
+
+  // Offset + 1 of the entry of each slot, 0 if the slot is empty. Only
+  // meaningful while the set has more than inline_entry_count entries.
+  std::vector<uint32_t> slots_;
+
+  size_t slot_mask_ = 0;
+};
+
+}  // End peloton namespace
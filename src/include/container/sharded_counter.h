@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// sharded_counter.h
+//
+// Identification: src/include/container/sharded_counter.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "common/platform.h"
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// Sharded Counter
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Counter updated by many threads and rarely read.
+ * Every thread updates a shard of its own, on its own cache line, and a read
+ * sums the shards. A read racing with updates sees some of them only.
+ */
+class ShardedCounter {
+ public:
+  /** @brief Number of shards, threads beyond it share shards. */
+  static const size_t shard_count = 32;
+
+  ShardedCounter() { Set(0); }
+
+  ShardedCounter(const ShardedCounter &) = delete;
+  ShardedCounter &operator=(const ShardedCounter &) = delete;
+
+  inline void Add(int64_t amount) {
+    shards_[GetShardOffset()].value.fetch_add(amount,
+                                              std::memory_order_relaxed);
+  }
+
+  inline void Subtract(int64_t amount) { Add(-amount); }
+
+  // Not atomic with respect to concurrent updates
+  void Set(int64_t value);
+
+  int64_t Get() const;
+
+ private:
+  // padded to a cache line, so that no two shards share one
+  struct Shard {
+    std::atomic<int64_t> value;
+    char padding[CACHELINE_SIZE - sizeof(std::atomic<int64_t>)];
+  };
+
+  // Shard of the calling thread
+  static size_t GetShardOffset();
+
+  Shard shards_[shard_count];
+};
+
+}  // End peloton namespace
@@ -17,8 +17,15 @@
 #include "executor/abstract_executor.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroup;
+}
+
 namespace executor {
 
+class JoinBloomFilter;
+
 /**
  * Super class for different kinds of scan executor.
  * It provides common codes for all kinds of scan:
@@ -41,11 +48,32 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   virtual void ResetState() {}
 
+  /**
+   * @brief Pushes down the bloom filter of the build side of a hash join.
+   * The tuples whose join key is not in the filter are skipped before they
+   * are read. Must be called after the executor is initialized.
+   * @param join_filter Filter owned by the join.
+   * @param key_column_offsets Offsets of the join key columns in the output
+   * tiles of the scan.
+   */
+  void SetJoinFilter(const JoinBloomFilter *join_filter,
+                     const std::vector<oid_t> &key_column_offsets);
+
  protected:
   bool DInit();
 
   virtual bool DExecute() = 0;
 
+  // Whether the join key of the tuple may be in the join filter
+  bool PassesJoinFilter(storage::TileGroup *tile_group, oid_t tuple_id) const;
+
+  // Removes the tuples whose join key is not in the join filter
+  void ApplyJoinFilter(storage::TileGroup *tile_group,
+                       std::vector<oid_t> &position_list) const;
+
+  void RecordJoinFilterProbes(oid_t database_id, oid_t table_id,
+                              size_t probe_count, size_t pass_count) const;
+
  protected:
   //===--------------------------------------------------------------------===//
   // Plan Info
@@ -56,6 +84,16 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   /** @brief Columns from tile group to be added to logical tile output. */
   std::vector<oid_t> column_ids_;
+
+  //===--------------------------------------------------------------------===//
+  // Join Filter
+  //===--------------------------------------------------------------------===//
+
+  /** @brief Bloom filter pushed down by a hash join, if any. */
+  const JoinBloomFilter *join_filter_ = nullptr;
+
+  /** @brief Tile group columns of the join key. */
+  std::vector<oid_t> join_filter_column_ids_;
 };
 
 }  // namespace executor
@@ -229,6 +229,13 @@ class MinAggregator : public AbstractAttributeAggregator {
 AbstractAttributeAggregator *GetAttributeAggregatorInstance(
     ExpressionType agg_type);
 
+/** brief Insert the output tuple of a group given its aggregated values */
+bool InsertAggregateTuple(const planner::AggregatePlan *node,
+                          std::vector<type::Value> &aggregate_values,
+                          storage::AbstractTable *output_table,
+                          const AbstractTuple *delegate_tuple,
+                          executor::ExecutorContext *econtext);
+
 /*
  * Interface for an aggregator (not an an individual attribute aggregate)
  *
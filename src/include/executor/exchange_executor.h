@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_executor.h
+//
+// Identification: src/include/executor/exchange_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+
+#include "executor/abstract_executor.h"
+
+namespace peloton {
+namespace executor {
+
+class SeqScanExecutor;
+
+/**
+ * Runs a sequential scan of a table on the worker threads of the thread pool.
+ * The tile groups of the table are the morsels of the scan: each worker scans
+ * the morsels of its own range and steals from the other ranges once it is
+ * empty. The thread executing the plan takes part in the scan when no result
+ * is ready, so the scan progresses even if the pool has no free thread.
+ *
+ * Only the visibility check and the predicate run on the workers; the reads
+ * are recorded in the transaction by the thread executing the plan.
+ */
+class ExchangeExecutor : public AbstractExecutor {
+ public:
+  ExchangeExecutor(const ExchangeExecutor &) = delete;
+  ExchangeExecutor &operator=(const ExchangeExecutor &) = delete;
+  ExchangeExecutor(ExchangeExecutor &&) = delete;
+  ExchangeExecutor &operator=(ExchangeExecutor &&) = delete;
+
+  explicit ExchangeExecutor(const planner::AbstractPlan *node,
+                            ExecutorContext *executor_context);
+
+  ~ExchangeExecutor();
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  struct ScanState;
+
+  void StopWorkers();
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  /** @brief The scan run in parallel, owned by the exchange so that the
+   *  workers are stopped before it is destroyed. */
+  std::unique_ptr<SeqScanExecutor> scan_;
+
+  /** @brief State shared with the workers. */
+  std::shared_ptr<ScanState> state_;
+};
+
+}  // namespace executor
+}  // namespace peloton
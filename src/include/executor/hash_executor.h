@@ -13,15 +13,13 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
+#include <memory>
+#include <vector>
 
 #include "type/types.h"
 #include "executor/abstract_executor.h"
 #include "executor/logical_tile.h"
-#include "common/container_tuple.h"
-
-#include <boost/functional/hash.hpp>
+#include "executor/join_hash_table.h"
 
 namespace peloton {
 namespace executor {
@@ -40,15 +38,7 @@ class HashExecutor : public AbstractExecutor {
   explicit HashExecutor(const planner::AbstractPlan *node,
                         ExecutorContext *executor_context);
 
-  /** @brief Type definitions for hash table */
-  typedef std::unordered_map<
-      expression::ContainerTuple<LogicalTile>,
-      std::unordered_set<std::pair<size_t, oid_t>,
-                         boost::hash<std::pair<size_t, oid_t>>>,
-      expression::ContainerTupleHasher<LogicalTile>,
-      expression::ContainerTupleComparator<LogicalTile>> HashMapType;
-
-  inline HashMapType &GetHashTable() { return this->hash_table_; }
+  inline const JoinHashTable &GetHashTable() const { return this->hash_table_; }
 
   inline const std::vector<oid_t> &GetHashKeyIds() const {
     return this->column_ids_;
@@ -61,7 +51,7 @@ class HashExecutor : public AbstractExecutor {
 
  private:
   /** @brief Hash table */
-  HashMapType hash_table_;
+  JoinHashTable hash_table_;
 
   /** @brief Input tiles from child node */
   std::vector<std::unique_ptr<LogicalTile>> child_tiles_;
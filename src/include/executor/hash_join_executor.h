@@ -14,11 +14,13 @@
 #pragma once
 
 #include <deque>
+#include <memory>
 #include <vector>
 
 #include "executor/abstract_join_executor.h"
 #include "planner/hash_join_plan.h"
 #include "executor/hash_executor.h"
+#include "executor/join_bloom_filter.h"
 
 namespace peloton {
 namespace executor {
@@ -37,13 +39,32 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  const std::vector<oid_t> &GetLeftKeyIds();
+
+  void PushDownBloomFilter();
+
   HashExecutor *hash_executor_ = nullptr;
 
+  // Filter of the build keys pushed down into the left scan, if any
+  std::unique_ptr<JoinBloomFilter> bloom_filter_;
+
   bool hashed_ = false;
 
+  /** A left tuple and a right tuple with the same key */
+  struct JoinMatch {
+    oid_t right_tile_itr;
+    oid_t right_tuple_id;
+    oid_t left_tuple_id;
+  };
+
   std::deque<LogicalTile *> buffered_output_tiles;
   std::vector<std::unique_ptr<LogicalTile>> right_tiles_;
 
+  // Probe state of the current left tile, kept to reuse the buffers
+  std::vector<oid_t> left_tuple_ids_;
+  std::vector<uint64_t> left_hashes_;
+  std::vector<JoinMatch> matches_;
+
   // logical tile iterators
   size_t left_logical_tile_itr_ = 0;
   size_t right_logical_tile_itr_ = 0;
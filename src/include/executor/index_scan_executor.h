@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "executor/abstract_scan_executor.h"
@@ -53,8 +54,27 @@ class IndexScanExecutor : public AbstractScanExecutor {
   //===--------------------------------------------------------------------===//
   // Helper
   //===--------------------------------------------------------------------===//
-  bool ExecPrimaryIndexLookup();
-  bool ExecSecondaryIndexLookup();
+  // Pulls the next batch of index entries, returns false once the scan is
+  // over. The key values of the entries are pulled as well from covering
+  // indices
+  bool ScanNextBatch(std::vector<ItemPointer *> &tuple_location_ptrs,
+                     std::vector<type::Value> &key_values);
+
+  // Build the logical tiles of the visible tuples of a batch
+  bool ExecPrimaryIndexLookup(
+      const std::vector<ItemPointer *> &tuple_location_ptrs);
+  bool ExecSecondaryIndexLookup(
+      const std::vector<ItemPointer *> &tuple_location_ptrs);
+
+  // The entries of a covering index are per version, the visibility of each
+  // is that of the version its key locates. In an index-only scan the output
+  // is read from the keys rather than from the table
+  bool ExecCoveringIndexLookup(
+      const std::vector<ItemPointer *> &tuple_location_ptrs,
+      const std::vector<type::Value> &key_values);
+
+  // Groups the visible tuples per tile group into the result tiles
+  void BuildResultTiles(const std::vector<ItemPointer> &visible_tuple_locations);
 
   // When the required scan range has open boundaries, the tuples found by the
   // index might not be exact since the index can only give back tuples in a
@@ -80,6 +100,12 @@ class IndexScanExecutor : public AbstractScanExecutor {
   /** @brief Computed the result */
   bool done_ = false;
 
+  /** @brief Cursor over the index entries of the scan */
+  std::unique_ptr<index::IndexScanCursor> scan_cursor_;
+
+  /** @brief Number of index entries pulled at a time */
+  static const size_t scan_batch_size = 1024;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
@@ -129,6 +155,12 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   // whether order by is descending
   bool descend_ = false;
+
+  // whether the output is read from the entries of a covering index
+  bool index_only_ = false;
+
+  // schema of the tiles of an index-only scan, the output columns of the table
+  std::unique_ptr<catalog::Schema> index_only_schema_;
 };
 
 }  // namespace executor
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_bloom_filter.h
+//
+// Identification: src/include/executor/join_bloom_filter.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Bloom filter over the key hashes of the build side of a hash join.
+ *
+ * The filter is blocked: the bits of a hash are all set in the same 64-bit
+ * word, so a lookup touches a single cache line. It is pushed down into the
+ * scan of the probe side, which skips the tuples whose key hash is not in the
+ * filter. A lookup may pass for a key that is not in the build side, but
+ * never fails for one that is.
+ *
+ * The hashes are the ones of JoinHashTable::HashKey.
+ */
+class JoinBloomFilter {
+ public:
+  JoinBloomFilter(const JoinBloomFilter &) = delete;
+  JoinBloomFilter &operator=(const JoinBloomFilter &) = delete;
+
+  /** Number of bits of the filter per build key. */
+  static const size_t bits_per_key = 16;
+
+  // Sizes the filter for the given number of keys
+  explicit JoinBloomFilter(size_t key_count);
+
+  inline void Insert(uint64_t hash) {
+    words_[GetWordOffset(hash)] |= GetMask(hash);
+  }
+
+  inline bool MayContain(uint64_t hash) const {
+    uint64_t mask = GetMask(hash);
+    return (words_[GetWordOffset(hash)] & mask) == mask;
+  }
+
+  size_t GetWordCount() const { return words_.size(); }
+
+ private:
+  // The bits of the hash that pick the bits of the word are not the ones
+  // that pick the word
+  inline size_t GetWordOffset(uint64_t hash) const {
+    return (hash >> 18) & word_mask_;
+  }
+
+  inline static uint64_t GetMask(uint64_t hash) {
+    return ((uint64_t)1 << (hash & 63)) | ((uint64_t)1 << ((hash >> 6) & 63)) |
+           ((uint64_t)1 << ((hash >> 12) & 63));
+  }
+
+  size_t word_mask_;
+
+  std::vector<uint64_t> words_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -0,0 +1,221 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_hash_table.h
+//
+// Identification: src/include/executor/join_hash_table.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+
+namespace storage {
+class TileGroup;
+}
+
+namespace executor {
+
+class LogicalTile;
+
+/**
+ * @brief Hash table of the build side of a hash join.
+ *
+ * The build tuples are materialized as flat entries holding the hash of their
+ * join key and their location. Entries with the same key are chained, the
+ * first one being stored in an open-addressing table with linear probing.
+ *
+ * When the table would not fit in the L2 cache, the entries are radix
+ * partitioned on the top bits of their hash first, each partition getting its
+ * own table sized to fit in the cache. The probe looks up a batch of hashes,
+ * prefetching the slots a few lookups ahead.
+ */
+class JoinHashTable {
+ public:
+  /** A build tuple */
+  struct Entry {
+    uint64_t hash;
+
+    // Offset of the logical tile of the tuple in the build input
+    uint32_t tile_itr;
+
+    oid_t tuple_id;
+
+    // Next entry with the same key
+    uint32_t next;
+  };
+
+  /** Size of the L2 cache the partitions are sized to. */
+  static const size_t l2_cache_size = 256 * 1024;
+
+  /** Number of lookups the probe prefetches ahead. */
+  static const size_t prefetch_distance = 8;
+
+  // Hash of the key of a tuple
+  static uint64_t HashKey(LogicalTile *tile, oid_t tuple_id,
+                          const std::vector<oid_t> &column_ids);
+
+  // Same hash for a tuple of a tile group, the column ids being the ones of
+  // the tile group
+  static uint64_t HashKey(storage::TileGroup *tile_group, oid_t tuple_id,
+                          const std::vector<oid_t> &column_ids);
+
+  // Whether the keys of two tuples are equal
+  static bool KeysEqual(LogicalTile *left_tile, oid_t left_tuple_id,
+                        const std::vector<oid_t> &left_column_ids,
+                        LogicalTile *right_tile, oid_t right_tuple_id,
+                        const std::vector<oid_t> &right_column_ids);
+
+  void Clear();
+
+  inline void Insert(uint64_t hash, uint32_t tile_itr, oid_t tuple_id) {
+    entries_.push_back({hash, tile_itr, tuple_id, INVALID_ENTRY});
+  }
+
+  /**
+   * @brief Builds the table out of the inserted entries.
+   * @param key_equal Compares the keys of two entries.
+   * @param on_duplicate Called for each entry whose key is the key of an
+   *        entry inserted before it.
+   */
+  template <typename KeyEqual, typename OnDuplicate>
+  void Build(KeyEqual key_equal, OnDuplicate on_duplicate);
+
+  /**
+   * @brief Looks up a batch of hashes.
+   * @param key_equal Compares the key of the i-th probe tuple to an entry.
+   * @param on_match Called with i and each entry matching the i-th probe
+   *        tuple.
+   */
+  template <typename KeyEqual, typename OnMatch>
+  void ProbeBatch(const uint64_t *hashes, size_t count, KeyEqual key_equal,
+                  OnMatch on_match) const;
+
+  size_t GetEntryCount() const { return entries_.size(); }
+
+  const std::vector<Entry> &GetEntries() const { return entries_; }
+
+  size_t GetPartitionCount() const { return partitions_.size(); }
+
+ private:
+  static const uint32_t INVALID_ENTRY = UINT32_MAX;
+
+  /** Slot of a table, the hash is kept to compare it without a jump. */
+  struct Slot {
+    uint64_t hash;
+
+    // Offset + 1 of the first entry with the key, 0 if the slot is empty
+    uint32_t head;
+  };
+
+  struct Partition {
+    size_t slot_offset;
+    size_t mask;
+  };
+
+  void PartitionEntries();
+
+  inline const Partition &GetPartition(uint64_t hash) const {
+    return partitions_[partition_bits_ == 0 ? 0
+                                            : hash >> (64 - partition_bits_)];
+  }
+
+  inline const Slot *GetFirstSlot(uint64_t hash) const {
+    auto &partition = GetPartition(hash);
+    return &slots_[partition.slot_offset + (hash & partition.mask)];
+  }
+
+  size_t partition_bits_ = 0;
+
+  std::vector<Entry> entries_;
+
+  std::vector<Partition> partitions_;
+
+  std::vector<Slot> slots_;
+};
+
+template <typename KeyEqual, typename OnDuplicate>
+void JoinHashTable::Build(KeyEqual key_equal, OnDuplicate on_duplicate) {
+  // Group the entries by partition, so that the table of one partition is
+  // filled at a time
+  PartitionEntries();
+
+  for (uint32_t entry_itr = 0; entry_itr < entries_.size(); entry_itr++) {
+    Entry &entry = entries_[entry_itr];
+    auto &partition = GetPartition(entry.hash);
+    size_t slot_itr = entry.hash & partition.mask;
+
+    while (true) {
+      Slot &slot = slots_[partition.slot_offset + slot_itr];
+      if (slot.head == 0) {
+        slot.hash = entry.hash;
+        slot.head = entry_itr + 1;
+        break;
+      }
+
+      Entry &head = entries_[slot.head - 1];
+      if (slot.hash == entry.hash && key_equal(head, entry)) {
+        // Chain it right after the head
+        entry.next = head.next;
+        head.next = entry_itr;
+        on_duplicate(entry);
+        break;
+      }
+      slot_itr = (slot_itr + 1) & partition.mask;
+    }
+  }
+}
+
+template <typename KeyEqual, typename OnMatch>
+void JoinHashTable::ProbeBatch(const uint64_t *hashes, size_t count,
+                               KeyEqual key_equal, OnMatch on_match) const {
+  if (entries_.empty()) {
+    return;
+  }
+
+  for (size_t i = 0; i < count && i < prefetch_distance; i++) {
+    __builtin_prefetch(GetFirstSlot(hashes[i]));
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    if (i + prefetch_distance < count) {
+      __builtin_prefetch(GetFirstSlot(hashes[i + prefetch_distance]));
+    }
+
+    uint64_t hash = hashes[i];
+    auto &partition = GetPartition(hash);
+    size_t slot_itr = hash & partition.mask;
+    while (true) {
+      const Slot &slot = slots_[partition.slot_offset + slot_itr];
+      if (slot.head == 0) {
+        break;
+      }
+
+      if (slot.hash == hash) {
+        const Entry *entry = &entries_[slot.head - 1];
+        if (key_equal(i, *entry)) {
+          while (true) {
+            on_match(i, *entry);
+            if (entry->next == INVALID_ENTRY) {
+              break;
+            }
+            entry = &entries_[entry->next];
+          }
+          break;
+        }
+      }
+      slot_itr = (slot_itr + 1) & partition.mask;
+    }
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
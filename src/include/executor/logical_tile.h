@@ -73,6 +73,9 @@ class LogicalTile : public Printable {
   void AddColumns(const std::shared_ptr<storage::TileGroup> &tile_group,
                   const std::vector<oid_t> &column_ids);
 
+  void AddColumns(storage::TileGroup *tile_group,
+                  const std::vector<oid_t> &column_ids);
+
   void ProjectColumns(const std::vector<oid_t> &original_column_ids,
                       const std::vector<oid_t> &column_ids);
 
@@ -109,6 +112,10 @@ class LogicalTile : public Printable {
   std::vector<std::vector<std::string>> GetAllValuesAsStrings(
       const std::vector<int> &result_format, bool use_to_string_null);
 
+  std::vector<std::string> GetValuesAsStrings(
+      const oid_t tuple_id, const std::vector<int> &result_format,
+      bool use_to_string_null);
+
   // Get a string representation for debugging
   const std::string GetInfo() const;
 
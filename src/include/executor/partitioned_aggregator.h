@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// partitioned_aggregator.h
+//
+// Identification: src/include/executor/partitioned_aggregator.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "executor/aggregator.h"
+
+namespace peloton {
+namespace executor {
+
+class LogicalTile;
+
+/**
+ * @brief Hash aggregation over fixed-width group-by keys.
+ *
+ * Every worker pre-aggregates its share of the input tiles into its own
+ * tables, which are open-addressing hash tables over the encoded keys, radix
+ * partitioned on the top bits of the hash. The partitions are then merged in
+ * parallel, a partition of the first worker absorbing the same partition of
+ * the other workers.
+ *
+ * Groups and aggregate states are kept in flat arrays, so no allocation is
+ * made per group. Only keys whose columns all have a fixed-width type and
+ * aggregates without DISTINCT are supported, see IsSupported.
+ */
+class PartitionedHashAggregator : public AbstractAggregator {
+ public:
+  PartitionedHashAggregator(const planner::AggregatePlan *node,
+                            storage::AbstractTable *output_table,
+                            executor::ExecutorContext *econtext,
+                            size_t num_input_columns);
+
+  // Whether the plan can be run by this aggregator on input like the tile
+  static bool IsSupported(const planner::AggregatePlan *node,
+                          const LogicalTile *tile);
+
+  bool Advance(AbstractTuple *next_tuple) override;
+
+  // Pre-aggregates the tiles on the threads of the thread pool
+  bool AdvanceTiles(std::vector<std::unique_ptr<LogicalTile>> &tiles);
+
+  bool Finalize() override;
+
+  ~PartitionedHashAggregator();
+
+  // Number of groups aggregated so far, before the partitions are merged
+  // the same group may be counted once per worker
+  size_t GetGroupCount() const;
+
+  /** @brief Number of radix partitions of a table. */
+  static const size_t partition_count = 16;
+
+ private:
+  /** State of an aggregate for a group. */
+  struct AggregateState {
+    type::Value value;
+    int64_t count = 0;
+  };
+
+  class GroupTable;
+
+  // Tables of a worker, one per partition
+  typedef std::vector<GroupTable> PartitionedTable;
+
+  void AdvanceTuple(PartitionedTable &table, AbstractTuple *tuple,
+                    std::vector<uint64_t> &key);
+
+  void AdvanceState(AggregateState &state, oid_t aggno,
+                    const type::Value &value) const;
+
+  void CombineState(AggregateState &state, AggregateState &other,
+                    oid_t aggno) const;
+
+  type::Value FinalizeState(AggregateState &state, oid_t aggno) const;
+
+  void MergePartition(size_t partition);
+
+  PartitionedTable &GetWorkerTable(size_t worker);
+
+  const size_t num_input_columns_;
+
+  /** @brief Number of 64-bit words of an encoded group-by key. */
+  const size_t key_width_;
+
+  /** @brief Pre-aggregation tables, one per worker. */
+  std::vector<std::unique_ptr<PartitionedTable>> worker_tables_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "common/statement.h"
 #include "executor/abstract_executor.h"
 #include "type/types.h"
@@ -45,6 +49,79 @@ typedef struct peloton_status {
 
 } peloton_status;
 
+//===--------------------------------------------------------------------===//
+// Plan Cursor
+//
+// Runs an executor tree one logical tile at a time, so that the results of a
+// statement can be delivered to the client while the plan is still running
+// instead of being materialized in full. The executor tree is kept alive
+// between fetches, which is what lets a portal be suspended after a row limit
+// and resumed by the next Execute message.
+//===--------------------------------------------------------------------===//
+
+class PlanCursor {
+ public:
+  PlanCursor(const PlanCursor &) = delete;
+  PlanCursor &operator=(const PlanCursor &) = delete;
+
+  PlanCursor(const planner::AbstractPlan *plan, concurrency::Transaction *txn,
+             const std::vector<type::Value> &params,
+             const std::vector<int> &result_format);
+
+  ~PlanCursor();
+
+  // Initialize the executor tree. Returns false if it failed.
+  bool Init();
+
+  // Fetch up to max_rows rows (all the rows of the next logical tile if
+  // max_rows is 0). Rows are never taken from more than one logical tile at
+  // a time, so the memory held by the cursor is bounded by the size of a
+  // tile. Returns the tile the rows live in and fills rows with their ids in
+  // it, or returns nullptr once the plan is exhausted. The tile stays valid
+  // until the next fetch.
+  executor::LogicalTile *FetchRows(const size_t max_rows,
+                                   std::vector<oid_t> &rows);
+
+  // Same as above, but with the values of the rows formatted as requested by
+  // the result format and flattened into the result. Returns the number of
+  // rows fetched.
+  size_t FetchRows(const size_t max_rows, std::vector<StatementResult> &result);
+
+  // Has the plan been run to completion and every row fetched?
+  bool IsDone() const { return done_ && next_row_ == tile_rows_.size(); }
+
+  concurrency::Transaction *GetTransaction() const { return txn_; }
+
+  // Number of columns in the rows that were fetched
+  size_t GetColumnCount() const { return column_count_; }
+
+  // Status of the execution so far
+  peloton_status GetStatus() const;
+
+ private:
+  concurrency::Transaction *txn_;
+
+  const std::vector<int> result_format_;
+
+  std::unique_ptr<executor::ExecutorContext> executor_context_;
+
+  std::unique_ptr<executor::AbstractExecutor> executor_tree_;
+
+  bool initialized_ = false;
+
+  bool done_ = false;
+
+  // Logical tile the rows are being fetched from
+  std::unique_ptr<executor::LogicalTile> tile_;
+
+  // Visible rows of the current logical tile
+  std::vector<oid_t> tile_rows_;
+
+  size_t next_row_ = 0;
+
+  size_t column_count_ = 0;
+};
+
 class PlanExecutor {
  public:
   PlanExecutor(const PlanExecutor &) = delete;
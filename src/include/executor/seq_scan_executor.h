@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "planner/seq_scan_plan.h"
 #include "executor/abstract_scan_executor.h"
 
@@ -30,6 +33,27 @@ class SeqScanExecutor : public AbstractScanExecutor {
 
   void ResetState() { current_tile_group_offset_ = START_OID; }
 
+  //===--------------------------------------------------------------------===//
+  // Tile Group Scan
+  //
+  // Used by the exchange executor to scan the tile groups of the table on
+  // several threads. ScanTileGroup only reads the state of the executor and
+  // can run concurrently; PerformReads records the reads in the transaction
+  // and must run on the thread that owns it.
+  //===--------------------------------------------------------------------===//
+
+  /** @brief Number of tile groups of the table to scan. */
+  oid_t GetTileGroupCount() const { return table_tile_group_count_; }
+
+  storage::TileGroup *ScanTileGroup(const oid_t tile_group_offset,
+                                    std::vector<oid_t> &position_list) const;
+
+  bool PerformReads(const storage::TileGroup *tile_group,
+                    const std::vector<oid_t> &position_list);
+
+  LogicalTile *BuildLogicalTile(storage::TileGroup *tile_group,
+                                std::vector<oid_t> &&position_list) const;
+
  protected:
   bool DInit();
 
@@ -46,6 +70,9 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Whether the predicate is evaluated batch-at-a-time. */
+  bool vectorized_predicate_ = false;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
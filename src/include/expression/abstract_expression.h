@@ -17,6 +17,7 @@
 #include "common/logger.h"
 #include "common/macros.h"
 #include "common/printable.h"
+#include "expression/column_vector.h"
 #include "type/serializeio.h"
 #include "type/types.h"
 #include "type/value_factory.h"
@@ -26,6 +27,10 @@ namespace peloton {
 class Printable;
 class AbstractTuple;
 
+namespace catalog {
+class Schema;
+}
+
 namespace executor {
 class ExecutorContext;
 }
@@ -106,6 +111,53 @@ class AbstractExpression : public Printable {
 
   virtual AbstractExpression *Copy() const = 0;
 
+  //===--------------------------------------------------------------------===//
+  // Vectorized Evaluation
+  // Expressions that support it override these functions. See
+  // expression/column_vector.h for the data structures.
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * Return true if this boolean expression can filter tuples of a table with
+   * the given schema batch-at-a-time through FilterBatch().
+   */
+  virtual bool IsVectorizable(
+      UNUSED_ATTRIBUTE const catalog::Schema *schema,
+      UNUSED_ATTRIBUTE executor::ExecutorContext *context) const {
+    return false;
+  }
+
+  /**
+   * Return the type of the ValueVector that EvaluateBatch() produces for a
+   * table with the given schema, or INVALID if this expression cannot be
+   * evaluated batch-at-a-time.
+   */
+  virtual type::Type::TypeId GetVectorizedType(
+      UNUSED_ATTRIBUTE const catalog::Schema *schema,
+      UNUSED_ATTRIBUTE executor::ExecutorContext *context) const {
+    return type::Type::INVALID;
+  }
+
+  /**
+   * Remove from the selection vector every position for which this
+   * expression does not evaluate to true.
+   */
+  virtual void FilterBatch(UNUSED_ATTRIBUTE const TileGroupBatch &batch,
+                           UNUSED_ATTRIBUTE SelectionVector &selection) const {
+    throw Exception(EXCEPTION_TYPE_EXPRESSION,
+                    "Expression does not support vectorized filtering.");
+  }
+
+  /**
+   * Evaluate this expression for every position in the selection vector.
+   */
+  virtual void EvaluateBatch(UNUSED_ATTRIBUTE const TileGroupBatch &batch,
+                             UNUSED_ATTRIBUTE const SelectionVector &selection,
+                             UNUSED_ATTRIBUTE ValueVector &result) const {
+    throw Exception(EXCEPTION_TYPE_EXPRESSION,
+                    "Expression does not support vectorized evaluation.");
+  }
+
   inline AbstractExpression *CopyUtil(
       const AbstractExpression *expression) const {
     return (expression == nullptr) ? nullptr : expression->Copy();
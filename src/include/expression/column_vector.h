@@ -0,0 +1,161 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_vector.h
+//
+// Identification: src/include/expression/column_vector.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace executor {
+class ExecutorContext;
+}
+
+namespace storage {
+class TileGroup;
+}
+
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// Vectorized Evaluation
+//
+// Batch-at-a-time predicate evaluation over the tiles of a tile group.
+// A SelectionVector holds the tuple offsets (in ascending order) that are
+// still qualifying. Boolean expressions narrow it in place through
+// FilterBatch(), and value expressions materialize a ValueVector with one
+// entry per selected offset through EvaluateBatch().
+//
+// Only fixed-width numeric and timestamp columns are supported. Expression
+// trees that touch anything else are evaluated one tuple at a time.
+//===----------------------------------------------------------------------===//
+
+typedef std::vector<oid_t> SelectionVector;
+
+/**
+ * A view over one fixed-width column of a tile. The value of the tuple at
+ * offset i is stored at (base + i * stride). The stride is the tuple length
+ * of the tile, so it is equal to the column width only for pure columnar
+ * layouts.
+ */
+struct ColumnVector {
+  const char *base = nullptr;
+  size_t stride = 0;
+  type::Type::TypeId type_id = type::Type::INVALID;
+
+  inline const char *GetLocation(const oid_t tuple_offset) const {
+    return base + tuple_offset * stride;
+  }
+};
+
+/**
+ * Values produced by a vectorized value expression. Integer types and
+ * TIMESTAMP are widened to int64_t, DECIMAL is kept as double. A constant
+ * vector holds a single value that applies to every selected position.
+ */
+struct ValueVector {
+  type::Type::TypeId type_id = type::Type::INVALID;
+  bool is_constant = false;
+  std::vector<int64_t> integers;
+  std::vector<double> decimals;
+  std::vector<uint8_t> nulls;
+
+  inline size_t Index(const size_t itr) const {
+    return is_constant ? 0 : itr;
+  }
+
+  inline bool IsNull(const size_t itr) const { return nulls[Index(itr)] != 0; }
+
+  inline bool IsDecimal() const { return type_id == type::Type::DECIMAL; }
+
+  inline int64_t GetInteger(const size_t itr) const {
+    return integers[Index(itr)];
+  }
+
+  inline double GetDecimal(const size_t itr) const {
+    return IsDecimal() ? decimals[Index(itr)]
+                       : static_cast<double>(integers[Index(itr)]);
+  }
+
+  // Reset the vector to hold count values of the given type
+  void Reset(type::Type::TypeId type, size_t count);
+
+  // Reset the vector to a single constant value
+  void SetConstant(const type::Value &value);
+};
+
+/**
+ * The unit of vectorized evaluation: one tile group together with the
+ * context of the running query (for parameter values).
+ */
+class TileGroupBatch {
+ public:
+  TileGroupBatch(storage::TileGroup *tile_group,
+                 executor::ExecutorContext *context)
+      : tile_group_(tile_group), context_(context) {}
+
+  // Locate the tile that stores the given tile group column
+  ColumnVector GetColumn(const oid_t column_id) const;
+
+  storage::TileGroup *GetTileGroup() const { return tile_group_; }
+
+  executor::ExecutorContext *GetContext() const { return context_; }
+
+ private:
+  storage::TileGroup *tile_group_;
+
+  executor::ExecutorContext *context_;
+};
+
+//===----------------------------------------------------------------------===//
+// Vectorized Kernels
+//===----------------------------------------------------------------------===//
+
+class VectorizedUtil {
+ public:
+  // Can a column or constant of this type take part in vectorized evaluation?
+  static bool IsVectorizableType(const type::Type::TypeId type_id);
+
+  // Can values of these two types be compared by the vectorized kernels?
+  static bool IsComparable(const type::Type::TypeId left,
+                           const type::Type::TypeId right);
+
+  // Result type of an arithmetic operator over these two types, or INVALID
+  // if the vectorized kernels do not support the combination.
+  static type::Type::TypeId GetArithmeticType(const ExpressionType op,
+                                              const type::Type::TypeId left,
+                                              const type::Type::TypeId right);
+
+  // Read the selected values of a column
+  static void Gather(const ColumnVector &column,
+                     const SelectionVector &selection, ValueVector &result);
+
+  // Keep the selected positions where (left op right) is true
+  static void Compare(const ExpressionType op, const ValueVector &left,
+                      const ValueVector &right, SelectionVector &selection);
+
+  // Compute (left op right) for every selected position
+  static void Arithmetic(const ExpressionType op,
+                         const type::Type::TypeId result_type,
+                         const ValueVector &left, const ValueVector &right,
+                         const size_t count, ValueVector &result);
+
+  // Merge two ascending selection vectors
+  static void Union(const SelectionVector &left, const SelectionVector &right,
+                    SelectionVector &result);
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "expression/abstract_expression.h"
+#include "expression/filter_kernels.h"
 
 namespace peloton {
 namespace expression {
@@ -58,6 +59,32 @@ class ComparisonExpression : public AbstractExpression {
     }
   }
 
+  bool IsVectorizable(const catalog::Schema *schema,
+                      executor::ExecutorContext *context) const override {
+    PL_ASSERT(children_.size() == 2);
+    if (exp_type_ < ExpressionType::COMPARE_EQUAL ||
+        exp_type_ > ExpressionType::COMPARE_GREATERTHANOREQUALTO)
+      return false;
+    return VectorizedUtil::IsComparable(
+        children_[0]->GetVectorizedType(schema, context),
+        children_[1]->GetVectorizedType(schema, context));
+  }
+
+  void FilterBatch(const TileGroupBatch &batch,
+                   SelectionVector &selection) const override {
+    PL_ASSERT(children_.size() == 2);
+    // column <op> constant is evaluated by the SIMD kernels
+    if (FilterKernels::FilterComparison(exp_type_, children_[0].get(),
+                                        children_[1].get(), batch,
+                                        selection))
+      return;
+
+    ValueVector vl, vr;
+    children_[0]->EvaluateBatch(batch, selection, vl);
+    children_[1]->EvaluateBatch(batch, selection, vr);
+    VectorizedUtil::Compare(exp_type_, vl, vr, selection);
+  }
+
   AbstractExpression *Copy() const override {
     return new ComparisonExpression(*this);
   }
@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+
 #include "expression/abstract_expression.h"
 
 namespace peloton {
@@ -56,6 +59,45 @@ class ConjunctionExpression : public AbstractExpression {
     }
   }
 
+  bool IsVectorizable(const catalog::Schema *schema,
+                      executor::ExecutorContext *context) const override {
+    PL_ASSERT(children_.size() == 2);
+    return children_[0]->IsVectorizable(schema, context) &&
+           children_[1]->IsVectorizable(schema, context);
+  }
+
+  void FilterBatch(const TileGroupBatch &batch,
+                   SelectionVector &selection) const override {
+    PL_ASSERT(children_.size() == 2);
+    switch (exp_type_) {
+      case (ExpressionType::CONJUNCTION_AND): {
+        // the right child only looks at what survived the left child
+        children_[0]->FilterBatch(batch, selection);
+        if (selection.empty() == false) {
+          children_[1]->FilterBatch(batch, selection);
+        }
+        break;
+      }
+      case (ExpressionType::CONJUNCTION_OR): {
+        SelectionVector left_selection(selection);
+        children_[0]->FilterBatch(batch, left_selection);
+        // the right child only looks at what failed the left child
+        SelectionVector right_selection;
+        right_selection.reserve(selection.size() - left_selection.size());
+        std::set_difference(selection.begin(), selection.end(),
+                            left_selection.begin(), left_selection.end(),
+                            std::back_inserter(right_selection));
+        if (right_selection.empty() == false) {
+          children_[1]->FilterBatch(batch, right_selection);
+        }
+        VectorizedUtil::Union(left_selection, right_selection, selection);
+        break;
+      }
+      default:
+        throw Exception("Invalid conjunction expression type.");
+    }
+  }
+
   AbstractExpression *Copy() const override {
     return new ConjunctionExpression(*this);
   }
@@ -39,6 +39,31 @@ class ConstantValueExpression : public AbstractExpression {
 
   bool HasParameter() const override { return false; }
 
+  bool IsVectorizable(
+      UNUSED_ATTRIBUTE const catalog::Schema *schema,
+      UNUSED_ATTRIBUTE executor::ExecutorContext *context) const override {
+    return value_.GetTypeId() == type::Type::BOOLEAN;
+  }
+
+  type::Type::TypeId GetVectorizedType(
+      UNUSED_ATTRIBUTE const catalog::Schema *schema,
+      UNUSED_ATTRIBUTE executor::ExecutorContext *context) const override {
+    return VectorizedUtil::IsVectorizableType(value_.GetTypeId())
+               ? value_.GetTypeId()
+               : type::Type::INVALID;
+  }
+
+  void FilterBatch(UNUSED_ATTRIBUTE const TileGroupBatch &batch,
+                   SelectionVector &selection) const override {
+    if (value_.IsTrue() == false) selection.clear();
+  }
+
+  void EvaluateBatch(UNUSED_ATTRIBUTE const TileGroupBatch &batch,
+                     UNUSED_ATTRIBUTE const SelectionVector &selection,
+                     ValueVector &result) const override {
+    result.SetConstant(value_);
+  }
+
   AbstractExpression *Copy() const override {
     return new ConstantValueExpression(*this);
   }
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_kernels.h
+//
+// Identification: src/include/expression/filter_kernels.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "expression/column_vector.h"
+
+namespace peloton {
+namespace expression {
+
+class AbstractExpression;
+
+//===----------------------------------------------------------------------===//
+// Filter Kernels
+//
+// Compare a fixed-width tile column against constants and narrow a selection
+// vector to the qualifying tuple offsets. The column is scanned a vector
+// register at a time (AVX2 or SSE4.2, picked at runtime from the features of
+// the CPU) and the matches are collected into a bitmap before the selection
+// vector is compacted. Contiguous columns are loaded directly, strided
+// columns (row or hybrid tile layouts) are gathered.
+//
+// Comparisons with NULL are never true, and NULL column values never match.
+//===----------------------------------------------------------------------===//
+
+enum class SIMDLevel {
+  SCALAR = 0,
+  SSE42 = 1,
+  AVX2 = 2
+};
+
+class FilterKernels {
+ public:
+  // Best instruction set supported by the running CPU
+  static SIMDLevel GetSupportedLevel();
+
+  // Instruction set the kernels currently dispatch to
+  static SIMDLevel GetLevel();
+
+  // Restrict the kernels to an instruction set. The level is capped to what
+  // the CPU supports. Used to compare the implementations in tests and
+  // benchmarks.
+  static void SetLevel(SIMDLevel level);
+
+  // Can a column of the given type be filtered against constants of the
+  // other type?
+  static bool IsSupported(const type::Type::TypeId column_type,
+                          const type::Type::TypeId constant_type);
+
+  // Keep the selected offsets where (column op constant) is true
+  static void Compare(const ExpressionType op, const ColumnVector &column,
+                      const type::Value &constant, SelectionVector &selection);
+
+  // Keep the selected offsets where (low <= column <= high) is true
+  static void Between(const ColumnVector &column, const type::Value &low,
+                      const type::Value &high, SelectionVector &selection);
+
+  // Keep the selected offsets where the column matches one of the values
+  static void In(const ColumnVector &column,
+                 const std::vector<type::Value> &values,
+                 SelectionVector &selection);
+
+  // Filter the batch with the kernels if the comparison is between a column
+  // of the batch and a constant or parameter. Returns false if the
+  // comparison has another shape and must be evaluated by the caller.
+  static bool FilterComparison(const ExpressionType op,
+                               const AbstractExpression *left,
+                               const AbstractExpression *right,
+                               const TileGroupBatch &batch,
+                               SelectionVector &selection);
+};
+
+}  // End expression namespace
+}  // End peloton namespace
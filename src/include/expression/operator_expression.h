@@ -74,6 +74,28 @@ class OperatorExpression : public AbstractExpression {
     return_value_type_ = type;
   }
 
+  type::Type::TypeId GetVectorizedType(
+      const catalog::Schema *schema,
+      executor::ExecutorContext *context) const override {
+    if (children_.size() != 2) return type::Type::INVALID;
+    return VectorizedUtil::GetArithmeticType(
+        exp_type_, children_[0]->GetVectorizedType(schema, context),
+        children_[1]->GetVectorizedType(schema, context));
+  }
+
+  void EvaluateBatch(const TileGroupBatch &batch,
+                     const SelectionVector &selection,
+                     ValueVector &result) const override {
+    PL_ASSERT(children_.size() == 2);
+    ValueVector vl, vr;
+    children_[0]->EvaluateBatch(batch, selection, vl);
+    children_[1]->EvaluateBatch(batch, selection, vr);
+    VectorizedUtil::Arithmetic(
+        exp_type_, VectorizedUtil::GetArithmeticType(exp_type_, vl.type_id,
+                                                     vr.type_id),
+        vl, vr, selection.size(), result);
+  }
+
   AbstractExpression *Copy() const override {
     return new OperatorExpression(*this);
   }
@@ -37,6 +37,24 @@ class ParameterValueExpression : public AbstractExpression {
     return context->GetParams().at(value_idx_);
   }
 
+  type::Type::TypeId GetVectorizedType(
+      UNUSED_ATTRIBUTE const catalog::Schema *schema,
+      executor::ExecutorContext *context) const override {
+    // parameter types are only known once the query is bound
+    if (context == nullptr || value_idx_ < 0 ||
+        (size_t)value_idx_ >= context->GetParams().size())
+      return type::Type::INVALID;
+    auto type_id = context->GetParams().at(value_idx_).GetTypeId();
+    return VectorizedUtil::IsVectorizableType(type_id) ? type_id
+                                                       : type::Type::INVALID;
+  }
+
+  void EvaluateBatch(const TileGroupBatch &batch,
+                     UNUSED_ATTRIBUTE const SelectionVector &selection,
+                     ValueVector &result) const override {
+    result.SetConstant(batch.GetContext()->GetParams().at(value_idx_));
+  }
+
   AbstractExpression *Copy() const override {
     return new ParameterValueExpression(value_idx_);
   }
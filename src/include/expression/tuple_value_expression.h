@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include "catalog/schema.h"
 #include "common/abstract_tuple.h"
 #include "expression/abstract_expression.h"
 
@@ -66,6 +67,24 @@ class TupleValueExpression : public AbstractExpression {
     tuple_idx_ = tuple_idx;
   }
 
+  type::Type::TypeId GetVectorizedType(
+      const catalog::Schema *schema,
+      UNUSED_ATTRIBUTE executor::ExecutorContext *context) const override {
+    // only the columns of the scanned tile group can be read in batches
+    if (tuple_idx_ != 0 || value_idx_ < 0 ||
+        (oid_t)value_idx_ >= schema->GetColumnCount())
+      return type::Type::INVALID;
+    auto type_id = schema->GetType(value_idx_);
+    return VectorizedUtil::IsVectorizableType(type_id) ? type_id
+                                                       : type::Type::INVALID;
+  }
+
+  void EvaluateBatch(const TileGroupBatch &batch,
+                     const SelectionVector &selection,
+                     ValueVector &result) const override {
+    VectorizedUtil::Gather(batch.GetColumn(value_idx_), selection, result);
+  }
+
   AbstractExpression *Copy() const override {
     return new TupleValueExpression(*this);
   }
@@ -13,10 +13,12 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "common/item_pointer.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "container/read_write_set.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -60,6 +62,17 @@ class GCManager {
     return INVALID_ITEMPOINTER;
   }
 
+  // Whether the free slots of the table are recycled
+  virtual bool IsRecyclingSlots(const oid_t &table_id UNUSED_ATTRIBUTE) {
+    return false;
+  }
+
+  // Takes back slots of the table that were claimed but never used, so that
+  // they are handed out again
+  virtual void RecycleUnusedSlots(
+      const oid_t &table_id UNUSED_ATTRIBUTE,
+      std::vector<ItemPointer> &slots UNUSED_ATTRIBUTE) {}
+
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
 
   virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
@@ -71,6 +84,10 @@ class GCManager {
       const cid_t &timestamp UNUSED_ATTRIBUTE,
       const GCSetType gc_set_type UNUSED_ATTRIBUTE) {}
 
+  // Drops a tile group that has been taken out of its table, once the
+  // garbage that may still point into it has been collected
+  virtual void RetireTileGroup(const oid_t &tile_group_id);
+
  protected:
   void CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple_id);
 
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include <unordered_map>
 #include <map>
@@ -20,6 +21,7 @@
 
 #include "type/types.h"
 #include "common/logger.h"
+#include "common/platform.h"
 #include "gc/gc_manager.h"
 
 #include "container/lock_free_queue.h"
@@ -39,9 +41,48 @@ struct GarbageContext {
     gc_set_ = gc_set;
   }
 
+  // a tile group to drop, once every thread collected the garbage queued
+  // before it
+  GarbageContext(const oid_t &tile_group_id, const cid_t &timestamp,
+                 std::shared_ptr<std::atomic<int>> pending_thread_count)
+      : timestamp_(timestamp),
+        gc_set_type_(GC_SET_TYPE_COMMITTED),
+        dropped_tile_group_id_(tile_group_id),
+        pending_thread_count_(pending_thread_count) {}
+
+  inline bool IsTileGroupDrop() const {
+    return dropped_tile_group_id_ != INVALID_OID;
+  }
+
   std::shared_ptr<ReadWriteSet> gc_set_;
   cid_t timestamp_;
   GCSetType gc_set_type_;
+
+  oid_t dropped_tile_group_id_ = INVALID_OID;
+
+  // threads that have not collected the garbage queued before the drop yet
+  std::shared_ptr<std::atomic<int>> pending_thread_count_;
+};
+
+/**
+ * @brief Recycled tuple slots of a table.
+ *
+ * The GC threads append the slots they reset in batches, and the inserting
+ * threads move them to their own caches in batches as well, so that the lock
+ * is taken once per batch.
+ */
+struct RecyclePool {
+  RecyclePool() : slot_count(0), dropped(false) {}
+
+  Spinlock lock;
+
+  std::vector<ItemPointer> slots;
+
+  // size of the slots, read without the lock
+  std::atomic<size_t> slot_count;
+
+  // set when the table is deregistered, the caches of the table are dropped
+  std::atomic<bool> dropped;
 };
 
 class TransactionLevelGCManager : public GCManager {
@@ -88,32 +129,49 @@ public:
 
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
+  virtual void RetireTileGroup(const oid_t &tile_group_id) override;
+
+  virtual bool IsRecyclingSlots(const oid_t &table_id) override {
+    return recycle_pool_map_.find(table_id) != recycle_pool_map_.end();
+  }
+
+  virtual void RecycleUnusedSlots(const oid_t &table_id,
+                                  std::vector<ItemPointer> &slots) override {
+    RecycleSlots(table_id, slots);
+  }
+
   virtual void RegisterTable(const oid_t &table_id) override {
     // Insert a new entry for the table
-    if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
-      std::shared_ptr<LockFreeQueue<ItemPointer>> recycle_queue(new LockFreeQueue<ItemPointer>(MAX_QUEUE_LENGTH));
-      recycle_queue_map_[table_id] = recycle_queue;
+    if (recycle_pool_map_.find(table_id) == recycle_pool_map_.end()) {
+      std::shared_ptr<RecyclePool> recycle_pool(new RecyclePool());
+      recycle_pool_map_[table_id] = recycle_pool;
     }
   }
 
   virtual void DeregisterTable(const oid_t &table_id) override {
     // Remove dropped tables
-    if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
-      recycle_queue_map_.erase(table_id);
+    auto entry = recycle_pool_map_.find(table_id);
+    if (entry != recycle_pool_map_.end()) {
+      entry->second->dropped = true;
+      recycle_pool_map_.erase(entry);
     }
   }
 
   virtual size_t GetTableCount() override {
-    return recycle_queue_map_.size();
+    return recycle_pool_map_.size();
   }
 
+  /** @brief Slots a thread moves at a time from a pool to its cache. */
+  static const size_t recycle_batch_size = 64;
+
 private:
   void StartGC(int thread_id);
 
   void StopGC(int thread_id);
 
-  inline unsigned int HashToThread(const cid_t &ts) {
-    return (unsigned int)ts % gc_thread_count_;
+  // the garbage of a tile group is always handled by the same thread
+  inline unsigned int HashToThread(const oid_t &tile_group_id) {
+    return (unsigned int)tile_group_id % gc_thread_count_;
   }
 
   void ClearGarbage(int thread_id);
@@ -124,13 +182,24 @@ private:
 
   int Reclaim(const int &thread_id, const cid_t &max_cid);
 
-  void AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx);
+  void AddToRecycleMap(
+      const int &thread_id, std::shared_ptr<GarbageContext> gc_ctx,
+      std::unordered_map<oid_t, std::vector<ItemPointer>> &recycled_slots);
+
+  void RecycleSlots(const oid_t &table_id, std::vector<ItemPointer> &slots);
 
   bool ResetTuple(const ItemPointer &);
 
+  ItemPointer CompactVersionChain(const int &thread_id,
+                                  const ItemPointer &location,
+                                  const RWType &type, const cid_t &timestamp);
+
   void DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx);
 
-  void DeleteTupleFromIndexes(ItemPointer *indirection);
+  void DeleteTupleFromIndexes(const ItemPointer &location,
+                              ItemPointer *indirection);
+
+  void DeleteVersionFromCoveringIndexes(const ItemPointer &location);
 
 private:
   //===--------------------------------------------------------------------===//
@@ -152,8 +221,8 @@ private:
   // metadata of the garbage.
   std::vector<std::multimap<cid_t, std::shared_ptr<GarbageContext>>> reclaim_maps_;
 
-  // queues for to-be-reused tuples.
-  std::unordered_map<oid_t, std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>> recycle_queue_map_;
+  // pools of to-be-reused tuples.
+  std::unordered_map<oid_t, std::shared_ptr<RecyclePool>> recycle_pool_map_;
 
 };
 }
@@ -159,6 +159,9 @@ extern bool print_flag;
 
 #define PREALLOCATE_THREAD_NUM ((size_t)1024)
 
+// The number of lookups of a batch that descend the tree together
+#define BATCH_LOOKUP_GROUP_SIZE ((size_t)16)
+
 /*
  * InnerInlineAllocateOfType() - allocates a chunk of memory from base node and
  *                               initialize it using placement new and then 
@@ -7331,6 +7334,178 @@ before_switch:
     return ret;
   }
 
+  /*
+   * BulkLoad() - Builds the tree bottom up from key-value pairs sorted on
+   *              their keys
+   *
+   * Leaves are filled up to fill_factor of the split threshold without
+   * spreading a key over two of them, and each level of inner nodes is built
+   * on top of the one below until a single node is left, which becomes the
+   * root. Key-value pairs that are in the list more than once are loaded once,
+   * the list being compacted in place.
+   *
+   * The tree must be empty, and no other thread may access it until this
+   * function returns. Returns the number of key-value pairs loaded
+   */
+  size_t BulkLoad(std::vector<KeyValuePair> &item_list, double fill_factor) {
+    assert(fill_factor > 0.0 && fill_factor <= 1.0);
+    assert(Begin().IsEnd() == true);
+
+    // Remove the values that are there twice for a key
+    size_t item_count = 0;
+    for(size_t start = 0;start < item_list.size();) {
+      size_t end = start + 1;
+      while((end < item_list.size()) &&
+            (KeyCmpEqual(item_list[start].first,
+                         item_list[end].first) == true)) {
+        end++;
+      }
+
+      ValueSet value_set{end - start, value_hash_obj, value_eq_obj};
+      for(size_t i = start;i < end;i++) {
+        if(value_set.insert(item_list[i].second).second == true) {
+          item_list[item_count++] = item_list[i];
+        }
+      }
+
+      start = end;
+    }
+
+    item_list.resize(item_count);
+    if(item_count == 0) {
+      return 0;
+    }
+
+    // Nodes are filled evenly, below the split threshold and above the
+    // merge threshold
+    auto GetNodeSize = [fill_factor](size_t count, int lower, int upper) {
+      size_t target = std::min(std::max(static_cast<int>(upper * fill_factor),
+                                        lower + 1),
+                               upper - 1);
+      size_t node_count = (count + target - 1) / target;
+
+      return (count + node_count - 1) / node_count;
+    };
+
+    // Cut the leaves at key boundaries: leaf i holds
+    // [leaf_start_list[i], leaf_start_list[i + 1])
+    size_t leaf_size = GetNodeSize(item_count,
+                                   LEAF_NODE_SIZE_LOWER_THRESHOLD,
+                                   LEAF_NODE_SIZE_UPPER_THRESHOLD);
+    std::vector<size_t> leaf_start_list{};
+    for(size_t start = 0;start < item_count;) {
+      leaf_start_list.push_back(start);
+
+      size_t end = std::min(start + leaf_size, item_count);
+      while((end < item_count) &&
+            (KeyCmpEqual(item_list[end - 1].first,
+                         item_list[end].first) == true)) {
+        end++;
+      }
+
+      start = end;
+    }
+    leaf_start_list.push_back(item_count);
+
+    // The old layout is replaced. The leftmost leaf keeps its NodeID since
+    // the iterator starts from there, and the root keeps its NodeID
+    NodeID old_root_id = root_id.load();
+    FreeNodeByNodeID(old_root_id);
+
+    size_t leaf_count = leaf_start_list.size() - 1;
+    std::vector<NodeID> node_id_list{FIRST_LEAF_NODE_ID};
+    for(size_t i = 1;i < leaf_count;i++) {
+      node_id_list.push_back(GetNextNodeID());
+    }
+
+    // Separators of the level being built on
+    std::vector<KeyNodeIDPair> sep_list{};
+
+    for(size_t i = 0;i < leaf_count;i++) {
+      size_t start = leaf_start_list[i];
+      size_t end = leaf_start_list[i + 1];
+
+      KeyNodeIDPair low_key_pair = \
+        (i == 0) ? std::make_pair(KeyType(), INVALID_NODE_ID) : \
+                   std::make_pair(item_list[start].first, ~INVALID_NODE_ID);
+      KeyNodeIDPair high_key_pair = \
+        (i + 1 == leaf_count) ? \
+          std::make_pair(KeyType(), INVALID_NODE_ID) : \
+          std::make_pair(item_list[end].first, node_id_list[i + 1]);
+
+      LeafNode *leaf_node_p = \
+        reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::\
+          Get(static_cast<int>(end - start),
+              NodeType::LeafType,
+              0,
+              static_cast<int>(end - start),
+              low_key_pair,
+              high_key_pair));
+
+      leaf_node_p->PushBack(item_list.data() + start, item_list.data() + end);
+
+      InstallNewNode(node_id_list[i], leaf_node_p);
+
+      sep_list.push_back(std::make_pair((i == 0) ? KeyType() : \
+                                                   item_list[start].first,
+                                        node_id_list[i]));
+    }
+
+    // Inner nodes hold the separators of their children, the first one
+    // being their low key. A level with a single node is the root
+    while(1) {
+      size_t sep_count = sep_list.size();
+      size_t inner_size = GetNodeSize(sep_count,
+                                      INNER_NODE_SIZE_LOWER_THRESHOLD,
+                                      INNER_NODE_SIZE_UPPER_THRESHOLD);
+      size_t inner_count = (sep_count + inner_size - 1) / inner_size;
+
+      node_id_list.clear();
+      if(inner_count == 1) {
+        node_id_list.push_back(old_root_id);
+      } else {
+        for(size_t i = 0;i < inner_count;i++) {
+          node_id_list.push_back(GetNextNodeID());
+        }
+      }
+
+      std::vector<KeyNodeIDPair> parent_sep_list{};
+      for(size_t i = 0;i < inner_count;i++) {
+        size_t start = i * inner_size;
+        size_t end = std::min(start + inner_size, sep_count);
+
+        KeyNodeIDPair high_key_pair = \
+          (i + 1 == inner_count) ? \
+            std::make_pair(KeyType(), INVALID_NODE_ID) : \
+            std::make_pair(sep_list[end].first, node_id_list[i + 1]);
+
+        InnerNode *inner_node_p = \
+          reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::\
+            Get(static_cast<int>(end - start),
+                NodeType::InnerType,
+                0,
+                static_cast<int>(end - start),
+                sep_list[start],
+                high_key_pair));
+
+        inner_node_p->PushBack(sep_list.data() + start, sep_list.data() + end);
+
+        InstallNewNode(node_id_list[i], inner_node_p);
+
+        parent_sep_list.push_back(std::make_pair(sep_list[start].first,
+                                                 node_id_list[i]));
+      }
+
+      if(inner_count == 1) {
+        break;
+      }
+
+      sep_list = std::move(parent_sep_list);
+    }
+
+    return item_count;
+  }
+
   /*
    * Insert() - Insert a key-value pair
    *
@@ -7637,6 +7812,175 @@ before_switch:
     return;
   }
 
+  /*
+   * GetValueBatch() - Fills the value list of each key of a sorted batch
+   *
+   * The keys are looked up in groups. The lookups of a group descend the
+   * tree one level at a time together: the children of all of them are
+   * located and their mapping table entries prefetched, then the child nodes
+   * are loaded and prefetched, before any of them is read. This way the
+   * cache misses of a group overlap instead of each lookup waiting on its
+   * own chain of misses. A lookup that would abort is run again on its own
+   * with TraverseReadOptimized().
+   *
+   * The keys must be sorted, so that the lookups of a group share the upper
+   * nodes of their paths. The keys that fall on the leaf node the previous
+   * group ended on are searched on the snapshot of that node without any
+   * descent. All snapshots are taken within a single epoch
+   *
+   * value_list_p[i] receives the values of key_list_p[i]
+   */
+  void GetValueBatch(const KeyType *key_list_p,
+                     size_t key_count,
+                     std::vector<ValueType> *value_list_p) {
+    bwt_printf("GetValueBatch()\n");
+
+    // State of a lookup in its group
+    enum class LookupState {
+      ON_INNER,
+      ON_LEAF,
+      RETRY,
+    };
+
+    // Context can be neither copied nor moved, so the contexts of a group
+    // are constructed in place in this buffer
+    alignas(Context) unsigned char \
+      context_buffer[BATCH_LOOKUP_GROUP_SIZE * sizeof(Context)];
+    Context *context_list_p = reinterpret_cast<Context *>(context_buffer);
+
+    LookupState state_list[BATCH_LOOKUP_GROUP_SIZE];
+    NodeID child_node_id_list[BATCH_LOOKUP_GROUP_SIZE];
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    // The leaf node the previous group ended on
+    NodeSnapshot leaf_snapshot{INVALID_NODE_ID, nullptr};
+
+    for(size_t group_start = 0;
+        group_start < key_count;
+        group_start += BATCH_LOOKUP_GROUP_SIZE) {
+      const size_t group_size = std::min(BATCH_LOOKUP_GROUP_SIZE,
+                                         key_count - group_start);
+      const KeyType *group_key_list_p = key_list_p + group_start;
+      std::vector<ValueType> *group_value_list_p = value_list_p + group_start;
+
+      // This is the serialization point for reading root node
+      NodeID root_node_id = root_id.load();
+
+      for(size_t i = 0; i < group_size; i++) {
+        Context *context_p = new (context_list_p + i) \
+                               Context{group_key_list_p[i]};
+
+        // The previous keys were on this node, so its low key is never
+        // greater than the search key
+        if(IsCoveredBySnapshot(leaf_snapshot, group_key_list_p[i]) == true) {
+          context_p->current_snapshot = leaf_snapshot;
+
+          #ifdef BWTREE_DEBUG
+          context_p->current_level = 0;
+          #endif
+
+          state_list[i] = LookupState::ON_LEAF;
+          continue;
+        }
+
+        LoadNodeIDReadOptimized(root_node_id, context_p);
+        if(context_p->abort_flag == true) {
+          state_list[i] = LookupState::RETRY;
+        } else if(context_p->current_snapshot.IsLeaf() == true) {
+          state_list[i] = LookupState::ON_LEAF;
+        } else {
+          state_list[i] = LookupState::ON_INNER;
+        }
+      }
+
+      while(1) {
+        // 1. Locate the children and prefetch their mapping table entries
+        bool has_inner = false;
+        for(size_t i = 0; i < group_size; i++) {
+          if(state_list[i] != LookupState::ON_INNER) {
+            continue;
+          }
+
+          child_node_id_list[i] = NavigateInnerNode(context_list_p + i);
+          if(context_list_p[i].abort_flag == true) {
+            state_list[i] = LookupState::RETRY;
+            continue;
+          }
+
+          __builtin_prefetch(&mapping_table[child_node_id_list[i]]);
+          has_inner = true;
+        }
+
+        if(has_inner == false) {
+          break;
+        }
+
+        // 2. Load the children and prefetch their nodes
+        for(size_t i = 0; i < group_size; i++) {
+          if(state_list[i] == LookupState::ON_INNER) {
+            TakeNodeSnapshotReadOptimized(child_node_id_list[i],
+                                          context_list_p + i);
+            __builtin_prefetch(context_list_p[i].current_snapshot.node_p);
+          }
+        }
+
+        // 3. Finish loading the children as LoadNodeIDReadOptimized() does
+        for(size_t i = 0; i < group_size; i++) {
+          if(state_list[i] != LookupState::ON_INNER) {
+            continue;
+          }
+
+          FinishPartialSMOReadOptimized(context_list_p + i);
+          if(context_list_p[i].abort_flag == true) {
+            state_list[i] = LookupState::RETRY;
+          } else if(context_list_p[i].current_snapshot.IsLeaf() == true) {
+            state_list[i] = LookupState::ON_LEAF;
+          }
+        }
+      } // while(1)
+
+      for(size_t i = 0; i < group_size; i++) {
+        if(state_list[i] == LookupState::ON_LEAF) {
+          NavigateLeafNode(context_list_p + i, group_value_list_p[i]);
+          if(context_list_p[i].abort_flag == true) {
+            state_list[i] = LookupState::RETRY;
+          } else {
+            leaf_snapshot = context_list_p[i].current_snapshot;
+          }
+        }
+
+        if(state_list[i] == LookupState::RETRY) {
+          group_value_list_p[i].clear();
+
+          Context context{group_key_list_p[i]};
+          TraverseReadOptimized(&context, group_value_list_p + i);
+          leaf_snapshot = context.current_snapshot;
+        }
+
+        context_list_p[i].~Context();
+      }
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return;
+  }
+
+  /*
+   * IsCoveredBySnapshot() - Returns whether the search key is less than
+   *                         the high key of the node in the snapshot
+   */
+  inline bool IsCoveredBySnapshot(const NodeSnapshot &snapshot,
+                                  const KeyType &search_key) const {
+    if(snapshot.node_p == nullptr) {
+      return false;
+    }
+
+    return (snapshot.node_p->GetNextNodeID() == INVALID_NODE_ID) ||
+           (KeyCmpLess(search_key, snapshot.node_p->GetHighKey()) == true);
+  }
+
   /*
    * GetValue() - Return value in a ValueSet object
    *
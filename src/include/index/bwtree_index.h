@@ -95,6 +95,12 @@ class BWTreeIndex : public Index {
                        ItemPointer *value,
                        std::function<bool(const void *)> predicate);
 
+  size_t InsertEntries(const std::vector<const storage::Tuple *> &keys,
+                       const std::vector<ItemPointer *> &locations);
+
+  size_t BulkLoad(const std::vector<const storage::Tuple *> &keys,
+                  const std::vector<ItemPointer *> &locations);
+
   void Scan(const std::vector<type::Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -116,6 +122,18 @@ class BWTreeIndex : public Index {
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result);
 
+  void ScanKeysBatch(const std::vector<const storage::Tuple *> &keys,
+                     std::vector<std::vector<ValueType>> &results);
+
+  std::unique_ptr<IndexScanCursor> ScanCursor(
+      const std::vector<type::Value> &values,
+      const std::vector<oid_t> &key_column_ids,
+      const std::vector<ExpressionType> &expr_types,
+      ScanDirectionType scan_direction,
+      const ConjunctionScanPredicate *csp_p);
+
+  std::unique_ptr<IndexScanCursor> ScanAllKeysCursor();
+
   std::string GetTypeName() const;
 
   // TODO: Implement this
@@ -135,6 +153,42 @@ class BWTreeIndex : public Index {
   }
 
  protected:
+  /*
+   * class ForwardScanCursor - Resumes a forward scan from the leaf page
+   *                           the iterator holds a copy of
+   */
+  class ForwardScanCursor : public IndexScanCursor {
+   public:
+    ForwardScanCursor(BWTreeIndex *index_p,
+                      const typename MapType::ForwardIterator &scan_itr,
+                      const KeyType *high_key_p);
+
+    bool Next(std::vector<ItemPointer *> &result, size_t max_count);
+
+    bool NextEntries(std::vector<ItemPointer *> &result,
+                     std::vector<type::Value> &key_values, size_t max_count);
+
+   private:
+    // Appends the values, and the key values if there is a list for them
+    bool NextBatch(std::vector<ItemPointer *> &result,
+                   std::vector<type::Value> *key_values_p, size_t max_count);
+
+    BWTreeIndex *index_p_;
+
+    typename MapType::ForwardIterator scan_itr_;
+
+    // The scan stops past the high key, if it has one
+    bool has_high_key_;
+    KeyType high_key_;
+  };
+
+  using KeyValuePair = std::pair<KeyType, ValueType>;
+
+  // Converts the entries into key-value pairs sorted on their keys
+  void SortEntries(const std::vector<const storage::Tuple *> &keys,
+                   const std::vector<ItemPointer *> &locations,
+                   std::vector<KeyValuePair> &items);
+
   // equality checker and comparator
   KeyComparator comparator;
   KeyEqualityChecker equals;
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.h
+//
+// Identification: src/include/index/hash_index.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "libcuckoo/cuckoohash_map.hh"
+
+#include "common/platform.h"
+#include "index/index.h"
+#include "type/types.h"
+
+#define HASH_TEMPLATE_ARGUMENTS                                          \
+  template <typename KeyType, typename ValueType, typename KeyHashFunc, \
+            typename KeyEqualityChecker>
+
+#define HASH_INDEX_TYPE \
+  HashIndex<KeyType, ValueType, KeyHashFunc, KeyEqualityChecker>
+
+namespace peloton {
+namespace index {
+
+/**
+ * Hash index implementation, on top of the cuckoo hash table that CuckooMap
+ * wraps.
+ *
+ * It maps each key to the list of its values, so that it is a multimap like
+ * the BwTree. The table locks the two buckets of a key while its list is
+ * updated, which makes point queries and updates of different keys
+ * concurrent.
+ *
+ * The keys are not ordered: any other scan goes through the whole table,
+ * locking it, and checks the predicate on each key.
+ *
+ * NOTE: The list of a key is left empty once all its values are deleted, it
+ * is reused if the key is inserted again.
+ *
+ * @see Index
+ */
+HASH_TEMPLATE_ARGUMENTS
+class HashIndex : public Index {
+  friend class IndexFactory;
+
+  using ValueListType = std::vector<ValueType>;
+
+  using MapType = cuckoohash_map<KeyType, ValueListType, KeyHashFunc,
+                                 KeyEqualityChecker>;
+
+ public:
+  HashIndex(IndexMetadata *metadata);
+
+  ~HashIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate);
+
+  void Scan(const std::vector<type::Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            ScanDirectionType scan_direction, std::vector<ValueType> &result,
+            const ConjunctionScanPredicate *csp_p);
+
+  void ScanLimit(const std::vector<type::Value> &values,
+                 const std::vector<oid_t> &key_column_ids,
+                 const std::vector<ExpressionType> &expr_types,
+                 ScanDirectionType scan_direction,
+                 std::vector<ValueType> &result,
+                 const ConjunctionScanPredicate *csp_p, uint64_t limit,
+                 uint64_t offset);
+
+  void ScanAllKeys(std::vector<ValueType> &result);
+
+  void ScanKey(const storage::Tuple *key, std::vector<ValueType> &result);
+
+  std::string GetTypeName() const;
+
+  bool Cleanup() { return true; }
+
+  // Only counts the entries of the table, not the storage of the value lists
+  size_t GetMemoryFootprint() {
+    return container.size() * (sizeof(KeyType) + sizeof(ValueListType));
+  }
+
+  // The deleted values are removed from the table right away
+  bool NeedGC() { return false; }
+
+  void PerformGC() { return; }
+
+ protected:
+  // container
+  MapType container;
+};
+
+}  // End index namespace
+}  // End peloton namespace
@@ -63,7 +63,8 @@ class IndexMetadata : public Printable {
                 IndexConstraintType index_constraint_type,
                 const catalog::Schema *tuple_schema,
                 const catalog::Schema *key_schema,
-                const std::vector<oid_t> &key_attrs, bool unique_keys);
+                const std::vector<oid_t> &key_attrs, bool unique_keys,
+                oid_t included_column_count = 0);
 
   ~IndexMetadata();
 
@@ -96,6 +97,21 @@ class IndexMetadata : public Printable {
 
   bool HasUniqueKeys() const { return unique_keys; }
 
+  /*
+   * GetIncludedColumnCount() - Returns the number of non-key columns whose
+   *                            values the keys carry after the key columns
+   */
+  inline oid_t GetIncludedColumnCount() const { return included_column_count; }
+
+  /*
+   * IsCovering() - Returns whether the keys carry included columns
+   *
+   * The keys of a covering index end with the location of the version they
+   * were built from, so that each version has its own entry and a scan may
+   * check its visibility without walking the version chain
+   */
+  inline bool IsCovering() const { return included_column_count != 0; }
+
   /*
    * GetKeyAttrs() - Returns the mapping relation between indexed columns
    *                 and base table columns
@@ -134,6 +150,12 @@ class IndexMetadata : public Printable {
   // STATIC HELPERS
   //===--------------------------------------------------------------------===//
 
+  // Builds the key schema of a covering index, which is made of the key
+  // columns, the included columns and the version hint column
+  static catalog::Schema *GetCoveringKeySchema(
+      const catalog::Schema *tuple_schema, const std::vector<oid_t> &key_attrs,
+      const std::vector<oid_t> &included_attrs);
+
   static inline void SetDefaultVisibleFlag(bool flag) {
     LOG_DEBUG("Set IndexMetadata visible flag to '%s'",
               (flag ? "true" : "false"));
@@ -175,6 +197,10 @@ class IndexMetadata : public Printable {
   // Whether keys are unique (e.g. primary key)
   bool unique_keys;
 
+  // Number of the trailing key_attrs that are included rather than key
+  // columns
+  oid_t included_column_count;
+
   // utility of an index
   double utility_ratio = INVALID_RATIO;
 
@@ -185,6 +211,51 @@ class IndexMetadata : public Printable {
   static bool index_default_visibility;
 };
 
+/////////////////////////////////////////////////////////////////////
+// IndexScanCursor class definition
+/////////////////////////////////////////////////////////////////////
+
+/*
+ * class IndexScanCursor - Resumable scan over an index
+ *
+ * The cursor hands out the values of a scan a batch at a time, in the order
+ * the scan would return them, so that the caller may stop as soon as it has
+ * seen enough of them
+ */
+class IndexScanCursor {
+ public:
+  virtual ~IndexScanCursor() {}
+
+  // Appends at most max_count values to the result, returns false if the
+  // scan is over and none is left
+  virtual bool Next(std::vector<ItemPointer *> &result, size_t max_count) = 0;
+
+  // Same as Next(), the values of the columns of the key of each entry being
+  // appended to key_values in key schema order. Only the cursors that read
+  // the keys from the index support it
+  virtual bool NextEntries(std::vector<ItemPointer *> &result,
+                           std::vector<type::Value> &key_values,
+                           size_t max_count);
+};
+
+/*
+ * class MaterializedScanCursor - Cursor over the values of a complete scan
+ *
+ * This is the cursor of the scans that indices can not resume
+ */
+class MaterializedScanCursor : public IndexScanCursor {
+ public:
+  MaterializedScanCursor(std::vector<ItemPointer *> &&values)
+      : values_(std::move(values)), position_(0) {}
+
+  bool Next(std::vector<ItemPointer *> &result, size_t max_count);
+
+ private:
+  std::vector<ItemPointer *> values_;
+
+  size_t position_;
+};
+
 /////////////////////////////////////////////////////////////////////
 // Index class definition
 /////////////////////////////////////////////////////////////////////
@@ -244,6 +315,18 @@ class Index : public Printable {
   virtual bool CondInsertEntry(const storage::Tuple *key, ItemPointer *location,
                                std::function<bool(const void *)> predicate) = 0;
 
+  // Inserts the entries keys[i] -> locations[i], skipping those that are
+  // there already. Returns the number of entries inserted
+  virtual size_t InsertEntries(const std::vector<const storage::Tuple *> &keys,
+                               const std::vector<ItemPointer *> &locations);
+
+  // Same as InsertEntries(), for an index that is empty and that no one else
+  // accesses yet, e.g. while it is created, but that only keeps one entry per
+  // key of a unique index. Indices that can build their structure from the
+  // whole set of entries at once override it
+  virtual size_t BulkLoad(const std::vector<const storage::Tuple *> &keys,
+                          const std::vector<ItemPointer *> &locations);
+
   ///////////////////////////////////////////////////////////////////
   // Index Scan
   ///////////////////////////////////////////////////////////////////
@@ -277,6 +360,22 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  // Looks up several keys at once, results[i] getting the values of keys[i].
+  // By default each key is looked up on its own
+  virtual void ScanKeysBatch(const std::vector<const storage::Tuple *> &keys,
+                             std::vector<std::vector<ItemPointer *>> &results);
+
+  // Opens a cursor over the same values as Scan(). By default the scan is
+  // performed at once and the cursor hands out its result
+  virtual std::unique_ptr<IndexScanCursor> ScanCursor(
+      const std::vector<type::Value> &value_list,
+      const std::vector<oid_t> &tuple_column_id_list,
+      const std::vector<ExpressionType> &expr_list,
+      ScanDirectionType scan_direction, const ConjunctionScanPredicate *csp_p);
+
+  // Opens a cursor over the same values as ScanAllKeys()
+  virtual std::unique_ptr<IndexScanCursor> ScanAllKeysCursor();
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection
   ///////////////////////////////////////////////////////////////////
@@ -326,6 +425,15 @@ class Index : public Printable {
    */
   bool HasUniqueKeys() const { return metadata->HasUniqueKeys(); }
 
+  bool IsCovering() const { return metadata->IsCovering(); }
+
+  // Sets the version hint of the key of a covering index to the location of
+  // the version the key is built from. Keys of other indices have no hint
+  void SetVersionHint(storage::Tuple *key, const ItemPointer &location) const;
+
+  // Returns the location held by the version hint column of a key
+  static ItemPointer GetVersionHint(const type::Value &hint);
+
   oid_t GetColumnCount() const { return metadata->GetColumnCount(); }
 
   const std::string &GetName() const { return metadata->GetName(); }
@@ -39,6 +39,14 @@ class IndexFactory {
   static Index *GetBwTreeIntsKeyIndex(IndexMetadata *metadata);
 
   static Index *GetBwTreeGenericKeyIndex(IndexMetadata *metadata);
+
+  //===--------------------------------------------------------------------===//
+  // PELOTON::HASH
+  //===--------------------------------------------------------------------===//
+
+  static Index *GetHashIntsKeyIndex(IndexMetadata *metadata);
+
+  static Index *GetHashGenericKeyIndex(IndexMetadata *metadata);
 };
 
 }  // End index namespace
@@ -18,6 +18,7 @@
 #include "type/value.h"
 
 #include <memory>
+#include <set>
 #include <vector>
 
 namespace peloton {
@@ -76,6 +77,12 @@ class SimpleOptimizer : public AbstractOptimizer {
                                   std::vector<type::Value> &values,
                                   bool &index_searchable);
 
+  // get the column IDs the tuple values of an expression read
+  static void GetTupleValueColumns(
+      const catalog::Schema *schema,
+      const expression::AbstractExpression *expression,
+      std::set<oid_t> &column_ids);
+
   static bool CheckIndexSearchable(storage::DataTable *target_table,
                                    expression::AbstractExpression *expression,
                                    std::vector<oid_t> &key_column_ids,
@@ -88,6 +95,10 @@ class SimpleOptimizer : public AbstractOptimizer {
       storage::DataTable *target_table, std::vector<oid_t> &column_ids,
       expression::AbstractExpression *predicate, bool for_update);
 
+  // run a sequential scan of a select statement on several threads
+  static std::unique_ptr<planner::AbstractPlan> CreateParallelScanPlan(
+      std::unique_ptr<planner::AbstractScan> scan_plan);
+
   // create a copy plan for a copy statement
   static std::unique_ptr<planner::AbstractPlan> CreateCopyPlan(
       parser::CopyStatement *copy_stmt);
@@ -97,6 +108,12 @@ class SimpleOptimizer : public AbstractOptimizer {
   static std::unique_ptr<planner::AbstractPlan> CreateJoinPlan(
       parser::SelectStatement *select_stmt);
 
+  // Whether a hash join should push a bloom filter of its build keys down
+  // into the scan of its probe side
+  static bool UseBloomFilterPushdown(JoinType join_type,
+                                     const storage::DataTable *probe_table,
+                                     const storage::DataTable *build_table);
+
   // This is used for order_by + limit optimization. Let the index scan executor
   // know order_by flags when create an order_by
   // plan. This is used when we create a order_by plan and the underlying
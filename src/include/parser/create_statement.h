@@ -172,6 +172,11 @@ struct CreateStatement : TableRefStatement {
       delete index_attrs;
     }
 
+    if (index_include_attrs) {
+      for (auto attr : *index_include_attrs) free(attr);
+      delete index_include_attrs;
+    }
+
     free(index_name);
     free(database_name);
   }
@@ -185,6 +190,8 @@ struct CreateStatement : TableRefStatement {
 
   std::vector<ColumnDefinition*>* columns;
   std::vector<char*>* index_attrs = nullptr;
+  // Non-key columns whose values the entries of the index carry
+  std::vector<char*>* index_include_attrs = nullptr;
 
   IndexType index_type;
 
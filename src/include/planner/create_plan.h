@@ -66,6 +66,10 @@ class CreatePlan : public AbstractPlan {
 
   std::vector<std::string> GetIndexAttributes() const { return index_attrs; }
 
+  std::vector<std::string> GetIndexIncludeAttributes() const {
+    return index_include_attrs;
+  }
+
  private:
   // Target Table
   storage::DataTable *target_table_ = nullptr;
@@ -82,6 +86,9 @@ class CreatePlan : public AbstractPlan {
   // Index attributes
   std::vector<std::string> index_attrs;
 
+  // Non-key attributes the index entries carry
+  std::vector<std::string> index_include_attrs;
+
   // Check to either Create Table or INDEX
   CreateType create_type;
 
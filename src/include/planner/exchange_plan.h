@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_plan.h
+//
+// Identification: src/include/planner/exchange_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "abstract_plan.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace planner {
+
+/**
+ * @brief	Exchange plan node.
+ * Runs its child, a sequential scan of a table, on several threads and hands
+ * the logical tiles of the scan to its parent in the order they are produced.
+ * IMPORTANT: the order of the tiles is not the order of the table.
+ */
+class ExchangePlan : public AbstractPlan {
+ public:
+  ExchangePlan(const ExchangePlan &) = delete;
+  ExchangePlan &operator=(const ExchangePlan &) = delete;
+  ExchangePlan(ExchangePlan &&) = delete;
+  ExchangePlan &operator=(ExchangePlan &&) = delete;
+
+  // parallelism is the maximum number of threads the scan may use, including
+  // the thread running the plan
+  explicit ExchangePlan(size_t parallelism) : parallelism_(parallelism) {}
+
+  // Accessors
+  size_t GetParallelism() const { return parallelism_; }
+
+  inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::EXCHANGE; }
+
+  const std::string GetInfo() const { return "Exchange"; }
+
+  std::unique_ptr<AbstractPlan> Copy() const {
+    return std::unique_ptr<AbstractPlan>(new ExchangePlan(parallelism_));
+  }
+
+ private:
+  const size_t parallelism_;
+};
+
+} /* namespace planner */
+} /* namespace peloton */
@@ -50,6 +50,14 @@ class HashJoinPlan : public AbstractJoinPlan {
     return outer_column_ids_;
   }
 
+  // Whether the join pushes down a bloom filter of the keys of its build side
+  // into the scan of its probe side, its left child
+  void SetBloomFilterPushdown(bool pushdown) {
+    bloom_filter_pushdown_ = pushdown;
+  }
+
+  bool IsBloomFilterPushdown() const { return bloom_filter_pushdown_; }
+
   std::unique_ptr<AbstractPlan> Copy() const {
     std::unique_ptr<const expression::AbstractExpression> predicate_copy(
         GetPredicate()->Copy());
@@ -58,11 +66,14 @@ class HashJoinPlan : public AbstractJoinPlan {
     HashJoinPlan *new_plan = new HashJoinPlan(
         GetJoinType(), std::move(predicate_copy),
         std::move(GetProjInfo()->Copy()), schema_copy, outer_column_ids_);
+    new_plan->SetBloomFilterPushdown(bloom_filter_pushdown_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
  private:
   std::vector<oid_t> outer_column_ids_;
+
+  bool bloom_filter_pushdown_ = false;
 };
 
 }  // namespace planner
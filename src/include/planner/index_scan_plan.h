@@ -154,6 +154,8 @@ class IndexScanPlan : public AbstractScan {
 
   inline bool GetDescend() const { return descend_; }
 
+  inline bool GetIndexOnly() const { return index_only_; }
+
   const std::string GetInfo() const { return "IndexScan"; }
 
   void SetLimit(bool limit) { limit_ = limit; }
@@ -164,6 +166,8 @@ class IndexScanPlan : public AbstractScan {
 
   void SetDescend(bool descend) { descend_ = descend; }
 
+  void SetIndexOnly(bool index_only) { index_only_ = index_only; }
+
   void SetParameterValues(std::vector<type::Value> *values);
 
   std::unique_ptr<AbstractPlan> Copy() const {
@@ -176,6 +180,7 @@ class IndexScanPlan : public AbstractScan {
                        new_runtime_keys);
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc, false);
+    new_plan->SetIndexOnly(index_only_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
@@ -232,6 +237,10 @@ class IndexScanPlan : public AbstractScan {
 
   // whether order by is descending
   bool descend_ = false;
+
+  // whether the output columns and the predicate are read from the entries
+  // of a covering index rather than from the table
+  bool index_only_ = false;
 };
 
 }  // namespace planner
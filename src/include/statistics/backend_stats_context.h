@@ -92,6 +92,11 @@ class BackendStatsContext {
   // Increment the delete stat for given tile group
   void IncrementTableDeletes(oid_t tile_group_id);
 
+  // Increment the join bloom filter stats of the given table by the number of
+  // tuples probed and the number of them that passed
+  void IncrementTableBloomFilterProbes(oid_t database_id, oid_t table_id,
+                                       size_t probe_count, size_t pass_count);
+
   // Increment the read stat for given index by read_count
   void IncrementIndexReads(size_t read_count, index::IndexMetadata* metadata);
 
@@ -18,6 +18,7 @@
 #include "type/types.h"
 #include "statistics/abstract_metric.h"
 #include "statistics/access_metric.h"
+#include "statistics/counter_metric.h"
 
 namespace peloton {
 namespace stats {
@@ -37,6 +38,19 @@ class TableMetric : public AbstractMetric {
 
   inline AccessMetric &GetTableAccess() { return table_access_; }
 
+  inline CounterMetric &GetBloomFilterProbes() { return bloom_filter_probes_; }
+
+  inline CounterMetric &GetBloomFilterPasses() { return bloom_filter_passes_; }
+
+  // Fraction of the tuples probed against a join bloom filter that passed it
+  inline double GetBloomFilterPassRate() const {
+    if (bloom_filter_probes_.GetCounter() == 0) {
+      return 1.0;
+    }
+    return (double)bloom_filter_passes_.GetCounter() /
+           bloom_filter_probes_.GetCounter();
+  }
+
   inline std::string GetName() { return table_name_; }
 
   inline oid_t GetDatabaseId() { return database_id_; }
@@ -47,12 +61,18 @@ class TableMetric : public AbstractMetric {
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() { table_access_.Reset(); }
+  inline void Reset() {
+    table_access_.Reset();
+    bloom_filter_probes_.Reset();
+    bloom_filter_passes_.Reset();
+  }
 
   inline bool operator==(const TableMetric &other) {
     return database_id_ == other.database_id_ && table_id_ == other.table_id_ &&
            table_name_ == other.table_name_ &&
-           table_access_ == other.table_access_;
+           table_access_ == other.table_access_ &&
+           bloom_filter_probes_ == other.bloom_filter_probes_ &&
+           bloom_filter_passes_ == other.bloom_filter_passes_;
   }
 
   inline bool operator!=(const TableMetric &other) { return !(*this == other); }
@@ -67,6 +87,10 @@ class TableMetric : public AbstractMetric {
     ;
     ss << "-----------------------------" << std::endl;
     ss << table_access_.GetInfo() << std::endl;
+    if (bloom_filter_probes_.GetCounter() > 0) {
+      ss << "[bloom filter] probes: " << bloom_filter_probes_.GetInfo()
+         << ", pass rate: " << GetBloomFilterPassRate() << std::endl;
+    }
     return ss.str();
   }
 
@@ -86,6 +110,13 @@ class TableMetric : public AbstractMetric {
 
   // The number of tuple accesses
   AccessMetric table_access_{ACCESS_METRIC};
+
+  // The number of tuples probed against the bloom filter of a hash join
+  // pushed down into a scan of the table
+  CounterMetric bloom_filter_probes_{COUNTER_METRIC};
+
+  // The number of probed tuples that passed the filter
+  CounterMetric bloom_filter_passes_{COUNTER_METRIC};
 };
 
 }  // namespace stats
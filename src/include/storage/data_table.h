@@ -21,6 +21,7 @@
 #include "common/item_pointer.h"
 #include "common/platform.h"
 #include "container/lock_free_array.h"
+#include "container/sharded_counter.h"
 #include "index/index.h"
 #include "storage/abstract_table.h"
 #include "storage/indirection_array.h"
@@ -107,10 +108,12 @@ class DataTable : public AbstractTable {
 
   // install an version in table. designed for update operation.
   // as we implement logical-pointer indexing mechanism, targets_ptr is
-  // required.
+  // required. the version at location is inserted into the covering
+  // indexes whatever the targets.
   bool InstallVersion(const AbstractTuple *tuple, const TargetList *targets_ptr,
                       concurrency::Transaction *transaction,
-                      ItemPointer *index_entry_ptr);
+                      ItemPointer *index_entry_ptr,
+                      const ItemPointer &location);
 
   // insert tuple in table. the pointer to the index entry is returned as
   // index_entry_ptr.
@@ -138,10 +141,16 @@ class DataTable : public AbstractTable {
   std::shared_ptr<storage::TileGroup> GetTileGroupById(
       const oid_t &tile_group_id) const;
 
+  // Same as GetTileGroup without taking a reference on the tile group, only
+  // valid in a transaction. See catalog::Manager::GetTileGroupRaw.
+  storage::TileGroup *GetTileGroupRaw(
+      const std::size_t &tile_group_offset) const;
+
   size_t GetTileGroupCount() const;
 
-  // Get a tile group with given layout
-  TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
+  // Get a tile group with given layout, placed on the given NUMA node
+  TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning,
+                                    int numa_node = NumaUtil::ANY_NODE);
 
   //===--------------------------------------------------------------------===//
   // INDEX
@@ -149,6 +158,29 @@ class DataTable : public AbstractTable {
 
   void AddIndex(std::shared_ptr<index::Index> index);
 
+  // Inserts the latest live versions of the tile groups in
+  // [begin_tile_group_offset, end_tile_group_offset) into the index, their
+  // keys being extracted in parallel. With bulk_load the index is built from
+  // all the entries at once, it must then be empty and not reachable by
+  // anyone else, e.g. before it is added to the table. Returns the number of
+  // entries inserted.
+  size_t PopulateIndex(index::Index *index, oid_t begin_tile_group_offset,
+                       oid_t end_tile_group_offset, bool bulk_load);
+
+  // Builds an index that is not in the table yet bottom up, from the versions
+  // visible to txn. The locations of these versions are stored, sorted, in
+  // versions. Returns false if a key of a unique index is there twice.
+  bool BuildIndex(index::Index *index, concurrency::Transaction *txn,
+                  std::vector<ItemPointer> &versions);
+
+  // Inserts the versions visible to txn into an index that is already in the
+  // table, the writers inserting the entries of their own versions. The
+  // indexed_versions, sorted, are skipped. The entries of unique indexes are
+  // checked like those of the writes of txn. Returns false if a key of a
+  // unique index is taken.
+  bool BackfillIndex(index::Index *index, concurrency::Transaction *txn,
+                     const std::vector<ItemPointer> &indexed_versions = {});
+
   // Throw CatalogException if not such index is found
   std::shared_ptr<index::Index> GetIndexWithOid(const oid_t &index_oid);
 
@@ -187,6 +219,28 @@ class DataTable : public AbstractTable {
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
+  //===--------------------------------------------------------------------===//
+  // COMPACTION
+  //===--------------------------------------------------------------------===//
+
+  // Stops handing out the slots of a full tile group, so that it empties as
+  // its versions are moved out and collected. Returns false if the tile group
+  // is still filled by inserts or already retired.
+  bool RetireTileGroup(const oid_t &tile_group_offset);
+
+  // Moves the latest version at the location to a new slot, as an update of
+  // the transaction that does not change it. The indexes point to the
+  // indirection of the version, so they follow, but the covering indexes get
+  // an entry for the new version. Returns false if the version
+  // is not visible to the transaction or is owned by another one.
+  bool RelocateVersion(concurrency::Transaction *transaction,
+                       const ItemPointer &location);
+
+  // Once all the slots of a retired tile group have been collected, replaces
+  // it in the table by an empty tile group and hands it to the GC to be
+  // dropped. Returns false if some slots are still in use.
+  bool DropRetiredTileGroup(const oid_t &tile_group_offset);
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -250,6 +304,17 @@ class DataTable : public AbstractTable {
                        concurrency::Transaction *transaction,
                        ItemPointer **index_entry_ptr);
 
+  // covering indexes have an entry per version, whose key holds the location
+  // of the version. the entries of the version at location are inserted or
+  // deleted when its values are set or changed in place.
+  void InsertInCoveringIndexes(const AbstractTuple *tuple,
+                               const ItemPointer &location,
+                               ItemPointer *index_entry_ptr);
+
+  void DeleteFromCoveringIndexes(const AbstractTuple *tuple,
+                                 const ItemPointer &location,
+                                 ItemPointer *index_entry_ptr);
+
   static void SetActiveTileGroupCount(const size_t active_tile_group_count) {
     default_active_tilegroup_count_ = active_tile_group_count;
   }
@@ -271,6 +336,21 @@ class DataTable : public AbstractTable {
   // Claim a tuple slot in a tile group
   ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple);
 
+  // Active tile group the calling thread inserts into. Each thread sticks to
+  // one of the active tile groups of the NUMA node it runs on.
+  size_t GetActiveTileGroupId() const;
+
+  // NUMA node the active_tile_group_id-th active tile group is placed on
+  int GetActiveTileGroupNode(const size_t &active_tile_group_id) const;
+
+  // Only writes the flag when it changes, so that concurrent inserters do not
+  // bounce its cache line
+  inline void MarkDirty() {
+    if (dirty_ == false) {
+      dirty_ = true;
+    }
+  }
+
   // add a tile group to the table
   oid_t AddDefaultTileGroup();
   // add a tile group to the table. replace the active_tile_group_id-th active
@@ -279,6 +359,9 @@ class DataTable : public AbstractTable {
 
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
 
+  // Get an indirection pointing to the location
+  ItemPointer *AllocateIndirection(const ItemPointer &location);
+
   // Drop all tile groups of the table. Used by recovery
   void DropTileGroups();
 
@@ -294,6 +377,20 @@ class DataTable : public AbstractTable {
   // check the foreign key constraints
   bool CheckForeignKeyConstraints(const storage::Tuple *tuple);
 
+  // Extracts the index entries of the tile groups in
+  // [begin_tile_group_offset, end_tile_group_offset) in parallel, of their
+  // latest live versions or, with a txn, of the versions visible to it but
+  // for the skipped_versions, sorted. The keys are stored in key_buffers, the
+  // locations of the versions in versions if it is given.
+  void CollectIndexEntries(index::Index *index, oid_t begin_tile_group_offset,
+                           oid_t end_tile_group_offset,
+                           concurrency::Transaction *txn,
+                           const std::vector<ItemPointer> &skipped_versions,
+                           std::vector<std::unique_ptr<char[]>> &key_buffers,
+                           std::vector<storage::Tuple> &key_tuples,
+                           std::vector<ItemPointer *> &locations,
+                           std::vector<ItemPointer> *versions = nullptr);
+
  public:
   static size_t default_active_tilegroup_count_;
 
@@ -307,6 +404,11 @@ class DataTable : public AbstractTable {
   size_t active_tilegroup_count_;
   size_t active_indirection_array_count_;
 
+  // the active tile groups are split in one set per NUMA node, a single set
+  // when the table is not NUMA aware
+  size_t numa_node_count_;
+  size_t active_tilegroups_per_node_;
+
   oid_t database_oid;
   std::string table_name;
 
@@ -320,6 +422,9 @@ class DataTable : public AbstractTable {
 
   std::atomic<size_t> tile_group_count_ = ATOMIC_VAR_INIT(0);
 
+  // tile group taking the place of the dropped ones, it is never inserted into
+  oid_t empty_tile_group_id_ = INVALID_OID;
+
   // INDIRECTIONS
   std::vector<std::shared_ptr<storage::IndirectionArray>>
       active_indirection_arrays_;
@@ -342,9 +447,9 @@ class DataTable : public AbstractTable {
   // # of unique constraints
   std::atomic<oid_t> unique_constraint_count_ = ATOMIC_VAR_INIT(START_OID);
 
-  // # of tuples. must be atomic as multiple transactions can perform insert
+  // # of tuples. sharded as multiple transactions can perform insert
   // concurrently.
-  std::atomic<size_t> number_of_tuples_ = ATOMIC_VAR_INIT(0);
+  ShardedCounter number_of_tuples_;
 
   // dirty flag. for detecting whether the tile group has been used.
   bool dirty_ = false;
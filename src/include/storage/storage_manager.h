@@ -14,6 +14,7 @@
 
 #include <mutex>
 
+#include "common/numa_util.h"
 #include "common/platform.h"
 #include "type/types.h"
 
@@ -44,7 +45,9 @@ class StorageManager {
   StorageManager();
   ~StorageManager();
 
-  void *Allocate(BackendType type, size_t size);
+  // numa_node is the node main memory is preferably placed on
+  void *Allocate(BackendType type, size_t size,
+                 int numa_node = NumaUtil::ANY_NODE);
 
   void Release(BackendType type, void *address);
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "catalog/manager.h"
+#include "common/numa_util.h"
 #include "storage/abstract_table.h"
 #include "storage/tile_group.h"
 
@@ -33,7 +34,8 @@ class TileGroupFactory {
                                  oid_t tile_group_id, AbstractTable *table,
                                  const std::vector<catalog::Schema> &schemas,
                                  const column_map_type &column_map,
-                                 int tuple_count);
+                                 int tuple_count,
+                                 int numa_node = NumaUtil::ANY_NODE);
 };
 
 }  // End storage namespace
@@ -20,10 +20,17 @@
 
 #include "common/item_pointer.h"
 #include "common/macros.h"
+#include "common/numa_util.h"
 #include "common/platform.h"
 #include "common/printable.h"
 #include "type/types.h"
 
+//===--------------------------------------------------------------------===//
+// GUC Variables
+//===--------------------------------------------------------------------===//
+
+extern peloton::LayoutType peloton_header_layout_mode;
+
 namespace peloton {
 namespace storage {
 
@@ -59,21 +66,36 @@ class TileGroup;
  * of the version chain header.
  *  ReservedField: unused space for future usage.
  *
+ *  With the column layout (peloton_header_layout_mode), each field is kept
+ *  in its own array instead, so that scans checking the visibility of many
+ *  tuples only touch the txn ids and the commit ids:
+ *
+ *  -----------------------------------------------------------------------------
+ *  | TxnID[0..n) | BeginTimeStamp[0..n) | EndTimeStamp[0..n) |
+ *  | NextItemPointer[0..n) | PrevItemPointer[0..n) | Indirection[0..n) |
+ *  | ReservedField[0..n)
+ *  -----------------------------------------------------------------------------
+ *
  */
 
-#define TUPLE_HEADER_LOCATION data + (tuple_slot_id * header_entry_size)
+// location of a field in the header of a tuple slot
+#define TUPLE_HEADER_LOCATION(field) \
+  (field##_location + (tuple_slot_id * field_stride))
 
 class TileGroupHeader : public Printable {
   TileGroupHeader() = delete;
 
  public:
-  TileGroupHeader(const BackendType &backend_type, const int &tuple_count);
+  TileGroupHeader(const BackendType &backend_type, const int &tuple_count,
+                  const LayoutType &layout_type = peloton_header_layout_mode,
+                  const int &numa_node = NumaUtil::ANY_NODE);
 
   TileGroupHeader &operator=(const peloton::storage::TileGroupHeader &other) {
     // check for self-assignment
     if (&other == this) return *this;
 
     header_size = other.header_size;
+    PL_ASSERT(layout_type == other.layout_type);
 
     // copy over all the data
     PL_MEMCPY(data, other.data, header_size);
@@ -82,6 +104,9 @@ class TileGroupHeader : public Printable {
     oid_t val = other.next_tuple_slot;
     next_tuple_slot = val;
 
+    all_visible_cid = MAX_CID;
+    retired = other.retired.load();
+
     return *this;
   }
 
@@ -103,6 +128,31 @@ class TileGroupHeader : public Printable {
     }
   }
 
+  // Reserves up to count consecutive slots, the first one being returned in
+  // first_slot. Returns the number of slots reserved, 0 if the tile group is
+  // full. The last slot is always reserved alone, so that the thread that
+  // gets it can replace the tile group right away.
+  oid_t ReserveTupleSlots(const oid_t &count, oid_t &first_slot) {
+    oid_t slot = next_tuple_slot.load(std::memory_order_relaxed);
+    while (true) {
+      if (slot >= num_tuple_slots) {
+        return 0;
+      }
+
+      oid_t end = slot + count;
+      if (end >= num_tuple_slots) {
+        end = (slot == num_tuple_slots - 1) ? num_tuple_slots
+                                            : num_tuple_slots - 1;
+      }
+
+      if (next_tuple_slot.compare_exchange_weak(slot, end,
+                                                std::memory_order_relaxed)) {
+        first_slot = slot;
+        return end - slot;
+      }
+    }
+  }
+
   /**
    * Used by logging
    */
@@ -133,6 +183,8 @@ class TileGroupHeader : public Printable {
 
   oid_t GetActiveTupleCount() const;
 
+  oid_t GetAllocatedTupleCount() const { return num_tuple_slots; }
+
   //===--------------------------------------------------------------------===//
   // MVCC utilities
   //===--------------------------------------------------------------------===//
@@ -147,32 +199,33 @@ class TileGroupHeader : public Printable {
   // but the current transaction reads the txn_id.
   // the returned value seems to be uncertain.
   inline txn_id_t GetTransactionId(const oid_t &tuple_slot_id) const {
-    return *((txn_id_t *)(TUPLE_HEADER_LOCATION));
+    return *((txn_id_t *)(TUPLE_HEADER_LOCATION(txn_id)));
   }
 
   inline cid_t GetBeginCommitId(const oid_t &tuple_slot_id) const {
-    return *((cid_t *)(TUPLE_HEADER_LOCATION + begin_cid_offset));
+    return *((cid_t *)(TUPLE_HEADER_LOCATION(begin_cid)));
   }
 
   inline cid_t GetEndCommitId(const oid_t &tuple_slot_id) const {
-    return *((cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset));
+    return *((cid_t *)(TUPLE_HEADER_LOCATION(end_cid)));
   }
 
   inline ItemPointer GetNextItemPointer(const oid_t &tuple_slot_id) const {
-    return *((ItemPointer *)(TUPLE_HEADER_LOCATION + next_pointer_offset));
+    return *((ItemPointer *)(TUPLE_HEADER_LOCATION(next_pointer)));
   }
 
   inline ItemPointer GetPrevItemPointer(const oid_t &tuple_slot_id) const {
-    return *((ItemPointer *)(TUPLE_HEADER_LOCATION + prev_pointer_offset));
+    return *((ItemPointer *)(TUPLE_HEADER_LOCATION(prev_pointer)));
   }
 
   inline ItemPointer *GetIndirection(const oid_t &tuple_slot_id) const {
-    return *(ItemPointer **)(TUPLE_HEADER_LOCATION + indirection_offset);
+    return *(ItemPointer **)(TUPLE_HEADER_LOCATION(indirection));
   }
 
   // constraint: at most 16 bytes.
   inline char *GetReservedFieldRef(const oid_t &tuple_slot_id) const {
-    return (char *)(TUPLE_HEADER_LOCATION + reserved_field_offset);
+    return (char *)(reserved_field_location +
+                    (tuple_slot_id * reserved_field_stride));
   }
 
   // Setters
@@ -182,49 +235,124 @@ class TileGroupHeader : public Printable {
   }
   inline void SetTransactionId(const oid_t &tuple_slot_id,
                                const txn_id_t &transaction_id) const {
-    *((txn_id_t *)(TUPLE_HEADER_LOCATION)) = transaction_id;
+    *((txn_id_t *)(TUPLE_HEADER_LOCATION(txn_id))) = transaction_id;
+    ClearAllVisible();
   }
 
   inline void SetBeginCommitId(const oid_t &tuple_slot_id,
                                const cid_t &begin_cid) {
-    *((cid_t *)(TUPLE_HEADER_LOCATION + begin_cid_offset)) = begin_cid;
+    *((cid_t *)(TUPLE_HEADER_LOCATION(begin_cid))) = begin_cid;
+    ClearAllVisible();
   }
 
   inline void SetEndCommitId(const oid_t &tuple_slot_id,
                              const cid_t &end_cid) const {
-    *((cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset)) = end_cid;
+    *((cid_t *)(TUPLE_HEADER_LOCATION(end_cid))) = end_cid;
+    ClearAllVisible();
   }
 
   inline void SetNextItemPointer(const oid_t &tuple_slot_id,
                                  const ItemPointer &item) const {
-    *((ItemPointer *)(TUPLE_HEADER_LOCATION + next_pointer_offset)) = item;
+    *((ItemPointer *)(TUPLE_HEADER_LOCATION(next_pointer))) = item;
   }
 
   inline void SetPrevItemPointer(const oid_t &tuple_slot_id,
                                  const ItemPointer &item) const {
-    *((ItemPointer *)(TUPLE_HEADER_LOCATION + prev_pointer_offset)) = item;
+    *((ItemPointer *)(TUPLE_HEADER_LOCATION(prev_pointer))) = item;
   }
 
   inline void SetIndirection(const oid_t &tuple_slot_id,
                              const ItemPointer *indirection) const {
-    *((const ItemPointer **)(TUPLE_HEADER_LOCATION + indirection_offset)) =
+    *((const ItemPointer **)(TUPLE_HEADER_LOCATION(indirection))) =
         indirection;
   }
 
+  // Sets the indirection of a slot that has none yet, returns the one it
+  // ends up with
+  inline ItemPointer *SetAtomicIndirection(const oid_t &tuple_slot_id,
+                                           ItemPointer *new_indirection) const {
+    ItemPointer **indirection_ptr =
+        (ItemPointer **)(TUPLE_HEADER_LOCATION(indirection));
+    ItemPointer *old_indirection = __sync_val_compare_and_swap(
+        indirection_ptr, (ItemPointer *)nullptr, new_indirection);
+    return old_indirection == nullptr ? new_indirection : old_indirection;
+  }
+
   inline txn_id_t SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                          const txn_id_t &old_txn_id,
                                          const txn_id_t &new_txn_id) const {
-    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
-    return __sync_val_compare_and_swap(txn_id_ptr, old_txn_id, new_txn_id);
+    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION(txn_id));
+    txn_id_t txn_id =
+        __sync_val_compare_and_swap(txn_id_ptr, old_txn_id, new_txn_id);
+    if (txn_id == old_txn_id) {
+      ClearAllVisible();
+    }
+    return txn_id;
+  }
+
+  // sets the next item pointer only if it is still the old one
+  inline bool SetAtomicNextItemPointer(const oid_t &tuple_slot_id,
+                                       const ItemPointer &old_item,
+                                       const ItemPointer &new_item) const {
+    static_assert(sizeof(ItemPointer) == sizeof(uint64_t),
+                  "an item pointer is swapped as a 64-bit word");
+    uint64_t *item_ptr = (uint64_t *)(TUPLE_HEADER_LOCATION(next_pointer));
+    uint64_t old_word, new_word;
+    PL_MEMCPY(&old_word, &old_item, sizeof(uint64_t));
+    PL_MEMCPY(&new_word, &new_item, sizeof(uint64_t));
+    return __sync_bool_compare_and_swap(item_ptr, old_word, new_word);
   }
 
   inline bool SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                      const txn_id_t &transaction_id) const {
-    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
-    return __sync_bool_compare_and_swap(txn_id_ptr, INITIAL_TXN_ID,
-                                        transaction_id);
+    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION(txn_id));
+    bool success = __sync_bool_compare_and_swap(txn_id_ptr, INITIAL_TXN_ID,
+                                                 transaction_id);
+    if (success == true) {
+      ClearAllVisible();
+    }
+    return success;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Visibility summary
+  //===--------------------------------------------------------------------===//
+
+  // The summary is only kept for tile groups that are full. When it is set,
+  // every slot holds a version that is committed, not owned by any
+  // transaction and not yet invalidated, and none of them was committed after
+  // the returned cid. So a reader that began at or after the cid sees every
+  // slot. Returns MAX_CID if there is no summary.
+  inline cid_t GetAllVisibleCommitId() const { return all_visible_cid.load(); }
+
+  inline bool IsAllVisible(const cid_t &read_cid) const {
+    cid_t all_visible_commit_id = all_visible_cid.load();
+    return (all_visible_commit_id != MAX_CID &&
+            read_cid >= all_visible_commit_id);
   }
 
+  // Publish the summary after a scan found every slot of the tile group
+  // committed, unowned and live, the newest committed at max_begin_cid.
+  // Returns false if the tile group is not full or a writer got in the way.
+  bool SetAllVisible(const cid_t &max_begin_cid) const;
+
+  // Drop the summary. Any change to a slot header goes through here.
+  inline void ClearAllVisible() const {
+    if (all_visible_cid.load(std::memory_order_relaxed) != MAX_CID) {
+      all_visible_cid.store(MAX_CID);
+    }
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Compaction
+  //===--------------------------------------------------------------------===//
+
+  // A retired tile group hands out no more slots, its live versions are
+  // moved to other tile groups before it is dropped.
+  inline bool IsRetired() const { return retired.load(); }
+
+  inline void SetRetired() { retired = true; }
+
   void PrintVisibility(txn_id_t txn_id, cid_t at_cid);
 
   // Getter for spin lock
@@ -243,6 +371,11 @@ class TileGroupHeader : public Printable {
 
   static inline size_t GetReservedSize() { return reserved_size; }
 
+  inline LayoutType GetLayoutType() const { return layout_type; }
+
+  // Node the header and the tiles of the tile group are placed on
+  inline int GetNumaNode() const { return numa_node; }
+
   // header entry size is the size of the layout described above
   static const size_t reserved_size = 16;
   static const size_t header_entry_size = sizeof(txn_id_t) + 2 * sizeof(cid_t) +
@@ -267,6 +400,12 @@ class TileGroupHeader : public Printable {
   // Backend
   BackendType backend_type;
 
+  // Row (one entry per slot) or column (one array per field) layout
+  LayoutType layout_type;
+
+  // NUMA node of the memory, NumaUtil::ANY_NODE if not placed
+  int numa_node;
+
   // Associated tile_group
   TileGroup *tile_group;
 
@@ -275,6 +414,19 @@ class TileGroupHeader : public Printable {
   // set of fixed-length tuple slots
   char *data;
 
+  // where the field of the first slot is found, and the distance between
+  // the fields of consecutive slots. all fields but the reserved one are
+  // 8 bytes wide, so they share a stride.
+  char *txn_id_location;
+  char *begin_cid_location;
+  char *end_cid_location;
+  char *next_pointer_location;
+  char *prev_pointer_location;
+  char *indirection_location;
+  char *reserved_field_location;
+  size_t field_stride;
+  size_t reserved_field_stride;
+
   // number of tuple slots allocated
   oid_t num_tuple_slots;
 
@@ -283,6 +435,12 @@ class TileGroupHeader : public Printable {
   // IT MAY OUT OF BOUNDARY! ALWAYS CHECK IF IT EXCEEDS num_tuple_slots
   std::atomic<oid_t> next_tuple_slot;
 
+  // visibility summary, MAX_CID when unknown
+  mutable std::atomic<cid_t> all_visible_cid;
+
+  // set when the tile group is being compacted
+  std::atomic<bool> retired;
+
   Spinlock tile_header_lock;
 };
 
@@ -14,6 +14,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <functional>
 #include <mutex>
 #include <stack>
 #include <vector>
@@ -37,6 +38,17 @@ namespace tcop {
 class TrafficCop {
   TrafficCop(TrafficCop const &) = delete;
 
+  // Receives a batch of result rows, as the ids of the rows in the logical
+  // tile they live in. Returns false if the rows could not be delivered,
+  // which aborts the statement.
+  typedef std::function<bool(executor::LogicalTile &,
+                             const std::vector<oid_t> &)> ResultCallback;
+
+  // Asked after each batch of rows was delivered. Returns true to suspend the
+  // portal before the next batch, e.g. until the client catches up with the
+  // rows already sent.
+  typedef std::function<bool()> PauseCallback;
+
  public:
   TrafficCop();
   ~TrafficCop();
@@ -67,6 +79,20 @@ class TrafficCop {
       const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
       std::vector<StatementResult> &result, const std::vector<int> &result_format);
 
+  // PortalRun - Execute the statement of a portal and hand its result rows to
+  // the callback one logical tile at a time, instead of materializing all of
+  // them. If max_rows is not 0, the portal is suspended once that many rows
+  // have been returned, and the next call resumes it. The portal is
+  // suspended the same way as soon as the pause callback asks for it.
+  ResultType ExecutePortal(Portal &portal, const std::vector<int> &result_format,
+                           const size_t max_rows,
+                           const ResultCallback &callback, bool &suspended,
+                           int &rows_changed, std::string &error_message,
+                           const PauseCallback &pause = nullptr);
+
+  // PortalDrop - Release the executor state of a suspended portal
+  void ClosePortal(Portal &portal);
+
   // InitBindPrepStmt - Prepare and bind a query from a query string
   std::shared_ptr<Statement> PrepareStatement(const std::string &statement_name,
                                               const std::string &query_string,
@@ -98,6 +124,16 @@ class TrafficCop {
 
   TcopTxnState &GetCurrentTxnState();
 
+  // Get the txn to run a statement in, starting a new one if there is no
+  // active txn block. Returns nullptr if the active txn block has aborted.
+  concurrency::Transaction *BeginStatementTransaction(
+      bool &single_statement_txn);
+
+  // Commit or abort the txn of a statement after it has run
+  void FinishStatementTransaction(concurrency::Transaction *txn,
+                                  const bool single_statement_txn,
+                                  bridge::peloton_status &p_status);
+
   ResultType BeginQueryHelper();
 
   ResultType CommitQueryHelper();
@@ -350,6 +350,7 @@ enum class NetworkMessageType : unsigned char {
   READY_FOR_QUERY = 'Z',
   ROW_DESCRIPTION = 'T',
   DATA_ROW = 'D',
+  PORTAL_SUSPENDED = 's',
   // Errors
   HUMAN_READABLE_ERROR = 'M',
   SQLSTATE_CODE_ERROR = 'C',
@@ -381,7 +382,15 @@ enum SqlStateErrorCode {
 
 enum class ConcurrencyType {
   INVALID = INVALID_TYPE_ID,
-  TIMESTAMP_ORDERING = 1  // timestamp ordering
+  TIMESTAMP_ORDERING = 1,  // timestamp ordering
+  OPTIMISTIC = 2           // optimistic concurrency control
+};
+
+// Where the commit ids of the transactions come from
+enum class TimestampType {
+  INVALID = INVALID_TYPE_ID,
+  CENTRALIZED = 1,   // one global counter
+  EPOCH_BATCHED = 2  // per-worker ranges of the counter, renewed every epoch
 };
 
 //===--------------------------------------------------------------------===//
@@ -528,6 +537,7 @@ enum class PlanNodeType {
   SEND = 40,
   RECEIVE = 41,
   PRINT = 42,
+  EXCHANGE = 43,
 
   // Algebra Nodes
   AGGREGATE = 50,
@@ -1027,9 +1037,6 @@ enum RWType {
 
 enum GCSetType { GC_SET_TYPE_COMMITTED, GC_SET_TYPE_ABORTED };
 
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, RWType>>
-    ReadWriteSet;
-
 //===--------------------------------------------------------------------===//
 // File Handle
 //===--------------------------------------------------------------------===//
@@ -207,6 +207,12 @@ class LibeventSocket {
 
   WriteState WritePackets();
 
+  // Write out the buffered packets while a statement is still running. The
+  // thread is never blocked: if the socket cannot take them all,
+  // write_blocked is set and the rest is written once it is writable. Returns
+  // false if the socket can no longer be written to.
+  bool FlushPackets(bool &write_blocked);
+
   void PrintWriteBuffer();
 
   void CloseSocket();
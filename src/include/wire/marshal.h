@@ -21,6 +21,11 @@
 #define BUFFER_INIT_SIZE 100
 
 namespace peloton {
+
+namespace type {
+class Value;
+}
+
 namespace wire {
 
 class LibeventSocket;
@@ -145,6 +150,20 @@ extern void PacketPutCbytes(OutputPacket *pkt, const uchar *b, int len);
 /* packet_put_bytes - used to write a uchar vector into a packet */
 extern void PacketPutBytes(OutputPacket *pkt, const std::vector<uchar> &data);
 
+/*
+* packet_put_value - used to write a column of a DataRow into a packet: the
+*   length of the value followed by its text (format 0) or binary (format 1)
+*   representation, without materializing it as a string first
+*/
+extern void PacketPutValue(OutputPacket *pkt, const type::Value &value,
+                           int format);
+
+/*
+* has_binary_format - whether packet_put_value has a binary representation for
+*   a column of the given type, columns without one are sent as text
+*/
+extern bool HasBinaryFormat(PostgresValueType type);
+
 /*
 * Unmarshallers
 */
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <boost/assign/list_of.hpp>
+#include <functional>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -96,6 +97,20 @@ class PacketManager {
   // so that we don't have to new packet each time
   ResponseBuffer responses;
 
+  // Writes the buffered responses out to the client while a statement is
+  // still running, so that large results are not held in memory. Installed
+  // by the socket that owns this packet manager; never blocks, and sets
+  // write_blocked if the socket could not take all of the responses. Returns
+  // false if the client can no longer be written to.
+  std::function<bool(bool& write_blocked)> flush_responses;
+
+  // Is a statement waiting for the client to read the results it was sent?
+  inline bool IsExecutionBlocked() const { return blocked_portal_ != nullptr; }
+
+  // Resume the statement that was waiting for the client, once the socket
+  // can be written to again
+  void ResumeExecution();
+
  private:
   //===--------------------------------------------------------------------===//
   // PROTOCOL HANDLING FUNCTIONS
@@ -108,12 +123,16 @@ class PacketManager {
   // Sends ready for query packet to the frontend
   void SendReadyForQuery(NetworkTransactionStateType txn_status);
 
-  // Sends the attribute headers required by SELECT queries
-  void PutTupleDescriptor(const std::vector<FieldInfo>& tuple_descriptor);
+  // Sends the attribute headers required by SELECT queries, with the format
+  // codes the columns will be sent in (text if none are given)
+  void PutTupleDescriptor(
+      const std::vector<FieldInfo>& tuple_descriptor,
+      const std::vector<int>& result_format = std::vector<int>());
 
-  // Send each row, one packet at a time, used by SELECT queries
-  void SendDataRows(std::vector<StatementResult>& results, int colcount,
-                    int& rows_affected);
+  // Send each row, one packet at a time, used by SELECT queries. The values
+  // are serialized from the tiles into the packets in the requested format.
+  void SendDataRows(executor::LogicalTile& tile, const std::vector<oid_t>& rows,
+                    const std::vector<int>& result_format);
 
   // Used to send a packet that indicates the completion of a query. Also has
   // txn state mgmt
@@ -122,6 +141,41 @@ class PacketManager {
   // Specific response for empty or NULL queries
   void SendEmptyQueryResponse();
 
+  // Informs the client that the row limit of an Execute message was reached
+  void SendPortalSuspended();
+
+  // Run the statement of a portal, streaming each batch of result rows to the
+  // client as soon as it is produced. If the socket cannot take a batch, the
+  // portal is suspended with blocked set, rather than waiting for the client
+  // on the thread of the connection
+  ResultType ExecutePortal(Portal& portal, const std::vector<int>& result_format,
+                           const size_t max_rows, bool& suspended,
+                           bool& blocked, int& rows_affected,
+                           std::string& error_message);
+
+  // Keep the portal around until the client has read the rows already sent
+  void BlockExecution(std::shared_ptr<Portal> portal,
+                      const std::vector<int>& result_format,
+                      const size_t max_rows, const bool simple_query,
+                      const int rows_sent);
+
+  // Run the queries of the simple query message that are left. Stops early if
+  // one of them has to wait for the client
+  void ExecSimpleQueries();
+
+  // Send the response to a query of a simple query message once it has run.
+  // Returns false if the queries after it must not be run
+  bool FinishSimpleQuery(const std::string& query, ResultType status,
+                         int rows_affected, const std::string& error_message);
+
+  // Send the response to an Execute message once its portal has run
+  void FinishExecute(const std::string& query_type, ResultType status,
+                     bool suspended, int rows_affected,
+                     const std::string& error_message);
+
+  // Release the executor state of the portal, if it was suspended
+  void ClosePortal(std::shared_ptr<Portal>& portal);
+
   /* Helper function used to make hardcoded ParameterStatus('S')
    * packets during startup
    */
@@ -182,6 +236,18 @@ class PacketManager {
   //  Portals
   std::unordered_map<std::string, std::shared_ptr<Portal>> portals_;
 
+  // The queries of the simple query message being run, and the next one
+  std::vector<std::string> simple_queries_;
+  size_t next_simple_query_ = 0;
+
+  // The portal of the statement waiting for the client to read its results,
+  // and how to go on with it
+  std::shared_ptr<Portal> blocked_portal_;
+  std::vector<int> blocked_result_format_;
+  size_t blocked_max_rows_ = 0;
+  bool blocked_simple_query_ = false;
+  int blocked_rows_sent_ = 0;
+
   // packets ready for read
   size_t pkt_cntr_;
 
@@ -11,7 +11,11 @@
 //===----------------------------------------------------------------------===//
 #include "index/bwtree_index.h"
 
+#include <algorithm>
+
+#include "common/init.h"
 #include "common/logger.h"
+#include "common/thread_pool.h"
 #include "index/index_key.h"
 #include "index/scan_optimizer.h"
 #include "statistics/stats_aggregator.h"
@@ -20,6 +24,15 @@
 namespace peloton {
 namespace index {
 
+// Share of the capacity of the nodes that bulk loads fill
+static const double BULK_LOAD_FILL_FACTOR = 0.7;
+
+// Entries below which the sort of bulk loads is not split across threads
+static const size_t PARALLEL_SORT_MIN_ENTRIES = 16384;
+
+// Probes ahead of the current one whose key tuple batched lookups prefetch
+static const size_t BATCH_PREFETCH_DISTANCE = 8;
+
 BWTREE_TEMPLATE_ARGUMENTS
 BWTREE_INDEX_TYPE::BWTreeIndex(IndexMetadata *metadata)
     :  // Base class
@@ -115,6 +128,109 @@ bool BWTREE_INDEX_TYPE::CondInsertEntry(
   return ret;
 }
 
+/*
+ * InsertEntries() - Inserts the entries in the order of their keys
+ *
+ * Consecutive inserts then go to the same leaf, whose delta chain and
+ * separators are still in cache
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+size_t BWTREE_INDEX_TYPE::InsertEntries(
+    const std::vector<const storage::Tuple *> &keys,
+    const std::vector<ItemPointer *> &locations) {
+  std::vector<KeyValuePair> items;
+  SortEntries(keys, locations, items);
+
+  size_t insert_count = 0;
+  for (auto &item : items) {
+    if (container.Insert(item.first, item.second) == true) {
+      insert_count++;
+    }
+  }
+
+  return insert_count;
+}
+
+/*
+ * BulkLoad() - Builds the tree bottom up from the sorted entries
+ *
+ * The entries are inserted one at a time if the tree is not empty. Of the
+ * entries of a unique index, only one per key is kept.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+size_t BWTREE_INDEX_TYPE::BulkLoad(
+    const std::vector<const storage::Tuple *> &keys,
+    const std::vector<ItemPointer *> &locations) {
+  if (container.Begin().IsEnd() == false) {
+    return Index::BulkLoad(keys, locations);
+  }
+
+  std::vector<KeyValuePair> items;
+  SortEntries(keys, locations, items);
+
+  if (GetIndexType() == IndexConstraintType::PRIMARY_KEY ||
+      GetIndexType() == IndexConstraintType::UNIQUE) {
+    auto key_equal = [this](const KeyValuePair &lhs, const KeyValuePair &rhs) {
+      return equals(lhs.first, rhs.first);
+    };
+    items.erase(std::unique(items.begin(), items.end(), key_equal),
+                items.end());
+  }
+
+  return container.BulkLoad(items, BULK_LOAD_FILL_FACTOR);
+}
+
+/*
+ * SortEntries() - Converts the entries into key-value pairs sorted on keys
+ *
+ * Large sets of entries are split into one run per thread, each run being
+ * converted and sorted by its thread. The runs are then merged pairwise in
+ * parallel until a single one is left.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::SortEntries(
+    const std::vector<const storage::Tuple *> &keys,
+    const std::vector<ItemPointer *> &locations,
+    std::vector<KeyValuePair> &items) {
+  PL_ASSERT(keys.size() == locations.size());
+
+  size_t entry_count = keys.size();
+  size_t run_count = std::max<size_t>(
+      std::min(thread_pool.GetPoolSize() + 1,
+               entry_count / PARALLEL_SORT_MIN_ENTRIES),
+      1);
+  size_t run_size = (entry_count + run_count - 1) / run_count;
+
+  auto key_less = [this](const KeyValuePair &lhs, const KeyValuePair &rhs) {
+    return comparator(lhs.first, rhs.first);
+  };
+
+  items.resize(entry_count);
+  thread_pool.RunTasks(run_count, run_count, [&](size_t, size_t run) {
+    size_t begin = std::min(run * run_size, entry_count);
+    size_t end = std::min(begin + run_size, entry_count);
+    for (size_t i = begin; i < end; i++) {
+      items[i].first.SetFromKey(keys[i]);
+      items[i].second = locations[i];
+    }
+    std::sort(items.begin() + begin, items.begin() + end, key_less);
+  });
+
+  // Each pass merges the runs two by two, doubling their size
+  for (size_t merged_size = run_size; merged_size < entry_count;
+       merged_size *= 2) {
+    size_t merge_count =
+        (entry_count + 2 * merged_size - 1) / (2 * merged_size);
+    thread_pool.RunTasks(merge_count, merge_count, [&](size_t, size_t merge) {
+      size_t begin = merge * 2 * merged_size;
+      size_t middle = std::min(begin + merged_size, entry_count);
+      size_t end = std::min(middle + merged_size, entry_count);
+      std::inplace_merge(items.begin() + begin, items.begin() + middle,
+                         items.begin() + end, key_less);
+    });
+  }
+}
+
 /*
  * Scan() - Scans a range inside the index using index scan optimizer
  *
@@ -273,6 +389,169 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * ScanKeysBatch() - Looks up the keys in the order of their values
+ *
+ * Sorted probes that fall on the same leaf or under the same parent share
+ * the part of the descent above it. The probe tuples are prefetched ahead
+ * of their conversion, as they are usually scattered in memory.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::ScanKeysBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<std::vector<ValueType>> &results) {
+  size_t probe_count = keys.size();
+
+  std::vector<KeyType> index_keys(probe_count);
+  for (size_t i = 0; i < probe_count; i++) {
+    if (i + BATCH_PREFETCH_DISTANCE < probe_count) {
+      __builtin_prefetch(keys[i + BATCH_PREFETCH_DISTANCE]->GetData());
+    }
+    index_keys[i].SetFromKey(keys[i]);
+  }
+
+  std::vector<size_t> probe_order(probe_count);
+  for (size_t i = 0; i < probe_count; i++) {
+    probe_order[i] = i;
+  }
+  std::sort(probe_order.begin(), probe_order.end(),
+            [this, &index_keys](size_t lhs, size_t rhs) {
+              return comparator(index_keys[lhs], index_keys[rhs]);
+            });
+
+  std::vector<KeyType> sorted_keys;
+  sorted_keys.reserve(probe_count);
+  for (auto probe : probe_order) {
+    sorted_keys.push_back(index_keys[probe]);
+  }
+
+  std::vector<std::vector<ValueType>> sorted_results(probe_count);
+  container.GetValueBatch(sorted_keys.data(), probe_count,
+                          sorted_results.data());
+
+  results.clear();
+  results.resize(probe_count);
+
+  size_t result_count = 0;
+  for (size_t i = 0; i < probe_count; i++) {
+    result_count += sorted_results[i].size();
+    results[probe_order[i]] = std::move(sorted_results[i]);
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result_count, metadata);
+  }
+
+  return;
+}
+
+/*
+ * ScanCursor() - Opens a cursor over a scan
+ *
+ * Forward full and interval scans walk the leaves a batch at a time, the
+ * others are performed at once. Scans of covering indices always walk the
+ * leaves, so that their keys can be read: they are never point queries as
+ * the version hint is not constrained, and the backward scan of the tree
+ * returns its entries in forward order anyway
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+std::unique_ptr<IndexScanCursor> BWTREE_INDEX_TYPE::ScanCursor(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, const ConjunctionScanPredicate *csp_p) {
+  if (IsCovering() == false &&
+      (scan_direction != ScanDirectionType::FORWARD ||
+       csp_p->IsPointQuery() == true)) {
+    return Index::ScanCursor(value_list, tuple_column_id_list, expr_list,
+                             scan_direction, csp_p);
+  }
+
+  if (csp_p->IsFullIndexScan() == true) {
+    return ScanAllKeysCursor();
+  }
+
+  KeyType index_low_key;
+  KeyType index_high_key;
+  index_low_key.SetFromKey(csp_p->GetLowKey());
+  index_high_key.SetFromKey(csp_p->GetHighKey());
+
+  return std::unique_ptr<IndexScanCursor>(new ForwardScanCursor(
+      this, container.Begin(index_low_key), &index_high_key));
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+std::unique_ptr<IndexScanCursor> BWTREE_INDEX_TYPE::ScanAllKeysCursor() {
+  return std::unique_ptr<IndexScanCursor>(
+      new ForwardScanCursor(this, container.Begin(), nullptr));
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+BWTREE_INDEX_TYPE::ForwardScanCursor::ForwardScanCursor(
+    BWTreeIndex *index_p, const typename MapType::ForwardIterator &scan_itr,
+    const KeyType *high_key_p)
+    : index_p_(index_p),
+      scan_itr_(scan_itr),
+      has_high_key_(high_key_p != nullptr) {
+  if (has_high_key_ == true) {
+    high_key_ = *high_key_p;
+  }
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ForwardScanCursor::Next(
+    std::vector<ItemPointer *> &result, size_t max_count) {
+  return NextBatch(result, nullptr, max_count);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ForwardScanCursor::NextEntries(
+    std::vector<ItemPointer *> &result, std::vector<type::Value> &key_values,
+    size_t max_count) {
+  return NextBatch(result, &key_values, max_count);
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ForwardScanCursor::NextBatch(
+    std::vector<ItemPointer *> &result, std::vector<type::Value> *key_values_p,
+    size_t max_count) {
+  const catalog::Schema *key_schema = index_p_->GetKeySchema();
+  oid_t key_column_count = index_p_->GetColumnCount();
+
+  size_t count = 0;
+  for (; count < max_count && scan_itr_.IsEnd() == false; scan_itr_++) {
+    if (has_high_key_ == true &&
+        index_p_->container.KeyCmpLessEqual(scan_itr_->first, high_key_) ==
+            false) {
+      // Nothing is left below the high key
+      has_high_key_ = false;
+      scan_itr_ = typename MapType::ForwardIterator();
+      break;
+    }
+
+    result.push_back(scan_itr_->second);
+    count++;
+
+    if (key_values_p != nullptr) {
+      // The iterator holds a copy of the leaf, the values are copied out of
+      // it before it moves on
+      KeyType index_key = scan_itr_->first;
+      auto key_tuple = index_key.GetTupleForComparison(key_schema);
+      for (oid_t column_id = 0; column_id < key_column_count; column_id++) {
+        key_values_p->push_back(key_tuple.GetValue(column_id).Copy());
+      }
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        count, index_p_->metadata);
+  }
+
+  return count != 0;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
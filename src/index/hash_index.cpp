@@ -0,0 +1,282 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.cpp
+//
+// Identification: src/index/hash_index.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/hash_index.h"
+
+#include "common/logger.h"
+#include "index/index_key.h"
+#include "index/scan_optimizer.h"
+#include "statistics/stats_aggregator.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+// Values are compared on the location they point to, as in the BwTree
+static inline bool ValueEquals(ItemPointer *const &lhs,
+                               ItemPointer *const &rhs) {
+  return (lhs->block == rhs->block) && (lhs->offset == rhs->offset);
+}
+
+HASH_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::HashIndex(IndexMetadata *metadata)
+    :  // Base class
+      Index{metadata},
+      container{} {
+  return;
+}
+
+HASH_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::~HashIndex() {}
+
+/*
+ * InsertEntry() - insert a key-value pair into the map
+ *
+ * If the key value pair already exists in the map, just return false
+ */
+HASH_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = true;
+
+  // The list of the key is updated under the lock of its buckets, it is
+  // created with the value if the key is not there
+  container.upsert(index_key,
+                   [&ret, value](ValueListType &values) {
+                     for (auto existing_value : values) {
+                       if (ValueEquals(existing_value, value) == true) {
+                         ret = false;
+                         return;
+                       }
+                     }
+                     values.push_back(value);
+                   },
+                   ValueListType(1, value));
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * DeleteEntry() - Removes a key-value pair
+ *
+ * If the key-value pair does not exists yet in the map return false
+ */
+HASH_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+  size_t delete_count = 0;
+
+  // The key is dropped together with its last value, under the same lock
+  container.erase_fn(index_key, [&delete_count, value](ValueListType &values) {
+    for (auto itr = values.begin(); itr != values.end(); itr++) {
+      if (ValueEquals(*itr, value) == true) {
+        values.erase(itr);
+        delete_count = 1;
+        break;
+      }
+    }
+    return values.empty();
+  });
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        delete_count, metadata);
+  }
+  return (delete_count != 0);
+}
+
+/*
+ * CondInsertEntry() - Inserts the value if no value of the key satisfies
+ *                     the predicate
+ *
+ * The check and the insert both happen under the lock of the buckets of
+ * the key, so they are atomic
+ */
+HASH_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::CondInsertEntry(
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  // The updater is not run if the key is inserted with the value
+  bool ret = true;
+
+  container.upsert(index_key,
+                   [&ret, value, &predicate](ValueListType &values) {
+                     for (auto existing_value : values) {
+                       if (predicate(existing_value) == true ||
+                           ValueEquals(existing_value, value) == true) {
+                         ret = false;
+                         return;
+                       }
+                     }
+                     values.push_back(value);
+                   },
+                   ValueListType(1, value));
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * Scan() - Scans the index using index scan optimizer
+ *
+ * A point query looks up its key. Any other scan goes through the whole
+ * table: the executor only checks the open ends of the ranges it gets from
+ * ordered indexes, so the keys are filtered here with the full predicate.
+ */
+HASH_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::Scan(const std::vector<type::Value> &value_list,
+                           const std::vector<oid_t> &tuple_column_id_list,
+                           const std::vector<ExpressionType> &expr_list,
+                           ScanDirectionType scan_direction,
+                           std::vector<ValueType> &result,
+                           const ConjunctionScanPredicate *csp_p) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  LOG_TRACE("Scan() Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  if (csp_p->IsPointQuery() == true) {
+    KeyType point_query_key;
+    point_query_key.SetFromKey(csp_p->GetPointQueryKey());
+
+    container.update_fn(point_query_key, [&result](ValueListType &values) {
+      result.insert(result.end(), values.begin(), values.end());
+    });
+  } else if (csp_p->IsFullIndexScan() == true) {
+    auto locked_table = container.lock_table();
+    for (auto &entry : locked_table) {
+      result.insert(result.end(), entry.second.begin(), entry.second.end());
+    }
+  } else {
+    const catalog::Schema *key_schema = GetKeySchema();
+
+    auto locked_table = container.lock_table();
+    for (auto &entry : locked_table) {
+      if (entry.second.empty() == true) {
+        continue;
+      }
+
+      KeyType index_key = entry.first;
+      auto key_tuple = index_key.GetTupleForComparison(key_schema);
+      if (Compare(key_tuple, tuple_column_id_list, expr_list, value_list) ==
+          true) {
+        result.insert(result.end(), entry.second.begin(), entry.second.end());
+      }
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+/*
+ * ScanLimit() - Scan the index with predicate and limit/offset
+ *
+ * The keys have no order for the limit to take the first of, so the whole
+ * scan is returned and the limit is left to the executor
+ */
+HASH_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanLimit(const std::vector<type::Value> &value_list,
+                                const std::vector<oid_t> &tuple_column_id_list,
+                                const std::vector<ExpressionType> &expr_list,
+                                ScanDirectionType scan_direction,
+                                std::vector<ValueType> &result,
+                                const ConjunctionScanPredicate *csp_p,
+                                UNUSED_ATTRIBUTE uint64_t limit,
+                                UNUSED_ATTRIBUTE uint64_t offset) {
+  Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
+       csp_p);
+}
+
+HASH_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
+  {
+    auto locked_table = container.lock_table();
+    for (auto &entry : locked_table) {
+      result.insert(result.end(), entry.second.begin(), entry.second.end());
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+  return;
+}
+
+HASH_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanKey(const storage::Tuple *key,
+                              std::vector<ValueType> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  container.update_fn(index_key, [&result](ValueListType &values) {
+    result.insert(result.end(), values.begin(), values.end());
+  });
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+HASH_TEMPLATE_ARGUMENTS
+std::string HASH_INDEX_TYPE::GetTypeName() const { return "Hash"; }
+
+// IMPORTANT: Make sure you don't exceed CompactIntegerKey_MAX_SLOTS
+
+template class HashIndex<CompactIntsKey<1>, ItemPointer *,
+                         CompactIntsHasher<1>, CompactIntsEqualityChecker<1>>;
+template class HashIndex<CompactIntsKey<2>, ItemPointer *,
+                         CompactIntsHasher<2>, CompactIntsEqualityChecker<2>>;
+template class HashIndex<CompactIntsKey<3>, ItemPointer *,
+                         CompactIntsHasher<3>, CompactIntsEqualityChecker<3>>;
+template class HashIndex<CompactIntsKey<4>, ItemPointer *,
+                         CompactIntsHasher<4>, CompactIntsEqualityChecker<4>>;
+
+// Generic key
+template class HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                         GenericEqualityChecker<4>>;
+template class HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                         GenericEqualityChecker<8>>;
+template class HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                         GenericEqualityChecker<16>>;
+template class HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                         GenericEqualityChecker<64>>;
+template class HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                         GenericEqualityChecker<256>>;
+
+}  // End index namespace
+}  // End peloton namespace
@@ -16,6 +16,7 @@
 #include "common/logger.h"
 #include "storage/tuple.h"
 #include "type/ephemeral_pool.h"
+#include "type/value_factory.h"
 
 #include "index/scan_optimizer.h"
 
@@ -27,6 +28,10 @@ namespace index {
 
 bool IndexMetadata::index_default_visibility = true;
 
+// Name of the version hint column of covering indices, which no table column
+// may have
+static const std::string VERSION_HINT_COLUMN_NAME = "$version";
+
 /*
  * GetColumnCount() - Returns the number of indexed columns
  *
@@ -53,7 +58,7 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
                              const catalog::Schema *tuple_schema,
                              const catalog::Schema *key_schema,
                              const std::vector<oid_t> &key_attrs,
-                             bool unique_keys)
+                             bool unique_keys, oid_t included_column_count)
     : name_(index_name),
       index_oid(index_oid),
       table_oid(table_oid),
@@ -65,6 +70,7 @@ IndexMetadata::IndexMetadata(std::string index_name, oid_t index_oid,
       key_attrs(key_attrs),
       tuple_attrs(),
       unique_keys(unique_keys),
+      included_column_count(included_column_count),
       visible_(IndexMetadata::index_default_visibility) {
   // Push the reverse mapping relation into tuple_attrs which maps
   // tuple key's column into index key's column
@@ -103,6 +109,35 @@ IndexMetadata::~IndexMetadata() {
   return;
 }
 
+/*
+ * GetCoveringKeySchema() - Builds the key schema of a covering index
+ *
+ * The included columns follow the key columns, so that the entries are
+ * ordered on the key columns first, and the version hint comes last. The
+ * indexed columns of the schema map the key and included columns to the
+ * table, the hint having no table column
+ */
+catalog::Schema *IndexMetadata::GetCoveringKeySchema(
+    const catalog::Schema *tuple_schema, const std::vector<oid_t> &key_attrs,
+    const std::vector<oid_t> &included_attrs) {
+  std::vector<oid_t> indexed_columns(key_attrs);
+  indexed_columns.insert(indexed_columns.end(), included_attrs.begin(),
+                         included_attrs.end());
+
+  std::vector<catalog::Column> columns;
+  for (auto column_id : indexed_columns) {
+    columns.push_back(tuple_schema->GetColumn(column_id));
+  }
+  columns.push_back(catalog::Column(
+      type::Type::BIGINT, type::Type::GetTypeSize(type::Type::BIGINT),
+      VERSION_HINT_COLUMN_NAME, true));
+
+  auto key_schema = new catalog::Schema(columns);
+  key_schema->SetIndexedColumns(indexed_columns);
+
+  return key_schema;
+}
+
 const std::string IndexMetadata::GetInfo() const {
   std::stringstream os;
 
@@ -113,6 +148,7 @@ const std::string IndexMetadata::GetInfo() const {
      << "ConstraintType=" << IndexConstraintTypeToString(index_constraint_type_)
      << ", "
      << "UtilityRatio=" << utility_ratio << ", "
+     << "IncludedColumns=" << included_column_count << ", "
      << "Visible=" << visible_ << "]";
 
   os << " -> " << key_schema->GetInfo();
@@ -185,6 +221,71 @@ oid_t Index::TupleColumnToKeyColumn(oid_t tuple_column_id) const {
   return key_column_id;
 }
 
+/*
+ * SetVersionHint() - Sets the last column of the key of a covering index to
+ *                    the location of a version
+ *
+ * The location is packed into a BIGINT, the tile group id in the high half
+ */
+void Index::SetVersionHint(storage::Tuple *key,
+                           const ItemPointer &location) const {
+  if (IsCovering() == false) {
+    return;
+  }
+
+  int64_t hint = (static_cast<int64_t>(location.block) << 32) |
+                 static_cast<int64_t>(location.offset);
+  key->SetValue(GetColumnCount() - 1,
+                type::ValueFactory::GetBigIntValue(hint), nullptr);
+}
+
+ItemPointer Index::GetVersionHint(const type::Value &hint) {
+  auto packed_location = static_cast<uint64_t>(hint.GetAs<int64_t>());
+  return ItemPointer(static_cast<oid_t>(packed_location >> 32),
+                     static_cast<oid_t>(packed_location & 0xFFFFFFFF));
+}
+
+size_t Index::InsertEntries(const std::vector<const storage::Tuple *> &keys,
+                            const std::vector<ItemPointer *> &locations) {
+  PL_ASSERT(keys.size() == locations.size());
+
+  size_t insert_count = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (InsertEntry(keys[i], locations[i]) == true) {
+      insert_count++;
+    }
+  }
+
+  return insert_count;
+}
+
+size_t Index::BulkLoad(const std::vector<const storage::Tuple *> &keys,
+                       const std::vector<ItemPointer *> &locations) {
+  if (GetIndexType() != IndexConstraintType::PRIMARY_KEY &&
+      GetIndexType() != IndexConstraintType::UNIQUE) {
+    return InsertEntries(keys, locations);
+  }
+
+  // Only the first entry of each key goes in
+  auto any_value = [](const void *) { return true; };
+  size_t insert_count = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (CondInsertEntry(keys[i], locations[i], any_value) == true) {
+      insert_count++;
+    }
+  }
+  return insert_count;
+}
+
+void Index::ScanKeysBatch(const std::vector<const storage::Tuple *> &keys,
+                          std::vector<std::vector<ItemPointer *>> &results) {
+  results.clear();
+  results.resize(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    ScanKey(keys[i], results[i]);
+  }
+}
+
 /*
  * ScanTest() - This is used inside the unit test to check correctness of
  *              scan optimizer - do not change or remove this
@@ -205,6 +306,48 @@ void Index::ScanTest(const std::vector<type::Value> &value_list,
   return;
 }
 
+std::unique_ptr<IndexScanCursor> Index::ScanCursor(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, const ConjunctionScanPredicate *csp_p) {
+  std::vector<ItemPointer *> values;
+  Scan(value_list, tuple_column_id_list, expr_list, scan_direction, values,
+       csp_p);
+
+  return std::unique_ptr<IndexScanCursor>(
+      new MaterializedScanCursor(std::move(values)));
+}
+
+std::unique_ptr<IndexScanCursor> Index::ScanAllKeysCursor() {
+  std::vector<ItemPointer *> values;
+  ScanAllKeys(values);
+
+  return std::unique_ptr<IndexScanCursor>(
+      new MaterializedScanCursor(std::move(values)));
+}
+
+bool IndexScanCursor::NextEntries(
+    UNUSED_ATTRIBUTE std::vector<ItemPointer *> &result,
+    UNUSED_ATTRIBUTE std::vector<type::Value> &key_values,
+    UNUSED_ATTRIBUTE size_t max_count) {
+  throw IndexException("The scan cursor does not hand out the index keys");
+}
+
+bool MaterializedScanCursor::Next(std::vector<ItemPointer *> &result,
+                                  size_t max_count) {
+  if (position_ == values_.size()) {
+    return false;
+  }
+
+  size_t count = std::min(max_count, values_.size() - position_);
+  result.insert(result.end(), values_.begin() + position_,
+                values_.begin() + position_ + count);
+  position_ += count;
+
+  return true;
+}
+
 /*
  * Compare() - Check whether a given index key satisfies a predicate
  *
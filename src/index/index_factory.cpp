@@ -15,6 +15,7 @@
 #include "common/logger.h"
 #include "common/macros.h"
 #include "index/bwtree_index.h"
+#include "index/hash_index.h"
 #include "index/index_factory.h"
 #include "index/index_key.h"
 #include "type/types.h"
@@ -64,6 +65,16 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
       index = IndexFactory::GetBwTreeGenericKeyIndex(metadata);
     }
 
+    // -----------------------
+    // HASH
+    // -----------------------
+  } else if (index_type == IndexType::HASH) {
+    if (ints_only) {
+      index = IndexFactory::GetHashIntsKeyIndex(metadata);
+    } else {
+      index = IndexFactory::GetHashGenericKeyIndex(metadata);
+    }
+
     // -----------------------
     // ERROR
     // -----------------------
@@ -196,6 +207,110 @@ Index *IndexFactory::GetBwTreeGenericKeyIndex(IndexMetadata *metadata) {
   return (index);
 }
 
+Index *IndexFactory::GetHashIntsKeyIndex(IndexMetadata *metadata) {
+  // Our new Index!
+  Index *index = nullptr;
+
+  // The size of the key in bytes
+  const auto key_size = metadata->key_schema->GetLength();
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= sizeof(uint64_t)) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<1>";
+#endif
+    index = new HashIndex<CompactIntsKey<1>, ItemPointer *,
+                          CompactIntsHasher<1>, CompactIntsEqualityChecker<1>>(
+        metadata);
+  } else if (key_size <= sizeof(uint64_t) * 2) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<2>";
+#endif
+    index = new HashIndex<CompactIntsKey<2>, ItemPointer *,
+                          CompactIntsHasher<2>, CompactIntsEqualityChecker<2>>(
+        metadata);
+  } else if (key_size <= sizeof(uint64_t) * 3) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<3>";
+#endif
+    index = new HashIndex<CompactIntsKey<3>, ItemPointer *,
+                          CompactIntsHasher<3>, CompactIntsEqualityChecker<3>>(
+        metadata);
+  } else if (key_size <= sizeof(uint64_t) * 4) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "CompactIntsKey<4>";
+#endif
+    index = new HashIndex<CompactIntsKey<4>, ItemPointer *,
+                          CompactIntsHasher<4>, CompactIntsEqualityChecker<4>>(
+        metadata);
+  } else {
+    throw IndexException("Unsupported IntsKey scheme");
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+  return (index);
+}
+
+Index *IndexFactory::GetHashGenericKeyIndex(IndexMetadata *metadata) {
+  // Our new Index!
+  Index *index = nullptr;
+
+  // The size of the key in bytes
+  const auto key_size = metadata->key_schema->GetLength();
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= 4) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<4>";
+#endif
+    index = new HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                          GenericEqualityChecker<4>>(metadata);
+  } else if (key_size <= 8) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<8>";
+#endif
+    index = new HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                          GenericEqualityChecker<8>>(metadata);
+  } else if (key_size <= 16) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<16>";
+#endif
+    index = new HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                          GenericEqualityChecker<16>>(metadata);
+  } else if (key_size <= 64) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<64>";
+#endif
+    index = new HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                          GenericEqualityChecker<64>>(metadata);
+  } else if (key_size <= 256) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "GenericKey<256>";
+#endif
+    index = new HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                          GenericEqualityChecker<256>>(metadata);
+  } else {
+    // The tuple key points to the tuple it is built from, which the table
+    // does not keep
+    throw IndexException("Unsupported hash index key size");
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+  return (index);
+}
+
 std::string IndexFactory::GetInfo(IndexMetadata *metadata,
                                   std::string comparatorType) {
   std::ostringstream os;
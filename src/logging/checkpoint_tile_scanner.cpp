@@ -34,11 +34,18 @@ std::unique_ptr<executor::LogicalTile> CheckpointTileScanner::Scan(
   // Construct position list by looping through tile group
   // and applying the predicate.
   std::vector<oid_t> position_list;
-  for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-    // check transaction visibility
-    if (IsVisible(tile_group_header, tuple_id, start_cid)) {
+  if (tile_group_header->IsAllVisible(start_cid)) {
+    // every version in the tile group committed before the checkpoint began
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
       position_list.push_back(tuple_id);
     }
+  } else {
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      // check transaction visibility
+      if (IsVisible(tile_group_header, tuple_id, start_cid)) {
+        position_list.push_back(tuple_id);
+      }
+    }
   }
 
   // Construct logical tile.
@@ -383,7 +383,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
 void WriteAheadFrontendLogger::RecoverIndex() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   LOG_TRACE("Recovering the indexes");
-  cid_t cid = txn_manager.GetNextCommitId();
+  cid_t cid = txn_manager.GetNextGlobalCommitId();
   LOG_TRACE("Index Recovery got Next commit id as %d", (int)cid);
 
   auto catalog = catalog::Catalog::GetInstance();
@@ -476,6 +476,9 @@ void WriteAheadFrontendLogger::InsertIndexEntry(storage::Tuple *tuple,
 
   for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
     auto index = table->GetIndex(index_itr);
+    if (index == nullptr) {
+      continue;
+    }
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
     std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
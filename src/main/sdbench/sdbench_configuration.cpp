@@ -25,6 +25,7 @@ void Usage() {
       "\n"
       "Command line options : sdbench <options>\n"
       "   -a --attribute_count                :  # of attributes\n"
+      "   -A --header_layout                  :  Tile group header layout\n"
       "   -b --convergence_query_threshold    :  # of queries for convergence\n"
       "   -c --query_complexity_type          :  Complexity of query\n"
       "   -d --variability_threshold          :  Variability threshold\n"
@@ -56,6 +57,7 @@ void Usage() {
 
 static struct option opts[] = {
     {"attribute_count", optional_argument, NULL, 'a'},
+    {"header_layout", optional_argument, NULL, 'A'},
     {"convergence_query_threshold", optional_argument, NULL, 'b'},
     {"query_complexity_type", optional_argument, NULL, 'c'},
     {"variability_threshold", optional_argument, NULL, 'd'},
@@ -193,6 +195,20 @@ static void ValidateLayout(const configuration &state) {
   }
 }
 
+static void ValidateHeaderLayout(const configuration &state) {
+  switch (state.header_layout_mode) {
+    case LAYOUT_TYPE_ROW:
+      LOG_INFO("%s : ROW", "header_layout ");
+      break;
+    case LAYOUT_TYPE_COLUMN:
+      LOG_INFO("%s : COLUMN", "header_layout ");
+      break;
+    default:
+      LOG_ERROR("Invalid header_layout :: %d", state.header_layout_mode);
+      exit(EXIT_FAILURE);
+  }
+}
+
 static void ValidateProjectivity(const configuration &state) {
   if (state.projectivity < 0 || state.projectivity > 1) {
     LOG_ERROR("Invalid projectivity :: %.1lf", state.projectivity);
@@ -398,6 +414,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
 
   // Layout parameter
   state.layout_mode = LAYOUT_TYPE_ROW;
+  state.header_layout_mode = LAYOUT_TYPE_ROW;
 
   // Learning rate
   state.analyze_sample_count_threshold = 100;
@@ -424,16 +441,19 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   while (1) {
     int idx = 0;
     int c = getopt_long(argc, argv,
-                        "a:b:c:d:e:f:g:hi:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:",
+                        "a:A:b:c:d:e:f:g:hi:j:k:l:m:n:o:p:q:r:s:t:u:v:w:x:y:z:",
                         opts, &idx);
 
     if (c == -1) break;
 
     switch (c) {
-      // AVAILABLE FLAGS: rABCDEFGHIJKLMNOPQRSTUVWXYZ
+      // AVAILABLE FLAGS: BCDEFGHIJKLMNOPQRSTUVWXYZ
       case 'a':
         state.attribute_count = atoi(optarg);
         break;
+      case 'A':
+        state.header_layout_mode = (LayoutType)atoi(optarg);
+        break;
       case 'b':
         state.convergence_op_threshold = atoi(optarg);
         break;
@@ -546,6 +566,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateSelectivity(state);
   ValidateProjectivity(state);
   ValidateLayout(state);
+  ValidateHeaderLayout(state);
   ValidateIndexCountThreshold(state);
   ValidateIndexUtilityThreshold(state);
   ValidateWriteRatioThreshold(state);
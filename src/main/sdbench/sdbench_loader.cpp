@@ -37,6 +37,7 @@
 #include "storage/table_factory.h"
 #include "storage/tile.h"
 #include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 #include "type/ephemeral_pool.h"
 
 namespace peloton {
@@ -119,6 +120,7 @@ void LoadTable() {
 void CreateAndLoadTable(LayoutType layout_type) {
   // Initialize settings
   peloton_layout_mode = layout_type;
+  peloton_header_layout_mode = state.header_layout_mode;
 
   CreateTable();
 
@@ -20,6 +20,7 @@
 #include "benchmark/tpcc/tpcc_loader.h"
 #include "benchmark/tpcc/tpcc_workload.h"
 
+#include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 
 namespace peloton {
@@ -36,7 +37,9 @@ void RunBenchmark() {
   }
   
   gc::GCManagerFactory::GetInstance().StartGC();
-  
+
+  concurrency::TransactionManagerFactory::Configure(state.protocol);
+
   // Create the database
   CreateTPCCDatabase();
 
@@ -36,6 +36,7 @@ void Usage(FILE *out) {
           "   -a --affinity          :  enable client affinity \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -r --protocol          :  concurrency control: to (default) or occ \n"
   );
 }
 
@@ -50,6 +51,7 @@ static struct option opts[] = {
     { "affinity", no_argument, NULL, 'a' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "protocol", optional_argument, NULL, 'r' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -127,11 +129,12 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.affinity = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:", opts, &idx);
+    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:r:", opts, &idx);
 
     if (c == -1) break;
 
@@ -171,8 +174,20 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         state.gc_mode = true;
         break;
       case 'n':
-        state.gc_backend_count = atof(optarg);
+        state.gc_backend_count = atoi(optarg);
         break;
+      case 'r': {
+        char *protocol = optarg;
+        if (strcmp(protocol, "to") == 0) {
+          state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
+        } else if (strcmp(protocol, "occ") == 0) {
+          state.protocol = ConcurrencyType::OPTIMISTIC;
+        } else {
+          LOG_ERROR("Unknown protocol: %s", protocol);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
 
       case 'h':
         Usage(stderr);
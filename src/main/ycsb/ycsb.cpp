@@ -19,7 +19,9 @@
 #include "benchmark/ycsb/ycsb_loader.h"
 #include "benchmark/ycsb/ycsb_workload.h"
 
+#include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
+#include "storage/tile_group_header.h"
 
 namespace peloton {
 namespace benchmark {
@@ -35,6 +37,11 @@ void RunBenchmark() {
   
   gc::GCManagerFactory::GetInstance().StartGC();
 
+  concurrency::TransactionManagerFactory::Configure(
+      state.protocol, IsolationLevelType::FULL, state.timestamp_type);
+
+  peloton_header_layout_mode = state.header_layout;
+
   // Create the database
   CreateYCSBDatabase();
 
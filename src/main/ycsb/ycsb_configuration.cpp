@@ -40,6 +40,9 @@ void Usage(FILE *out) {
           "   -m --string_mode       :  store strings \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -l --header_layout     :  header layout: 1 (row) or 2 (column) \n"
+          "   -t --timestamp_type    :  commit ids: 1 (centralized) or 2 (epoch batched) \n"
+          "   -r --protocol          :  concurrency control: to (default) or occ \n"
   );
 }
 
@@ -57,6 +60,9 @@ static struct option opts[] = {
     { "string_mode", no_argument, NULL, 'm' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "header_layout", optional_argument, NULL, 'l' },
+    { "timestamp_type", optional_argument, NULL, 't' },
+    { "protocol", optional_argument, NULL, 'r' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -148,6 +154,26 @@ void ValidateGCBackendCount(const configuration &state) {
   LOG_TRACE("%s : %d", "gc_backend_count", state.gc_backend_count);
 }
 
+void ValidateHeaderLayout(const configuration &state) {
+  if (state.header_layout != LAYOUT_TYPE_ROW &&
+      state.header_layout != LAYOUT_TYPE_COLUMN) {
+    LOG_ERROR("Invalid header_layout :: %d", state.header_layout);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_TRACE("%s : %d", "header_layout", state.header_layout);
+}
+
+void ValidateTimestampType(const configuration &state) {
+  if (state.timestamp_type != TimestampType::CENTRALIZED &&
+      state.timestamp_type != TimestampType::EPOCH_BATCHED) {
+    LOG_ERROR("Invalid timestamp_type :: %d", (int)state.timestamp_type);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_TRACE("%s : %d", "timestamp_type", (int)state.timestamp_type);
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = IndexType::BWTREE;
@@ -163,11 +189,14 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.string_mode = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.header_layout = LAYOUT_TYPE_ROW;
+  state.timestamp_type = TimestampType::CENTRALIZED;
+  state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:", opts, &idx);
+    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:l:t:r:", opts, &idx);
 
     if (c == -1) break;
 
@@ -216,8 +245,26 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         state.gc_mode = true;
         break;
       case 'n':
-        state.gc_backend_count = atof(optarg);
+        state.gc_backend_count = atoi(optarg);
+        break;
+      case 'l':
+        state.header_layout = (LayoutType)atoi(optarg);
+        break;
+      case 't':
+        state.timestamp_type = (TimestampType)atoi(optarg);
+        break;
+      case 'r': {
+        char *protocol = optarg;
+        if (strcmp(protocol, "to") == 0) {
+          state.protocol = ConcurrencyType::TIMESTAMP_ORDERING;
+        } else if (strcmp(protocol, "occ") == 0) {
+          state.protocol = ConcurrencyType::OPTIMISTIC;
+        } else {
+          LOG_ERROR("Unknown protocol: %s", protocol);
+          exit(EXIT_FAILURE);
+        }
         break;
+      }
         
       case 'h':
         Usage(stderr);
@@ -243,6 +290,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateUpdateRatio(state);
   ValidateZipfTheta(state);
   ValidateGCBackendCount(state);
+  ValidateHeaderLayout(state);
+  ValidateTimestampType(state);
 
   LOG_TRACE("%s : %d", "Run exponential backoff", state.exp_backoff);
   LOG_TRACE("%s : %d", "Run string mode", state.string_mode);
@@ -16,6 +16,7 @@
 
 #include "catalog/catalog.h"
 #include "catalog/schema.h"
+#include "configuration/configuration.h"
 #include "expression/aggregate_expression.h"
 #include "expression/expression_util.h"
 #include "expression/function_expression.h"
@@ -28,6 +29,7 @@
 #include "planner/create_plan.h"
 #include "planner/delete_plan.h"
 #include "planner/drop_plan.h"
+#include "planner/exchange_plan.h"
 #include "planner/hash_join_plan.h"
 #include "planner/hash_plan.h"
 #include "planner/index_scan_plan.h"
@@ -43,6 +45,7 @@
 #include "common/logger.h"
 #include "type/value_factory.h"
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 
@@ -178,8 +181,9 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
       if (!agg_flag && group_by_columns.size() == 0) {
         LOG_TRACE("No aggregate functions found.");
         std::unique_ptr<planner::AbstractPlan> child_SelectPlan =
-            CreateScanPlan(target_table, column_ids, predicate,
-                           select_stmt->is_for_update);
+            CreateParallelScanPlan(CreateScanPlan(target_table, column_ids,
+                                                  predicate,
+                                                  select_stmt->is_for_update));
 
         // if we have expressions which are not just columns, we need to add a
         // projection plan node
@@ -605,7 +609,7 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
                 std::move(agg_terms), std::move(group_by_columns),
                 output_table_schema, agg_type));
 
-        child_agg_plan->AddChild(std::move(scan_node));
+        child_agg_plan->AddChild(CreateParallelScanPlan(std::move(scan_node)));
         child_plan = std::move(child_agg_plan);
       }
 
@@ -945,11 +949,73 @@ std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
   // Create plan node.
   std::unique_ptr<planner::IndexScanPlan> node(new planner::IndexScanPlan(
       target_table, predicate, column_ids, index_scan_desc, for_update));
+
+  // The table is not read at all if a covering index holds every column the
+  // select and the rest of the predicate read. The writers need the versions.
+  if (for_update == false && index->IsCovering() == true &&
+      column_ids.empty() == false) {
+    std::set<oid_t> read_column_ids(column_ids.begin(), column_ids.end());
+    if (predicate != nullptr) {
+      GetTupleValueColumns(target_table->GetSchema(), predicate,
+                           read_column_ids);
+    }
+
+    auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+    bool index_only = true;
+    for (auto column_id : read_column_ids) {
+      if (std::find(key_attrs.begin(), key_attrs.end(), column_id) ==
+          key_attrs.end()) {
+        index_only = false;
+        break;
+      }
+    }
+    node->SetIndexOnly(index_only);
+  }
   LOG_TRACE("Index scan plan created");
 
   return std::move(node);
 }
 
+/**
+ * Collects the columns of the tuple value expressions of an expression. A
+ * column whose name is not in the schema is collected as INVALID_OID.
+ */
+void SimpleOptimizer::GetTupleValueColumns(
+    const catalog::Schema* schema,
+    const expression::AbstractExpression* expression,
+    std::set<oid_t>& column_ids) {
+  if (expression->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    auto tuple_expr =
+        static_cast<const expression::TupleValueExpression*>(expression);
+    column_ids.insert(schema->GetColumnID(tuple_expr->GetColumnName()));
+    return;
+  }
+
+  for (size_t child_itr = 0; child_itr < expression->GetChildrenSize();
+       child_itr++) {
+    GetTupleValueColumns(schema, expression->GetChild(child_itr), column_ids);
+  }
+}
+
+/**
+ * Runs a sequential scan on several threads by putting an exchange on top of
+ * it. Scans for update are run by the query thread alone.
+ */
+std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateParallelScanPlan(
+    std::unique_ptr<planner::AbstractScan> scan_plan) {
+  if (FLAGS_parallel_scan_threads <= 1 ||
+      scan_plan->GetPlanNodeType() != PlanNodeType::SEQSCAN ||
+      scan_plan->IsForUpdate()) {
+    return std::move(scan_plan);
+  }
+
+  LOG_TRACE("Creating an exchange plan");
+  std::unique_ptr<planner::AbstractPlan> exchange_plan(
+      new planner::ExchangePlan(FLAGS_parallel_scan_threads));
+  exchange_plan->AddChild(std::move(scan_plan));
+  return exchange_plan;
+}
+
 /**
  * This function replaces all COLUMN_REF expressions with TupleValue
  * expressions
@@ -1293,6 +1359,18 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateJoinPlan(
     right_key_col_name = static_cast<expression::TupleValueExpression*>(
                              join_condition->GetModifiableChild(1))
                              ->GetColumnName();
+  // The left key is the other side of the condition
+  auto left_key_col_name = static_cast<expression::TupleValueExpression*>(
+                               join_condition->GetModifiableChild(0))
+                               ->GetColumnName();
+  if (left_key_col_name == right_key_col_name)
+    left_key_col_name = static_cast<expression::TupleValueExpression*>(
+                            join_condition->GetModifiableChild(1))
+                            ->GetColumnName();
+  std::vector<oid_t> left_hash_ids;
+  auto left_key_col_id = left_schema->GetColumnID(left_key_col_name);
+  if (left_key_col_id != (oid_t)-1) left_hash_ids.push_back(left_key_col_id);
+
   // Generate hash for right table
   auto right_key = expression::ExpressionUtil::ConvertToTupleValueExpression(
       right_schema, right_key_col_name);
@@ -1389,7 +1467,9 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateJoinPlan(
         select_stmt->where_clause->Copy());
   std::unique_ptr<planner::HashJoinPlan> hash_join_plan_node(
       new planner::HashJoinPlan(join_type, std::move(predicates),
-                                std::move(proj_info), schema));
+                                std::move(proj_info), schema, left_hash_ids));
+  hash_join_plan_node->SetBloomFilterPushdown(
+      UseBloomFilterPushdown(join_type, left_table, right_table));
   // index only works on comparison with a constant
 
   hash_join_plan_node->AddChild(std::move(left_SelectPlan));
@@ -1397,6 +1477,28 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateJoinPlan(
   return std::move(hash_join_plan_node);
 }
 
+/**
+ * The filter pays off when the build side is much smaller than the probe
+ * side, as in a join of a fact table with a dimension table: many probe tuples
+ * are then expected not to join, and skipping them before they are read and
+ * materialized saves more than probing the filter costs. It can only be used
+ * when the unmatched probe tuples are not part of the output.
+ */
+bool SimpleOptimizer::UseBloomFilterPushdown(
+    JoinType join_type, const storage::DataTable* probe_table,
+    const storage::DataTable* build_table) {
+  // The probe side must have at least this many times the tuples of the build
+  // side
+  const size_t min_probe_build_ratio = 4;
+
+  if (join_type != JoinType::INNER && join_type != JoinType::RIGHT) {
+    return false;
+  }
+
+  return build_table->GetTupleCount() * min_probe_build_ratio <=
+         probe_table->GetTupleCount();
+}
+
 void SimpleOptimizer::SetIndexScanFlag(planner::AbstractPlan* select_plan,
                                        uint64_t limit, uint64_t offset,
                                        bool descent) {
@@ -194,7 +194,7 @@ struct PARSER_CUST_LTYPE {
 %token REFERENCES DEALLOCATE PARAMETERS INTERSECT TEMPORARY TIMESTAMP
 %token VARBINARY ROLLBACK DISTINCT NVARCHAR RESTRICT TRUNCATE ANALYZE BETWEEN BOOLEAN ADDRESS
 %token DATABASE SMALLINT VARCHAR FOREIGN TINYINT CASCADE COLUMNS CONTROL DEFAULT EXECUTE EXPLAIN EXTRACT
-%token INTEGER NATURAL PREPARE PRIMARY SCHEMAS DECIMAL
+%token INTEGER NATURAL PREPARE PRIMARY SCHEMAS DECIMAL INCLUDE
 %token SPATIAL VIRTUAL BEFORE COLUMN CREATE DELETE DIRECT 
 %token BIGINT DOUBLE ESCAPE EXCEPT EXISTS GLOBAL HAVING
 %token INSERT ISNULL OFFSET RENAME SCHEMA SELECT SORTED
@@ -238,7 +238,7 @@ struct PARSER_CUST_LTYPE {
 %type <update_t>	update_clause
 %type <group_t>		opt_group
 
-%type <str_vec>				ident_commalist opt_column_list
+%type <str_vec>				ident_commalist opt_column_list opt_include
 %type <expr_vec>			expr_list select_list literal_list
 %type <table_vec>			table_ref_commalist
 %type <update_vec>			update_clause_commalist
@@ -344,6 +344,7 @@ execute_statement:
  * Create Statement
  * CREATE TABLE students (name TEXT, student_number INTEGER, city TEXT, grade DOUBLE)
  * CREATE INDEX i_security ON security (s_co_id, s_issue)
+ * CREATE INDEX i_security ON security (s_co_id) INCLUDE (s_issue)
  * CREATE DATABASE my_db
  ******************************/
 create_statement:
@@ -358,22 +359,24 @@ create_statement:
 			$$->if_not_exists = $3;
 			$$->database_name = $4;
 		}
-		|	CREATE opt_unique INDEX IDENTIFIER ON table_name '(' ident_commalist ')' {
+		|	CREATE opt_unique INDEX IDENTIFIER ON table_name '(' ident_commalist ')' opt_include {
 			$$ = new CreateStatement(CreateStatement::kIndex);
 			$$->unique = $2;
 			$$->index_name = $4;
 			$$->table_info_ = $6;
 			$$->index_attrs = $8;
+			$$->index_include_attrs = $10;
 			$$->index_type = peloton::IndexType::BWTREE;
 		}
 
-		|	CREATE opt_unique INDEX IDENTIFIER ON table_name '(' ident_commalist ')' USING opt_index_type {
+		|	CREATE opt_unique INDEX IDENTIFIER ON table_name '(' ident_commalist ')' opt_include USING opt_index_type {
 			$$ = new CreateStatement(CreateStatement::kIndex);
 			$$->unique = $2;
 			$$->index_name = $4;
 			$$->table_info_ = $6;
 			$$->index_attrs = $8;
-			$$->index_type = peloton::StringToIndexType(CharsToStringDestructive($11));
+			$$->index_include_attrs = $10;
+			$$->index_type = static_cast<peloton::IndexType>($12);
 		}
 	;
 
@@ -452,6 +455,11 @@ column_type:
     |   VARBINARY { $$ = ColumnDefinition::VARBINARY; }
 	;
 
+opt_include:
+		INCLUDE '(' ident_commalist ')' { $$ = $3; }
+	|	/* empty */ { $$ = nullptr; }
+	;
+
 opt_index_type:
 		HASH { $$ = static_cast<uint32_t>(peloton::IndexType::HASH); }
 	|	BWTREE { $$ = static_cast<uint32_t>(peloton::IndexType::BWTREE); }
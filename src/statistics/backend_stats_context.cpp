@@ -163,6 +163,16 @@ void BackendStatsContext::IncrementTableDeletes(oid_t tile_group_id) {
   }
 }
 
+void BackendStatsContext::IncrementTableBloomFilterProbes(oid_t database_id,
+                                                          oid_t table_id,
+                                                          size_t probe_count,
+                                                          size_t pass_count) {
+  auto table_metric = GetTableMetric(database_id, table_id);
+  PL_ASSERT(table_metric != nullptr);
+  table_metric->GetBloomFilterProbes().Increment(probe_count);
+  table_metric->GetBloomFilterPasses().Increment(pass_count);
+}
+
 void BackendStatsContext::IncrementIndexReads(size_t read_count,
                                               index::IndexMetadata* metadata) {
   oid_t index_id = metadata->GetOid();
@@ -306,6 +316,9 @@ void BackendStatsContext::Reset() {
       oid_t num_indexes = table->GetIndexCount();
       for (oid_t k = 0; k < num_indexes; ++k) {
         auto index = table->GetIndex(k);
+        if (index == nullptr) {
+          continue;
+        }
         oid_t index_id = index->GetOid();
         if (index_metrics_.Contains(index_id) == false) {
           std::shared_ptr<IndexMetric> index_metric(
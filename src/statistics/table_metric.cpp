@@ -35,6 +35,8 @@ void TableMetric::Aggregate(AbstractMetric& source) {
 
   TableMetric& table_metric = static_cast<TableMetric&>(source);
   table_access_.Aggregate(table_metric.GetTableAccess());
+  bloom_filter_probes_.Aggregate(table_metric.GetBloomFilterProbes());
+  bloom_filter_passes_.Aggregate(table_metric.GetBloomFilterPasses());
 }
 
 }  // namespace stats
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <mutex>
 #include <utility>
 
@@ -17,10 +18,14 @@
 #include "brain/sample.h"
 #include "catalog/catalog.h"
 #include "catalog/foreign_key.h"
+#include "common/container_tuple.h"
 #include "common/exception.h"
 #include "common/exception.h"
+#include "common/init.h"
 #include "common/logger.h"
+#include "common/numa_util.h"
 #include "common/platform.h"
+#include "common/thread_pool.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
@@ -53,6 +58,75 @@ oid_t DataTable::invalid_tile_group_id = -1;
 size_t DataTable::default_active_tilegroup_count_ = 1;
 size_t DataTable::default_active_indirection_array_count_ = 1;
 
+namespace {
+
+/** Tuple slots a thread reserved in a tile group of a table. */
+struct SlotReservation {
+  ~SlotReservation() { Release(); }
+
+  // Hands the slots left to the recycle pool of the table, unless their tile
+  // group is gone or being compacted
+  void Release();
+
+  const DataTable *table = nullptr;
+  oid_t table_oid = INVALID_OID;
+  TileGroup *tile_group = nullptr;
+  oid_t tile_group_id = INVALID_OID;
+  oid_t next_slot = 0;
+  oid_t end_slot = 0;
+
+  // slots to reserve next time, doubled on each reservation so that threads
+  // inserting a few tuples leave few slots unused
+  oid_t batch_size = 1;
+};
+
+const oid_t max_reserved_slot_count = 64;
+
+void SlotReservation::Release() {
+  if (next_slot < end_slot &&
+      catalog::Manager::GetInstance().GetTileGroupRaw(tile_group_id) ==
+          tile_group &&
+      tile_group->GetHeader()->IsRetired() == false) {
+    std::vector<ItemPointer> slots;
+    for (oid_t slot = next_slot; slot < end_slot; slot++) {
+      slots.emplace_back(tile_group_id, slot);
+    }
+    gc::GCManagerFactory::GetInstance().RecycleUnusedSlots(table_oid, slots);
+  }
+  next_slot = end_slot;
+}
+
+// The reservations of a thread, the table of a reservation replacing the
+// previous one when they map to the same entry. The slots left in a replaced
+// reservation, or in the reservations of a thread that exits, are recycled.
+const size_t slot_reservation_count = 8;
+
+thread_local SlotReservation slot_reservations[slot_reservation_count];
+
+SlotReservation &GetSlotReservation(const DataTable *table) {
+  auto &reservation =
+      slot_reservations[((uintptr_t)table / sizeof(DataTable)) %
+                        slot_reservation_count];
+  if (reservation.table != table ||
+      reservation.table_oid != table->GetOid()) {
+    reservation.Release();
+    reservation = SlotReservation();
+    reservation.table = table;
+    reservation.table_oid = table->GetOid();
+  }
+  return reservation;
+}
+
+}  // namespace
+
+// Threads are numbered as they first insert, so that concurrent inserters are
+// spread over the active tile groups and indirection arrays
+static size_t GetInserterNumber() {
+  static std::atomic<size_t> inserter_count(0);
+  static thread_local size_t inserter_number = inserter_count++;
+  return inserter_number;
+}
+
 DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
                      const oid_t &database_oid, const oid_t &table_oid,
                      const size_t &tuples_per_tilegroup, const bool own_schema,
@@ -76,6 +150,15 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
     active_indirection_array_count_ = default_active_indirection_array_count_;
   }
 
+  // Give every node the same number of active tile groups
+  numa_node_count_ = 1;
+  if (is_catalog == false && NumaUtil::IsEnabled() == true) {
+    numa_node_count_ = NumaUtil::GetNodeCount();
+  }
+  active_tilegroups_per_node_ =
+      (active_tilegroup_count_ + numa_node_count_ - 1) / numa_node_count_;
+  active_tilegroup_count_ = active_tilegroups_per_node_ * numa_node_count_;
+
   active_tile_groups_.resize(active_tilegroup_count_);
 
   active_indirection_arrays_.resize(active_indirection_array_count_);
@@ -171,40 +254,67 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   //=============== garbage collection==================
   // check if there are recycled tuple slots
   auto &gc_manager = gc::GCManagerFactory::GetInstance();
-  auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
-  if (free_item_pointer.IsNull() == false) {
+  while (true) {
+    auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
+    if (free_item_pointer.IsNull() == true) {
+      break;
+    }
+
+    auto tile_group =
+        catalog::Manager::GetInstance().GetTileGroup(free_item_pointer.block);
+    // the slots of a tile group being compacted are not reused
+    if (tile_group == nullptr || tile_group->GetHeader()->IsRetired()) {
+      continue;
+    }
+
     // when inserting a tuple
     if (tuple != nullptr) {
-      auto tile_group =
-          catalog::Manager::GetInstance().GetTileGroup(free_item_pointer.block);
       tile_group->CopyTuple(tuple, free_item_pointer.offset);
     }
     return free_item_pointer;
   }
   //====================================================
 
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  // take the next slot of the batch the thread reserved in the table
+  SlotReservation &reservation = GetSlotReservation(this);
+  if (reservation.next_slot < reservation.end_slot &&
+      catalog::Manager::GetInstance().GetTileGroupRaw(
+          reservation.tile_group_id) == reservation.tile_group &&
+      reservation.tile_group->GetHeader()->IsRetired() == false) {
+    oid_t tuple_slot = reservation.next_slot++;
+    if (tuple != nullptr) {
+      reservation.tile_group->CopyTuple(tuple, tuple_slot);
+    }
+    return ItemPointer(reservation.tile_group_id, tuple_slot);
+  }
+
+  size_t active_tile_group_id = GetActiveTileGroupId();
   std::shared_ptr<storage::TileGroup> tile_group;
   oid_t tuple_slot = INVALID_OID;
-  oid_t tile_group_id = INVALID_OID;
+  oid_t slot_count = 0;
 
-  // get valid tuple.
+  // reserve a new batch of slots
   while (true) {
     // get the last tile group.
     tile_group = active_tile_groups_[active_tile_group_id];
 
-    tuple_slot = tile_group->InsertTuple(tuple);
+    slot_count = tile_group->GetHeader()->ReserveTupleSlots(
+        reservation.batch_size, tuple_slot);
 
-    // now we have already obtained a new tuple slot.
-    if (tuple_slot != INVALID_OID) {
-      tile_group_id = tile_group->GetTileGroupId();
+    // now we have already obtained new tuple slots.
+    if (slot_count != 0) {
       break;
     }
+
+    // wait for the thread that got the last slot to replace the tile group
+    _mm_pause();
   }
 
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+
   // if this is the last tuple slot we can get
   // then create a new tile group
-  if (tuple_slot == tile_group->GetAllocatedTupleCount() - 1) {
+  if (tuple_slot + slot_count == tile_group->GetAllocatedTupleCount()) {
     AddDefaultTileGroup(active_tile_group_id);
   }
 
@@ -212,6 +322,25 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
             tile_group_count_.load(), tile_group->GetTileGroupId(),
             tile_group.get());
 
+  // the thread keeps the rest of the batch, and reserves more next time
+  reservation.tile_group = tile_group.get();
+  reservation.tile_group_id = tile_group_id;
+  reservation.next_slot = tuple_slot + 1;
+  reservation.end_slot = tuple_slot + slot_count;
+
+  // a thread that stops inserting leaves the rest of its batch unused until
+  // it is recycled, so without recycling the slots are taken one at a time.
+  // This costs a little more than the plain allocation did, as each slot
+  // still goes through the reservation lookup besides the CAS.
+  if (gc_manager.IsRecyclingSlots(table_oid) == true) {
+    reservation.batch_size =
+        std::min(reservation.batch_size * 2, max_reserved_slot_count);
+  }
+
+  if (tuple != nullptr) {
+    tile_group->CopyTuple(tuple, tuple_slot);
+  }
+
   // Set tuple location
   ItemPointer location(tile_group_id, tuple_slot);
 
@@ -252,13 +381,16 @@ ItemPointer DataTable::AcquireVersion() {
 bool DataTable::InstallVersion(const AbstractTuple *tuple,
                                const TargetList *targets_ptr,
                                concurrency::Transaction *transaction,
-                               ItemPointer *index_entry_ptr) {
+                               ItemPointer *index_entry_ptr,
+                               const ItemPointer &location) {
   // Index checks and updates
   if (InsertInSecondaryIndexes(tuple, targets_ptr, transaction,
                                index_entry_ptr) == false) {
     LOG_TRACE("Index constraint violated");
     return false;
   }
+
+  InsertInCoveringIndexes(tuple, location, index_entry_ptr);
   return true;
 }
 
@@ -341,29 +473,7 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
                                 ItemPointer **index_entry_ptr) {
   int index_count = GetIndexCount();
 
-  size_t active_indirection_array_id =
-      number_of_tuples_ % active_indirection_array_count_;
-
-  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
-
-  while (true) {
-    auto active_indirection_array =
-        active_indirection_arrays_[active_indirection_array_id];
-    indirection_offset = active_indirection_array->AllocateIndirection();
-
-    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
-      *index_entry_ptr =
-          active_indirection_array->GetIndirectionByOffset(indirection_offset);
-      break;
-    }
-  }
-
-  (*index_entry_ptr)->block = location.block;
-  (*index_entry_ptr)->offset = location.offset;
-
-  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
-    AddDefaultIndirectionArray(active_indirection_array_id);
-  }
+  *index_entry_ptr = AllocateIndirection(location);
 
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
@@ -378,10 +488,14 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
 
   for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
     auto index = GetIndex(index_itr);
+    if (index == nullptr) {
+      continue;
+    }
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
     std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
     key->SetFromTuple(tuple, indexed_columns, index->GetPool());
+    index->SetVersionHint(key.get(), location);
 
     switch (index->GetIndexType()) {
       case IndexConstraintType::PRIMARY_KEY:
@@ -441,10 +555,16 @@ bool DataTable::InsertInSecondaryIndexes(const AbstractTuple *tuple,
   // Since this is NOT protected by a lock, concurrent insert may happen.
   for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
     auto index = GetIndex(index_itr);
+    if (index == nullptr) {
+      continue;
+    }
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
 
-    if (index->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
+    // The entries of covering indexes are per version, they are inserted
+    // once the constraints are checked
+    if (index->GetIndexType() == IndexConstraintType::PRIMARY_KEY ||
+        index->IsCovering() == true) {
       continue;
     }
 
@@ -482,6 +602,46 @@ bool DataTable::InsertInSecondaryIndexes(const AbstractTuple *tuple,
   return res;
 }
 
+void DataTable::InsertInCoveringIndexes(const AbstractTuple *tuple,
+                                        const ItemPointer &location,
+                                        ItemPointer *index_entry_ptr) {
+  int index_count = GetIndexCount();
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    if (index == nullptr || index->IsCovering() == false) {
+      continue;
+    }
+
+    auto index_schema = index->GetKeySchema();
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    key->SetFromTuple(tuple, index_schema->GetIndexedColumns(),
+                      index->GetPool());
+    index->SetVersionHint(key.get(), location);
+
+    index->InsertEntry(key.get(), index_entry_ptr);
+  }
+}
+
+void DataTable::DeleteFromCoveringIndexes(const AbstractTuple *tuple,
+                                          const ItemPointer &location,
+                                          ItemPointer *index_entry_ptr) {
+  int index_count = GetIndexCount();
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    if (index == nullptr || index->IsCovering() == false) {
+      continue;
+    }
+
+    auto index_schema = index->GetKeySchema();
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    key->SetFromTuple(tuple, index_schema->GetIndexedColumns(),
+                      index->GetPool());
+    index->SetVersionHint(key.get(), location);
+
+    index->DeleteEntry(key.get(), index_entry_ptr);
+  }
+}
+
 /**
  * @brief Check if all the foreign key constraints on this table
  * is satisfied by checking whether the key exist in the referred table
@@ -508,6 +668,9 @@ bool DataTable::CheckForeignKeyConstraints(
     for (int index_itr = ref_table_index_count - 1; index_itr >= 0;
          --index_itr) {
       auto index = ref_table->GetIndex(index_itr);
+      if (index == nullptr) {
+        continue;
+      }
 
       // The foreign key constraints only refer to the primary key
       if (index->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
@@ -548,8 +711,8 @@ bool DataTable::CheckForeignKeyConstraints(
  * @param amount amount to increase
  */
 void DataTable::IncreaseTupleCount(const size_t &amount) {
-  number_of_tuples_ += amount;
-  dirty_ = true;
+  number_of_tuples_.Add(amount);
+  MarkDirty();
 }
 
 /**
@@ -557,8 +720,8 @@ void DataTable::IncreaseTupleCount(const size_t &amount) {
  * @param amount amount to decrease
  */
 void DataTable::DecreaseTupleCount(const size_t &amount) {
-  number_of_tuples_ -= amount;
-  dirty_ = true;
+  number_of_tuples_.Subtract(amount);
+  MarkDirty();
 }
 
 /**
@@ -566,15 +729,18 @@ void DataTable::DecreaseTupleCount(const size_t &amount) {
  * @param num_tuples number of tuples
  */
 void DataTable::SetTupleCount(const size_t &num_tuples) {
-  number_of_tuples_ = num_tuples;
-  dirty_ = true;
+  number_of_tuples_.Set(num_tuples);
+  MarkDirty();
 }
 
 /**
  * @brief Get the number of tuples in this table
  * @return number of tuples
  */
-size_t DataTable::GetTupleCount() const { return number_of_tuples_; }
+size_t DataTable::GetTupleCount() const {
+  int64_t tuple_count = number_of_tuples_.Get();
+  return (tuple_count > 0) ? tuple_count : 0;
+}
 
 /**
  * @brief return dirty flag
@@ -592,10 +758,29 @@ void DataTable::ResetDirty() { dirty_ = false; }
 //===--------------------------------------------------------------------===//
 
 TileGroup *DataTable::GetTileGroupWithLayout(
-    const column_map_type &partitioning) {
+    const column_map_type &partitioning, int numa_node) {
   oid_t tile_group_id = catalog::Manager::GetInstance().GetNextTileGroupId();
-  return (AbstractTable::GetTileGroupWithLayout(
-      database_oid, tile_group_id, partitioning, tuples_per_tilegroup_));
+  return (AbstractTable::GetTileGroupWithLayout(database_oid, tile_group_id,
+                                                partitioning,
+                                                tuples_per_tilegroup_,
+                                                numa_node));
+}
+
+size_t DataTable::GetActiveTileGroupId() const {
+  size_t node = 0;
+  if (numa_node_count_ > 1) {
+    node = NumaUtil::GetCurrentNode() % numa_node_count_;
+  }
+  return node * active_tilegroups_per_node_ +
+         GetInserterNumber() % active_tilegroups_per_node_;
+}
+
+int DataTable::GetActiveTileGroupNode(
+    const size_t &active_tile_group_id) const {
+  if (numa_node_count_ <= 1) {
+    return NumaUtil::ANY_NODE;
+  }
+  return active_tile_group_id / active_tilegroups_per_node_;
 }
 
 oid_t DataTable::AddDefaultIndirectionArray(
@@ -614,9 +799,37 @@ oid_t DataTable::AddDefaultIndirectionArray(
   return indirection_array_id;
 }
 
+ItemPointer *DataTable::AllocateIndirection(const ItemPointer &location) {
+  size_t active_indirection_array_id =
+      GetInserterNumber() % active_indirection_array_count_;
+
+  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+  ItemPointer *indirection = nullptr;
+
+  while (true) {
+    auto active_indirection_array =
+        active_indirection_arrays_[active_indirection_array_id];
+    indirection_offset = active_indirection_array->AllocateIndirection();
+
+    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
+      indirection =
+          active_indirection_array->GetIndirectionByOffset(indirection_offset);
+      break;
+    }
+  }
+
+  indirection->block = location.block;
+  indirection->offset = location.offset;
+
+  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
+    AddDefaultIndirectionArray(active_indirection_array_id);
+  }
+
+  return indirection;
+}
+
 oid_t DataTable::AddDefaultTileGroup() {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
-  return AddDefaultTileGroup(active_tile_group_id);
+  return AddDefaultTileGroup(GetActiveTileGroupId());
 }
 
 oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
@@ -626,8 +839,9 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
   // Figure out the partitioning for given tilegroup layout
   column_map = GetTileGroupLayout((LayoutType)peloton_layout_mode);
 
-  // Create a tile group with that partitioning
-  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(column_map));
+  // Create a tile group with that partitioning, on the node of the slot
+  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(
+      column_map, GetActiveTileGroupNode(active_tile_group_id)));
   PL_ASSERT(tile_group.get());
 
   tile_group_id = tile_group->GetTileGroupId();
@@ -692,7 +906,7 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
 
 // NOTE: This function is only used in test cases.
 void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id = GetActiveTileGroupId();
 
   active_tile_groups_[active_tile_group_id] = tile_group;
 
@@ -724,6 +938,16 @@ std::shared_ptr<storage::TileGroup> DataTable::GetTileGroup(
   return GetTileGroupById(tile_group_id);
 }
 
+storage::TileGroup *DataTable::GetTileGroupRaw(
+    const std::size_t &tile_group_offset) const {
+  PL_ASSERT(tile_group_offset < GetTileGroupCount());
+
+  auto tile_group_id =
+      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+
+  return catalog::Manager::GetInstance().GetTileGroupRaw(tile_group_id);
+}
+
 std::shared_ptr<storage::TileGroup> DataTable::GetTileGroupById(
     const oid_t &tile_group_id) const {
   auto &manager = catalog::Manager::GetInstance();
@@ -775,22 +999,218 @@ void DataTable::AddIndex(std::shared_ptr<index::Index> index) {
   }
 }
 
+size_t DataTable::PopulateIndex(index::Index *index,
+                                oid_t begin_tile_group_offset,
+                                oid_t end_tile_group_offset, bool bulk_load) {
+  std::vector<std::unique_ptr<char[]>> key_buffers;
+  std::vector<storage::Tuple> key_tuples;
+  std::vector<ItemPointer *> locations;
+  CollectIndexEntries(index, begin_tile_group_offset, end_tile_group_offset,
+                      nullptr, {}, key_buffers, key_tuples, locations);
+
+  std::vector<const storage::Tuple *> keys;
+  keys.reserve(key_tuples.size());
+  for (auto &key_tuple : key_tuples) {
+    keys.push_back(&key_tuple);
+  }
+
+  LOG_TRACE("Populating index %s with %lu entries", index->GetName().c_str(),
+            keys.size());
+
+  if (bulk_load == true) {
+    return index->BulkLoad(keys, locations);
+  }
+  return index->InsertEntries(keys, locations);
+}
+
+bool DataTable::BuildIndex(index::Index *index, concurrency::Transaction *txn,
+                           std::vector<ItemPointer> &versions) {
+  std::vector<std::unique_ptr<char[]>> key_buffers;
+  std::vector<storage::Tuple> key_tuples;
+  std::vector<ItemPointer *> locations;
+  CollectIndexEntries(index, 0, GetTileGroupCount(), txn, {}, key_buffers,
+                      key_tuples, locations, &versions);
+  std::sort(versions.begin(), versions.end());
+
+  std::vector<const storage::Tuple *> keys;
+  keys.reserve(key_tuples.size());
+  for (auto &key_tuple : key_tuples) {
+    keys.push_back(&key_tuple);
+  }
+
+  LOG_TRACE("Building index %s from %lu entries", index->GetName().c_str(),
+            keys.size());
+
+  // Every version has its own indirection, the entries are all distinct but
+  // for the keys of a unique index that are there twice
+  return index->BulkLoad(keys, locations) == keys.size();
+}
+
+bool DataTable::BackfillIndex(index::Index *index,
+                              concurrency::Transaction *txn,
+                              const std::vector<ItemPointer> &indexed_versions) {
+  std::vector<std::unique_ptr<char[]>> key_buffers;
+  std::vector<storage::Tuple> key_tuples;
+  std::vector<ItemPointer *> locations;
+  CollectIndexEntries(index, 0, GetTileGroupCount(), txn, indexed_versions,
+                      key_buffers, key_tuples, locations);
+
+  LOG_TRACE("Backfilling index %s with %lu entries", index->GetName().c_str(),
+            key_tuples.size());
+
+  if (index->GetIndexType() != IndexConstraintType::PRIMARY_KEY &&
+      index->GetIndexType() != IndexConstraintType::UNIQUE) {
+    std::vector<const storage::Tuple *> keys;
+    keys.reserve(key_tuples.size());
+    for (auto &key_tuple : key_tuples) {
+      keys.push_back(&key_tuple);
+    }
+    index->InsertEntries(keys, locations);
+    return true;
+  }
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  std::function<bool(const void *)> fn =
+      std::bind(&concurrency::TransactionManager::IsOccupied,
+                &transaction_manager, txn, std::placeholders::_1);
+
+  for (size_t i = 0; i < key_tuples.size(); i++) {
+    // a writer may have inserted the entry of the version already
+    std::vector<ItemPointer *> entries;
+    index->ScanKey(&key_tuples[i], entries);
+    if (std::find(entries.begin(), entries.end(), locations[i]) !=
+        entries.end()) {
+      continue;
+    }
+
+    if (index->CondInsertEntry(&key_tuples[i], locations[i], fn) == false) {
+      LOG_TRACE("Index constraint violated");
+      return false;
+    }
+  }
+  return true;
+}
+
+void DataTable::CollectIndexEntries(
+    index::Index *index, oid_t begin_tile_group_offset,
+    oid_t end_tile_group_offset, concurrency::Transaction *txn,
+    const std::vector<ItemPointer> &skipped_versions,
+    std::vector<std::unique_ptr<char[]>> &key_buffers,
+    std::vector<storage::Tuple> &key_tuples,
+    std::vector<ItemPointer *> &locations, std::vector<ItemPointer> *versions) {
+  end_tile_group_offset =
+      std::min<oid_t>(end_tile_group_offset, GetTileGroupCount());
+  if (begin_tile_group_offset >= end_tile_group_offset) {
+    return;
+  }
+
+  auto index_schema = index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+  size_t key_length = index_schema->GetLength();
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  // The keys of a tile group are laid out one after the other in its buffer,
+  // the index entries point to the indirections of the versions
+  size_t tile_group_count = end_tile_group_offset - begin_tile_group_offset;
+  key_buffers.resize(tile_group_count);
+  std::vector<std::vector<ItemPointer *>> tile_group_locations(
+      tile_group_count);
+  std::vector<std::vector<ItemPointer>> tile_group_versions(
+      versions != nullptr ? tile_group_count : 0);
+
+  thread_pool.RunTasks(
+      thread_pool.GetPoolSize() + 1, tile_group_count,
+      [&](size_t, size_t task) {
+        auto tile_group = GetTileGroup(begin_tile_group_offset + task);
+        if (tile_group == nullptr) {
+          return;
+        }
+
+        auto tile_group_header = tile_group->GetHeader();
+        oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+        key_buffers[task].reset(new char[active_tuple_count * key_length]());
+
+        auto tile_group_id = tile_group->GetTileGroupId();
+        auto &locations = tile_group_locations[task];
+        for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+          if (txn != nullptr) {
+            // Uncommitted versions are indexed by their writers
+            if (transaction_manager.IsVisible(txn, tile_group_header,
+                                              tuple_id) != VisibilityType::OK) {
+              continue;
+            }
+            if (std::binary_search(skipped_versions.begin(),
+                                   skipped_versions.end(),
+                                   ItemPointer(tile_group_id, tuple_id))) {
+              continue;
+            }
+          } else if (tile_group_header->GetTransactionId(tuple_id) ==
+                         INVALID_TXN_ID ||
+                     tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+            // Skip the empty slots and the versions that are not the latest
+            continue;
+          }
+
+          expression::ContainerTuple<storage::TileGroup> container_tuple(
+              tile_group.get(), tuple_id);
+          storage::Tuple key(index_schema, key_buffers[task].get() +
+                                               locations.size() * key_length);
+          key.SetFromTuple(&container_tuple, indexed_columns, index->GetPool());
+          index->SetVersionHint(&key, ItemPointer(tile_group_id, tuple_id));
+
+          // The versions inserted while the table had no index have no
+          // indirection yet
+          auto indirection = tile_group_header->GetIndirection(tuple_id);
+          if (indirection == nullptr) {
+            indirection = tile_group_header->SetAtomicIndirection(
+                tuple_id,
+                AllocateIndirection(ItemPointer(tile_group_id, tuple_id)));
+          }
+          locations.push_back(indirection);
+          if (versions != nullptr) {
+            tile_group_versions[task].emplace_back(tile_group_id, tuple_id);
+          }
+        }
+      });
+
+  size_t entry_count = 0;
+  for (auto &tile_group_entries : tile_group_locations) {
+    entry_count += tile_group_entries.size();
+  }
+
+  key_tuples.reserve(entry_count);
+  locations.reserve(entry_count);
+  for (size_t task = 0; task < tile_group_count; task++) {
+    for (size_t i = 0; i < tile_group_locations[task].size(); i++) {
+      key_tuples.emplace_back(index_schema,
+                              key_buffers[task].get() + i * key_length);
+    }
+    locations.insert(locations.end(), tile_group_locations[task].begin(),
+                     tile_group_locations[task].end());
+    if (versions != nullptr) {
+      versions->insert(versions->end(), tile_group_versions[task].begin(),
+                       tile_group_versions[task].end());
+    }
+  }
+}
+
 std::shared_ptr<index::Index> DataTable::GetIndexWithOid(
     const oid_t &index_oid) {
-  std::shared_ptr<index::Index> ret_index;
   auto index_count = indexes_.GetSize();
 
   for (std::size_t index_itr = 0; index_itr < index_count; index_itr++) {
-    ret_index = indexes_.Find(index_itr);
-    if (ret_index->GetOid() == index_oid) {
-      break;
+    auto ret_index = indexes_.Find(index_itr);
+    // Dropped indexes leave an empty slot
+    if (ret_index != nullptr && ret_index->GetOid() == index_oid) {
+      return ret_index;
     }
   }
-  if (ret_index == nullptr) {
-    throw CatalogException("No index with oid = " + std::to_string(index_oid) +
-                           " is found");
-  }
-  return ret_index;
+  throw CatalogException("No index with oid = " + std::to_string(index_oid) +
+                         " is found");
 }
 
 void DataTable::DropIndexWithOid(const oid_t &index_oid) {
@@ -798,20 +1218,21 @@ void DataTable::DropIndexWithOid(const oid_t &index_oid) {
   std::shared_ptr<index::Index> index;
   auto index_count = indexes_.GetSize();
 
-  for (std::size_t index_itr = 0; index_itr < index_count; index_itr++) {
-    index = indexes_.Find(index_itr);
-    if (index->GetOid() == index_oid) {
+  for (index_offset = 0; index_offset < index_count; index_offset++) {
+    index = indexes_.Find(index_offset);
+    if (index != nullptr && index->GetOid() == index_oid) {
       break;
     }
   }
 
   PL_ASSERT(index_offset < indexes_.GetSize());
 
-  // Drop the index
+  // Drop the index, its slot is left empty so that the offsets of the other
+  // indexes do not change
   indexes_.Update(index_offset, nullptr);
 
   // Drop index column info
-  indexes_columns_.erase(indexes_columns_.begin() + index_offset);
+  indexes_columns_[index_offset].clear();
 }
 
 void DataTable::DropIndexes() {
@@ -1018,6 +1439,126 @@ storage::TileGroup *DataTable::TransformTileGroup(
   return new_tile_group.get();
 }
 
+//===--------------------------------------------------------------------===//
+// COMPACTION
+//===--------------------------------------------------------------------===//
+
+bool DataTable::RetireTileGroup(const oid_t &tile_group_offset) {
+  auto tile_group = GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr) {
+    return false;
+  }
+
+  // the active tile groups are still being filled
+  auto tile_group_header = tile_group->GetHeader();
+  if (tile_group_header->GetCurrentNextTupleSlot() <
+      tile_group->GetAllocatedTupleCount()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(data_table_mutex_);
+  if (tile_group->GetTileGroupId() == empty_tile_group_id_ ||
+      tile_group_header->IsRetired() == true) {
+    return false;
+  }
+
+  tile_group_header->SetRetired();
+  LOG_TRACE("Retired tile group : %u", tile_group->GetTileGroupId());
+  return true;
+}
+
+bool DataTable::RelocateVersion(concurrency::Transaction *transaction,
+                                const ItemPointer &location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto tile_group = manager.GetTileGroup(location.block);
+  auto tile_group_header = tile_group->GetHeader();
+
+  // the new version begins when the transaction commits, so the old one must
+  // have been committed before it began
+  if (transaction_manager.IsVisible(transaction, tile_group_header,
+                                    location.offset) != VisibilityType::OK) {
+    return false;
+  }
+
+  // read it with the ownership, as the update executor does
+  if (transaction_manager.PerformRead(transaction, location, true) == false) {
+    return false;
+  }
+
+  ItemPointer new_location = AcquireVersion();
+  auto new_tile_group = manager.GetTileGroup(new_location.block);
+
+  auto column_count = schema->GetColumnCount();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto value = tile_group->GetValue(location.offset, column_itr);
+    new_tile_group->SetValue(value, new_location.offset, column_itr);
+  }
+
+  // the covering indexes have an entry per version, the one of the old
+  // version is deleted when it is collected
+  expression::ContainerTuple<storage::TileGroup> new_tuple(
+      new_tile_group.get(), new_location.offset);
+  InsertInCoveringIndexes(&new_tuple, new_location,
+                          tile_group_header->GetIndirection(location.offset));
+
+  transaction_manager.PerformUpdate(transaction, location, new_location);
+  return true;
+}
+
+bool DataTable::DropRetiredTileGroup(const oid_t &tile_group_offset) {
+  auto tile_group = GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr) {
+    return false;
+  }
+
+  auto tile_group_header = tile_group->GetHeader();
+  if (tile_group_header->IsRetired() == false) {
+    return false;
+  }
+
+  // all the slots must have been collected, including the old versions
+  oid_t tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    if (tile_group_header->GetTransactionId(tuple_id) != INVALID_TXN_ID) {
+      return false;
+    }
+  }
+
+  auto tile_group_id = tile_group->GetTileGroupId();
+  {
+    std::lock_guard<std::mutex> lock(data_table_mutex_);
+
+    // the scans expect a tile group at every offset
+    if (empty_tile_group_id_ == INVALID_OID) {
+      std::vector<catalog::Schema> schemas;
+      schemas.push_back(*schema);
+
+      column_map_type column_map;
+      auto col_count = schema->GetColumnCount();
+      for (oid_t col_itr = 0; col_itr < col_count; col_itr++) {
+        column_map[col_itr] = std::make_pair(0, col_itr);
+      }
+
+      auto &manager = catalog::Manager::GetInstance();
+      empty_tile_group_id_ = manager.GetNextTileGroupId();
+      std::shared_ptr<TileGroup> empty_tile_group(
+          TileGroupFactory::GetTileGroup(database_oid, table_oid,
+                                         empty_tile_group_id_, this, schemas,
+                                         column_map, 1));
+      manager.AddTileGroup(empty_tile_group_id_, empty_tile_group);
+    }
+
+    tile_groups_.Update(tile_group_offset, empty_tile_group_id_);
+  }
+
+  LOG_TRACE("Dropping compacted tile group : %u", tile_group_id);
+  gc::GCManagerFactory::GetInstance().RetireTileGroup(tile_group_id);
+  return true;
+}
+
 void DataTable::RecordLayoutSample(const brain::Sample &sample) {
   // Add layout sample
   {
@@ -12,12 +12,14 @@
 
 #include <sstream>
 
+#include "brain/tile_group_compactor.h"
 #include "catalog/foreign_key.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "index/index.h"
 #include "storage/database.h"
 #include "storage/table_factory.h"
+#include "configuration/configuration.h"
 #include "gc/gc_manager_factory.h"
 
 namespace peloton {
@@ -28,7 +30,12 @@ Database::Database(const oid_t &database_oid) : database_oid(database_oid) {}
 Database::~Database() {
   // Clean up all the tables
   LOG_TRACE("Deleting tables from database");
-  for (auto table : tables) delete table;
+  for (auto table : tables) {
+    if (FLAGS_tile_group_compactor == true) {
+      brain::TileGroupCompactor::GetInstance().RemoveTable(table);
+    }
+    delete table;
+  }
 
   LOG_TRACE("Finish deleting tables from database");
 }
@@ -47,6 +54,11 @@ void Database::AddTable(storage::DataTable *table, bool is_catalog) {
       auto *gc_manager = &gc::GCManagerFactory::GetInstance();
       assert(gc_manager != nullptr);
       gc_manager->RegisterTable(table->GetOid());
+
+      // Register table to tile group compactor.
+      if (FLAGS_tile_group_compactor == true) {
+        brain::TileGroupCompactor::GetInstance().AddTable(table);
+      }
     }
   }
 }
@@ -78,6 +90,10 @@ void Database::DropTableWithOid(const oid_t table_oid) {
     oid_t table_offset = 0;
     for (auto table : tables) {
       if (table->GetOid() == table_oid) {
+        // Deregister table from tile group compactor.
+        if (FLAGS_tile_group_compactor == true) {
+          brain::TileGroupCompactor::GetInstance().RemoveTable(table);
+        }
         delete table;
         break;
       }
@@ -124,6 +140,9 @@ const std::string Database::GetInfo() const {
         os << "Index Count : " << index_count << std::endl;
         for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
           auto index = table->GetIndex(index_itr);
+          if (index == nullptr) {
+            continue;
+          }
 
           switch (index->GetIndexType()) {
             case IndexConstraintType::PRIMARY_KEY:
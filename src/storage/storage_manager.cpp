@@ -442,14 +442,19 @@ StorageManager::~StorageManager() {
   }
 }
 
-void *StorageManager::Allocate(BackendType type, size_t size) {
+void *StorageManager::Allocate(BackendType type, size_t size, int numa_node) {
   // Update allocation count
   allocation_count++;
 
   switch (type) {
     case BackendType::MM:
     case BackendType::NVM: {
-      return ::operator new(size);
+      void *address = ::operator new(size);
+      // bind before the memory is first touched
+      if (numa_node != NumaUtil::ANY_NODE) {
+        NumaUtil::BindMemory(address, size, numa_node);
+      }
+      return address;
     } break;
 
     case BackendType::SSD:
@@ -54,8 +54,10 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
   // allocate tuple storage space for inlined data
   auto &storage_manager = storage::StorageManager::GetInstance();
+  int numa_node = (tile_header != nullptr) ? tile_header->GetNumaNode()
+                                           : NumaUtil::ANY_NODE;
   data = reinterpret_cast<char *>(
-      storage_manager.Allocate(backend_type, tile_size));
+      storage_manager.Allocate(backend_type, tile_size, numa_node));
   PL_ASSERT(data != NULL);
 
   // zero out the data
@@ -29,24 +29,53 @@ namespace peloton {
 namespace storage {
 
 TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
-                                 const int &tuple_count)
+                                 const int &tuple_count,
+                                 const LayoutType &layout_type,
+                                 const int &numa_node)
     : backend_type(backend_type),
+      layout_type(layout_type),
+      numa_node(numa_node),
       tile_group(nullptr),
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
+      all_visible_cid(MAX_CID),
+      retired(false),
       tile_header_lock() {
   header_size = num_tuple_slots * header_entry_size;
 
   // allocate storage space for header
   auto &storage_manager = storage::StorageManager::GetInstance();
   data = reinterpret_cast<char *>(
-      storage_manager.Allocate(backend_type, header_size));
+      storage_manager.Allocate(backend_type, header_size, numa_node));
   PL_ASSERT(data != nullptr);
 
   // zero out the data
   PL_MEMSET(data, 0, header_size);
 
+  // Locate the fields
+  static_assert(sizeof(txn_id_t) == sizeof(cid_t) &&
+                    sizeof(cid_t) == sizeof(ItemPointer) &&
+                    sizeof(ItemPointer) == sizeof(ItemPointer *),
+                "header fields must share a stride");
+  size_t field_scale;
+  if (layout_type == LAYOUT_TYPE_COLUMN) {
+    field_scale = num_tuple_slots;
+    field_stride = sizeof(cid_t);
+    reserved_field_stride = reserved_size;
+  } else {
+    field_scale = 1;
+    field_stride = header_entry_size;
+    reserved_field_stride = header_entry_size;
+  }
+  txn_id_location = data + txn_id_offset * field_scale;
+  begin_cid_location = data + begin_cid_offset * field_scale;
+  end_cid_location = data + end_cid_offset * field_scale;
+  next_pointer_location = data + next_pointer_offset * field_scale;
+  prev_pointer_location = data + prev_pointer_offset * field_scale;
+  indirection_location = data + indirection_offset * field_scale;
+  reserved_field_location = data + reserved_field_offset * field_scale;
+
   // Set MVCC Initial Value
   for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
        tuple_slot_id++) {
@@ -66,6 +95,29 @@ TileGroupHeader::~TileGroupHeader() {
   data = nullptr;
 }
 
+bool TileGroupHeader::SetAllVisible(const cid_t &max_begin_cid) const {
+  if (next_tuple_slot < num_tuple_slots) {
+    return false;
+  }
+
+  all_visible_cid.store(max_begin_cid);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  // A writer that acquired the ownership of a slot while the caller was
+  // scanning the tile group may have checked the summary before it got
+  // published. Such a writer is visible here, so check the slots again.
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
+       tuple_slot_id++) {
+    if (GetTransactionId(tuple_slot_id) != INITIAL_TXN_ID ||
+        GetEndCommitId(tuple_slot_id) != MAX_CID) {
+      ClearAllVisible();
+      return false;
+    }
+  }
+
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Tile Group Header
 //===--------------------------------------------------------------------===//
@@ -202,63 +202,192 @@ ResultType TrafficCop::ExecuteStatement(
 bridge::peloton_status TrafficCop::ExecuteStatementPlan(
     const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
     std::vector<StatementResult> &result, const std::vector<int> &result_format) {
-  concurrency::Transaction *txn;
-  bool single_statement_txn = false, init_failure = false;
+  bool single_statement_txn = false;
   bridge::peloton_status p_status;
 
+  auto txn = BeginStatementTransaction(single_statement_txn);
+
+  // skip if already aborted
+  if (txn == nullptr) {
+    p_status.m_result = ResultType::ABORTED;
+    return p_status;
+  }
+
+  p_status = bridge::PlanExecutor::ExecutePlan(plan, txn, params, result,
+                                               result_format);
+  FinishStatementTransaction(txn, single_statement_txn, p_status);
+  return p_status;
+}
+
+ResultType TrafficCop::ExecutePortal(Portal &portal,
+                                     const std::vector<int> &result_format,
+                                     const size_t max_rows,
+                                     const ResultCallback &callback,
+                                     bool &suspended, int &rows_changed,
+                                     std::string &error_message,
+                                     const PauseCallback &pause) {
+  suspended = false;
+
+  try {
+    // Start the statement, unless we are resuming a suspended portal
+    if (portal.cursor_ == nullptr) {
+      auto statement = portal.GetStatement();
+      if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+        stats::BackendStatsContext::GetInstance()->InitQueryMetric(
+            statement, portal.GetParamStat());
+      }
+      LOG_TRACE("Execute Portal %s of query: %s", portal.portal_name_.c_str(),
+                statement->GetQueryString().c_str());
+
+      if (statement->GetQueryType() == "BEGIN")
+        return BeginQueryHelper();
+      else if (statement->GetQueryType() == "COMMIT")
+        return CommitQueryHelper();
+      else if (statement->GetQueryType() == "ROLLBACK")
+        return AbortQueryHelper();
+
+      bool single_statement_txn = false;
+      auto txn = BeginStatementTransaction(single_statement_txn);
+
+      // skip if already aborted
+      if (txn == nullptr) return ResultType::ABORTED;
+
+      portal.cursor_.reset(new bridge::PlanCursor(
+          statement->GetPlanTree().get(), txn, portal.GetParameters(),
+          result_format));
+      portal.single_statement_txn_ = single_statement_txn;
+      portal.cursor_->Init();
+    } else if (portal.single_statement_txn_ == false &&
+               GetCurrentTxnState().first !=
+                   portal.cursor_->GetTransaction()) {
+      // The txn block the portal was suspended in has ended
+      portal.cursor_.reset();
+      error_message = "portal \"" + portal.portal_name_ + "\" cannot be run";
+      return ResultType::FAILURE;
+    }
+
+    auto &cursor = *portal.cursor_;
+    size_t row_count = 0;
+    std::vector<oid_t> rows;
+
+    // Hand the rows out a logical tile at a time
+    while (cursor.IsDone() == false &&
+           (max_rows == 0 || row_count < max_rows)) {
+      auto tile =
+          cursor.FetchRows((max_rows == 0) ? 0 : max_rows - row_count, rows);
+      if (tile == nullptr || rows.empty()) continue;
+
+      row_count += rows.size();
+      if (callback(*tile, rows) == false) {
+        LOG_TRACE("Could not deliver the rows of portal %s",
+                  portal.portal_name_.c_str());
+        cursor.GetTransaction()->SetResult(ResultType::FAILURE);
+        error_message = "could not send the query results";
+        break;
+      }
+      if (pause != nullptr && pause() == true) break;
+    }
+
+    // Row limit reached or paused, keep the executor tree around for the next call
+    if (cursor.IsDone() == false &&
+        cursor.GetTransaction()->GetResult() != ResultType::FAILURE) {
+      suspended = true;
+      rows_changed = row_count;
+      return ResultType::SUCCESS;
+    }
+
+    auto txn = cursor.GetTransaction();
+    auto p_status = cursor.GetStatus();
+    portal.cursor_.reset();
+
+    FinishStatementTransaction(txn, portal.single_statement_txn_, p_status);
+    LOG_TRACE("Portal executed. Result: %s",
+              ResultTypeToString(p_status.m_result).c_str());
+    rows_changed = p_status.m_processed;
+    return p_status.m_result;
+  } catch (Exception &e) {
+    if (portal.cursor_ != nullptr) {
+      portal.cursor_->GetTransaction()->SetResult(ResultType::FAILURE);
+      ClosePortal(portal);
+    }
+    error_message = e.what();
+    return ResultType::FAILURE;
+  }
+}
+
+void TrafficCop::ClosePortal(Portal &portal) {
+  if (portal.cursor_ == nullptr) return;
+
+  auto txn = portal.cursor_->GetTransaction();
+  auto p_status = portal.cursor_->GetStatus();
+  portal.cursor_.reset();
+
+  // A txn block outlives its portals, it is ended by COMMIT or ROLLBACK
+  if (portal.single_statement_txn_ == true) {
+    FinishStatementTransaction(txn, true, p_status);
+  }
+}
+
+concurrency::Transaction *TrafficCop::BeginStatementTransaction(
+    bool &single_statement_txn) {
   auto &curr_state = GetCurrentTxnState();
   if (tcop_txn_state_.empty()) {
     // no active txn, single-statement txn
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
     // new txn, reset result status
     curr_state.second = ResultType::SUCCESS;
-    txn = txn_manager.BeginTransaction();
     single_statement_txn = true;
-  } else {
-    // get ptr to current active txn
-    txn = curr_state.first;
+    auto txn = txn_manager.BeginTransaction();
+    PL_ASSERT(txn);
+    return txn;
   }
 
+  single_statement_txn = false;
+
   // skip if already aborted
-  if (curr_state.second != ResultType::ABORTED) {
-    PL_ASSERT(txn);
-    p_status = bridge::PlanExecutor::ExecutePlan(plan, txn, params, result,
-                                                 result_format);
+  if (curr_state.second == ResultType::ABORTED) {
+    return nullptr;
+  }
 
-    if (p_status.m_result == ResultType::FAILURE) {
-      // only possible if init failed
-      init_failure = true;
-    }
+  // get ptr to current active txn
+  return curr_state.first;
+}
 
-    auto txn_result = txn->GetResult();
-    if (single_statement_txn == true || init_failure == true ||
-        txn_result == ResultType::FAILURE) {
-      auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-
-      LOG_TRACE(
-          "About to commit: single stmt: %d, init_failure: %d, txn_result: %s",
-          single_statement_txn, init_failure,
-          ResultTypeToString(txn_result).c_str());
-      switch (txn_result) {
-        case ResultType::SUCCESS:
-          // Commit
-          LOG_TRACE("Commit Transaction");
-          p_status.m_result = txn_manager.CommitTransaction(txn);
-          break;
-
-        case ResultType::FAILURE:
-        default:
-          // Abort
-          LOG_TRACE("Abort Transaction");
-          p_status.m_result = txn_manager.AbortTransaction(txn);
-          curr_state.second = ResultType::ABORTED;
-      }
+void TrafficCop::FinishStatementTransaction(concurrency::Transaction *txn,
+                                            const bool single_statement_txn,
+                                            bridge::peloton_status &p_status) {
+  bool init_failure = false;
+  if (p_status.m_result == ResultType::FAILURE) {
+    // only possible if init failed
+    init_failure = true;
+  }
+
+  auto txn_result = txn->GetResult();
+  if (single_statement_txn == true || init_failure == true ||
+      txn_result == ResultType::FAILURE) {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+    LOG_TRACE(
+        "About to commit: single stmt: %d, init_failure: %d, txn_result: %s",
+        single_statement_txn, init_failure,
+        ResultTypeToString(txn_result).c_str());
+    switch (txn_result) {
+      case ResultType::SUCCESS:
+        // Commit
+        LOG_TRACE("Commit Transaction");
+        p_status.m_result = txn_manager.CommitTransaction(txn);
+        break;
+
+      case ResultType::FAILURE:
+      default:
+        // Abort
+        LOG_TRACE("Abort Transaction");
+        p_status.m_result = txn_manager.AbortTransaction(txn);
+        if (single_statement_txn == false) {
+          GetCurrentTxnState().second = ResultType::ABORTED;
+        }
     }
-  } else {
-    // otherwise, we have already aborted
-    p_status.m_result = ResultType::ABORTED;
   }
-  return p_status;
 }
 
 std::shared_ptr<Statement> TrafficCop::PrepareStatement(
@@ -399,11 +528,27 @@ FieldInfo TrafficCop::GetColumnFieldForValueType(
   PostgresValueType field_type;
   size_t field_size;
   switch (column_type) {
+    case type::Type::BOOLEAN: {
+      field_type = PostgresValueType::BOOLEAN;
+      field_size = 1;
+      break;
+    }
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT: {
+      field_type = PostgresValueType::SMALLINT;
+      field_size = 2;
+      break;
+    }
     case type::Type::INTEGER: {
       field_type = PostgresValueType::INTEGER;
       field_size = 4;
       break;
     }
+    case type::Type::BIGINT: {
+      field_type = PostgresValueType::BIGINT;
+      field_size = 8;
+      break;
+    }
     case type::Type::DECIMAL: {
       field_type = PostgresValueType::DOUBLE;
       field_size = 8;
@@ -55,7 +55,7 @@ CmpBool TimestampType::CompareGreaterThan(const Value& left, const Value &right)
   PL_ASSERT(left.CheckComparable(right));
   if (left.IsNull() || right.IsNull())
     return CMP_NULL;
-  return GetCmpBool(left.GetAs<int64_t>() > right.GetAs<int64_t>());
+  return GetCmpBool(left.GetAs<uint64_t>() > right.GetAs<uint64_t>());
 }
 
 CmpBool TimestampType::CompareGreaterThanEquals(const Value& left, const Value &right) const {
@@ -984,6 +984,9 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
     case PlanNodeType::PRINT: {
       return ("PRINT");
     }
+    case PlanNodeType::EXCHANGE: {
+      return ("EXCHANGE");
+    }
     case PlanNodeType::AGGREGATE: {
       return ("AGGREGATE");
     }
@@ -1069,6 +1072,8 @@ PlanNodeType StringToPlanNodeType(const std::string& str) {
     return PlanNodeType::RECEIVE;
   } else if (upper_str == "PRINT") {
     return PlanNodeType::PRINT;
+  } else if (upper_str == "EXCHANGE") {
+    return PlanNodeType::EXCHANGE;
   } else if (upper_str == "AGGREGATE") {
     return PlanNodeType::AGGREGATE;
   } else if (upper_str == "UNION") {
@@ -169,6 +169,12 @@ void StateMachine(LibeventSocket *conn) {
         // examine write packets result
         switch(conn->WritePackets()) {
           case WRITE_COMPLETE: {
+            // The statement that waited for the client goes on
+            if (conn->pkt_manager.IsExecutionBlocked() == true) {
+              conn->pkt_manager.ResumeExecution();
+              break;
+            }
+
             // Input Packet can now be reset, before we parse the next packet
             conn->rpkt.Reset();
             conn->UpdateEvent(EV_READ | EV_PERSIST);
@@ -25,6 +25,11 @@ void LibeventSocket::Init(short event_flags, LibeventThread *thread,
   this->thread = thread;
   this->state = init_state;
 
+  // stream long results out while the statement is running
+  pkt_manager.flush_responses = [this](bool &write_blocked) {
+    return FlushPackets(write_blocked);
+  };
+
   // clear out packet
   rpkt.Reset();
   if (event == nullptr) {
@@ -193,6 +198,23 @@ WriteState LibeventSocket::WritePackets() {
   return WRITE_COMPLETE;
 }
 
+bool LibeventSocket::FlushPackets(bool &write_blocked) {
+  pkt_manager.force_flush = true;
+  switch (WritePackets()) {
+    case WRITE_COMPLETE:
+      write_blocked = false;
+      return true;
+    case WRITE_NOT_READY:
+      // The socket now waits for EV_WRITE, the rest of the packets is
+      // written from the event loop
+      write_blocked = true;
+      return true;
+    case WRITE_ERROR:
+    default:
+      return false;
+  }
+}
+
 ReadState LibeventSocket::FillReadBuffer() {
   ReadState result = READ_NO_DATA_RECEIVED;
   ssize_t bytes_read = 0;
@@ -15,7 +15,9 @@
 #include <iterator>
 #include "wire/marshal.h"
 #include "common/macros.h"
+#include "type/value.h"
 
+#include <endian.h>
 #include <netinet/in.h>
 
 namespace peloton {
@@ -162,5 +164,181 @@ void PacketPutCbytes(OutputPacket *pkt, const uchar *b, int len) {
   pkt->len += len;
 }
 
+// length of a NULL value
+#define NULL_VALUE_LENGTH -1
+
+// microseconds in a day
+#define USECS_PER_DAY 86400000000LL
+
+// days from 1970-01-01 to 2000-01-01, the epoch of Postgres timestamps
+#define POSTGRES_EPOCH_DAY 10957
+
+/* Put the length of a value followed by its bytes */
+static void PacketPutField(OutputPacket *pkt, const char *data, int len) {
+  PacketPutInt(pkt, len, 4);
+  PacketPutCbytes(pkt, reinterpret_cast<const uchar *>(data), len);
+}
+
+/* Format an integer as text, returns the number of characters written */
+static int FormatInteger(int64_t n, char *buf) {
+  char digits[20];
+  int digit_count = 0;
+  uint64_t u = (n < 0) ? -static_cast<uint64_t>(n) : n;
+  do {
+    digits[digit_count++] = '0' + (u % 10);
+    u /= 10;
+  } while (u != 0);
+
+  int len = 0;
+  if (n < 0) buf[len++] = '-';
+  while (digit_count > 0) buf[len++] = digits[--digit_count];
+  return len;
+}
+
+/* Convert a timestamp to microseconds since the Postgres epoch in UTC, which
+ * is what the binary format of a timestamp carries. Timestamps are packed as
+ * month, day, time zone, year, seconds of the day and microseconds (see
+ * TimestampType::ToString), the time zone being an hour offset from UTC. */
+static int64_t ConvertTimestamp(uint64_t tm) {
+  int64_t micro = tm % 1000000;
+  tm /= 1000000;
+  int64_t second = tm % 100000;
+  tm /= 100000;
+  int64_t year = tm % 10000;
+  tm /= 10000;
+  int64_t zone = static_cast<int64_t>(tm % 27) - 12;
+  tm /= 27;
+  int64_t day = tm % 32;
+  tm /= 32;
+  int64_t month = tm;
+
+  // days since 1970-01-01 of the civil date
+  year -= (month <= 2);
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t year_of_era = year - era * 400;
+  int64_t day_of_year =
+      (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t day_of_era = year_of_era * 365 + year_of_era / 4 -
+                       year_of_era / 100 + day_of_year;
+  int64_t days = era * 146097 + day_of_era - 719468;
+
+  return (days - POSTGRES_EPOCH_DAY) * USECS_PER_DAY +
+         (second - zone * 3600) * 1000000 + micro;
+}
+
+bool HasBinaryFormat(PostgresValueType type) {
+  switch (type) {
+    case PostgresValueType::BOOLEAN:
+    case PostgresValueType::SMALLINT:
+    case PostgresValueType::INTEGER:
+    case PostgresValueType::BIGINT:
+    case PostgresValueType::DOUBLE:
+    case PostgresValueType::TEXT:
+    case PostgresValueType::VARCHAR:
+    case PostgresValueType::VARCHAR2:
+    case PostgresValueType::BPCHAR:
+    case PostgresValueType::VARBINARY:
+    case PostgresValueType::TIMESTAMPS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void PacketPutValue(OutputPacket *pkt, const type::Value &value, int format) {
+  if (value.IsNull()) {
+    PacketPutInt(pkt, NULL_VALUE_LENGTH, 4);
+    return;
+  }
+
+  auto type_id = value.GetTypeId();
+
+  // Strings are the same in text and binary, send them straight from storage
+  if (type_id == type::Type::VARCHAR || type_id == type::Type::VARBINARY) {
+    uint32_t len = value.GetLength();
+    if (len != type::PELOTON_VARCHAR_MAX_LEN) {
+      // varchars are stored with their null terminator
+      if (type_id == type::Type::VARCHAR && len > 0) len--;
+      PacketPutField(pkt, value.GetData(), len);
+      return;
+    }
+  }
+
+  if (format == 1) {
+    switch (type_id) {
+      case type::Type::BOOLEAN: {
+        char val = value.IsTrue() ? 1 : 0;
+        PacketPutField(pkt, &val, 1);
+        return;
+      }
+      case type::Type::TINYINT:
+      case type::Type::SMALLINT: {
+        // there is no one byte integer in Postgres, send it as an int2
+        int16_t val = (type_id == type::Type::TINYINT)
+                          ? value.GetAs<int8_t>()
+                          : value.GetAs<int16_t>();
+        val = htons(val);
+        PacketPutField(pkt, reinterpret_cast<char *>(&val), sizeof(val));
+        return;
+      }
+      case type::Type::INTEGER: {
+        int32_t val = htonl(value.GetAs<int32_t>());
+        PacketPutField(pkt, reinterpret_cast<char *>(&val), sizeof(val));
+        return;
+      }
+      case type::Type::BIGINT: {
+        int64_t val = htobe64(value.GetAs<int64_t>());
+        PacketPutField(pkt, reinterpret_cast<char *>(&val), sizeof(val));
+        return;
+      }
+      case type::Type::DECIMAL: {
+        // sent as a float8
+        double decimal = value.GetAs<double>();
+        uint64_t val;
+        PL_MEMCPY(&val, &decimal, sizeof(val));
+        val = htobe64(val);
+        PacketPutField(pkt, reinterpret_cast<char *>(&val), sizeof(val));
+        return;
+      }
+      case type::Type::TIMESTAMP: {
+        int64_t val = htobe64(ConvertTimestamp(value.GetAs<uint64_t>()));
+        PacketPutField(pkt, reinterpret_cast<char *>(&val), sizeof(val));
+        return;
+      }
+      default:
+        // no binary representation, the Bind already advertised these
+        // columns as text (see HasBinaryFormat)
+        break;
+    }
+  }
+
+  char buf[512];
+  switch (type_id) {
+    case type::Type::TINYINT:
+      PacketPutField(pkt, buf, FormatInteger(value.GetAs<int8_t>(), buf));
+      return;
+    case type::Type::SMALLINT:
+      PacketPutField(pkt, buf, FormatInteger(value.GetAs<int16_t>(), buf));
+      return;
+    case type::Type::INTEGER:
+      PacketPutField(pkt, buf, FormatInteger(value.GetAs<int32_t>(), buf));
+      return;
+    case type::Type::BIGINT:
+      PacketPutField(pkt, buf, FormatInteger(value.GetAs<int64_t>(), buf));
+      return;
+    case type::Type::DECIMAL: {
+      // same as std::to_string
+      int len = snprintf(buf, sizeof(buf), "%f", value.GetAs<double>());
+      PacketPutField(pkt, buf, std::min(len, (int)sizeof(buf) - 1));
+      return;
+    }
+    default: {
+      auto str = value.ToString();
+      PacketPutField(pkt, str.data(), str.size());
+      return;
+    }
+  }
+}
+
 }  // end wire
 }  // end peloton
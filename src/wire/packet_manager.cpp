@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 #include "wire/packet_manager.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <cstdio>
 #include <unordered_map>
@@ -76,6 +77,12 @@ PacketManager::~PacketManager() {
     LOG_DEBUG("Removed PacketManager [count=%d]",
               (int)PacketManager::packet_managers_.size());
   }
+
+  // End the txns of suspended portals
+  for (auto &entry : portals_) {
+    ClosePortal(entry.second);
+  }
+  ClosePortal(blocked_portal_);
 }
 
 void PacketManager::InvalidatePreparedStatements(oid_t table_id) {
@@ -183,14 +190,16 @@ bool PacketManager::ProcessStartupPacket(InputPacket *pkt) {
 }
 
 void PacketManager::PutTupleDescriptor(
-    const std::vector<FieldInfo> &tuple_descriptor) {
+    const std::vector<FieldInfo> &tuple_descriptor,
+    const std::vector<int> &result_format) {
   if (tuple_descriptor.empty()) return;
 
   std::unique_ptr<OutputPacket> pkt(new OutputPacket());
   pkt->msg_type = NetworkMessageType::ROW_DESCRIPTION;
   PacketPutInt(pkt.get(), tuple_descriptor.size(), 2);
 
-  for (auto col : tuple_descriptor) {
+  for (size_t col_idx = 0; col_idx < tuple_descriptor.size(); col_idx++) {
+    auto &col = tuple_descriptor[col_idx];
     PacketPutString(pkt.get(), std::get<0>(col));
     // TODO: Table Oid (int32)
     PacketPutInt(pkt.get(), 0, 4);
@@ -202,39 +211,34 @@ void PacketManager::PutTupleDescriptor(
     PacketPutInt(pkt.get(), std::get<2>(col), 2);
     // Type modifier (int32)
     PacketPutInt(pkt.get(), -1, 4);
-    // Format code for text
-    PacketPutInt(pkt.get(), 0, 2);
+    // Format code, text unless binary was requested
+    PacketPutInt(pkt.get(),
+                 (col_idx < result_format.size()) ? result_format[col_idx] : 0,
+                 2);
   }
   responses.push_back(std::move(pkt));
 }
 
-void PacketManager::SendDataRows(std::vector<StatementResult> &results,
-                                 int colcount, int &rows_affected) {
-  if (results.empty() || colcount == 0) return;
-
-  size_t numrows = results.size() / colcount;
+void PacketManager::SendDataRows(executor::LogicalTile &tile,
+                                 const std::vector<oid_t> &rows,
+                                 const std::vector<int> &result_format) {
+  int colcount = tile.GetColumnCount();
+  size_t row_size = 0;
 
   // 1 packet per row
-  for (size_t i = 0; i < numrows; i++) {
+  for (auto tuple_id : rows) {
     std::unique_ptr<OutputPacket> pkt(new OutputPacket());
     pkt->msg_type = NetworkMessageType::DATA_ROW;
+    // rows of a tile tend to have similar sizes
+    pkt->buf.reserve(row_size);
     PacketPutInt(pkt.get(), colcount, 2);
     for (int j = 0; j < colcount; j++) {
-      auto content = results[i * colcount + j].second;
-      if (content.size() == 0) {
-        // content is NULL
-        PacketPutInt(pkt.get(), NULL_CONTENT_SIZE, 4);
-        // no value bytes follow
-      } else {
-        // length of the row attribute
-        PacketPutInt(pkt.get(), content.size(), 4);
-        // contents of the row attribute
-        PacketPutBytes(pkt.get(), content);
-      }
+      int format = (j < (int)result_format.size()) ? result_format[j] : 0;
+      PacketPutValue(pkt.get(), tile.GetValue(tuple_id, j), format);
     }
+    row_size = pkt->buf.size();
     responses.push_back(std::move(pkt));
   }
-  rows_affected = numrows;
 }
 
 void PacketManager::CompleteCommand(const std::string &query_type, int rows) {
@@ -273,6 +277,106 @@ void PacketManager::SendEmptyQueryResponse() {
   responses.push_back(std::move(response));
 }
 
+void PacketManager::SendPortalSuspended() {
+  std::unique_ptr<OutputPacket> response(new OutputPacket());
+  response->msg_type = NetworkMessageType::PORTAL_SUSPENDED;
+  responses.push_back(std::move(response));
+}
+
+ResultType PacketManager::ExecutePortal(Portal &portal,
+                                        const std::vector<int> &result_format,
+                                        const size_t max_rows, bool &suspended,
+                                        bool &blocked, int &rows_affected,
+                                        std::string &error_message) {
+  // Only queries with a tuple descriptor send rows back
+  bool send_rows = !portal.GetStatement()->GetTupleDescriptor().empty();
+  int rows_sent = 0;
+  bool write_blocked = false;
+
+  auto status = traffic_cop_->ExecutePortal(
+      portal, result_format, max_rows,
+      [this, send_rows, &result_format, &rows_sent, &write_blocked](
+          executor::LogicalTile &tile, const std::vector<oid_t> &rows) {
+        if (send_rows == false) return true;
+        SendDataRows(tile, rows, result_format);
+        rows_sent += rows.size();
+
+        // Write the rows out now rather than after the whole result
+        if (flush_responses == nullptr) return true;
+        return flush_responses(write_blocked);
+      },
+      suspended, rows_affected, error_message,
+      // Produce no more rows than the socket takes, the rest waits
+      [&write_blocked]() { return write_blocked; });
+
+  // Suspended short of the row limit, the client has to catch up first
+  blocked = (suspended == true && write_blocked == true &&
+             (max_rows == 0 || static_cast<size_t>(rows_sent) < max_rows));
+
+  // Report the rows sent to the client for queries that return rows
+  if (send_rows == true) rows_affected = rows_sent;
+  return status;
+}
+
+void PacketManager::BlockExecution(std::shared_ptr<Portal> portal,
+                                   const std::vector<int> &result_format,
+                                   const size_t max_rows,
+                                   const bool simple_query,
+                                   const int rows_sent) {
+  LOG_TRACE("Portal %s waits for the client", portal->portal_name_.c_str());
+  blocked_portal_ = portal;
+  blocked_result_format_ = result_format;
+  blocked_max_rows_ = max_rows;
+  blocked_simple_query_ = simple_query;
+  blocked_rows_sent_ = rows_sent;
+}
+
+void PacketManager::ResumeExecution() {
+  PL_ASSERT(blocked_portal_ != nullptr);
+  std::shared_ptr<Portal> portal = std::move(blocked_portal_);
+  blocked_portal_.reset();
+
+  std::string error_message;
+  int rows_affected = 0;
+  bool suspended = false, blocked = false;
+  auto status = ExecutePortal(*portal, blocked_result_format_,
+                              blocked_max_rows_, suspended, blocked,
+                              rows_affected, error_message);
+
+  // Count the rows sent before the portal was blocked as well
+  int rows_sent = blocked_rows_sent_ + rows_affected;
+  if (blocked == true) {
+    size_t max_rows = (blocked_max_rows_ == 0)
+                          ? 0
+                          : blocked_max_rows_ - rows_affected;
+    BlockExecution(portal, blocked_result_format_, max_rows,
+                   blocked_simple_query_, rows_sent);
+    return;
+  }
+
+  if (blocked_simple_query_ == true) {
+    // the responses to a simple query message are sent right away
+    force_flush = true;
+    if (FinishSimpleQuery(simple_queries_[next_simple_query_], status,
+                          rows_sent, error_message) == true) {
+      next_simple_query_++;
+      ExecSimpleQueries();
+    } else {
+      simple_queries_.clear();
+      SendReadyForQuery(NetworkTransactionStateType::IDLE);
+    }
+  } else {
+    FinishExecute(portal->GetStatement()->GetQueryType(), status, suspended,
+                  rows_sent, error_message);
+  }
+}
+
+void PacketManager::ClosePortal(std::shared_ptr<Portal> &portal) {
+  if (portal.get() != nullptr) {
+    traffic_cop_->ClosePortal(*portal);
+  }
+}
+
 bool PacketManager::HardcodedExecuteFilter(std::string query_type) {
   // Skip SET
   if (query_type.compare("SET") == 0 || query_type.compare("SHOW") == 0)
@@ -307,44 +411,59 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt) {
     return;
   }
 
-  for (auto query : queries) {
-    // iterate till before the empty string after the last ';'
-    if (query != queries.back()) {
-      if (query.empty()) {
-        SendEmptyQueryResponse();
-        SendReadyForQuery(NetworkTransactionStateType::IDLE);
-        return;
-      }
+  simple_queries_ = std::move(queries);
+  next_simple_query_ = 0;
+  ExecSimpleQueries();
+}
 
-      std::vector<StatementResult> result;
-      std::vector<FieldInfo> tuple_descriptor;
-      std::string error_message;
-      int rows_affected;
-
-      // execute the query using tcop
-      auto status = traffic_cop_->ExecuteStatement(
-          query, result, tuple_descriptor, rows_affected, error_message);
-
-      // check status
-      if (status == ResultType::FAILURE) {
-        SendErrorResponse(
-            {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
-        break;
-      }
+void PacketManager::ExecSimpleQueries() {
+  // iterate till before the empty string after the last ';'
+  for (; next_simple_query_ + 1 < simple_queries_.size();
+       next_simple_query_++) {
+    auto &query = simple_queries_[next_simple_query_];
+    if (query.empty()) {
+      simple_queries_.clear();
+      SendEmptyQueryResponse();
+      SendReadyForQuery(NetworkTransactionStateType::IDLE);
+      return;
+    }
 
-      // send the attribute names
-      PutTupleDescriptor(tuple_descriptor);
+    std::string error_message;
+    int rows_affected = 0;
+
+    // prepare the query using tcop
+    auto statement =
+        traffic_cop_->PrepareStatement("unnamed", query, error_message);
+    if (statement.get() == nullptr) {
+      SendErrorResponse(
+          {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
+      break;
+    }
 
-      // send the result rows
-      SendDataRows(result, tuple_descriptor.size(), rows_affected);
+    // send the attribute names
+    auto tuple_descriptor = statement->GetTupleDescriptor();
+    PutTupleDescriptor(tuple_descriptor);
+
+    // execute the query, sending the result rows as they are produced
+    std::shared_ptr<Portal> portal(
+        new Portal("", statement, std::vector<type::Value>(), nullptr));
+    std::vector<int> result_format(tuple_descriptor.size(), 0);
+    bool suspended = false, blocked = false;
+    auto status = ExecutePortal(*portal, result_format, 0, suspended, blocked,
+                                rows_affected, error_message);
+
+    // the rest of the queries run once the client has caught up
+    if (blocked == true) {
+      BlockExecution(portal, result_format, 0, true, rows_affected);
+      return;
+    }
 
-      // TODO: should change to query_type
-      CompleteCommand(query, rows_affected);
-    } else if (queries.size() == 1) {
-      // just a ';' sent
-      SendEmptyQueryResponse();
+    if (FinishSimpleQuery(query, status, rows_affected, error_message) ==
+        false) {
+      break;
     }
   }
+  simple_queries_.clear();
 
   // PAVLO: 2017-01-15
   // There used to be code here that would invoke this method passing
@@ -355,6 +474,21 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt) {
   SendReadyForQuery(NetworkTransactionStateType::IDLE);
 }
 
+bool PacketManager::FinishSimpleQuery(const std::string &query,
+                                      ResultType status, int rows_affected,
+                                      const std::string &error_message) {
+  // check status
+  if (status == ResultType::FAILURE) {
+    SendErrorResponse(
+        {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
+    return false;
+  }
+
+  // TODO: should change to query_type
+  CompleteCommand(query, rows_affected);
+  return true;
+}
+
 /*
  * exec_parse_message - handle PARSE message
  */
@@ -559,6 +693,18 @@ void PacketManager::ExecBindMessage(InputPacket *pkt) {
     }
   }
 
+  // Columns without a binary representation are sent, and described, as text
+  const auto &tuple_descriptor = statement->GetTupleDescriptor();
+  for (size_t column_idx = 0;
+       column_idx < std::min(result_format_.size(), tuple_descriptor.size());
+       ++column_idx) {
+    if (result_format_[column_idx] == 1 &&
+        HasBinaryFormat(static_cast<PostgresValueType>(
+            std::get<1>(tuple_descriptor[column_idx]))) == false) {
+      result_format_[column_idx] = 0;
+    }
+  }
+
   if (param_values.size() > 0) {
     statement->GetPlanTree()->SetParameterValues(&param_values);
     // Instead of tree traversal, we should put param values in the
@@ -592,6 +738,7 @@ void PacketManager::ExecBindMessage(InputPacket *pkt) {
   auto itr = portals_.find(portal_name);
   // Found portal name in portal map
   if (itr != portals_.end()) {
+    ClosePortal(itr->second);
     itr->second = portal_reference;
   }
   // Create a new entry in portal map
@@ -761,7 +908,7 @@ bool PacketManager::ExecDescribeMessage(InputPacket *pkt) {
     }
 
     auto statement = portal->GetStatement();
-    PutTupleDescriptor(statement->GetTupleDescriptor());
+    PutTupleDescriptor(statement->GetTupleDescriptor(), result_format_);
   } else {
     LOG_TRACE("Describe a prepared statement");
   }
@@ -770,10 +917,12 @@ bool PacketManager::ExecDescribeMessage(InputPacket *pkt) {
 
 void PacketManager::ExecExecuteMessage(InputPacket *pkt) {
   // EXECUTE message
-  std::vector<StatementResult> results;
   std::string error_message, portal_name;
   int rows_affected = 0;
   GetStringToken(pkt, portal_name);
+  // maximum number of rows to return, 0 for no limit
+  int max_rows = PacketGetInt(pkt, 4);
+  if (max_rows < 0) max_rows = 0;
 
   // covers weird JDBC edge case of sending double BEGIN statements. Don't
   // execute them
@@ -799,7 +948,6 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt) {
   auto statement = portal->GetStatement();
   const auto &query_type = statement->GetQueryType();
 
-  auto param_stat = portal->GetParamStat();
   if (statement.get() == nullptr) {
     LOG_ERROR("Did not find statement in portal : %s", portal_name.c_str());
     SendErrorResponse(
@@ -808,14 +956,25 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt) {
     return;
   }
 
-  auto statement_name = statement->GetStatementName();
-  bool unnamed = statement_name.empty();
-  auto param_values = portal->GetParameters();
+  bool suspended = false, blocked = false;
+  auto status = ExecutePortal(*portal, result_format_, max_rows, suspended,
+                              blocked, rows_affected, error_message);
+
+  // the response is sent once the client has caught up
+  if (blocked == true) {
+    BlockExecution(portal, result_format_,
+                   (max_rows == 0) ? 0 : max_rows - rows_affected, false,
+                   rows_affected);
+    return;
+  }
 
-  auto status = traffic_cop_->ExecuteStatement(
-      statement, param_values, unnamed, param_stat, result_format_, results,
-      rows_affected, error_message);
+  FinishExecute(query_type, status, suspended, rows_affected, error_message);
+}
 
+void PacketManager::FinishExecute(const std::string &query_type,
+                                  ResultType status, bool suspended,
+                                  int rows_affected,
+                                  const std::string &error_message) {
   switch (status) {
     case ResultType::FAILURE:
       LOG_ERROR("Failed to execute: %s", error_message.c_str());
@@ -832,9 +991,12 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt) {
       }
       return;
     default: {
-      auto tuple_descriptor = statement->GetTupleDescriptor();
-      SendDataRows(results, tuple_descriptor.size(), rows_affected);
-      CompleteCommand(query_type, rows_affected);
+      // the rows have already been sent
+      if (suspended == true) {
+        SendPortalSuspended();
+      } else {
+        CompleteCommand(query_type, rows_affected);
+      }
       return;
     }
   }
@@ -861,6 +1023,7 @@ void PacketManager::ExecCloseMessage(InputPacket *pkt) {
       auto portal_itr = portals_.find(name);
       if (portal_itr != portals_.end()) {
         // delete portal if it exists
+        ClosePortal(portal_itr->second);
         portals_.erase(portal_itr);
       }
       break;
@@ -979,7 +1142,13 @@ void PacketManager::Reset() {
 
   statement_cache_.clear();
   table_statement_cache_.clear();
+  for (auto &entry : portals_) {
+    ClosePortal(entry.second);
+  }
   portals_.clear();
+  ClosePortal(blocked_portal_);
+  blocked_portal_.reset();
+  simple_queries_.clear();
   pkt_cntr_ = 0;
 
   traffic_cop_->Reset();
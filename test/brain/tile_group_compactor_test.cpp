@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor_test.cpp
+//
+// Identification: test/brain/tile_group_compactor_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "brain/tile_group_compactor.h"
+#include "catalog/catalog.h"
+#include "catalog/manager.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_tests_util.h"
+#include "configuration/configuration.h"
+#include "gc/gc_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupCompactorTests : public PelotonTest {};
+
+// the keys left in the first two tile groups of 100 tuples
+bool IsKeptKey(int key) { return key >= 200 || key % 100 >= 95; }
+
+TEST_F(TileGroupCompactorTests, CompactTest) {
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  size_t epoch = epoch_manager.GetCurrentEpoch();
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = ExecutorTestsUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+
+  // 3 tile groups of 100 tuples, the last one being active
+  const int num_key = 250;
+  std::unique_ptr<storage::DataTable> table(TransactionTestsUtil::CreateTable(
+      num_key, "TEST_TABLE", db_id, INVALID_OID, 1234, true));
+  std::vector<oid_t> tile_group_ids = {
+      table->GetTileGroup(0)->GetTileGroupId(),
+      table->GetTileGroup(1)->GetTileGroupId()};
+
+  gc_manager.StartGC();
+
+  // leave 5 tuples in each of the first two tile groups
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  {
+    TransactionScheduler scheduler(1, table.get(), &txn_manager);
+    for (int key = 0; key < num_key; key++) {
+      if (IsKeptKey(key) == false) {
+        scheduler.Txn(0).Delete(key);
+      }
+    }
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+  }
+
+  auto &compactor = brain::TileGroupCompactor::GetInstance();
+  compactor.AddTable(table.get());
+
+  // the deleted versions are collected, the sparse tile groups are retired,
+  // their tuples moved, and they are dropped once collected in turn
+  for (size_t i = 1; i <= 40; ++i) {
+    epoch_manager.Reset(epoch + i);
+    {
+      TransactionScheduler scheduler(1, table.get(), &txn_manager);
+      scheduler.Txn(0).Read(num_key - 1);
+      scheduler.Txn(0).Commit();
+      scheduler.Run();
+    }
+    compactor.Compact();
+    if (i % 10 == 0) {
+      // sleep a while for gc to finish its job
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+  }
+
+  EXPECT_EQ(0, compactor.GetRetiredTileGroupCount());
+
+  // the compacted tile groups are gone
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto tile_group_id : tile_group_ids) {
+    EXPECT_TRUE(manager.GetTileGroup(tile_group_id) == nullptr);
+  }
+
+  // and an empty tile group takes their place in the table
+  EXPECT_EQ(table->GetTileGroup(0)->GetTileGroupId(),
+            table->GetTileGroup(1)->GetTileGroupId());
+  EXPECT_EQ(0, table->GetTileGroup(0)->GetNextTupleSlot());
+  EXPECT_TRUE(table->GetTileGroup(0)->GetTileGroupId() != tile_group_ids[0]);
+
+  // the moved tuples are still reached through the index
+  {
+    TransactionScheduler scheduler(1, table.get(), &txn_manager);
+    for (int key = 0; key < num_key; key++) {
+      scheduler.Txn(0).Read(key);
+    }
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+
+    auto &results = scheduler.schedules[0].results;
+    EXPECT_EQ(num_key, results.size());
+    for (int key = 0; key < num_key; key++) {
+      EXPECT_EQ(IsKeptKey(key) ? 0 : -1, results[key]);
+    }
+  }
+
+  compactor.ClearTables();
+
+  gc_manager.StopGC();
+
+  table.release();
+
+  // DROP!
+  ExecutorTestsUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+}
+
+TEST_F(TileGroupCompactorTests, DropTableTest) {
+  gc::GCManagerFactory::Configure(1);
+  FLAGS_tile_group_compactor = true;
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = ExecutorTestsUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+
+  // the table is registered with the compactor as it is added to the database
+  const int num_key = 250;
+  oid_t table_oid = 5678;
+  auto table = TransactionTestsUtil::CreateTable(num_key, "TEST_TABLE", db_id,
+                                                 table_oid, 1234, true);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  {
+    TransactionScheduler scheduler(1, table, &txn_manager);
+    for (int key = 0; key < num_key; key++) {
+      if (IsKeptKey(key) == false) {
+        scheduler.Txn(0).Delete(key);
+      }
+    }
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+  }
+
+  auto &compactor = brain::TileGroupCompactor::GetInstance();
+  compactor.Compact();
+  EXPECT_LT(0, compactor.GetRetiredTileGroupCount());
+
+  // the compactor forgets the tile groups of a dropped table
+  database->DropTableWithOid(table_oid);
+  EXPECT_EQ(0, compactor.GetRetiredTileGroupCount());
+  compactor.Compact();
+  EXPECT_EQ(0, compactor.GetRetiredTileGroupCount());
+
+  // DROP!
+  ExecutorTestsUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  FLAGS_tile_group_compactor = false;
+  gc::GCManagerFactory::Configure(0);
+}
+
+}  // End test namespace
+}  // End peloton namespace
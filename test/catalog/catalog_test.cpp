@@ -11,11 +11,13 @@
 //===----------------------------------------------------------------------===//
 
 #include <cstdio>
+#include <thread>
 
 #include "gtest/gtest.h"
 #include "common/harness.h"
 #include "common/logger.h"
 #include "catalog/catalog.h"
+#include "catalog/catalog_util.h"
 
 #define CATALOG_DATABASE_NAME "catalog_db"
 #define DATABASE_CATALOG_NAME "database_catalog"
@@ -149,6 +151,86 @@ TEST_F(CatalogTests, DroppingDatabase) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(CatalogTests, CreatingIndexWhileInserting) {
+  auto catalog = catalog::Catalog::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->CreateDatabase("INDEX_DB", txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto id_column = catalog::Column(
+      type::Type::INTEGER, type::Type::GetTypeSize(type::Type::INTEGER),
+      "id", true);
+  auto name_column = catalog::Column(type::Type::VARCHAR, 32, "name", true);
+  std::unique_ptr<catalog::Schema> table_schema(
+      new catalog::Schema({id_column, name_column}));
+  txn = txn_manager.BeginTransaction();
+  catalog->CreateTable("INDEX_DB", "index_table", std::move(table_schema),
+                       txn);
+  txn_manager.CommitTransaction(txn);
+  auto table =
+      catalog->GetDatabaseWithName("INDEX_DB")->GetTableWithName("index_table");
+
+  auto make_tuple = [table](int id, const std::string &name) {
+    std::unique_ptr<storage::Tuple> tuple(
+        new storage::Tuple(table->GetSchema(), true));
+    tuple->SetValue(0, type::ValueFactory::GetIntegerValue(id), nullptr);
+    tuple->SetValue(1, type::ValueFactory::GetVarcharValue(name), nullptr);
+    return tuple;
+  };
+  const int committed_count = 5;
+  for (int id = 0; id < committed_count; id++) {
+    catalog::InsertTuple(table, make_tuple(id, "name_" + std::to_string(id)),
+                         nullptr);
+  }
+
+  // The writer inserts before the index is there and commits while it is
+  // being created
+  auto create_index_across_insert = [&](int id, const std::string &name,
+                                        const std::string &column,
+                                        const std::string &index_name) {
+    auto writer_txn = txn_manager.BeginTransaction();
+    catalog::InsertTuple(table, make_tuple(id, name), writer_txn);
+
+    auto index_count = table->GetIndexCount();
+    ResultType result = ResultType::INVALID;
+    std::thread creator([&] {
+      result = catalog->CreateIndex("INDEX_DB", "index_table", {column},
+                                    index_name, true, IndexType::BWTREE);
+    });
+    while (table->GetIndexCount() == index_count) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    txn_manager.CommitTransaction(writer_txn);
+    creator.join();
+    return result;
+  };
+
+  EXPECT_EQ(ResultType::SUCCESS,
+            create_index_across_insert(committed_count, "name_new", "id",
+                                       "index_table_id"));
+  auto id_index = table->GetIndex(0);
+  for (int id = 0; id <= committed_count; id++) {
+    std::unique_ptr<storage::Tuple> key(
+        new storage::Tuple(id_index->GetKeySchema(), true));
+    key->SetValue(0, type::ValueFactory::GetIntegerValue(id), nullptr);
+    std::vector<ItemPointer *> entries;
+    id_index->ScanKey(key.get(), entries);
+    EXPECT_EQ(1, entries.size());
+  }
+
+  // A unique index is not created over the key the writer inserts twice
+  EXPECT_EQ(ResultType::FAILURE,
+            create_index_across_insert(committed_count + 1, "name_0", "name",
+                                       "index_table_name"));
+  EXPECT_EQ(1, table->GetValidIndexCount());
+
+  txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithName("INDEX_DB", txn);
+  txn_manager.CommitTransaction(txn);
+}
+
 TEST_F(CatalogTests, DroppingCatalog) {
   auto catalog = catalog::Catalog::GetInstance();
   EXPECT_NE(catalog, nullptr);
@@ -16,6 +16,7 @@
 #include "common/macros.h"
 #include "catalog/manager.h"
 #include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_factory.h"
 
@@ -70,5 +71,46 @@ TEST_F(ManagerTests, TransactionTest) {
   // EXPECT_EQ(catalog::Manager::GetInstance().GetCurrentTileGroupId(), 800);
 }
 
+TEST_F(ManagerTests, RetiredTileGroupTest) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  std::vector<catalog::Column> columns(
+      {catalog::Column(type::Type::INTEGER,
+                       type::Type::GetTypeSize(type::Type::INTEGER), "A",
+                       true)});
+  std::vector<catalog::Schema> schemas({catalog::Schema(columns)});
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  column_map[0] = std::make_pair(0, 0);
+
+  oid_t tile_group_id = manager.GetNextTileGroupId();
+  std::shared_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID,
+                                              tile_group_id, nullptr, schemas,
+                                              column_map, 3));
+  std::weak_ptr<storage::TileGroup> tile_group_ref(tile_group);
+  manager.AddTileGroup(tile_group_id, tile_group);
+  tile_group.reset();
+
+  // A transaction looks the tile group up, then it is dropped
+  auto txn = txn_manager.BeginTransaction();
+  auto raw_tile_group = manager.GetTileGroupRaw(tile_group_id);
+  EXPECT_EQ(tile_group_ref.lock().get(), raw_tile_group);
+
+  manager.DropTileGroup(tile_group_id);
+  EXPECT_TRUE(manager.GetTileGroupRaw(tile_group_id) == nullptr);
+  EXPECT_TRUE(manager.GetTileGroup(tile_group_id) == nullptr);
+
+  // It stays alive as long as the transaction runs
+  manager.ReclaimTileGroups();
+  EXPECT_FALSE(tile_group_ref.expired());
+  EXPECT_EQ(tile_group_id, raw_tile_group->GetTileGroupId());
+
+  txn_manager.CommitTransaction(txn);
+
+  manager.ReclaimTileGroups();
+  EXPECT_TRUE(tile_group_ref.expired());
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -24,7 +24,7 @@ namespace test {
 class IsolationLevelTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING};
+    ConcurrencyType::TIMESTAMP_ORDERING, ConcurrencyType::OPTIMISTIC};
 
 void DirtyWriteTest() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
@@ -14,6 +14,8 @@
 
 #include "concurrency/transaction_tests_util.h"
 #include "gc/gc_manager_factory.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 
 namespace peloton {
 
@@ -26,7 +28,7 @@ namespace test {
 class MVCCTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING};
+    ConcurrencyType::TIMESTAMP_ORDERING, ConcurrencyType::OPTIMISTIC};
 
 TEST_F(MVCCTests, SingleThreadVersionChainTest) {
   LOG_INFO("SingleThreadVersionChainTest");
@@ -169,5 +171,56 @@ TEST_F(MVCCTests, VersionChainTest) {
   }
 }
 
+TEST_F(MVCCTests, PruneVersionChainTest) {
+  for (auto protocol : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(
+        protocol, IsolationLevelType::FULL);
+
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable(1));
+
+    for (int value = 1; value <= 3; value++) {
+      TransactionScheduler scheduler(1, table.get(), &txn_manager);
+      scheduler.Txn(0).Update(0, value);
+      scheduler.Txn(0).Commit();
+      scheduler.Run();
+      EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+    }
+
+    // prune the chains with the given dead cid, returns the links cut
+    auto prune = [&txn_manager, &table](cid_t dead_cid) {
+      size_t pruned_count = 0;
+      for (oid_t offset = 0; offset < table->GetTileGroupCount(); offset++) {
+        auto tile_group = table->GetTileGroup(offset);
+        auto tile_group_header = tile_group->GetHeader();
+        for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+             tuple_id++) {
+          if (txn_manager.PruneVersionChain(tile_group_header, tuple_id,
+                                            dead_cid) == true) {
+            pruned_count++;
+          }
+        }
+      }
+      return pruned_count;
+    };
+
+    // the versions may still be observed by a transaction
+    EXPECT_EQ(0U, prune(0));
+
+    // the three versions replaced are unlinked
+    EXPECT_EQ(3U, prune(txn_manager.GetCurrentCommitId()));
+    EXPECT_EQ(0U, prune(txn_manager.GetCurrentCommitId()));
+
+    // the latest version is still read
+    TransactionScheduler scheduler(1, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+    EXPECT_EQ(3, scheduler.schedules[0].results[0]);
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager_test.cpp
+//
+// Identification: test/concurrency/optimistic_transaction_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "concurrency/transaction_tests_util.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Optimistic Transaction Manager Tests
+//===--------------------------------------------------------------------===//
+
+class OptimisticTransactionManagerTests : public PelotonTest {};
+
+TEST_F(OptimisticTransactionManagerTests, ValidationTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::OPTIMISTIC);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  {
+    // A newer reader doesn't block an older writer, as it would in timestamp
+    // ordering
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(1).Read(1);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+  }
+
+  {
+    // A reader whose version got replaced before its commit fails validation
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 2);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(1, scheduler.schedules[0].results[0]);
+  }
+
+  {
+    // and so does a reader whose version is owned by a concurrent writer
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 3);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+  }
+
+  {
+    // A writer can't own a version older than the latest one
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(1).Update(0, 4);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(0, 5);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+  }
+
+  {
+    // Concurrent readers all commit
+    TransactionScheduler scheduler(3, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Read(0);
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Commit();
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    for (auto &schedule : scheduler.schedules) {
+      EXPECT_EQ(ResultType::SUCCESS, schedule.txn_result);
+      EXPECT_EQ(4, schedule.results[0]);
+    }
+  }
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -13,6 +13,8 @@
 
 #include "common/harness.h"
 #include "concurrency/transaction_tests_util.h"
+#include "executor/executor_tests_util.h"
+#include "storage/tile_group_header.h"
 
 namespace peloton {
 
@@ -29,5 +31,98 @@ TEST_F(TimestampOrderingTransactionManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+namespace {
+
+// Check the batch against the per-tuple visibility of every tile group.
+// Returns the number of visible tuples.
+int CheckVisibleBatch(concurrency::Transaction *txn,
+                         storage::DataTable *table) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  int visible_count = 0;
+
+  for (oid_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    std::vector<oid_t> expected;
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (txn_manager.IsVisible(txn, tile_group_header, tuple_id) ==
+          VisibilityType::OK) {
+        expected.push_back(tuple_id);
+      }
+    }
+
+    std::vector<oid_t> visible_tuples;
+    txn_manager.IsVisibleBatch(txn, tile_group_header, 0, active_tuple_count,
+                               visible_tuples);
+    EXPECT_EQ(expected, visible_tuples);
+    visible_count += visible_tuples.size();
+  }
+
+  return visible_count;
+}
+
+}  // namespace
+
+TEST_F(TimestampOrderingTransactionManagerTests, IsVisibleBatchTest) {
+  const int tuples_per_tile_group = 10;
+  const int tuple_count = 25;
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+
+  // began before the tuples got committed
+  auto old_txn = txn_manager.BeginTransaction();
+
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto header_0 = table->GetTileGroup(0)->GetHeader();
+  auto header_2 = table->GetTileGroup(2)->GetHeader();
+  EXPECT_EQ(MAX_CID, header_0->GetAllVisibleCommitId());
+
+  // The first scan publishes the summary of the full tile groups
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(tuple_count, CheckVisibleBatch(txn, table.get()));
+  EXPECT_TRUE(header_0->IsAllVisible(txn->GetBeginCommitId()));
+  EXPECT_FALSE(header_2->IsAllVisible(txn->GetBeginCommitId()));
+  EXPECT_EQ(tuple_count, CheckVisibleBatch(txn, table.get()));
+  txn_manager.CommitTransaction(txn);
+
+  // Readers that began earlier don't take the fast path
+  EXPECT_FALSE(header_0->IsAllVisible(old_txn->GetBeginCommitId()));
+  EXPECT_EQ(0, CheckVisibleBatch(old_txn, table.get()));
+  txn_manager.CommitTransaction(old_txn);
+
+  // Acquiring the ownership of a tuple drops the summary
+  auto owner_txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(txn_manager.PerformRead(
+      owner_txn, ItemPointer(table->GetTileGroup(0)->GetTileGroupId(), 3),
+      true));
+  EXPECT_EQ(MAX_CID, header_0->GetAllVisibleCommitId());
+  EXPECT_EQ(tuple_count, CheckVisibleBatch(owner_txn, table.get()));
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(tuple_count, CheckVisibleBatch(txn, table.get()));
+  EXPECT_FALSE(header_0->IsAllVisible(txn->GetBeginCommitId()));
+  txn_manager.CommitTransaction(txn);
+
+  // and the next scan after the ownership is yielded publishes it again
+  txn_manager.CommitTransaction(owner_txn);
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(tuple_count, CheckVisibleBatch(txn, table.get()));
+  EXPECT_TRUE(header_0->IsAllVisible(txn->GetBeginCommitId()));
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // End test namespace
 }  // End peloton namespace
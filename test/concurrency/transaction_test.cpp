@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <set>
+
 #include "common/harness.h"
 #include "concurrency/transaction_tests_util.h"
 
@@ -25,7 +27,7 @@ namespace test {
 class TransactionTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING
+    ConcurrencyType::TIMESTAMP_ORDERING, ConcurrencyType::OPTIMISTIC
 };
 
 void TransactionTest(concurrency::TransactionManager *txn_manager,
@@ -78,6 +80,73 @@ TEST_F(TransactionTests, ReadonlyTransactionTest) {
   }
 }
 
+TEST_F(TransactionTests, SnapshotReadTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(test_type);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+
+    auto tile_group = table->GetTileGroup(0);
+    auto tile_group_header = tile_group->GetHeader();
+    ItemPointer location(tile_group->GetTileGroupId(), 0);
+    std::string reserved_field(tile_group_header->GetReservedFieldRef(0),
+                               storage::TileGroupHeader::GetReservedSize());
+
+    auto txn = txn_manager.BeginReadonlyTransaction();
+    EXPECT_TRUE(txn->IsDeclaredReadOnly());
+    EXPECT_TRUE(txn->GetGCSetPtr() == nullptr);
+    EXPECT_TRUE(txn->IsGCSetEmpty());
+
+    // Reads are neither recorded nor stamped in the tuple headers
+    EXPECT_TRUE(txn_manager.PerformRead(txn, location));
+    EXPECT_TRUE(txn->GetReadWriteSet().IsEmpty());
+    EXPECT_EQ(INITIAL_TXN_ID, tile_group_header->GetTransactionId(0));
+    EXPECT_EQ(reserved_field,
+              std::string(tile_group_header->GetReservedFieldRef(0),
+                          storage::TileGroupHeader::GetReservedSize()));
+
+    // so a concurrent writer is not held back by them
+    auto writer_txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(txn_manager.PerformRead(writer_txn, location, true));
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(writer_txn));
+
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  }
+}
+
+TEST_F(TransactionTests, RecycleTest) {
+  auto txn = concurrency::Transaction::Allocate(1, 1);
+  txn->RecordRead(ItemPointer(1, 1));
+  txn->RecordInsert(ItemPointer(1, 2));
+  txn->GetGCSetPtr()->Insert(1, 3, RW_TYPE_UPDATE);
+  txn->SetResult(ResultType::ABORTED);
+  auto gc_set = txn->GetGCSetPtr();
+  concurrency::Transaction::Free(txn);
+
+  // The thread gets the same transaction back, emptied
+  auto recycled_txn = concurrency::Transaction::Allocate(2, 2);
+  EXPECT_EQ(txn, recycled_txn);
+  EXPECT_EQ(2, recycled_txn->GetTransactionId());
+  EXPECT_EQ(ResultType::SUCCESS, recycled_txn->GetResult());
+  EXPECT_TRUE(recycled_txn->GetReadWriteSet().IsEmpty());
+  EXPECT_TRUE(recycled_txn->IsReadOnly());
+
+  // a GC set still held by someone else is not reused
+  EXPECT_TRUE(recycled_txn->IsGCSetEmpty());
+  EXPECT_NE(gc_set, recycled_txn->GetGCSetPtr());
+  EXPECT_EQ(1, gc_set->GetSize());
+  gc_set.reset();
+
+  concurrency::Transaction::Free(recycled_txn);
+  recycled_txn = concurrency::Transaction::Allocate(3, 3);
+  auto reused_gc_set = recycled_txn->GetGCSetPtr().get();
+  concurrency::Transaction::Free(recycled_txn);
+  recycled_txn = concurrency::Transaction::Allocate(4, 4);
+  EXPECT_EQ(reused_gc_set, recycled_txn->GetGCSetPtr().get());
+  concurrency::Transaction::Free(recycled_txn);
+}
+
 TEST_F(TransactionTests, SingleTransactionTest) {
   for (auto test_type : TEST_TYPES) {
     concurrency::TransactionManagerFactory::Configure(test_type);
@@ -230,5 +299,50 @@ TEST_F(TransactionTests, AbortTest) {
   }
 }
 
+void TakeCommitIds(concurrency::TransactionManager *txn_manager,
+                   std::vector<std::vector<cid_t>> *commit_ids,
+                   uint64_t thread_itr) {
+  for (int cid_itr = 0; cid_itr < 200; cid_itr++) {
+    (*commit_ids)[thread_itr].push_back(txn_manager->GetNextCommitId());
+  }
+}
+
+TEST_F(TransactionTests, BatchedTimestampTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING, IsolationLevelType::FULL,
+      TimestampType::EPOCH_BATCHED);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // Commit ids are unique, and grow on every thread
+  const uint64_t thread_count = 8;
+  std::vector<std::vector<cid_t>> commit_ids(thread_count);
+  LaunchParallelTest(thread_count, TakeCommitIds, &txn_manager, &commit_ids);
+
+  std::set<cid_t> all_commit_ids;
+  for (auto &thread_commit_ids : commit_ids) {
+    for (size_t cid_itr = 1; cid_itr < thread_commit_ids.size(); cid_itr++) {
+      EXPECT_LT(thread_commit_ids[cid_itr - 1], thread_commit_ids[cid_itr]);
+    }
+    all_commit_ids.insert(thread_commit_ids.begin(), thread_commit_ids.end());
+  }
+  EXPECT_EQ(thread_count * 200, all_commit_ids.size());
+
+  // Once the epoch advances, a worker gets a commit id larger than any
+  // handed out before
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto epoch = epoch_manager.GetCurrentEpoch();
+  auto global_cid = txn_manager.GetCurrentCommitId();
+  epoch_manager.Reset(epoch + 1);
+  EXPECT_LE(global_cid, txn_manager.GetNextCommitId());
+  epoch_manager.Reset(epoch);
+
+  // Transactions still run
+  LaunchParallelTest(8, TransactionTest, &txn_manager);
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+  EXPECT_EQ(TimestampType::CENTRALIZED, txn_manager.GetTimestampType());
+}
+
 }  // End test namespace
 }  // End peloton namespace
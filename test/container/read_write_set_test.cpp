@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set_test.cpp
+//
+// Identification: test/container/read_write_set_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "container/read_write_set.h"
+
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// ReadWriteSet Test
+//===--------------------------------------------------------------------===//
+
+class ReadWriteSetTests : public PelotonTest {};
+
+TEST_F(ReadWriteSetTests, BasicTest) {
+  ReadWriteSet rw_set;
+  EXPECT_TRUE(rw_set.IsEmpty());
+  EXPECT_TRUE(rw_set.Find(1, 2) == nullptr);
+
+  rw_set.Insert(1, 2, RW_TYPE_READ);
+  rw_set.Insert(2, 1, RW_TYPE_INSERT);
+  EXPECT_EQ(2, rw_set.GetSize());
+  EXPECT_EQ(RW_TYPE_READ, *rw_set.Find(1, 2));
+  EXPECT_EQ(RW_TYPE_INSERT, *rw_set.Find(2, 1));
+  EXPECT_TRUE(rw_set.Find(2, 2) == nullptr);
+
+  // the type can be changed in place
+  *rw_set.Find(1, 2) = RW_TYPE_UPDATE;
+  rw_set.Set(2, 1, RW_TYPE_INS_DEL);
+  rw_set.Set(3, 3, RW_TYPE_DELETE);
+  EXPECT_EQ(3, rw_set.GetSize());
+  EXPECT_EQ(RW_TYPE_UPDATE, *rw_set.Find(1, 2));
+  EXPECT_EQ(RW_TYPE_INS_DEL, *rw_set.Find(2, 1));
+  EXPECT_EQ(RW_TYPE_DELETE, *rw_set.Find(3, 3));
+
+  rw_set.Clear();
+  EXPECT_TRUE(rw_set.IsEmpty());
+  EXPECT_TRUE(rw_set.Find(1, 2) == nullptr);
+}
+
+TEST_F(ReadWriteSetTests, IndexTest) {
+  // well beyond the inline entries and the initial capacity
+  const oid_t tile_group_count = 10;
+  const oid_t tuple_count = 100;
+
+  ReadWriteSet rw_set;
+  for (int round = 0; round < 2; round++) {
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      for (oid_t tile_group_id = 0; tile_group_id < tile_group_count;
+           tile_group_id++) {
+        rw_set.Insert(tile_group_id, tuple_id,
+                      (tuple_id % 2 == 0) ? RW_TYPE_READ : RW_TYPE_UPDATE);
+      }
+    }
+    EXPECT_EQ(tile_group_count * tuple_count, rw_set.GetSize());
+
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      for (oid_t tile_group_id = 0; tile_group_id < tile_group_count;
+           tile_group_id++) {
+        auto type = rw_set.Find(tile_group_id, tuple_id);
+        EXPECT_TRUE(type != nullptr);
+        EXPECT_EQ((tuple_id % 2 == 0) ? RW_TYPE_READ : RW_TYPE_UPDATE, *type);
+      }
+    }
+    EXPECT_TRUE(rw_set.Find(tile_group_count, 0) == nullptr);
+
+    // the entries are iterated in the order they were added
+    size_t entry_itr = 0;
+    for (auto &entry : rw_set) {
+      EXPECT_EQ(entry_itr % tile_group_count, entry.tile_group_id);
+      EXPECT_EQ(entry_itr / tile_group_count, entry.tuple_id);
+      entry_itr++;
+    }
+
+    // a cleared set is filled again
+    rw_set.Clear();
+    EXPECT_TRUE(rw_set.Find(0, 0) == nullptr);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// sharded_counter_test.cpp
+//
+// Identification: test/container/sharded_counter_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "container/sharded_counter.h"
+
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// ShardedCounter Test
+//===--------------------------------------------------------------------===//
+
+class ShardedCounterTests : public PelotonTest {};
+
+void UpdateCounter(ShardedCounter *counter, int64_t update_count,
+                   uint64_t thread_itr) {
+  for (int64_t update_itr = 0; update_itr < update_count; update_itr++) {
+    counter->Add(2);
+    // some threads take back what others added
+    if (thread_itr % 2 == 1) {
+      counter->Subtract(1);
+    }
+  }
+}
+
+TEST_F(ShardedCounterTests, BasicTest) {
+  ShardedCounter counter;
+  EXPECT_EQ(0, counter.Get());
+
+  counter.Add(5);
+  counter.Subtract(2);
+  EXPECT_EQ(3, counter.Get());
+
+  counter.Set(10);
+  EXPECT_EQ(10, counter.Get());
+}
+
+TEST_F(ShardedCounterTests, MultiThreadTest) {
+  const int64_t update_count = 10000;
+  // more threads than shards
+  const uint64_t thread_count = ShardedCounter::shard_count + 4;
+
+  ShardedCounter counter;
+  LaunchParallelTest(thread_count, UpdateCounter, &counter, update_count);
+
+  EXPECT_EQ(update_count * (thread_count / 2 * 2 + thread_count / 2),
+            counter.Get());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
@@ -17,6 +18,9 @@
 
 #include "common/harness.h"
 
+#include "common/init.h"
+#include "common/thread_pool.h"
+
 #include "type/types.h"
 #include "type/value.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -24,10 +28,12 @@
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
+#include "executor/partitioned_aggregator.h"
 #include "expression/expression_util.h"
 #include "planner/abstract_plan.h"
 #include "planner/aggregate_plan.h"
 #include "storage/data_table.h"
+#include "storage/table_factory.h"
 
 #include "executor/executor_tests_util.h"
 #include "executor/mock_executor.h"
@@ -863,5 +869,128 @@ TEST_F(AggregateTests, PlainSumCountDistinctTest) {
   EXPECT_TRUE(cmp == type::CMP_TRUE);
 }
 
+namespace {
+
+// Rows of the output table of an aggregation, sorted
+std::vector<std::string> GetSortedRows(storage::AbstractTable *table) {
+  std::vector<std::string> rows;
+  for (oid_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    std::unique_ptr<executor::LogicalTile> tile(
+        executor::LogicalTileFactory::WrapTileGroup(
+            table->GetTileGroup(tile_group_itr)));
+    for (oid_t tuple_id : *tile) {
+      std::string row;
+      for (oid_t column_itr = 0; column_itr < tile->GetColumnCount();
+           column_itr++) {
+        row += tile->GetValue(tuple_id, column_itr).ToString() + "|";
+      }
+      rows.push_back(row);
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+}  // namespace
+
+TEST_F(AggregateTests, PartitionedHashGroupByTest) {
+  // SELECT b, COUNT(*), SUM(a), MIN(a), MAX(a), AVG(a) from table GROUP BY b;
+  const int tuples_per_tile_group = 100;
+  const int tuple_count = 30 * tuples_per_tile_group;
+
+  thread_pool.Initialize(3, 0);
+
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  // b has about tuple_count / 3 distinct values
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, true,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_COUNT_STAR, nullptr);
+  for (auto agg_type :
+       {ExpressionType::AGGREGATE_SUM, ExpressionType::AGGREGATE_MIN,
+        ExpressionType::AGGREGATE_MAX, ExpressionType::AGGREGATE_AVG}) {
+    agg_terms.emplace_back(agg_type,
+                           expression::ExpressionUtil::TupleValueFactory(
+                               type::Type::INTEGER, 0, 0));
+  }
+
+  DirectMapList direct_map_list = {{0, {0, 1}}};
+  for (oid_t aggno = 0; aggno < agg_terms.size(); aggno++) {
+    direct_map_list.push_back({aggno + 1, {1, aggno}});
+  }
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  auto integer_size = type::Type::GetTypeSize(type::Type::INTEGER);
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(
+          {catalog::Column(type::Type::INTEGER, integer_size, "b"),
+           catalog::Column(type::Type::BIGINT,
+                           type::Type::GetTypeSize(type::Type::BIGINT),
+                           "count"),
+           catalog::Column(type::Type::INTEGER, integer_size, "sum"),
+           catalog::Column(type::Type::INTEGER, integer_size, "min"),
+           catalog::Column(type::Type::INTEGER, integer_size, "max"),
+           catalog::Column(type::Type::DECIMAL,
+                           type::Type::GetTypeSize(type::Type::DECIMAL),
+                           "avg")}));
+
+  planner::AggregatePlan node(
+      std::move(proj_info),
+      std::unique_ptr<const expression::AbstractExpression>(nullptr),
+      std::move(agg_terms), std::vector<oid_t>({1}), output_table_schema,
+      AggregateType::HASH);
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> tiles;
+  for (oid_t tile_group_itr = 0;
+       tile_group_itr < data_table->GetTileGroupCount(); tile_group_itr++) {
+    tiles.emplace_back(executor::LogicalTileFactory::WrapTileGroup(
+        data_table->GetTileGroup(tile_group_itr)));
+  }
+  EXPECT_TRUE(executor::PartitionedHashAggregator::IsSupported(
+      &node, tiles[0].get()));
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  auto schema = const_cast<catalog::Schema *>(node.GetOutputSchema());
+
+  // Aggregate with the hash aggregator
+  std::unique_ptr<storage::AbstractTable> expected_table(
+      storage::TableFactory::GetTempTable(schema, false));
+  executor::HashAggregator hash_aggregator(&node, expected_table.get(),
+                                           context.get(), 4);
+  for (auto &tile : tiles) {
+    for (oid_t tuple_id : *tile) {
+      expression::ContainerTuple<executor::LogicalTile> tuple(tile.get(),
+                                                              tuple_id);
+      EXPECT_TRUE(hash_aggregator.Advance(&tuple));
+    }
+  }
+  EXPECT_TRUE(hash_aggregator.Finalize());
+  auto expected = GetSortedRows(expected_table.get());
+  EXPECT_LT(100U, expected.size());
+  EXPECT_GT((size_t)tuple_count, expected.size());
+
+  // Aggregate in parallel, the groups are found by several workers
+  std::unique_ptr<storage::AbstractTable> output_table(
+      storage::TableFactory::GetTempTable(schema, false));
+  executor::PartitionedHashAggregator partitioned_aggregator(
+      &node, output_table.get(), context.get(), 4);
+  EXPECT_TRUE(partitioned_aggregator.AdvanceTiles(tiles));
+  EXPECT_LE(expected.size(), partitioned_aggregator.GetGroupCount());
+  EXPECT_TRUE(partitioned_aggregator.Finalize());
+  EXPECT_EQ(expected, GetSortedRows(output_table.get()));
+
+  txn_manager.CommitTransaction(txn);
+  thread_pool.Shutdown();
+}
+
 }  // namespace test
 }  // namespace peloton
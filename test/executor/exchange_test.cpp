@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_test.cpp
+//
+// Identification: test/executor/exchange_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/init.h"
+#include "common/thread_pool.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/exchange_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Exchange Tests
+//===--------------------------------------------------------------------===//
+
+class ExchangeTests : public PelotonTest {};
+
+namespace {
+
+const int tuples_per_tile_group = 10;
+
+const int tuple_count = 487;
+
+const size_t column_count = 2;
+
+// Rows of the result of the plan, sorted
+std::vector<std::vector<std::string>> ExecuteAndSort(
+    planner::AbstractPlan *plan) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  std::vector<StatementResult> result;
+  std::vector<int> result_format(column_count, 0);
+  auto status = bridge::PlanExecutor::ExecutePlan(
+      plan, txn, std::vector<type::Value>(), result, result_format);
+  EXPECT_EQ(ResultType::SUCCESS, status.m_result);
+  txn_manager.CommitTransaction(txn);
+
+  std::vector<std::vector<std::string>> rows;
+  for (size_t i = 0; i + column_count <= result.size(); i += column_count) {
+    std::vector<std::string> row;
+    for (size_t column = 0; column < column_count; column++) {
+      auto &value = result[i + column].second;
+      row.emplace_back(value.begin(), value.end());
+    }
+    rows.push_back(row);
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+// a >= 10 * lower_bound
+expression::AbstractExpression *CreatePredicate(int lower_bound) {
+  return expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(lower_bound, 0))));
+}
+
+}  // namespace
+
+TEST_F(ExchangeTests, ParallelScanTest) {
+  thread_pool.Initialize(4, 0);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  for (int lower_bound : {-1, 100, tuple_count}) {
+    planner::SeqScanPlan scan_plan(
+        table.get(), lower_bound < 0 ? nullptr : CreatePredicate(lower_bound),
+        {0, 1});
+    auto expected = ExecuteAndSort(&scan_plan);
+    EXPECT_EQ((size_t)(tuple_count - std::max(lower_bound, 0)),
+              expected.size());
+
+    // The exchange returns the same rows, whatever the parallelism
+    for (size_t parallelism : {1, 2, 4, 8}) {
+      planner::ExchangePlan exchange_plan(parallelism);
+      exchange_plan.AddChild(std::unique_ptr<planner::AbstractPlan>(
+          new planner::SeqScanPlan(
+              table.get(),
+              lower_bound < 0 ? nullptr : CreatePredicate(lower_bound),
+              {0, 1})));
+      EXPECT_EQ(expected, ExecuteAndSort(&exchange_plan));
+    }
+  }
+
+  // Stop reading while the workers are still scanning
+  planner::ExchangePlan exchange_plan(4);
+  exchange_plan.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0, 1})));
+  txn = txn_manager.BeginTransaction();
+  {
+    bridge::PlanCursor cursor(&exchange_plan, txn, std::vector<type::Value>(),
+                              std::vector<int>(column_count, 0));
+    EXPECT_TRUE(cursor.Init());
+    std::vector<StatementResult> result;
+    EXPECT_EQ(1U, cursor.FetchRows(1, result));
+  }
+  txn_manager.CommitTransaction(txn);
+
+  thread_pool.Shutdown();
+}
+
+}  // End test namespace
+}  // End peloton namespace
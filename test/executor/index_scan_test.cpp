@@ -10,12 +10,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <memory>
 
 #include "catalog/catalog.h"
 #include "common/harness.h"
 #include "common/logger.h"
 #include "common/statement.h"
+#include "concurrency/transaction_tests_util.h"
 #include "type/types.h"
 #include "type/value_factory.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -27,6 +29,7 @@
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/plan_executor.h"
+#include "index/index_factory.h"
 #include "optimizer/simple_optimizer.h"
 #include "parser/parser.h"
 #include "planner/create_plan.h"
@@ -110,6 +113,72 @@ TEST_F(IndexScanTests, IndexPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Index scan with a limit, pulling the index entries a batch at a time.
+TEST_F(IndexScanTests, LimitBatchTest) {
+  // First, generate the table with index
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 <= 110 LIMIT 2
+  //===--------------------------------------------------------------------===//
+
+  auto index = data_table->GetIndex(0);
+  std::vector<oid_t> key_column_ids;
+  std::vector<ExpressionType> expr_types;
+  std::vector<type::Value> values;
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  key_column_ids.push_back(0);
+  expr_types.push_back(
+      ExpressionType::COMPARE_LESSTHANOREQUALTO);
+  values.push_back(type::ValueFactory::GetIntegerValue(110).Copy());
+
+  // Create index scan desc
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+
+  expression::AbstractExpression *predicate = nullptr;
+
+  // Create plan node.
+  planner::IndexScanPlan node(data_table.get(), predicate, column_ids,
+                              index_scan_desc);
+  node.SetLimit(true);
+  node.SetLimitNumber(2);
+  node.SetLimitOffset(0);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // Run the executor
+  executor::IndexScanExecutor executor(&node, context.get());
+
+  EXPECT_TRUE(executor.Init());
+
+  // The first tile holds no more than the limit
+  EXPECT_TRUE(executor.Execute());
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_THAT(result_tile, NotNull());
+  EXPECT_EQ(2, result_tile->GetTupleCount());
+
+  // The rest of the range is still there for a parent that asks for it
+  size_t tuple_count = result_tile->GetTupleCount();
+  while (executor.Execute()) {
+    result_tile.reset(executor.GetOutput());
+    EXPECT_TRUE(result_tile->GetTupleCount() <= 2);
+    tuple_count += result_tile->GetTupleCount();
+  }
+  EXPECT_EQ(12, tuple_count);
+
+  txn_manager.CommitTransaction(txn);
+}
+
 TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   // First, generate the table with index
   std::unique_ptr<storage::DataTable> data_table(
@@ -173,5 +242,107 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Builds a covering index on the value column of the table of the
+// transaction tests, which includes the id column
+static std::shared_ptr<index::Index> AddCoveringIndex(
+    storage::DataTable *table) {
+  auto tuple_schema = table->GetSchema();
+  std::vector<oid_t> key_attrs = {1};
+  std::vector<oid_t> included_attrs = {0};
+  auto key_schema = index::IndexMetadata::GetCoveringKeySchema(
+      tuple_schema, key_attrs, included_attrs);
+
+  auto index_metadata = new index::IndexMetadata(
+      "covering_index", 1235, INVALID_OID, INVALID_OID, IndexType::BWTREE,
+      IndexConstraintType::DEFAULT, tuple_schema, key_schema, {1, 0}, false,
+      included_attrs.size());
+
+  std::shared_ptr<index::Index> index(
+      index::IndexFactory::GetIndex(index_metadata));
+  table->PopulateIndex(index.get(), 0, table->GetTileGroupCount(), true);
+  table->AddIndex(index);
+  return index;
+}
+
+// Reads the (value, id) pairs of the tuples whose value is at most
+// max_value out of the covering index alone
+static std::vector<std::pair<int, int>> ScanCoveringIndex(
+    concurrency::Transaction *txn, storage::DataTable *table,
+    std::shared_ptr<index::Index> index, int max_value) {
+  std::vector<oid_t> key_column_ids = {1};
+  std::vector<ExpressionType> expr_types = {
+      ExpressionType::COMPARE_LESSTHANOREQUALTO};
+  std::vector<type::Value> values = {
+      type::ValueFactory::GetIntegerValue(max_value).Copy()};
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+  planner::IndexScanPlan node(table, nullptr, {1, 0}, index_scan_desc);
+  node.SetIndexOnly(true);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::IndexScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::pair<int, int>> result;
+  while (executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (auto tuple_id : *result_tile) {
+      result.emplace_back(
+          result_tile->GetValue(tuple_id, 0).GetAs<int32_t>(),
+          result_tile->GetValue(tuple_id, 1).GetAs<int32_t>());
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+// Index-only scans of a covering index see the versions of their snapshot
+TEST_F(IndexScanTests, CoveringIndexTest) {
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable(5));
+  auto index = AddCoveringIndex(table.get());
+  EXPECT_TRUE(index->IsCovering());
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  std::vector<std::pair<int, int>> expected = {
+      {0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4}};
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(expected, ScanCoveringIndex(txn, table.get(), index, 10));
+  txn_manager.CommitTransaction(txn);
+
+  // New versions, a version updated again in place, deletes of committed
+  // and of own versions and an insert
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 1, 5));
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 1, 7));
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 2, 20));
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteDelete(txn, table.get(), 3));
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 4, 3));
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteDelete(txn, table.get(), 4));
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteInsert(txn, table.get(), 5, 1));
+
+  expected = {{0, 0}, {1, 5}, {7, 1}};
+  EXPECT_EQ(expected, ScanCoveringIndex(txn, table.get(), index, 10));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(expected, ScanCoveringIndex(txn, table.get(), index, 10));
+  txn_manager.CommitTransaction(txn);
+
+  // The versions of an aborted transaction are not seen
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 0, 2));
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteInsert(txn, table.get(), 6, 4));
+  txn_manager.AbortTransaction(txn);
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_EQ(expected, ScanCoveringIndex(txn, table.get(), index, 10));
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
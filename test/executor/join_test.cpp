@@ -14,6 +14,8 @@
 
 #include "common/harness.h"
 
+#include "common/container_tuple.h"
+
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "type/types.h"
@@ -23,6 +25,7 @@
 #include "executor/index_scan_executor.h"
 #include "executor/merge_join_executor.h"
 #include "executor/nested_loop_join_executor.h"
+#include "executor/seq_scan_executor.h"
 
 #include "expression/abstract_expression.h"
 #include "expression/expression_util.h"
@@ -33,11 +36,16 @@
 #include "planner/index_scan_plan.h"
 #include "planner/merge_join_plan.h"
 #include "planner/nested_loop_join_plan.h"
+#include "planner/seq_scan_plan.h"
+
+#include "statistics/backend_stats_context.h"
+#include "statistics/stats_aggregator.h"
 
 #include "storage/data_table.h"
 #include "storage/tile.h"
 
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 
 #include "executor/executor_tests_util.h"
 #include "executor/join_tests_util.h"
@@ -219,6 +227,91 @@ TEST_F(JoinTests, BasicNestedLoopTest) {
   ExecuteNestedLoopJoinTest(JoinType::INNER);
 }
 
+TEST_F(JoinTests, BloomFilterPushdownTest) {
+  FLAGS_stats_mode = STATS_TYPE_ENABLE;
+  stats::StatsAggregator::GetInstance(1000000);
+
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+  size_t left_tuple_count = tile_group_size * 10;
+  size_t right_tuple_count = tile_group_size * 2;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  // Left keys are multiples of 10, right keys multiples of 50, so only one
+  // left tuple in five has a match
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateTable(tile_group_size));
+  ExecutorTestsUtil::PopulateTable(left_table.get(), left_tuple_count, false,
+                                   false, false, txn);
+  std::unique_ptr<storage::DataTable> right_table(
+      ExecutorTestsUtil::CreateTable(tile_group_size));
+  PopulateTable(right_table.get(), right_tuple_count, false, txn);
+
+  txn_manager.CommitTransaction(txn);
+
+  auto &table_metric = *stats::BackendStatsContext::GetInstance()
+                            ->GetTableMetric(left_table->GetDatabaseOid(),
+                                             left_table->GetOid());
+  table_metric.Reset();
+
+  for (bool pushdown : {false, true}) {
+    txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+
+    // LEFT.A = RIGHT.A
+    planner::SeqScanPlan left_scan_node(left_table.get(), nullptr, {0, 1});
+    executor::SeqScanExecutor left_scan_executor(&left_scan_node,
+                                                 context.get());
+    planner::SeqScanPlan right_scan_node(right_table.get(), nullptr, {0, 1});
+    executor::SeqScanExecutor right_scan_executor(&right_scan_node,
+                                                  context.get());
+
+    std::vector<std::unique_ptr<const expression::AbstractExpression>>
+        hash_keys;
+    hash_keys.emplace_back(
+        new expression::TupleValueExpression(type::Type::INTEGER, 1, 0));
+    planner::HashPlan hash_plan_node(hash_keys);
+    executor::HashExecutor hash_executor(&hash_plan_node, context.get());
+
+    auto schema = CreateJoinSchema();
+    planner::HashJoinPlan hash_join_plan_node(
+        JoinType::INNER, nullptr, JoinTestsUtil::CreateProjection(), schema,
+        {0});
+    hash_join_plan_node.SetBloomFilterPushdown(pushdown);
+    executor::HashJoinExecutor hash_join_executor(&hash_join_plan_node,
+                                                  context.get());
+
+    hash_join_executor.AddChild(&left_scan_executor);
+    hash_join_executor.AddChild(&hash_executor);
+    hash_executor.AddChild(&right_scan_executor);
+
+    size_t result_tuple_count = 0;
+    EXPECT_TRUE(hash_join_executor.Init());
+    while (hash_join_executor.Execute() == true) {
+      std::unique_ptr<executor::LogicalTile> result_logical_tile(
+          hash_join_executor.GetOutput());
+      result_tuple_count += result_logical_tile->GetTupleCount();
+    }
+    txn_manager.CommitTransaction(txn);
+
+    EXPECT_EQ(right_tuple_count, result_tuple_count);
+  }
+
+  // Only the join with the filter probed it, with every left tuple. All the
+  // matching ones passed, and the filter discarded most of the others
+  EXPECT_EQ((int64_t)left_tuple_count,
+            table_metric.GetBloomFilterProbes().GetCounter());
+  EXPECT_LE((int64_t)right_tuple_count,
+            table_metric.GetBloomFilterPasses().GetCounter());
+  EXPECT_GT((int64_t)left_tuple_count / 2,
+            table_metric.GetBloomFilterPasses().GetCounter());
+  EXPECT_GT(0.5, table_metric.GetBloomFilterPassRate());
+
+  FLAGS_stats_mode = STATS_TYPE_INVALID;
+}
+
 void PopulateTable(storage::DataTable *table, int num_rows, bool random,
                    concurrency::Transaction *current_txn) {
   // Random values
@@ -0,0 +1,177 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cursor_test.cpp
+//
+// Identification: test/executor/plan_cursor_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/portal.h"
+#include "common/statement.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/plan_executor.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "tcop/tcop.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Plan Cursor Tests
+//===--------------------------------------------------------------------===//
+
+class PlanCursorTests : public PelotonTest {};
+
+const int tuples_per_tile_group = 5;
+
+const int tuple_count = 23;
+
+const size_t column_count = 2;
+
+TEST_F(PlanCursorTests, FetchRowsTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  planner::SeqScanPlan plan(table.get(), nullptr, {0, 1});
+  std::vector<type::Value> params;
+  std::vector<int> result_format(column_count, 0);
+
+  // Materialize the whole result
+  txn = txn_manager.BeginTransaction();
+  std::vector<StatementResult> expected;
+  auto status = bridge::PlanExecutor::ExecutePlan(&plan, txn, params, expected,
+                                                  result_format);
+  EXPECT_EQ(ResultType::SUCCESS, status.m_result);
+  EXPECT_EQ(tuple_count * column_count, expected.size());
+
+  // Fetch the same rows a few at a time
+  for (size_t max_rows : {0, 1, 3, 7}) {
+    bridge::PlanCursor cursor(&plan, txn, params, result_format);
+    EXPECT_TRUE(cursor.Init());
+
+    std::vector<StatementResult> result;
+    size_t fetch_count = 0;
+    while (cursor.IsDone() == false) {
+      auto row_count = cursor.FetchRows(max_rows, result);
+      if (max_rows != 0) {
+        EXPECT_LE(row_count, max_rows);
+      }
+      // never more than a logical tile at a time
+      EXPECT_LE(row_count, (size_t)tuples_per_tile_group);
+      fetch_count++;
+    }
+
+    EXPECT_EQ(column_count, cursor.GetColumnCount());
+    EXPECT_EQ(0U, cursor.FetchRows(max_rows, result));
+    EXPECT_GE(fetch_count, (size_t)tuple_count / tuples_per_tile_group);
+    EXPECT_EQ(expected, result);
+  }
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(PlanCursorTests, PortalRowLimitTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::shared_ptr<Statement> statement(
+      new Statement("select", "SELECT a, b FROM test_table"));
+  statement->SetPlanTree(std::shared_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0, 1})));
+
+  Portal portal("portal", statement, std::vector<type::Value>(), nullptr);
+  std::vector<int> result_format(column_count, 0);
+  auto &traffic_cop = tcop::TrafficCop::GetInstance();
+
+  size_t rows_received = 0;
+  auto callback = [&rows_received](executor::LogicalTile &tile,
+                                   const std::vector<oid_t> &rows) {
+    EXPECT_EQ(column_count, tile.GetColumnCount());
+    rows_received += rows.size();
+    return true;
+  };
+
+  // 10 rows per Execute
+  bool suspended = false;
+  int rows_changed = 0;
+  std::string error_message;
+  int execute_count = 0;
+  do {
+    auto status = traffic_cop.ExecutePortal(portal, result_format, 10,
+                                            callback, suspended, rows_changed,
+                                            error_message);
+    EXPECT_EQ(ResultType::SUCCESS, status);
+    execute_count++;
+
+    if (suspended == true) {
+      EXPECT_EQ((size_t)(10 * execute_count), rows_received);
+      EXPECT_TRUE(portal.cursor_ != nullptr);
+    }
+  } while (suspended == true);
+
+  EXPECT_EQ(3, execute_count);
+  EXPECT_EQ((size_t)tuple_count, rows_received);
+  EXPECT_TRUE(portal.cursor_ == nullptr);
+
+  // Close a suspended portal
+  rows_received = 0;
+  traffic_cop.ExecutePortal(portal, result_format, 4, callback, suspended,
+                            rows_changed, error_message);
+  EXPECT_TRUE(suspended);
+  EXPECT_EQ(4U, rows_received);
+  traffic_cop.ClosePortal(portal);
+  EXPECT_TRUE(portal.cursor_ == nullptr);
+
+  // A failed delivery aborts the statement
+  auto failing_callback = [](executor::LogicalTile &,
+                             const std::vector<oid_t> &) { return false; };
+  auto status = traffic_cop.ExecutePortal(portal, result_format, 0,
+                                          failing_callback, suspended,
+                                          rows_changed, error_message);
+  EXPECT_EQ(ResultType::ABORTED, status);
+  EXPECT_FALSE(suspended);
+  EXPECT_TRUE(portal.cursor_ == nullptr);
+
+  // Pausing after each batch suspends the portal a tile at a time
+  auto pause = []() { return true; };
+  rows_received = 0;
+  execute_count = 0;
+  do {
+    size_t rows_before = rows_received;
+    status = traffic_cop.ExecutePortal(portal, result_format, 0, callback,
+                                       suspended, rows_changed, error_message,
+                                       pause);
+    EXPECT_EQ(ResultType::SUCCESS, status);
+    EXPECT_GE((size_t)tuples_per_tile_group, rows_received - rows_before);
+    execute_count++;
+  } while (suspended == true);
+
+  EXPECT_LE(tuple_count / tuples_per_tile_group, execute_count);
+  EXPECT_EQ((size_t)tuple_count, rows_received);
+  EXPECT_TRUE(portal.cursor_ == nullptr);
+}
+
+}  // End test namespace
+}  // End peloton namespace
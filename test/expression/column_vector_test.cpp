@@ -0,0 +1,218 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_vector_test.cpp
+//
+// Identification: test/expression/column_vector_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/container_tuple.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "expression/column_vector.h"
+#include "expression/expression_util.h"
+#include "expression/parameter_value_expression.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "type/value_factory.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Column Vector Tests
+//===--------------------------------------------------------------------===//
+
+class ColumnVectorTests : public PelotonTest {};
+
+namespace {
+
+expression::AbstractExpression *Column(type::Type::TypeId type_id,
+                                       int column_id) {
+  return expression::ExpressionUtil::TupleValueFactory(type_id, 0, column_id);
+}
+
+expression::AbstractExpression *Integer(int32_t value) {
+  return expression::ExpressionUtil::ConstantValueFactory(
+      type::ValueFactory::GetIntegerValue(value));
+}
+
+expression::AbstractExpression *Decimal(double value) {
+  return expression::ExpressionUtil::ConstantValueFactory(
+      type::ValueFactory::GetDecimalValue(value));
+}
+
+/**
+ * Run the predicate batch-at-a-time over every tile group of the table and
+ * check that it selects exactly the tuples for which the scalar evaluation
+ * returns true. Returns the number of selected tuples.
+ */
+int CheckPredicate(storage::DataTable *table,
+                   expression::AbstractExpression *predicate,
+                   executor::ExecutorContext *context) {
+  EXPECT_TRUE(predicate->IsVectorizable(table->GetSchema(), context));
+
+  int selected = 0;
+  for (oid_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    // skip the slots reserved by the inserting thread but not filled
+    expression::SelectionVector selection;
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (tile_group_header->GetTransactionId(tuple_id) != INVALID_TXN_ID) {
+        selection.push_back(tuple_id);
+      }
+    }
+
+    expression::TileGroupBatch batch(tile_group.get(), context);
+    predicate->FilterBatch(batch, selection);
+
+    expression::SelectionVector expected;
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID) {
+        continue;
+      }
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                           tuple_id);
+      if (predicate->Evaluate(&tuple, nullptr, context).IsTrue()) {
+        expected.push_back(tuple_id);
+      }
+    }
+
+    EXPECT_EQ(expected, selection);
+    selected += selection.size();
+  }
+
+  return selected;
+}
+
+}  // namespace
+
+TEST_F(ColumnVectorTests, FilterBatchTest) {
+  const int tuples_per_tile_group = 20;
+  const int tuple_count = 50;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::vector<type::Value> params(
+      {type::ValueFactory::GetIntegerValue(200),
+       type::ValueFactory::GetDecimalValue(301.5)});
+  executor::ExecutorContext context(nullptr, params);
+
+  // a >= 100
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+          Column(type::Type::INTEGER, 0), Integer(100)));
+  EXPECT_EQ(40, CheckPredicate(table.get(), predicate.get(), &context));
+
+  // c < 55.5 (DECIMAL column against DECIMAL constant)
+  predicate.reset(expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_LESSTHAN, Column(type::Type::DECIMAL, 2),
+      Decimal(55.5)));
+  EXPECT_EQ(6, CheckPredicate(table.get(), predicate.get(), &context));
+
+  // a > 40 AND b <> 101
+  predicate.reset(expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND,
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHAN, Column(type::Type::INTEGER, 0),
+          Integer(40)),
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_NOTEQUAL, Column(type::Type::INTEGER, 1),
+          Integer(101))));
+  EXPECT_EQ(44, CheckPredicate(table.get(), predicate.get(), &context));
+
+  // a = 0 OR c > 400
+  predicate.reset(expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_OR,
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_EQUAL, Column(type::Type::INTEGER, 0),
+          Integer(0)),
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHAN, Column(type::Type::DECIMAL, 2),
+          Integer(400))));
+  EXPECT_EQ(11, CheckPredicate(table.get(), predicate.get(), &context));
+
+  // a * 2 + 1 <= $0
+  predicate.reset(expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_LESSTHANOREQUALTO,
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_PLUS, type::Type::INTEGER,
+          expression::ExpressionUtil::OperatorFactory(
+              ExpressionType::OPERATOR_MULTIPLY, type::Type::INTEGER,
+              Column(type::Type::INTEGER, 0), Integer(2)),
+          Integer(1)),
+      new expression::ParameterValueExpression(0)));
+  EXPECT_EQ(10, CheckPredicate(table.get(), predicate.get(), &context));
+
+  // b >= $1, comparing an INTEGER column with a DECIMAL parameter
+  predicate.reset(expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+      Column(type::Type::INTEGER, 1),
+      new expression::ParameterValueExpression(1)));
+  EXPECT_EQ(19, CheckPredicate(table.get(), predicate.get(), &context));
+
+  // Constant predicates
+  predicate.reset(expression::ExpressionUtil::ConstantValueFactory(
+      type::ValueFactory::GetBooleanValue(true)));
+  EXPECT_EQ(tuple_count,
+            CheckPredicate(table.get(), predicate.get(), &context));
+
+  predicate.reset(expression::ExpressionUtil::ConstantValueFactory(
+      type::ValueFactory::GetBooleanValue(false)));
+  EXPECT_EQ(0, CheckPredicate(table.get(), predicate.get(), &context));
+}
+
+TEST_F(ColumnVectorTests, NotVectorizableTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  executor::ExecutorContext context(nullptr);
+
+  // VARCHAR columns are evaluated one tuple at a time
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_EQUAL, Column(type::Type::VARCHAR, 3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetVarcharValue("3"))));
+  EXPECT_FALSE(predicate->IsVectorizable(table->GetSchema(), &context));
+
+  // So is any conjunction that contains them
+  predicate.reset(expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND,
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_EQUAL, Column(type::Type::INTEGER, 0),
+          Integer(0)),
+      predicate.release()));
+  EXPECT_FALSE(predicate->IsVectorizable(table->GetSchema(), &context));
+
+  // Parameters that are not bound cannot be typed
+  predicate.reset(expression::ExpressionUtil::ComparisonFactory(
+      ExpressionType::COMPARE_EQUAL, Column(type::Type::INTEGER, 0),
+      new expression::ParameterValueExpression(0)));
+  EXPECT_FALSE(predicate->IsVectorizable(table->GetSchema(), &context));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,322 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_kernels_test.cpp
+//
+// Identification: test/expression/filter_kernels_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "expression/column_vector.h"
+#include "expression/filter_kernels.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Filter Kernels Tests
+//===--------------------------------------------------------------------===//
+
+class FilterKernelsTests : public PelotonTest {};
+
+namespace {
+
+// Not a multiple of any vector width, so the scalar tail is exercised
+const int tuple_count = 203;
+
+// Timestamps around 2^63, where signed comparisons would go wrong
+const uint64_t timestamp_base = 9223372036854775758ULL;
+
+std::vector<catalog::Column> GetColumns() {
+  std::vector<type::Type::TypeId> types(
+      {type::Type::INTEGER, type::Type::BIGINT, type::Type::DECIMAL,
+       type::Type::TIMESTAMP, type::Type::SMALLINT});
+
+  std::vector<catalog::Column> columns;
+  for (auto type_id : types) {
+    columns.push_back(catalog::Column(type_id, type::Type::GetTypeSize(type_id),
+                                      "COL" + std::to_string(columns.size()),
+                                      true));
+  }
+  return columns;
+}
+
+type::Value GetPopulatedValue(type::Type::TypeId type_id, int tuple_id) {
+  // every 17th tuple is NULL
+  if (tuple_id % 17 == 5) {
+    return type::ValueFactory::GetNullValueByType(type_id);
+  }
+
+  int value = (tuple_id * 37) % 101 - 50;
+  switch (type_id) {
+    case type::Type::INTEGER:
+      return type::ValueFactory::GetIntegerValue(value);
+    case type::Type::BIGINT:
+      return type::ValueFactory::GetBigIntValue(value * 1000000000000LL);
+    case type::Type::DECIMAL:
+      return type::ValueFactory::GetDecimalValue(value / 4.0);
+    case type::Type::TIMESTAMP:
+      return type::ValueFactory::GetTimestampValue(
+          static_cast<int64_t>(timestamp_base + value));
+    default:
+      return type::ValueFactory::GetSmallIntValue(value);
+  }
+}
+
+/**
+ * Create a tile group that either stores all columns in one tile (strided
+ * columns) or every column in its own tile (contiguous columns).
+ */
+std::shared_ptr<storage::TileGroup> CreateTileGroup(bool columnar) {
+  auto columns = GetColumns();
+
+  std::vector<catalog::Schema> schemas;
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  if (columnar) {
+    for (oid_t column_id = 0; column_id < columns.size(); column_id++) {
+      schemas.push_back(catalog::Schema({columns[column_id]}));
+      column_map[column_id] = std::make_pair(column_id, 0);
+    }
+  } else {
+    schemas.push_back(catalog::Schema(columns));
+    for (oid_t column_id = 0; column_id < columns.size(); column_id++) {
+      column_map[column_id] = std::make_pair(0, column_id);
+    }
+  }
+
+  std::shared_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr, schemas,
+          column_map, tuple_count));
+
+  catalog::Schema schema(columns);
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  for (int tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    storage::Tuple tuple(&schema, true);
+    for (oid_t column_id = 0; column_id < columns.size(); column_id++) {
+      tuple.SetValue(column_id,
+                     GetPopulatedValue(columns[column_id].GetType(), tuple_id),
+                     pool);
+    }
+    tile_group->InsertTuple(&tuple);
+  }
+
+  return tile_group;
+}
+
+bool Compare(const ExpressionType op, const type::Value &left,
+             const type::Value &right) {
+  // NULL column values never match
+  if (left.IsNull()) return false;
+
+  switch (op) {
+    case ExpressionType::COMPARE_EQUAL:
+      return left.CompareEquals(right) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return left.CompareNotEquals(right) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_LESSTHAN:
+      return left.CompareLessThan(right) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return left.CompareLessThanEquals(right) == type::CMP_TRUE;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return left.CompareGreaterThan(right) == type::CMP_TRUE;
+    default:
+      return left.CompareGreaterThanEquals(right) == type::CMP_TRUE;
+  }
+}
+
+const std::vector<ExpressionType> compare_ops(
+    {ExpressionType::COMPARE_EQUAL, ExpressionType::COMPARE_NOTEQUAL,
+     ExpressionType::COMPARE_LESSTHAN,
+     ExpressionType::COMPARE_LESSTHANOREQUALTO,
+     ExpressionType::COMPARE_GREATERTHAN,
+     ExpressionType::COMPARE_GREATERTHANOREQUALTO});
+
+const std::vector<expression::SIMDLevel> simd_levels(
+    {expression::SIMDLevel::SCALAR, expression::SIMDLevel::SSE42,
+     expression::SIMDLevel::AVX2});
+
+// All tuple offsets, every second one and every ninth one
+std::vector<expression::SelectionVector> GetSelections() {
+  expression::SelectionVector all, half, sparse;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    all.push_back(tuple_id);
+    if (tuple_id % 2 == 0) half.push_back(tuple_id);
+    if (tuple_id % 9 == 0) sparse.push_back(tuple_id);
+  }
+  return {all, half, sparse};
+}
+
+/**
+ * Check that the kernels select the same tuples as the scalar comparison
+ * of the values, at every SIMD level and for both tile layouts.
+ */
+template <typename Kernel, typename Expected>
+void CheckKernel(oid_t column_id, Kernel kernel, Expected expected) {
+  for (bool columnar : {false, true}) {
+    auto tile_group = CreateTileGroup(columnar);
+    expression::TileGroupBatch batch(tile_group.get(), nullptr);
+    auto column = batch.GetColumn(column_id);
+
+    for (auto level : simd_levels) {
+      expression::FilterKernels::SetLevel(level);
+
+      for (auto &selection : GetSelections()) {
+        expression::SelectionVector expected_selection;
+        for (auto tuple_id : selection) {
+          if (expected(tile_group->GetValue(tuple_id, column_id))) {
+            expected_selection.push_back(tuple_id);
+          }
+        }
+
+        kernel(column, selection);
+        EXPECT_EQ(expected_selection, selection);
+      }
+    }
+  }
+
+  expression::FilterKernels::SetLevel(
+      expression::FilterKernels::GetSupportedLevel());
+}
+
+void CheckCompare(oid_t column_id, const type::Value &constant) {
+  for (auto op : compare_ops) {
+    CheckKernel(column_id,
+                [&](const expression::ColumnVector &column,
+                    expression::SelectionVector &selection) {
+                  expression::FilterKernels::Compare(op, column, constant,
+                                                     selection);
+                },
+                [&](const type::Value &value) {
+                  return Compare(op, value, constant);
+                });
+  }
+}
+
+}  // namespace
+
+TEST_F(FilterKernelsTests, CompareTest) {
+  // INTEGER, including constants outside the range of the column
+  for (int64_t constant : {-51LL, -50LL, -7LL, 0LL, 13LL, 50LL, 51LL,
+                           10000000000LL, -10000000000LL}) {
+    CheckCompare(0, type::ValueFactory::GetBigIntValue(constant));
+  }
+  CheckCompare(0, type::ValueFactory::GetSmallIntValue(3));
+
+  // BIGINT
+  for (int64_t constant : {-50000000000000LL, 0LL, 13000000000000LL,
+                           13000000000001LL}) {
+    CheckCompare(1, type::ValueFactory::GetBigIntValue(constant));
+  }
+  CheckCompare(1, type::ValueFactory::GetIntegerValue(0));
+
+  // DECIMAL, with DECIMAL and INTEGER constants
+  for (double constant : {-12.5, -0.1, 0.0, 3.25, 12.5, 100.0}) {
+    CheckCompare(2, type::ValueFactory::GetDecimalValue(constant));
+  }
+  CheckCompare(2, type::ValueFactory::GetIntegerValue(3));
+
+  // TIMESTAMP, on both sides of 2^63
+  for (int offset : {-51, -1, 0, 9, 50}) {
+    CheckCompare(3, type::ValueFactory::GetTimestampValue(
+                        static_cast<int64_t>(timestamp_base + offset)));
+  }
+
+  // SMALLINT has no vector kernel, but goes through the same interface
+  for (int32_t constant : {-40, 0, 40, 100000}) {
+    CheckCompare(4, type::ValueFactory::GetIntegerValue(constant));
+  }
+}
+
+TEST_F(FilterKernelsTests, BetweenAndInTest) {
+  auto low = type::ValueFactory::GetIntegerValue(-20);
+  auto high = type::ValueFactory::GetIntegerValue(35);
+  CheckKernel(0,
+              [&](const expression::ColumnVector &column,
+                  expression::SelectionVector &selection) {
+                expression::FilterKernels::Between(column, low, high,
+                                                   selection);
+              },
+              [&](const type::Value &value) {
+                return Compare(ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+                               value, low) &&
+                       Compare(ExpressionType::COMPARE_LESSTHANOREQUALTO,
+                               value, high);
+              });
+
+  auto decimal_low = type::ValueFactory::GetDecimalValue(-2.5);
+  auto decimal_high = type::ValueFactory::GetDecimalValue(7.75);
+  CheckKernel(2,
+              [&](const expression::ColumnVector &column,
+                  expression::SelectionVector &selection) {
+                expression::FilterKernels::Between(column, decimal_low,
+                                                   decimal_high, selection);
+              },
+              [&](const type::Value &value) {
+                return Compare(ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+                               value, decimal_low) &&
+                       Compare(ExpressionType::COMPARE_LESSTHANOREQUALTO,
+                               value, decimal_high);
+              });
+
+  for (oid_t column_id = 0; column_id < 4; column_id++) {
+    auto type_id = GetColumns()[column_id].GetType();
+    std::vector<type::Value> values(
+        {GetPopulatedValue(type_id, 0), GetPopulatedValue(type_id, 3),
+         GetPopulatedValue(type_id, 8), GetPopulatedValue(type_id, 5)});
+    CheckKernel(column_id,
+                [&](const expression::ColumnVector &column,
+                    expression::SelectionVector &selection) {
+                  expression::FilterKernels::In(column, values, selection);
+                },
+                [&](const type::Value &value) {
+                  for (auto &in_value : values) {
+                    if (Compare(ExpressionType::COMPARE_EQUAL, value,
+                                in_value))
+                      return true;
+                  }
+                  return false;
+                });
+  }
+}
+
+TEST_F(FilterKernelsTests, NullConstantTest) {
+  auto tile_group = CreateTileGroup(true);
+  expression::TileGroupBatch batch(tile_group.get(), nullptr);
+
+  expression::SelectionVector selection(GetSelections()[0]);
+  expression::FilterKernels::Compare(
+      ExpressionType::COMPARE_NOTEQUAL, batch.GetColumn(0),
+      type::ValueFactory::GetNullValueByType(type::Type::INTEGER), selection);
+  EXPECT_TRUE(selection.empty());
+}
+
+TEST_F(FilterKernelsTests, SupportedTypesTest) {
+  EXPECT_TRUE(expression::FilterKernels::IsSupported(type::Type::INTEGER,
+                                                     type::Type::BIGINT));
+  EXPECT_TRUE(expression::FilterKernels::IsSupported(type::Type::DECIMAL,
+                                                     type::Type::INTEGER));
+  EXPECT_FALSE(expression::FilterKernels::IsSupported(type::Type::INTEGER,
+                                                      type::Type::DECIMAL));
+  EXPECT_FALSE(expression::FilterKernels::IsSupported(type::Type::TIMESTAMP,
+                                                      type::Type::BIGINT));
+  EXPECT_FALSE(expression::FilterKernels::IsSupported(type::Type::VARCHAR,
+                                                      type::Type::VARCHAR));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -108,6 +108,29 @@ int GarbageNum(storage::DataTable *table) {
   return old_num;
 }
 
+// count number of versions linked to an older version.
+int LinkedNum(storage::DataTable *table) {
+  auto table_tile_group_count_ = table->GetTileGroupCount();
+  auto current_tile_group_offset_ = START_OID;
+
+  int linked_num = 0;
+
+  while (current_tile_group_offset_ < table_tile_group_count_) {
+    auto tile_group =
+      table->GetTileGroup(current_tile_group_offset_++);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (tile_group_header->GetNextItemPointer(tuple_id).IsNull() == false) {
+        linked_num++;
+      }
+    }
+  }
+
+  return linked_num;
+}
+
 // get tuple recycled by GC
 int RecycledNum(storage::DataTable *table) {
   int count = 0;
@@ -177,6 +200,9 @@ TEST_F(GarbageCollectionTests, SimpleTest) {
   old_num = GarbageNum(table.get());
   EXPECT_EQ(old_num, 0);
 
+  // the latest version should not point to the recycled one
+  EXPECT_EQ(0, LinkedNum(table.get()));
+
   // there should be 1 tuple recycled
   EXPECT_EQ(1, RecycledNum(table.get()));
 
@@ -192,6 +218,64 @@ TEST_F(GarbageCollectionTests, SimpleTest) {
 
 }
 
+TEST_F(GarbageCollectionTests, DeleteTest) {
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  // the epochs go on from the ones of the previous test
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  size_t start_epoch = epoch_manager.GetCurrentEpoch();
+
+  auto catalog = catalog::Catalog::GetInstance();
+  // create database
+  auto database = ExecutorTestsUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(catalog->HasDatabase(db_id));
+
+  // create a table with two keys
+  const int num_key = 2;
+  std::unique_ptr<storage::DataTable> table(
+    TransactionTestsUtil::CreateTable(num_key, "TEST_TABLE", db_id, INVALID_OID, 1234, true));
+
+  gc_manager.StartGC();
+
+  // delete the first key
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  TransactionScheduler scheduler(1, table.get(), &txn_manager);
+  scheduler.Txn(0).Delete(0);
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+  EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+
+  EXPECT_EQ(1, GarbageNum(table.get()));
+
+  for (size_t i = 1; i < 21; ++i) {
+    epoch_manager.Reset(start_epoch + i);
+    SelectTuple(table.get(), num_key);
+    if (i % 10 == 0) {
+      // sleep a while for gc to finish its job
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+  }
+
+  // there should be no garbage
+  EXPECT_EQ(0, GarbageNum(table.get()));
+
+  // both the deleted version and the empty version are recycled
+  EXPECT_EQ(2, RecycledNum(table.get()));
+
+  gc_manager.StopGC();
+
+  table.release();
+
+  // DROP!
+  ExecutorTestsUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+
+}
 
 }  // End test namespace
 }  // End peloton namespace
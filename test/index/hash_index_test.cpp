@@ -0,0 +1,207 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index_test.cpp
+//
+// Identification: test/index/hash_index_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "gtest/gtest.h"
+
+#include "common/logger.h"
+#include "common/platform.h"
+#include "index/index_factory.h"
+#include "index/scan_optimizer.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Index Tests
+//===--------------------------------------------------------------------===//
+
+class HashIndexTests : public PelotonTest {};
+
+// The index metadata does not own them
+static std::unique_ptr<catalog::Schema> tuple_schema = nullptr;
+
+static ItemPointer item0(120, 5);
+static ItemPointer item1(120, 7);
+static ItemPointer item2(123, 19);
+
+/*
+ * BuildIndex() - Builds a hash index on an integer and a varchar column,
+ *                which takes a generic key
+ */
+static index::Index *BuildIndex() {
+  catalog::Column column0(type::Type::INTEGER,
+                          type::Type::GetTypeSize(type::Type::INTEGER), "A",
+                          true);
+  catalog::Column column1(type::Type::VARCHAR, 1024, "B", false);
+
+  std::vector<catalog::Column> column_list = {column0, column1};
+  std::vector<oid_t> key_attrs = {0, 1};
+
+  auto key_schema = new catalog::Schema(column_list);
+  key_schema->SetIndexedColumns(key_attrs);
+  tuple_schema.reset(new catalog::Schema(column_list));
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "hash_test_index", 125,  // Index oid
+      INVALID_OID, INVALID_OID, IndexType::HASH, IndexConstraintType::DEFAULT,
+      tuple_schema.get(), key_schema, key_attrs, false);
+
+  index::Index *index = index::IndexFactory::GetIndex(index_metadata);
+  EXPECT_TRUE(index != NULL);
+
+  return index;
+}
+
+static std::unique_ptr<storage::Tuple> MakeKey(index::Index *index, int a,
+                                               const std::string &b) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(index->GetKeySchema(), true));
+  key->SetValue(0, type::ValueFactory::GetIntegerValue(a), pool);
+  key->SetValue(1, type::ValueFactory::GetVarcharValue(b), pool);
+  return key;
+}
+
+TEST_F(HashIndexTests, MultiValueTest) {
+  std::unique_ptr<index::Index> index(BuildIndex());
+  EXPECT_EQ("Hash", index->GetTypeName());
+
+  std::vector<ItemPointer *> location_ptrs;
+  auto key0 = MakeKey(index.get(), 100, "a");
+  auto key1 = MakeKey(index.get(), 100, "b");
+
+  // INSERT
+  EXPECT_TRUE(index->InsertEntry(key0.get(), &item0));
+  EXPECT_TRUE(index->InsertEntry(key0.get(), &item1));
+  EXPECT_FALSE(index->InsertEntry(key0.get(), &item1));
+  EXPECT_TRUE(index->InsertEntry(key1.get(), &item2));
+
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanKey(key1.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(item2.offset, location_ptrs[0]->offset);
+  location_ptrs.clear();
+
+  // DELETE
+  EXPECT_TRUE(index->DeleteEntry(key0.get(), &item0));
+  EXPECT_FALSE(index->DeleteEntry(key0.get(), &item0));
+  EXPECT_FALSE(index->DeleteEntry(key1.get(), &item0));
+
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(item1.offset, location_ptrs[0]->offset);
+  location_ptrs.clear();
+
+  // the key is found again once all its values are deleted and reinserted
+  size_t footprint = index->GetMemoryFootprint();
+  EXPECT_TRUE(index->DeleteEntry(key0.get(), &item1));
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+  location_ptrs.clear();
+
+  // the key is dropped along with its last value
+  EXPECT_GT(footprint, index->GetMemoryFootprint());
+  EXPECT_TRUE(index->DeleteEntry(key1.get(), &item2));
+  EXPECT_EQ(0, index->GetMemoryFootprint());
+
+  EXPECT_TRUE(index->InsertEntry(key0.get(), &item0));
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+}
+
+TEST_F(HashIndexTests, CondInsertTest) {
+  std::unique_ptr<index::Index> index(BuildIndex());
+
+  std::vector<ItemPointer *> location_ptrs;
+  auto key0 = MakeKey(index.get(), 100, "a");
+
+  auto is_item0 = [](const void *value) {
+    auto location = static_cast<const ItemPointer *>(value);
+    return location->block == item0.block && location->offset == item0.offset;
+  };
+
+  EXPECT_TRUE(index->CondInsertEntry(key0.get(), &item1, is_item0));
+  EXPECT_TRUE(index->InsertEntry(key0.get(), &item0));
+
+  // item0 is there now
+  EXPECT_FALSE(index->CondInsertEntry(key0.get(), &item2, is_item0));
+
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+}
+
+TEST_F(HashIndexTests, ScanTest) {
+  std::unique_ptr<index::Index> index(BuildIndex());
+
+  const int num_key = 10;
+  std::vector<ItemPointer> items;
+  for (int i = 0; i < num_key; i++) {
+    items.push_back(ItemPointer(i, i));
+  }
+  for (int i = 0; i < num_key; i++) {
+    auto key = MakeKey(index.get(), i, "a");
+    EXPECT_TRUE(index->InsertEntry(key.get(), &items[i]));
+  }
+
+  std::vector<ItemPointer *> location_ptrs;
+
+  // POINT QUERY
+  std::vector<type::Value> value_list = {
+      type::ValueFactory::GetIntegerValue(3).Copy(),
+      type::ValueFactory::GetVarcharValue("a").Copy()};
+  std::vector<oid_t> tuple_column_id_list = {0, 1};
+  std::vector<ExpressionType> expr_list = {ExpressionType::COMPARE_EQUAL,
+                                           ExpressionType::COMPARE_EQUAL};
+  {
+    index::ConjunctionScanPredicate csp(index.get(), value_list,
+                                        tuple_column_id_list, expr_list);
+    EXPECT_TRUE(csp.IsPointQuery());
+
+    index->Scan(value_list, tuple_column_id_list, expr_list,
+                ScanDirectionType::FORWARD, location_ptrs, &csp);
+    EXPECT_EQ(1, location_ptrs.size());
+    EXPECT_EQ(3, location_ptrs[0]->offset);
+    location_ptrs.clear();
+  }
+
+  // RANGE QUERY, filtered on each key
+  value_list = {type::ValueFactory::GetIntegerValue(4).Copy(),
+                type::ValueFactory::GetIntegerValue(7).Copy()};
+  tuple_column_id_list = {0, 0};
+  expr_list = {ExpressionType::COMPARE_GREATERTHAN,
+               ExpressionType::COMPARE_LESSTHANOREQUALTO};
+  {
+    index::ConjunctionScanPredicate csp(index.get(), value_list,
+                                        tuple_column_id_list, expr_list);
+    EXPECT_FALSE(csp.IsPointQuery());
+
+    index->Scan(value_list, tuple_column_id_list, expr_list,
+                ScanDirectionType::FORWARD, location_ptrs, &csp);
+    EXPECT_EQ(3, location_ptrs.size());
+    for (auto location : location_ptrs) {
+      EXPECT_TRUE(location->offset > 4 && location->offset <= 7);
+    }
+    location_ptrs.clear();
+  }
+
+  // FULL SCAN
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(num_key, location_ptrs.size());
+}
+
+}  // End test namespace
+}  // End peloton namespace
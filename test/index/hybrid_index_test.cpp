@@ -392,9 +392,15 @@ void BuildIndex(std::shared_ptr<index::Index> index,
   while (start_tile_group_count < table_tile_group_count) {
     auto tile_group = table->GetTileGroup(start_tile_group_count++);
     auto column_count = table->GetSchema()->GetColumnCount();
+    auto tile_group_header = tile_group->GetHeader();
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
     for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      // Skip the slots that were reserved but never filled
+      if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID) {
+        continue;
+      }
+
       std::unique_ptr<storage::Tuple> tuple_ptr(
           new storage::Tuple(table->GetSchema(), true));
       CopyTuple(tuple_id, tuple_ptr.get(), tile_group.get(), column_count);
@@ -229,6 +229,46 @@ TEST_F(IndexIntsKeyTests, BwTreeTest) {
   }
 }
 
+TEST_F(IndexIntsKeyTests, HashTest) {
+  std::vector<type::Type::TypeId> types = {
+      type::Type::BIGINT, type::Type::INTEGER, type::Type::SMALLINT,
+      type::Type::TINYINT};
+
+  // ONE COLUMN
+  for (type::Type::TypeId type0 : types) {
+    std::vector<type::Type::TypeId> col_types = {type0};
+    IndexIntsKeyTestHelper(IndexType::HASH, col_types);
+  }
+  // TWO COLUMNS
+  for (type::Type::TypeId type0 : types) {
+    for (type::Type::TypeId type1 : types) {
+      std::vector<type::Type::TypeId> col_types = {type0, type1};
+      IndexIntsKeyTestHelper(IndexType::HASH, col_types);
+    }
+  }
+  // THREE COLUMNS
+  for (type::Type::TypeId type0 : types) {
+    for (type::Type::TypeId type1 : types) {
+      for (type::Type::TypeId type2 : types) {
+        std::vector<type::Type::TypeId> col_types = {type0, type1, type2};
+        IndexIntsKeyTestHelper(IndexType::HASH, col_types);
+      }
+    }
+  }
+  // FOUR COLUMNS
+  for (type::Type::TypeId type0 : types) {
+    for (type::Type::TypeId type1 : types) {
+      for (type::Type::TypeId type2 : types) {
+        for (type::Type::TypeId type3 : types) {
+          std::vector<type::Type::TypeId> col_types = {type0, type1, type2,
+                                                       type3};
+          IndexIntsKeyTestHelper(IndexType::HASH, col_types);
+        }
+      }
+    }
+  }
+}
+
 // FIXME: The B-Tree core dumps. If we're not going to support then we should
 // probably drop it.
 // TEST_F(IndexIntsKeyTests, BTreeTest) {
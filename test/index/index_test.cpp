@@ -13,6 +13,8 @@
 #include "common/harness.h"
 #include "gtest/gtest.h"
 
+#include <set>
+
 #include "common/logger.h"
 #include "common/platform.h"
 #include "index/index_factory.h"
@@ -930,5 +932,183 @@ TEST_F(IndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   delete tuple_schema;
 }
 
+TEST_F(IndexTests, BulkLoadTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // The same entries are bulk loaded into the first index and inserted into
+  // the second one
+  std::unique_ptr<index::Index> index(BuildIndex(false));
+  std::unique_ptr<catalog::Schema> index_tuple_schema(tuple_schema);
+  std::unique_ptr<index::Index> insert_index(BuildIndex(false));
+
+  // Enough keys for several levels of inner nodes, one of them with more
+  // values than a leaf holds, and a pair that is there twice
+  const int num_key = 20000;
+  const int big_key = 7;
+  const int big_key_value_count = 300;
+
+  std::vector<ItemPointer> items;
+  items.reserve(num_key + big_key_value_count);
+  std::vector<std::unique_ptr<storage::Tuple>> key_tuples;
+  std::vector<const storage::Tuple *> keys;
+  std::vector<ItemPointer *> locations;
+
+  auto AddEntry = [&](int key, int offset) {
+    items.push_back(ItemPointer(key, offset));
+    key_tuples.emplace_back(new storage::Tuple(key_schema, true));
+    key_tuples.back()->SetValue(0, type::ValueFactory::GetIntegerValue(key),
+                                pool);
+    key_tuples.back()->SetValue(1, type::ValueFactory::GetVarcharValue("a"),
+                                pool);
+    keys.push_back(key_tuples.back().get());
+    locations.push_back(&items.back());
+  };
+
+  for (int key = num_key - 1; key >= 0; key--) {
+    AddEntry(key, 0);
+  }
+  for (int offset = 1; offset < big_key_value_count; offset++) {
+    AddEntry(big_key, offset);
+  }
+  keys.push_back(keys[0]);
+  locations.push_back(locations[0]);
+
+  EXPECT_EQ(num_key + big_key_value_count - 1,
+            index->BulkLoad(keys, locations));
+  EXPECT_EQ(num_key + big_key_value_count - 1,
+            insert_index->InsertEntries(keys, locations));
+
+  // The entries come out in the order of their keys
+  std::vector<ItemPointer *> insert_location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  insert_index->ScanAllKeys(insert_location_ptrs);
+  EXPECT_EQ(num_key + big_key_value_count - 1, location_ptrs.size());
+  EXPECT_EQ(insert_location_ptrs.size(), location_ptrs.size());
+  for (size_t i = 1; i < location_ptrs.size(); i++) {
+    EXPECT_LE(location_ptrs[i - 1]->block, location_ptrs[i]->block);
+  }
+  location_ptrs.clear();
+
+  index->ScanKey(keys[num_key - 1 - big_key], location_ptrs);
+  EXPECT_EQ(big_key_value_count, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanKey(keys[0], location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  std::vector<type::Value> value_list = {
+      type::ValueFactory::GetIntegerValue(101).Copy(),
+      type::ValueFactory::GetIntegerValue(200).Copy()};
+  std::vector<oid_t> tuple_column_id_list = {0, 0};
+  std::vector<ExpressionType> expr_list = {
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+      ExpressionType::COMPARE_LESSTHANOREQUALTO};
+  index->ScanTest(value_list, tuple_column_id_list, expr_list,
+                  ScanDirectionType::FORWARD, location_ptrs);
+  EXPECT_EQ(100, location_ptrs.size());
+  location_ptrs.clear();
+
+  // The loaded tree takes updates like any other
+  ItemPointer new_item(num_key, 0);
+  std::unique_ptr<storage::Tuple> new_key(new storage::Tuple(key_schema, true));
+  new_key->SetValue(0, type::ValueFactory::GetIntegerValue(num_key), pool);
+  new_key->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+
+  EXPECT_TRUE(index->InsertEntry(new_key.get(), &new_item));
+  EXPECT_FALSE(index->InsertEntry(keys[0], locations[0]));
+  EXPECT_TRUE(index->DeleteEntry(keys[1], locations[1]));
+
+  index->ScanKey(new_key.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanKey(keys[1], location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(num_key + big_key_value_count - 1, location_ptrs.size());
+  location_ptrs.clear();
+
+  delete tuple_schema;
+}
+
+TEST_F(IndexTests, ScanKeysBatchTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<index::Index> index(BuildIndex(false));
+
+  // The even keys over many leaves, one of them with more values than a
+  // leaf holds
+  const int num_key = 5000;
+  const int big_key = 10;
+  const int big_key_value_count = 300;
+
+  std::vector<ItemPointer> items;
+  items.reserve(num_key + big_key_value_count);
+  std::vector<const storage::Tuple *> keys;
+  std::vector<ItemPointer *> locations;
+
+  std::vector<std::unique_ptr<storage::Tuple>> key_tuples;
+  auto MakeKey = [&](int key) {
+    key_tuples.emplace_back(new storage::Tuple(key_schema, true));
+    key_tuples.back()->SetValue(0, type::ValueFactory::GetIntegerValue(key),
+                                pool);
+    key_tuples.back()->SetValue(1, type::ValueFactory::GetVarcharValue("a"),
+                                pool);
+    return key_tuples.back().get();
+  };
+
+  for (int key = 0; key < num_key; key += 2) {
+    items.push_back(ItemPointer(key, 0));
+    keys.push_back(MakeKey(key));
+    locations.push_back(&items.back());
+  }
+  for (int offset = 1; offset < big_key_value_count; offset++) {
+    items.push_back(ItemPointer(big_key, offset));
+    keys.push_back(keys[big_key / 2]);
+    locations.push_back(&items.back());
+  }
+  index->BulkLoad(keys, locations);
+
+  // Unsorted probes on keys that are there or not, some of them twice, and
+  // past both ends of the index
+  std::vector<const storage::Tuple *> probe_keys;
+  for (int i = 0; i < 2 * num_key; i++) {
+    probe_keys.push_back(MakeKey(i * 7919 % (num_key + 1)));
+  }
+  probe_keys.push_back(MakeKey(-1));
+  probe_keys.push_back(MakeKey(big_key));
+  probe_keys.push_back(MakeKey(num_key * 2));
+
+  std::vector<std::vector<ItemPointer *>> results;
+  index->ScanKeysBatch(probe_keys, results);
+  EXPECT_EQ(probe_keys.size(), results.size());
+
+  // Each probe gets the same values as its own lookup
+  std::vector<ItemPointer *> location_ptrs;
+  for (size_t i = 0; i < probe_keys.size(); i++) {
+    index->ScanKey(probe_keys[i], location_ptrs);
+    EXPECT_EQ(location_ptrs.size(), results[i].size());
+    std::set<ItemPointer *> expected(location_ptrs.begin(),
+                                     location_ptrs.end());
+    for (auto location : results[i]) {
+      EXPECT_EQ(1, expected.count(location));
+    }
+    location_ptrs.clear();
+  }
+  EXPECT_EQ(0, results[probe_keys.size() - 3].size());
+  EXPECT_EQ(big_key_value_count, results[probe_keys.size() - 2].size());
+  EXPECT_EQ(0, results[probe_keys.size() - 1].size());
+
+  // An empty batch
+  std::vector<const storage::Tuple *> no_keys;
+  index->ScanKeysBatch(no_keys, results);
+  EXPECT_EQ(0, results.size());
+
+  delete tuple_schema;
+}
+
 }  // End test namespace
 }  // End peloton namespace
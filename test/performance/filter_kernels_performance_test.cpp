@@ -0,0 +1,183 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_kernels_performance_test.cpp
+//
+// Identification: test/performance/filter_kernels_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "common/timer.h"
+#include "expression/column_vector.h"
+#include "expression/expression_util.h"
+#include "expression/filter_kernels.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Filter Kernels Performance Tests
+//===--------------------------------------------------------------------===//
+
+class FilterKernelsPerformanceTests : public PelotonTest {};
+
+const int tuple_count = 1 << 20;
+
+const int scan_count = 20;
+
+/**
+ * Create a tile group with an INTEGER, a BIGINT and a DECIMAL column, either
+ * in a single tile (strided) or in one tile per column (contiguous).
+ */
+std::shared_ptr<storage::TileGroup> CreatePerformanceTileGroup(bool columnar) {
+  std::vector<catalog::Column> columns(
+      {catalog::Column(type::Type::INTEGER,
+                       type::Type::GetTypeSize(type::Type::INTEGER), "A",
+                       true),
+       catalog::Column(type::Type::BIGINT,
+                       type::Type::GetTypeSize(type::Type::BIGINT), "B", true),
+       catalog::Column(type::Type::DECIMAL,
+                       type::Type::GetTypeSize(type::Type::DECIMAL), "C",
+                       true)});
+
+  std::vector<catalog::Schema> schemas;
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  for (oid_t column_id = 0; column_id < columns.size(); column_id++) {
+    if (columnar) {
+      schemas.push_back(catalog::Schema({columns[column_id]}));
+      column_map[column_id] = std::make_pair(column_id, 0);
+    } else {
+      column_map[column_id] = std::make_pair(0, column_id);
+    }
+  }
+  if (columnar == false) {
+    schemas.push_back(catalog::Schema(columns));
+  }
+
+  std::shared_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr, schemas,
+          column_map, tuple_count));
+
+  catalog::Schema schema(columns);
+  storage::Tuple tuple(&schema, true);
+  for (int tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    int value = std::rand() % 1000;
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(value), nullptr);
+    tuple.SetValue(1, type::ValueFactory::GetBigIntValue(value), nullptr);
+    tuple.SetValue(2, type::ValueFactory::GetDecimalValue(value), nullptr);
+    tile_group->InsertTuple(&tuple);
+  }
+
+  return tile_group;
+}
+
+expression::SelectionVector GetAllTuples() {
+  expression::SelectionVector selection(tuple_count);
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    selection[tuple_id] = tuple_id;
+  }
+  return selection;
+}
+
+// column < 500, tuple by tuple through the expression tree
+double ScalarScan(storage::TileGroup *tile_group, oid_t column_id,
+                  type::Type::TypeId type_id, size_t &match_count) {
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_LESSTHAN,
+          expression::ExpressionUtil::TupleValueFactory(type_id, 0, column_id),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(500))));
+
+  Timer<std::milli> timer;
+  for (int scan_itr = 0; scan_itr < scan_count; scan_itr++) {
+    timer.Start();
+    match_count = 0;
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
+                                                           tuple_id);
+      if (predicate->Evaluate(&tuple, nullptr, nullptr).IsTrue()) {
+        match_count++;
+      }
+    }
+    timer.Stop();
+  }
+  return timer.GetDuration() / scan_count;
+}
+
+// column < 500 with the filter kernels
+double KernelScan(storage::TileGroup *tile_group, oid_t column_id,
+                  expression::SIMDLevel level, size_t &match_count) {
+  expression::FilterKernels::SetLevel(level);
+  expression::TileGroupBatch batch(tile_group, nullptr);
+  auto column = batch.GetColumn(column_id);
+  auto constant = type::ValueFactory::GetIntegerValue(500);
+
+  Timer<std::milli> timer;
+  for (int scan_itr = 0; scan_itr < scan_count; scan_itr++) {
+    auto selection = GetAllTuples();
+    timer.Start();
+    expression::FilterKernels::Compare(ExpressionType::COMPARE_LESSTHAN,
+                                       column, constant, selection);
+    timer.Stop();
+    match_count = selection.size();
+  }
+
+  expression::FilterKernels::SetLevel(
+      expression::FilterKernels::GetSupportedLevel());
+  return timer.GetDuration() / scan_count;
+}
+
+TEST_F(FilterKernelsPerformanceTests, CompareTest) {
+  std::vector<type::Type::TypeId> types(
+      {type::Type::INTEGER, type::Type::BIGINT, type::Type::DECIMAL});
+  std::vector<expression::SIMDLevel> levels(
+      {expression::SIMDLevel::SCALAR, expression::SIMDLevel::SSE42,
+       expression::SIMDLevel::AVX2});
+  auto supported_level = expression::FilterKernels::GetSupportedLevel();
+
+  for (bool columnar : {true, false}) {
+    auto tile_group = CreatePerformanceTileGroup(columnar);
+
+    for (oid_t column_id = 0; column_id < types.size(); column_id++) {
+      size_t expected_count = 0;
+      double duration = ScalarScan(tile_group.get(), column_id,
+                                   types[column_id], expected_count);
+      LOG_INFO("%s %s :: Tuple-at-a-time; Duration=%.2lf ms",
+               columnar ? "Contiguous" : "Strided",
+               TypeIdToString(types[column_id]).c_str(), duration);
+
+      for (auto level : levels) {
+        if (level > supported_level) continue;
+
+        size_t match_count = 0;
+        duration = KernelScan(tile_group.get(), column_id, level, match_count);
+        EXPECT_EQ(expected_count, match_count);
+        LOG_INFO("%s %s :: Kernel level=%d; Duration=%.2lf ms",
+                 columnar ? "Contiguous" : "Strided",
+                 TypeIdToString(types[column_id]).c_str(),
+                 static_cast<int>(level), duration);
+      }
+    }
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
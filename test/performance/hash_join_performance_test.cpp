@@ -0,0 +1,200 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_join_performance_test.cpp
+//
+// Identification: test/performance/hash_join_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "common/timer.h"
+#include "executor/join_hash_table.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Join Performance Tests
+//===--------------------------------------------------------------------===//
+
+class HashJoinPerformanceTests : public PelotonTest {};
+
+// About the number of order lines of a TPC-C warehouse
+const int probe_tuple_count = 1 << 20;
+
+const int join_count = 5;
+
+const std::vector<oid_t> key_column_ids({0});
+
+/**
+ * Create a tile group with an INTEGER key and an INTEGER payload. The keys
+ * are 0 .. key_count - 1, in order if unique, random otherwise.
+ */
+std::shared_ptr<storage::TileGroup> CreateJoinTileGroup(int tuple_count,
+                                                        int key_count,
+                                                        bool unique) {
+  std::vector<catalog::Column> columns(
+      {catalog::Column(type::Type::INTEGER,
+                       type::Type::GetTypeSize(type::Type::INTEGER), "KEY",
+                       true),
+       catalog::Column(type::Type::INTEGER,
+                       type::Type::GetTypeSize(type::Type::INTEGER),
+                       "PAYLOAD", true)});
+  std::vector<catalog::Schema> schemas({catalog::Schema(columns)});
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  column_map[0] = std::make_pair(0, 0);
+  column_map[1] = std::make_pair(0, 1);
+
+  std::shared_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr, schemas,
+          column_map, tuple_count));
+
+  catalog::Schema schema(columns);
+  storage::Tuple tuple(&schema, true);
+  for (int tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    int key = unique ? tuple_id : std::rand() % key_count;
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(key), nullptr);
+    tuple.SetValue(1, type::ValueFactory::GetIntegerValue(tuple_id), nullptr);
+    auto tuple_slot_id = tile_group->InsertTuple(&tuple);
+    tile_group->GetHeader()->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+  }
+
+  return tile_group;
+}
+
+// The hash table the hash executor used to build
+double UnorderedMapJoin(executor::LogicalTile *build_tile,
+                        executor::LogicalTile *probe_tile,
+                        size_t &match_count) {
+  typedef std::unordered_map<
+      expression::ContainerTuple<executor::LogicalTile>,
+      std::unordered_set<std::pair<size_t, oid_t>,
+                         boost::hash<std::pair<size_t, oid_t>>>,
+      expression::ContainerTupleHasher<executor::LogicalTile>,
+      expression::ContainerTupleComparator<executor::LogicalTile>>
+      HashMapType;
+
+  Timer<std::milli> timer;
+  for (int join_itr = 0; join_itr < join_count; join_itr++) {
+    timer.Start();
+    HashMapType hash_table;
+    for (oid_t tuple_id : *build_tile) {
+      auto key = HashMapType::key_type(build_tile, tuple_id, &key_column_ids);
+      hash_table[key].insert(std::make_pair(0, tuple_id));
+    }
+
+    match_count = 0;
+    for (oid_t tuple_id : *probe_tile) {
+      const expression::ContainerTuple<executor::LogicalTile> probe_tuple(
+          probe_tile, tuple_id, &key_column_ids);
+      auto build_tuples = hash_table.find(probe_tuple);
+      if (build_tuples != hash_table.end()) {
+        match_count += build_tuples->second.size();
+      }
+    }
+    timer.Stop();
+  }
+  return timer.GetDuration() / join_count;
+}
+
+double JoinHashTableJoin(executor::LogicalTile *build_tile,
+                         executor::LogicalTile *probe_tile,
+                         size_t &match_count, size_t &partition_count) {
+  Timer<std::milli> timer;
+  for (int join_itr = 0; join_itr < join_count; join_itr++) {
+    timer.Start();
+    executor::JoinHashTable hash_table;
+    for (oid_t tuple_id : *build_tile) {
+      hash_table.Insert(executor::JoinHashTable::HashKey(build_tile, tuple_id,
+                                                         key_column_ids),
+                        0, tuple_id);
+    }
+    hash_table.Build(
+        [build_tile](const executor::JoinHashTable::Entry &lhs,
+                     const executor::JoinHashTable::Entry &rhs) {
+          return executor::JoinHashTable::KeysEqual(
+              build_tile, lhs.tuple_id, key_column_ids, build_tile,
+              rhs.tuple_id, key_column_ids);
+        },
+        [](const executor::JoinHashTable::Entry &) {});
+
+    std::vector<oid_t> probe_tuple_ids;
+    std::vector<uint64_t> probe_hashes;
+    for (oid_t tuple_id : *probe_tile) {
+      probe_tuple_ids.push_back(tuple_id);
+      probe_hashes.push_back(executor::JoinHashTable::HashKey(
+          probe_tile, tuple_id, key_column_ids));
+    }
+
+    match_count = 0;
+    hash_table.ProbeBatch(
+        probe_hashes.data(), probe_hashes.size(),
+        [&](size_t probe_itr, const executor::JoinHashTable::Entry &entry) {
+          return executor::JoinHashTable::KeysEqual(
+              probe_tile, probe_tuple_ids[probe_itr], key_column_ids,
+              build_tile, entry.tuple_id, key_column_ids);
+        },
+        [&match_count](size_t, const executor::JoinHashTable::Entry &) {
+          match_count++;
+        });
+    timer.Stop();
+    partition_count = hash_table.GetPartitionCount();
+  }
+  return timer.GetDuration() / join_count;
+}
+
+TEST_F(HashJoinPerformanceTests, BuildProbeTest) {
+  // From a small dimension table to about the stock of a TPC-C warehouse
+  for (int build_tuple_count : {1 << 10, 100000, 1 << 20}) {
+    auto build_tile_group =
+        CreateJoinTileGroup(build_tuple_count, build_tuple_count, true);
+    auto probe_tile_group =
+        CreateJoinTileGroup(probe_tuple_count, build_tuple_count, false);
+    std::unique_ptr<executor::LogicalTile> build_tile(
+        executor::LogicalTileFactory::WrapTileGroup(build_tile_group));
+    std::unique_ptr<executor::LogicalTile> probe_tile(
+        executor::LogicalTileFactory::WrapTileGroup(probe_tile_group));
+
+    size_t expected_count = 0;
+    double duration = UnorderedMapJoin(build_tile.get(), probe_tile.get(),
+                                       expected_count);
+    EXPECT_EQ((size_t)probe_tuple_count, expected_count);
+    LOG_INFO("Build=%d :: unordered_map; Duration=%.2lf ms",
+             build_tuple_count, duration);
+
+    size_t match_count = 0;
+    size_t partition_count = 0;
+    duration = JoinHashTableJoin(build_tile.get(), probe_tile.get(),
+                                 match_count, partition_count);
+    EXPECT_EQ(expected_count, match_count);
+    LOG_INFO("Build=%d :: JoinHashTable partitions=%lu; Duration=%.2lf ms",
+             build_tuple_count, partition_count, duration);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -16,8 +16,10 @@
 #include <thread>
 #include <vector>
 
+#include "common/init.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "common/thread_pool.h"
 #include "common/timer.h"
 #include "index/index_factory.h"
 #include "storage/tuple.h"
@@ -166,6 +168,37 @@ static void DeleteTest1(index::Index *index, size_t num_thread, size_t num_key,
   return;
 }
 
+/*
+ * LookupTest1() - Tests ScanKey() performance for each index type
+ *
+ * This function tests threads looking up the keys of their own consecutive
+ * interval, as inserted by InsertTest1()
+ */
+static void LookupTest1(index::Index *index, size_t num_thread, size_t num_key,
+                        uint64_t thread_id) {
+  // To avoid compiler warning
+  (void)num_thread;
+
+  size_t start_key = thread_id * num_key;
+  size_t end_key = start_key + num_key;
+
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  std::vector<ItemPointer *> location_ptrs;
+
+  for (size_t i = start_key; i < end_key; i++) {
+    auto key_value = type::ValueFactory::GetIntegerValue(i);
+
+    key->SetValue(0, key_value, nullptr);
+    key->SetValue(1, key_value, nullptr);
+
+    location_ptrs.clear();
+    index->ScanKey(key.get(), location_ptrs);
+    EXPECT_EQ(1, location_ptrs.size());
+  }
+
+  return;
+}
+
 /*
  * InsertTest2() - Tests InsertEntry() performance for each index type
  *
@@ -292,6 +325,18 @@ static void TestIndexPerformance(const IndexType &index_type) {
   LOG_INFO("InsertTest1 :: Type=%s; Duration=%.2lf",
            IndexTypeToString(index_type).c_str(), timer.GetDuration());
 
+  ///////////////////////////////////////////////////////////////////
+  // Start LookupTest1
+  ///////////////////////////////////////////////////////////////////
+
+  timer.Start();
+
+  LaunchParallelTest(num_thread, LookupTest1, index.get(), num_thread, num_key);
+
+  timer.Stop();
+  LOG_INFO("LookupTest1 :: Type=%s; Duration=%.2lf",
+           IndexTypeToString(index_type).c_str(), timer.GetDuration());
+
   ///////////////////////////////////////////////////////////////////
   // Start DeleteTest1
   ///////////////////////////////////////////////////////////////////
@@ -364,10 +409,215 @@ static void TestIndexPerformance(const IndexType &index_type) {
   return;
 }
 
+/*
+ * TestBulkLoadPerformance() - Compares the ways of loading a set of entries
+ *                             into an empty index
+ *
+ * The keys come in a shuffled order, as from a table that is not clustered
+ * on them
+ */
+static void TestBulkLoadPerformance(const IndexType &index_type) {
+  // Number of keys loaded
+  size_t num_key = 1024 * 256;
+
+  // One index per way of loading the entries
+  const int num_load_type = 3;
+  std::vector<std::unique_ptr<catalog::Schema>> tuple_schemas;
+  std::vector<std::unique_ptr<index::Index>> indexes;
+  for (int load_type = 0; load_type < num_load_type; load_type++) {
+    indexes.emplace_back(BuildIndex(false, index_type));
+    tuple_schemas.emplace_back(tuple_schema);
+  }
+
+  std::vector<ItemPointer> items;
+  std::vector<storage::Tuple> key_tuples;
+  std::vector<const storage::Tuple *> keys;
+  std::vector<ItemPointer *> locations;
+
+  size_t key_length = key_schema->GetLength();
+  std::unique_ptr<char[]> key_data(new char[num_key * key_length]());
+
+  items.reserve(num_key);
+  key_tuples.reserve(num_key);
+  for (size_t i = 0; i < num_key; i++) {
+    // 7919 is a prime, so the keys are a permutation of [0, num_key)
+    auto key_value = type::ValueFactory::GetIntegerValue(i * 7919 % num_key);
+
+    key_tuples.emplace_back(key_schema, key_data.get() + i * key_length);
+    key_tuples.back().SetValue(0, key_value, nullptr);
+    key_tuples.back().SetValue(1, key_value, nullptr);
+    keys.push_back(&key_tuples.back());
+
+    items.push_back(ItemPointer(i, 0));
+    locations.push_back(&items.back());
+  }
+
+  Timer<> timer;
+  std::vector<ItemPointer *> location_ptrs;
+
+  for (int load_type = 0; load_type < num_load_type; load_type++) {
+    auto index = indexes[load_type].get();
+
+    timer.Reset();
+    timer.Start();
+
+    // One entry at a time, sorted entries, and bottom up build
+    size_t load_count = 0;
+    if (load_type == 0) {
+      load_count = index->Index::InsertEntries(keys, locations);
+    } else if (load_type == 1) {
+      load_count = index->InsertEntries(keys, locations);
+    } else {
+      load_count = index->BulkLoad(keys, locations);
+    }
+
+    timer.Stop();
+    LOG_INFO("LoadTest%d :: Type=%s; Duration=%.2lf", load_type,
+             IndexTypeToString(index_type).c_str(), timer.GetDuration());
+
+    EXPECT_EQ(num_key, load_count);
+
+    index->ScanAllKeys(location_ptrs);
+    EXPECT_EQ(num_key, location_ptrs.size());
+    location_ptrs.clear();
+  }
+}
+
+/*
+ * TestBatchLookupPerformance() - Compares batched lookups with lookups of
+ *                                one key at a time
+ *
+ * The probes are scattered over the index, in batches as small as the lines
+ * of an order and as large as an IN list. An integer key gets a compact
+ * integer index key, and an integer with a varchar a generic one.
+ */
+static void TestBatchLookupPerformance(const IndexType &index_type,
+                                       bool generic_key) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // Number of keys in the index, and number of probes
+  size_t num_key = 1024 * 1024;
+  size_t num_probe = 1024 * 256;
+
+  std::vector<catalog::Column> columns;
+  columns.push_back(catalog::Column(
+      type::Type::INTEGER, type::Type::GetTypeSize(type::Type::INTEGER), "A",
+      true));
+  if (generic_key == true) {
+    columns.push_back(catalog::Column(type::Type::VARCHAR, 16, "B", false));
+  }
+  std::vector<oid_t> key_attrs(columns.size());
+  for (oid_t column_id = 0; column_id < key_attrs.size(); column_id++) {
+    key_attrs[column_id] = column_id;
+  }
+
+  auto lookup_key_schema = new catalog::Schema(columns);
+  lookup_key_schema->SetIndexedColumns(key_attrs);
+  std::unique_ptr<catalog::Schema> lookup_tuple_schema(
+      new catalog::Schema(columns));
+
+  std::unique_ptr<index::Index> index(
+      index::IndexFactory::GetIndex(new index::IndexMetadata(
+          "test_index", 125, INVALID_OID, INVALID_OID, index_type,
+          IndexConstraintType::DEFAULT, lookup_tuple_schema.get(),
+          lookup_key_schema, key_attrs, false)));
+
+  std::vector<ItemPointer> items;
+  std::vector<std::unique_ptr<storage::Tuple>> key_tuples;
+  std::vector<const storage::Tuple *> keys;
+  std::vector<ItemPointer *> locations;
+
+  items.reserve(num_key);
+  for (size_t i = 0; i < num_key; i++) {
+    key_tuples.emplace_back(new storage::Tuple(lookup_key_schema, true));
+    key_tuples.back()->SetValue(0, type::ValueFactory::GetIntegerValue(i),
+                                pool);
+    if (generic_key == true) {
+      key_tuples.back()->SetValue(
+          1, type::ValueFactory::GetVarcharValue(std::to_string(i % 100)),
+          pool);
+    }
+    keys.push_back(key_tuples.back().get());
+
+    items.push_back(ItemPointer(i, 0));
+    locations.push_back(&items.back());
+  }
+  index->BulkLoad(keys, locations);
+
+  // 7919 is a prime, so the probes are all different
+  std::vector<const storage::Tuple *> probe_keys;
+  for (size_t i = 0; i < num_probe; i++) {
+    probe_keys.push_back(keys[i * 7919 % num_key]);
+  }
+
+  Timer<> timer;
+  std::vector<size_t> batch_sizes = {16, 1024};
+
+  for (auto batch_size : batch_sizes) {
+    // One key at a time
+    timer.Reset();
+    timer.Start();
+
+    size_t result_count = 0;
+    std::vector<ItemPointer *> location_ptrs;
+    for (auto probe_key : probe_keys) {
+      index->ScanKey(probe_key, location_ptrs);
+      result_count += location_ptrs.size();
+      location_ptrs.clear();
+    }
+
+    timer.Stop();
+    LOG_INFO("LookupTest :: Type=%s; Key=%s; Batch=%lu; Duration=%.2lf",
+             IndexTypeToString(index_type).c_str(),
+             generic_key ? "Generic" : "Integer", batch_size,
+             timer.GetDuration());
+    EXPECT_EQ(num_probe, result_count);
+
+    // A batch at a time
+    timer.Reset();
+    timer.Start();
+
+    result_count = 0;
+    std::vector<const storage::Tuple *> batch_keys;
+    std::vector<std::vector<ItemPointer *>> results;
+    for (size_t begin = 0; begin < num_probe; begin += batch_size) {
+      size_t end = std::min(begin + batch_size, num_probe);
+      batch_keys.assign(probe_keys.begin() + begin, probe_keys.begin() + end);
+      index->ScanKeysBatch(batch_keys, results);
+      for (auto &result : results) {
+        result_count += result.size();
+      }
+    }
+
+    timer.Stop();
+    LOG_INFO("BatchLookupTest :: Type=%s; Key=%s; Batch=%lu; Duration=%.2lf",
+             IndexTypeToString(index_type).c_str(),
+             generic_key ? "Generic" : "Integer", batch_size,
+             timer.GetDuration());
+    EXPECT_EQ(num_probe, result_count);
+  }
+}
+
 TEST_F(IndexPerformanceTests, BwTreeMultiThreadedTest) {
   TestIndexPerformance(IndexType::BWTREE);
 }
 
+TEST_F(IndexPerformanceTests, HashMultiThreadedTest) {
+  TestIndexPerformance(IndexType::HASH);
+}
+
+TEST_F(IndexPerformanceTests, BwTreeBulkLoadTest) {
+  // The keys are sorted by the threads of the pool
+  thread_pool.Initialize(3, 0);
+
+  TestBulkLoadPerformance(IndexType::BWTREE);
+}
+
+TEST_F(IndexPerformanceTests, BwTreeBatchLookupTest) {
+  TestBatchLookupPerformance(IndexType::BWTREE, false);
+  TestBatchLookupPerformance(IndexType::BWTREE, true);
+}
+
 // TEST_F(IndexPerformanceTests, BTreeMultiThreadedTest) {
 //  TestIndexPerformance(IndexType::BTREE);
 //}
@@ -11,8 +11,10 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <atomic>
@@ -27,6 +29,7 @@
 #include "executor/executor_context.h"
 #include "executor/insert_executor.h"
 #include "executor/logical_tile_factory.h"
+#include "gc/gc_manager_factory.h"
 #include "expression/expression_util.h"
 #include "expression/tuple_value_expression.h"
 #include "expression/comparison_expression.h"
@@ -147,5 +150,81 @@ TEST_F(InsertPerformanceTests, LoadingTest) {
                bytes_to_megabytes_converter);
 }
 
+void InsertTuplesInTransactions(storage::DataTable *table,
+                                type::AbstractPool *pool, oid_t tuple_count,
+                                UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  const oid_t tuples_per_txn = 100;
+
+  std::unique_ptr<storage::Tuple> tuple(
+      ExecutorTestsUtil::GetTuple(table, ++loader_tuple_id, pool));
+  planner::InsertPlan node(table, std::move(tuple));
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count;
+       tuple_itr += tuples_per_txn) {
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+    for (oid_t txn_itr = 0; txn_itr < tuples_per_txn; txn_itr++) {
+      executor::InsertExecutor executor(&node, context.get());
+      executor.Execute();
+    }
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
+TEST_F(InsertPerformanceTests, ScalabilityTest) {
+  // Inserts the same number of tuples per thread with more and more threads,
+  // one active tile group per thread as set up by PelotonInit. The
+  // throughput should grow linearly with the thread count.
+  //
+  // The table is first registered with the GC, as Database::AddTable does,
+  // so that the inserters reserve their slots in batches. It is then left
+  // out, as with the GC off, where they take one slot at a time.
+  const oid_t tuples_per_tilegroup = 1000;
+  const oid_t tuples_per_thread = 100000;
+  size_t max_thread_count =
+      std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  auto default_active_tilegroup_count =
+      storage::DataTable::default_active_tilegroup_count_;
+
+  for (bool gc_registered : {true, false}) {
+    gc::GCManagerFactory::Configure(gc_registered == true ? 1 : 0);
+    auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+    for (size_t thread_count = 1; thread_count <= max_thread_count;
+         thread_count *= 2) {
+      storage::DataTable::SetActiveTileGroupCount(thread_count);
+      std::unique_ptr<storage::DataTable> data_table(
+          ExecutorTestsUtil::CreateTable(tuples_per_tilegroup, false));
+      if (gc_registered == true) {
+        gc_manager.RegisterTable(data_table->GetOid());
+      }
+
+      Timer<> timer;
+      timer.Start();
+      LaunchParallelTest(thread_count, InsertTuplesInTransactions,
+                         data_table.get(), testing_pool, tuples_per_thread);
+      timer.Stop();
+
+      EXPECT_EQ(thread_count * tuples_per_thread,
+                data_table->GetTupleCount());
+      LOG_INFO("GC %s, %2lu threads: %.2lf s, %.0lf inserts/s",
+               gc_registered == true ? "on" : "off", thread_count,
+               timer.GetDuration(),
+               thread_count * tuples_per_thread / timer.GetDuration());
+
+      if (gc_registered == true) {
+        gc_manager.DeregisterTable(data_table->GetOid());
+      }
+    }
+  }
+
+  gc::GCManagerFactory::Configure(0);
+  storage::DataTable::SetActiveTileGroupCount(default_active_tilegroup_count);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_header_performance_test.cpp
+//
+// Identification: test/performance/tile_group_header_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "common/logger.h"
+#include "common/timer.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Header Performance Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupHeaderPerformanceTests : public PelotonTest {};
+
+const int tuple_count = 1 << 22;
+
+const int scan_count = 10;
+
+/**
+ * Fill the header with committed versions, every tenth of them already
+ * invalidated.
+ */
+std::unique_ptr<storage::TileGroupHeader> CreateHeader(LayoutType layout_type) {
+  std::unique_ptr<storage::TileGroupHeader> header(
+      new storage::TileGroupHeader(BackendType::MM, tuple_count, layout_type));
+  for (oid_t tuple_slot_id = 0; tuple_slot_id < tuple_count; tuple_slot_id++) {
+    header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+    header->SetBeginCommitId(tuple_slot_id, tuple_slot_id % 100);
+    header->SetEndCommitId(tuple_slot_id,
+                           (tuple_slot_id % 10 == 0) ? 150 : MAX_CID);
+  }
+  return header;
+}
+
+// Visit every slot the way the visibility check does
+double ScanHeader(const storage::TileGroupHeader *header, cid_t read_cid,
+                  size_t &visible_count) {
+  Timer<std::milli> timer;
+  for (int scan_itr = 0; scan_itr < scan_count; scan_itr++) {
+    timer.Start();
+    visible_count = 0;
+    for (oid_t tuple_slot_id = 0; tuple_slot_id < tuple_count;
+         tuple_slot_id++) {
+      if (header->GetTransactionId(tuple_slot_id) == INITIAL_TXN_ID &&
+          read_cid >= header->GetBeginCommitId(tuple_slot_id) &&
+          read_cid < header->GetEndCommitId(tuple_slot_id)) {
+        visible_count++;
+      }
+    }
+    timer.Stop();
+  }
+  return timer.GetDuration() / scan_count;
+}
+
+TEST_F(TileGroupHeaderPerformanceTests, VisibilityScanTest) {
+  size_t expected_count = 0;
+
+  for (auto layout_type : {LAYOUT_TYPE_ROW, LAYOUT_TYPE_COLUMN}) {
+    auto header = CreateHeader(layout_type);
+
+    size_t visible_count = 0;
+    double duration = ScanHeader(header.get(), 200, visible_count);
+    if (layout_type == LAYOUT_TYPE_ROW) {
+      expected_count = visible_count;
+    }
+    EXPECT_EQ(expected_count, visible_count);
+
+    LOG_INFO("%s header :: Duration=%.2lf ms",
+             (layout_type == LAYOUT_TYPE_ROW) ? "Row" : "Column", duration);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
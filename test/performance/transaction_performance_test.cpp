@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_performance_test.cpp
+//
+// Identification: test/performance/transaction_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Transaction Performance Tests
+//===--------------------------------------------------------------------===//
+
+class TransactionPerformanceTests : public PelotonTest {};
+
+namespace {
+
+// Runs short transactions reading random tuples, as a YCSB transaction with
+// the default operation count does. Returns the average duration of a
+// transaction in ns.
+double RunReadTransactions(const std::vector<ItemPointer> &locations,
+                           size_t txn_count, size_t reads_per_txn) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::mt19937 generator(15721);
+  std::uniform_int_distribution<size_t> distribution(0, locations.size() - 1);
+
+  Timer<std::ratio<1, 1000 * 1000 * 1000>> timer;
+  timer.Start();
+  for (size_t txn_itr = 0; txn_itr < txn_count; txn_itr++) {
+    auto txn = txn_manager.BeginTransaction();
+    for (size_t read_itr = 0; read_itr < reads_per_txn; read_itr++) {
+      txn_manager.PerformRead(txn, locations[distribution(generator)]);
+    }
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  }
+  timer.Stop();
+
+  return timer.GetDuration() / txn_count;
+}
+
+}  // namespace
+
+TEST_F(TransactionPerformanceTests, BeginCommitTest) {
+  const int tuple_count = 10000;
+  const size_t txn_count = 200000;
+
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(TEST_TUPLES_PER_TILEGROUP, false));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::vector<ItemPointer> locations;
+  for (oid_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+         tuple_id++) {
+      locations.emplace_back(tile_group->GetTileGroupId(), tuple_id);
+    }
+  }
+  EXPECT_EQ(tuple_count, locations.size());
+
+  for (auto protocol :
+       {ConcurrencyType::TIMESTAMP_ORDERING, ConcurrencyType::OPTIMISTIC}) {
+    concurrency::TransactionManagerFactory::Configure(protocol);
+
+    // empty transactions measure begin and commit alone
+    for (size_t reads_per_txn : {0, 10, 100}) {
+      auto duration = RunReadTransactions(locations, txn_count, reads_per_txn);
+      LOG_INFO("Protocol %d, %lu reads per transaction: %.1lf ns",
+               (int)protocol, reads_per_txn, duration);
+    }
+  }
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -10,14 +10,23 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <set>
+
 #include "common/harness.h"
 
+#include "common/numa_util.h"
+#include "configuration/configuration.h"
+
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
 
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_tests_util.h"
+#include "gc/gc_manager_factory.h"
+#include "index/index_factory.h"
+#include "type/ephemeral_pool.h"
 
 namespace peloton {
 namespace test {
@@ -90,5 +99,252 @@ TEST_F(DataTableTests, GlobalTableTest) {
   delete data_table_pointer;
 }
 
+void InsertTuples(storage::DataTable *table, size_t tuple_count,
+                  std::vector<std::set<oid_t>> *thread_tile_groups,
+                  uint64_t thread_itr) {
+  type::EphemeralPool pool;
+  for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto tuple = ExecutorTestsUtil::GetTuple(table, tuple_itr, &pool);
+    auto location = table->InsertTuple(tuple.get());
+    EXPECT_FALSE(location.IsNull());
+    (*thread_tile_groups)[thread_itr].insert(location.block);
+  }
+}
+
+TEST_F(DataTableTests, ThreadAffineInsertTest) {
+  const size_t thread_count = 4;
+  const size_t tuple_count = 3 * TESTS_TUPLES_PER_TILEGROUP;
+
+  EXPECT_LT(NumaUtil::GetCurrentNode(), NumaUtil::GetNodeCount());
+
+  // Without NUMA every thread sticks to one of the active tile groups
+  bool numa_aware = FLAGS_numa_aware;
+  FLAGS_numa_aware = false;
+  storage::DataTable::SetActiveTileGroupCount(thread_count);
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  storage::DataTable::SetActiveTileGroupCount(1);
+  FLAGS_numa_aware = numa_aware;
+
+  std::vector<std::set<oid_t>> thread_tile_groups(thread_count);
+  LaunchParallelTest(thread_count, InsertTuples, table.get(), tuple_count,
+                     &thread_tile_groups);
+
+  // The tile groups are not shared, and filled one at a time
+  std::set<oid_t> tile_groups;
+  for (auto &thread_groups : thread_tile_groups) {
+    EXPECT_EQ(3, thread_groups.size());
+    tile_groups.insert(thread_groups.begin(), thread_groups.end());
+  }
+  EXPECT_EQ(thread_count * 3, tile_groups.size());
+  EXPECT_EQ(thread_count * tuple_count, table->GetTupleCount());
+}
+
+TEST_F(DataTableTests, ReservedSlotRecycleTest) {
+  const size_t tuple_count = 5;
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(100, false));
+  gc_manager.RegisterTable(table->GetOid());
+
+  // The thread reserves more slots than it fills, and hands the rest back
+  // when it exits
+  std::vector<std::set<oid_t>> thread_tile_groups(1);
+  LaunchParallelTest(1, InsertTuples, table.get(), tuple_count,
+                     &thread_tile_groups);
+  auto tile_group = table->GetTileGroup(0);
+  oid_t reserved_count = tile_group->GetNextTupleSlot();
+  EXPECT_LT(tuple_count, reserved_count);
+
+  // They are used before any new slot
+  type::EphemeralPool pool;
+  for (size_t tuple_itr = tuple_count; tuple_itr < reserved_count;
+       tuple_itr++) {
+    auto tuple = ExecutorTestsUtil::GetTuple(table.get(), tuple_itr, &pool);
+    auto location = table->InsertTuple(tuple.get());
+    EXPECT_EQ(tile_group->GetTileGroupId(), location.block);
+    EXPECT_LE(tuple_count, location.offset);
+  }
+  EXPECT_EQ(reserved_count, tile_group->GetNextTupleSlot());
+
+  gc_manager.DeregisterTable(table->GetOid());
+  gc::GCManagerFactory::Configure(0);
+}
+
+// Index on the second column of the test table
+static index::Index *BuildSecondaryIndex(
+    storage::DataTable *table, oid_t index_oid,
+    IndexConstraintType constraint = IndexConstraintType::DEFAULT) {
+  std::vector<oid_t> key_attrs = {1};
+  auto tuple_schema = table->GetSchema();
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+
+  auto index_metadata = new index::IndexMetadata(
+      "populated_index", index_oid, INVALID_OID, INVALID_OID,
+      IndexType::BWTREE, constraint, tuple_schema,
+      key_schema, key_attrs, false);
+
+  return index::IndexFactory::GetIndex(index_metadata);
+}
+
+TEST_F(DataTableTests, PopulateIndexTest) {
+  const int tuples_per_tile_group = 100;
+  const int tuple_count = 10 * tuples_per_tile_group;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, true,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The primary index holds the indirections of all the tuples
+  std::vector<ItemPointer *> pkey_locations;
+  table->GetIndex(0)->ScanAllKeys(pkey_locations);
+  std::set<ItemPointer *> expected(pkey_locations.begin(),
+                                   pkey_locations.end());
+  EXPECT_EQ(tuple_count, expected.size());
+
+  // Both ways of populating the index give the same entries
+  for (bool bulk_load : {true, false}) {
+    std::unique_ptr<index::Index> index(
+        BuildSecondaryIndex(table.get(), 200 + bulk_load));
+    EXPECT_EQ(tuple_count,
+              table->PopulateIndex(index.get(), 0, table->GetTileGroupCount(),
+                                   bulk_load));
+
+    std::vector<ItemPointer *> locations;
+    index->ScanAllKeys(locations);
+    EXPECT_EQ(expected,
+              std::set<ItemPointer *>(locations.begin(), locations.end()));
+  }
+
+  // Only the tuples of the given tile groups are inserted, so that an index
+  // may be populated a few tile groups at a time
+  std::unique_ptr<index::Index> index(BuildSecondaryIndex(table.get(), 202));
+  size_t insert_count = 0;
+  for (oid_t offset = 0; offset < table->GetTileGroupCount(); offset += 3) {
+    insert_count += table->PopulateIndex(index.get(), offset, offset + 3, false);
+  }
+  EXPECT_EQ(tuple_count, insert_count);
+  EXPECT_EQ(0, table->PopulateIndex(index.get(), table->GetTileGroupCount(),
+                                    table->GetTileGroupCount() + 1, false));
+}
+
+TEST_F(DataTableTests, BackfillIndexTest) {
+  const int tuples_per_tile_group = 100;
+  const int tuple_count = 5 * tuples_per_tile_group;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+
+  // The uncommitted tuples are left to their writer
+  std::unique_ptr<index::Index> index(BuildSecondaryIndex(table.get(), 203));
+  auto build_txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(table->BackfillIndex(index.get(), build_txn));
+  txn_manager.CommitTransaction(build_txn);
+
+  std::vector<ItemPointer *> locations;
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(0, locations.size());
+
+  txn_manager.CommitTransaction(txn);
+
+  // A build transaction that begins after the commit sees them, and the
+  // entries already in a unique index are not inserted twice
+  std::unique_ptr<index::Index> unique_index(BuildSecondaryIndex(
+      table.get(), 204, IndexConstraintType::UNIQUE));
+  for (int build = 0; build < 2; build++) {
+    build_txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(table->BackfillIndex(unique_index.get(), build_txn));
+    txn_manager.CommitTransaction(build_txn);
+
+    locations.clear();
+    unique_index->ScanAllKeys(locations);
+    EXPECT_EQ(tuple_count, locations.size());
+  }
+
+  // Duplicate keys violate the constraint of a unique index
+  std::unique_ptr<storage::DataTable> duplicate_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true));
+  txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(duplicate_table.get(), tuple_count, false,
+                                   true, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<index::Index> duplicate_index(BuildSecondaryIndex(
+      duplicate_table.get(), 205, IndexConstraintType::UNIQUE));
+  build_txn = txn_manager.BeginTransaction();
+  EXPECT_FALSE(
+      duplicate_table->BackfillIndex(duplicate_index.get(), build_txn));
+  txn_manager.CommitTransaction(build_txn);
+}
+
+TEST_F(DataTableTests, BuildIndexTest) {
+  const int tuples_per_tile_group = 100;
+  const int tuple_count = 5 * tuples_per_tile_group;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<index::Index> index(BuildSecondaryIndex(
+      table.get(), 206, IndexConstraintType::UNIQUE));
+  auto snapshot_txn = txn_manager.BeginTransaction();
+  std::vector<ItemPointer> versions;
+  EXPECT_TRUE(table->BuildIndex(index.get(), snapshot_txn, versions));
+  txn_manager.CommitTransaction(snapshot_txn);
+  EXPECT_EQ(tuple_count, versions.size());
+  EXPECT_TRUE(std::is_sorted(versions.begin(), versions.end()));
+
+  // The tuples written after the snapshot are the only ones backfilled
+  txn = txn_manager.BeginTransaction();
+  type::EphemeralPool pool;
+  for (int tuple_itr = tuple_count; tuple_itr < 2 * tuple_count;
+       tuple_itr++) {
+    auto tuple = ExecutorTestsUtil::GetTuple(table.get(), tuple_itr, &pool);
+    ItemPointer *index_entry_ptr = nullptr;
+    auto location = table->InsertTuple(tuple.get(), txn, &index_entry_ptr);
+    txn_manager.PerformInsert(txn, location, index_entry_ptr);
+  }
+  txn_manager.CommitTransaction(txn);
+
+  auto build_txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(table->BackfillIndex(index.get(), build_txn, versions));
+  txn_manager.CommitTransaction(build_txn);
+
+  std::vector<ItemPointer *> locations;
+  index->ScanAllKeys(locations);
+  EXPECT_EQ(2 * tuple_count, locations.size());
+
+  // Duplicate keys violate the constraint of a unique index
+  std::unique_ptr<storage::DataTable> duplicate_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, true));
+  txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(duplicate_table.get(), tuple_count, false,
+                                   true, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<index::Index> duplicate_index(BuildSecondaryIndex(
+      duplicate_table.get(), 207, IndexConstraintType::UNIQUE));
+  snapshot_txn = txn_manager.BeginTransaction();
+  versions.clear();
+  EXPECT_FALSE(duplicate_table->BuildIndex(duplicate_index.get(), snapshot_txn,
+                                           versions));
+  txn_manager.CommitTransaction(snapshot_txn);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -543,5 +543,74 @@ TEST_F(TileGroupTests, TileCopyTest) {
   delete schema;
 }
 
+TEST_F(TileGroupTests, HeaderLayoutTest) {
+  const int tuple_count = 5;
+
+  for (auto layout_type : {LAYOUT_TYPE_ROW, LAYOUT_TYPE_COLUMN}) {
+    storage::TileGroupHeader header(BackendType::MM, tuple_count, layout_type);
+    EXPECT_EQ(layout_type, header.GetLayoutType());
+
+    // Every slot starts out empty
+    for (oid_t tuple_slot_id = 0; tuple_slot_id < tuple_count;
+         tuple_slot_id++) {
+      EXPECT_EQ(INVALID_TXN_ID, header.GetTransactionId(tuple_slot_id));
+      EXPECT_EQ(MAX_CID, header.GetBeginCommitId(tuple_slot_id));
+      EXPECT_EQ(MAX_CID, header.GetEndCommitId(tuple_slot_id));
+      EXPECT_TRUE(header.GetNextItemPointer(tuple_slot_id).IsNull());
+      EXPECT_TRUE(header.GetPrevItemPointer(tuple_slot_id).IsNull());
+    }
+
+    // Fields of neighboring slots don't overlap
+    ItemPointer indirection;
+    for (oid_t tuple_slot_id = 0; tuple_slot_id < tuple_count;
+         tuple_slot_id++) {
+      header.SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+      header.SetBeginCommitId(tuple_slot_id, 10 + tuple_slot_id);
+      header.SetEndCommitId(tuple_slot_id, 20 + tuple_slot_id);
+      header.SetNextItemPointer(tuple_slot_id, ItemPointer(1, tuple_slot_id));
+      header.SetPrevItemPointer(tuple_slot_id, ItemPointer(2, tuple_slot_id));
+      header.SetIndirection(tuple_slot_id, &indirection);
+      PL_MEMSET(header.GetReservedFieldRef(tuple_slot_id), tuple_slot_id,
+                storage::TileGroupHeader::GetReservedSize());
+    }
+
+    for (oid_t tuple_slot_id = 0; tuple_slot_id < tuple_count;
+         tuple_slot_id++) {
+      EXPECT_EQ(INITIAL_TXN_ID, header.GetTransactionId(tuple_slot_id));
+      EXPECT_EQ(10 + tuple_slot_id, header.GetBeginCommitId(tuple_slot_id));
+      EXPECT_EQ(20 + tuple_slot_id, header.GetEndCommitId(tuple_slot_id));
+      EXPECT_EQ(tuple_slot_id, header.GetNextItemPointer(tuple_slot_id).offset);
+      EXPECT_EQ(1U, header.GetNextItemPointer(tuple_slot_id).block);
+      EXPECT_EQ(tuple_slot_id, header.GetPrevItemPointer(tuple_slot_id).offset);
+      EXPECT_EQ(2U, header.GetPrevItemPointer(tuple_slot_id).block);
+      EXPECT_EQ(&indirection, header.GetIndirection(tuple_slot_id));
+      for (size_t byte = 0; byte < storage::TileGroupHeader::GetReservedSize();
+           byte++) {
+        EXPECT_EQ(tuple_slot_id,
+                  (oid_t)header.GetReservedFieldRef(tuple_slot_id)[byte]);
+      }
+    }
+
+    // Ownership
+    EXPECT_TRUE(header.SetAtomicTransactionId(3, 100));
+    EXPECT_FALSE(header.SetAtomicTransactionId(3, 101));
+    EXPECT_EQ(100U, header.SetAtomicTransactionId(3, 100, INITIAL_TXN_ID));
+    EXPECT_EQ(INITIAL_TXN_ID, header.GetTransactionId(3));
+    EXPECT_EQ(INITIAL_TXN_ID, header.GetTransactionId(2));
+    EXPECT_EQ(INITIAL_TXN_ID, header.GetTransactionId(4));
+
+    // The reserved fields are packed in the column layout
+    size_t reserved_field_distance =
+        header.GetReservedFieldRef(1) - header.GetReservedFieldRef(0);
+    if (layout_type == LAYOUT_TYPE_COLUMN) {
+      EXPECT_EQ(storage::TileGroupHeader::GetReservedSize(),
+                reserved_field_distance);
+    } else {
+      size_t header_entry_size = storage::TileGroupHeader::header_entry_size;
+      EXPECT_EQ(header_entry_size, reserved_field_distance);
+    }
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// marshal_test.cpp
+//
+// Identification: test/wire/marshal_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "type/value_factory.h"
+#include "wire/marshal.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Marshal Tests
+//===--------------------------------------------------------------------===//
+
+class MarshalTests : public PelotonTest {};
+
+namespace {
+
+/**
+ * Serialize the value into a fresh packet and return the bytes that follow
+ * the length, checking that the length matches them.
+ */
+std::string PutValue(const type::Value &value, int format) {
+  wire::OutputPacket pkt;
+  pkt.Reset();
+  wire::PacketPutValue(&pkt, value, format);
+
+  EXPECT_EQ(pkt.len, pkt.buf.size());
+  EXPECT_GE(pkt.buf.size(), 4U);
+  int32_t len = (pkt.buf[0] << 24) | (pkt.buf[1] << 16) | (pkt.buf[2] << 8) |
+                pkt.buf[3];
+  if (len == -1) {
+    EXPECT_EQ(4U, pkt.buf.size());
+    return "NULL";
+  }
+  EXPECT_EQ(pkt.buf.size() - 4, (size_t)len);
+  return std::string(pkt.buf.begin() + 4, pkt.buf.end());
+}
+
+// Big endian bytes of an integer
+std::string BigEndian(uint64_t value, int size) {
+  std::string bytes;
+  for (int i = size - 1; i >= 0; i--) {
+    bytes.push_back((char)((value >> (i * 8)) & 0xFF));
+  }
+  return bytes;
+}
+
+}  // namespace
+
+TEST_F(MarshalTests, TextValueTest) {
+  // Text values match the string representation of the values
+  std::vector<type::Value> values(
+      {type::ValueFactory::GetTinyIntValue(-12),
+       type::ValueFactory::GetSmallIntValue(1234),
+       type::ValueFactory::GetIntegerValue(-2147483647),
+       type::ValueFactory::GetIntegerValue(0),
+       type::ValueFactory::GetBigIntValue(9223372036854775807LL),
+       type::ValueFactory::GetDecimalValue(-3.25),
+       type::ValueFactory::GetBooleanValue(true),
+       type::ValueFactory::GetVarcharValue("peloton")});
+  for (auto &value : values) {
+    EXPECT_EQ(value.ToString(), PutValue(value, 0));
+  }
+
+  EXPECT_EQ("", PutValue(type::ValueFactory::GetVarcharValue(""), 0));
+  EXPECT_EQ("NULL", PutValue(type::ValueFactory::GetNullValueByType(
+                                 type::Type::INTEGER),
+                             0));
+  EXPECT_EQ("NULL", PutValue(type::ValueFactory::GetNullValueByType(
+                                 type::Type::VARCHAR),
+                             1));
+}
+
+TEST_F(MarshalTests, BinaryValueTest) {
+  EXPECT_EQ(std::string(1, 1),
+            PutValue(type::ValueFactory::GetBooleanValue(true), 1));
+  EXPECT_EQ(BigEndian((uint16_t)-12, 2),
+            PutValue(type::ValueFactory::GetTinyIntValue(-12), 1));
+  EXPECT_EQ(BigEndian(1234, 2),
+            PutValue(type::ValueFactory::GetSmallIntValue(1234), 1));
+  EXPECT_EQ(BigEndian((uint32_t)-7, 4),
+            PutValue(type::ValueFactory::GetIntegerValue(-7), 1));
+  EXPECT_EQ(BigEndian(1LL << 40, 8),
+            PutValue(type::ValueFactory::GetBigIntValue(1LL << 40), 1));
+
+  // DECIMAL is sent as a float8
+  double decimal = 2.5;
+  uint64_t decimal_bits;
+  memcpy(&decimal_bits, &decimal, sizeof(decimal_bits));
+  EXPECT_EQ(BigEndian(decimal_bits, 8),
+            PutValue(type::ValueFactory::GetDecimalValue(decimal), 1));
+
+  // 2000-01-02 00:00:01.000005 is one day, one second and five microseconds
+  // after the Postgres epoch
+  uint64_t timestamp =
+      ((((1 * 32 + 2) * 27 + 12) * 10000 + 2000) * 100000ULL + 1) * 1000000 +
+      5;
+  EXPECT_EQ(BigEndian(86400000000ULL + 1000000 + 5, 8),
+            PutValue(type::ValueFactory::GetTimestampValue(timestamp), 1));
+
+  // 2000-01-02 05:00:01.000005+05 is the same instant, sent in UTC
+  timestamp =
+      ((((1 * 32 + 2) * 27 + 17) * 10000 + 2000) * 100000ULL + 18001) *
+          1000000 +
+      5;
+  EXPECT_EQ(BigEndian(86400000000ULL + 1000000 + 5, 8),
+            PutValue(type::ValueFactory::GetTimestampValue(timestamp), 1));
+
+  // Strings are the same in both formats
+  EXPECT_EQ("peloton",
+            PutValue(type::ValueFactory::GetVarcharValue("peloton"), 1));
+}
+
+TEST_F(MarshalTests, HasBinaryFormatTest) {
+  EXPECT_TRUE(wire::HasBinaryFormat(PostgresValueType::INTEGER));
+  EXPECT_TRUE(wire::HasBinaryFormat(PostgresValueType::DOUBLE));
+  EXPECT_TRUE(wire::HasBinaryFormat(PostgresValueType::TEXT));
+  EXPECT_TRUE(wire::HasBinaryFormat(PostgresValueType::TIMESTAMPS));
+  // numeric and date have no binary encoding here, they are sent as text
+  EXPECT_FALSE(wire::HasBinaryFormat(PostgresValueType::DECIMAL));
+  EXPECT_FALSE(wire::HasBinaryFormat(PostgresValueType::DATE));
+}
+
+}  // End test namespace
+}  // End peloton namespace
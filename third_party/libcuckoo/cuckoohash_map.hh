@@ -552,6 +552,19 @@ public:
         return (st == ok);
     }
 
+    //! erase_fn runs the function \p fn on the value associated with \p key,
+    //! and removes the key and its value from the table if \p fn returns
+    //! true. \p fn will be passed one argument of type \p mapped_type& and
+    //! can modify the argument as desired. If \p key is not there, it returns
+    //! false, otherwise it returns true.
+    template <typename Eraser>
+    bool erase_fn(const key_type& key, Eraser fn) {
+        size_t hv = hashed_key(key);
+        auto b = snapshot_and_lock_two(hv);
+        const cuckoo_status st = cuckoo_erase_fn(key, fn, hv, b.i[0], b.i[1]);
+        return (st == ok);
+    }
+
     //! upsert is a combination of update_fn and insert. It first tries updating
     //! the value associated with \p key using \p fn. If \p key is not in the
     //! table, then it runs an insert with \p key and \p val. It will always
@@ -1397,6 +1410,31 @@ private:
         return false;
     }
 
+    // try_erase_bucket_fn will search the bucket for the given key, run the
+    // given function on its associated value if it finds it, and set the slot
+    // of the key to empty if the function returns true.
+    template <typename Eraser>
+    bool try_erase_bucket_fn(const partial_t partial, const key_type &key,
+                             Eraser fn, Bucket& b) {
+        for (size_t i = 0; i < slot_per_bucket; ++i) {
+            if (!b.occupied(i)) {
+                continue;
+            }
+            if (!is_simple && b.partial(i) != partial) {
+                continue;
+            }
+            if (key_eq()(b.key(i), key)) {
+                if (fn(b.val(i))) {
+                    b.eraseKV(i);
+                    num_deletes_[get_counterid()].num.fetch_add(
+                        1, std::memory_order_relaxed);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
     // cuckoo_find searches the table for the given key and value, storing the
     // value in the val if it finds the key. It expects the locks to be taken
     // and released outside the function.
@@ -1577,6 +1615,24 @@ private:
         return failure_key_not_found;
     }
 
+    // cuckoo_erase_fn searches the table for the given key, runs the given
+    // function on its value if it finds it, and removes the key if the
+    // function returns true. It expects the locks to be taken and released
+    // outside the function.
+    template <typename Eraser>
+    cuckoo_status cuckoo_erase_fn(const key_type &key, Eraser fn,
+                                  const size_t hv, const size_t i1,
+                                  const size_t i2) {
+        const partial_t partial = partial_key(hv);
+        if (try_erase_bucket_fn(partial, key, fn, buckets_[i1])) {
+            return ok;
+        }
+        if (try_erase_bucket_fn(partial, key, fn, buckets_[i2])) {
+            return ok;
+        }
+        return failure_key_not_found;
+    }
+
     // cuckoo_clear empties the table, calling the destructors of all the
     // elements it removes from the table. It assumes the locks are taken as
     // necessary.